@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "Audio_AnalysisWorker.h"
+//--------------------------------------
+
+namespace Audio {
+    //**************************************************************************
+    // AnalysisWorker
+    //**************************************************************************
+    bool AnalysisWorker::StartThread(data_manager_pointer pDataManager) {
+        assert(pDataManager); if (!pDataManager) { return false; }
+        assert(!m_Thread.joinable()); if (m_Thread.joinable()) { return false; }
+
+        m_pDataManager = pDataManager;
+        m_Statistics.Set(statistics{});
+        m_IntervalTimer.Reset();
+
+        m_Thread = std::thread{
+            [this]() noexcept {
+                try {
+                    Run();
+                } catch (...) {
+                    SafeLogCritical("Unhandled exception in audio analysis thread.");
+                    assert(false);
+                }
+            }
+        };
+        return m_Thread.joinable();
+    }
+
+    //------------------------------------------------------
+
+    void AnalysisWorker::StopThread() noexcept {
+        if (!m_Thread.joinable()) { return; }
+
+        // NOTE: `Stop` posts to the thread message queue, which will not
+        //       exist until the thread has started running, so keep
+        //       asking until the thread actually exits.
+        const auto hThread{ static_cast<HANDLE>(m_Thread.native_handle()) };
+        do {
+            Stop();
+        } while (::WaitForSingleObject(hThread, 10) == WAIT_TIMEOUT);
+
+        try {
+            m_Thread.join();
+        } catch (...) {
+            assert(false);
+        }
+        m_pDataManager.reset();
+
+        const auto stats{ m_Statistics.Get() };
+        SafeLogDebug("Audio analysis: {} passes, mean {:.2f}ms, max {:.2f}ms, jitter {:.2f}ms",
+                     stats.m_nPasses,
+                     stats.m_fMeanDurationMS,
+                     stats.m_fMaxDurationMS,
+                     stats.m_fJitterMS);
+    }
+
+    //------------------------------------------------------
+
+    AnalysisWorker::generation_type AnalysisWorker::SetRequest(const request_params& params,
+                                                               duration_type fFrequency) {
+        request_type request{};
+        request.m_Params     = params;
+        request.m_Generation = ++m_nGeneration;
+        request.m_fFrequency = fFrequency;
+        m_Request.Set(request);
+        return request.m_Generation;
+    }
+
+    //------------------------------------------------------
+
+    AnalysisWorker::WorkerStatus AnalysisWorker::OnTick(float /*fInterp*/) {
+        assert(m_pDataManager); if (!m_pDataManager) { return WorkerStatus::Quit; }
+
+        const auto request{ m_Request.Get() };
+        if (request.m_Generation == 0) { return WorkerStatus::Continue; } //< Nothing requested yet
+
+        // Frequency can only be changed from the worker's own thread
+        if (std::fabs(GetTickFrequency() - request.m_fFrequency) >= 1.f) {
+            SetFrequency(request.m_fFrequency, request.m_fFrequency);
+        }
+
+        const auto fIntervalMS{
+            m_IntervalTimer.IsRunning() ? m_IntervalTimer.GetElapsedMilliseconds() : 0.f
+        };
+        m_IntervalTimer.Start();
+
+        m_PassTimer.Start();
+        m_pDataManager->Analyse(request.m_Params, request.m_Generation);
+        const auto fDurationMS{ m_PassTimer.GetElapsedMilliseconds() };
+
+        constexpr const duration_type fWeight{ .1f };
+        auto stats{ m_Statistics.Get() };
+        ++stats.m_nPasses;
+        stats.m_fDurationMS     = fDurationMS;
+        stats.m_fMeanDurationMS = ::util::lerp(stats.m_fMeanDurationMS, fDurationMS, fWeight);
+        stats.m_fMaxDurationMS  = std::max(stats.m_fMaxDurationMS, fDurationMS);
+        if (fIntervalMS > 0) {
+            stats.m_fIntervalMS = fIntervalMS;
+            stats.m_fJitterMS   = ::util::lerp(stats.m_fJitterMS,
+                                               std::fabs(fIntervalMS - GetTickPeriod()),
+                                               fWeight);
+        }
+        m_Statistics.Set(stats);
+
+        return WorkerStatus::Continue;
+    }
+} // namespace Audio
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef GUID_E35191A7_8083_413F_8660_FB0EDA329973
+#define GUID_E35191A7_8083_413F_8660_FB0EDA329973
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Audio_DataManager.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Windows/Thread/Thread_Worker.h"
+#include "Windows/Thread/Thread_CriticalSection.h"
+#include "Windows/Windows_StopWatch.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <thread>
+//--------------------------------------
+
+namespace Audio {
+    //**************************************************************************
+    // AnalysisWorker:
+    // ---------------
+    //
+    // Runs `IAudioDataManager::Analyse` on a dedicated thread, so audio fetch
+    // and processing is isolated from rendering (and from the LCD update,
+    // which may block waiting for VSync).
+    //
+    // Requests are handed over with a "generation", which is carried through
+    // to each published frame so the render thread can tell when data for
+    // the current request has arrived.
+    //
+    // Timing of each analysis pass (duration, and interval between passes)
+    // is recorded so latency and jitter can be inspected.
+    //
+    //**************************************************************************
+    class AnalysisWorker final :
+        public ::Windows::Thread::Worker {
+    private:
+        using this_class = AnalysisWorker;
+        using base_class = ::Windows::Thread::Worker;
+
+        using stop_watch = ::Windows::StopWatch;
+
+        template <typename TypeT>
+        using protected_variable = ::Windows::Thread::CriticalSectionProtectedVariableT<TypeT>;
+
+    public:
+        using data_manager         = ::Audio::IAudioDataManager;
+        using data_manager_pointer = typename data_manager::pointer_type;
+        using request_params       = ::Visualisation::RequestParams;
+        using generation_type      = typename data_manager::generation_type;
+        using duration_type        = float;
+
+        struct request_type final {
+            request_params  m_Params    {};
+            generation_type m_Generation{ 0 };
+            duration_type   m_fFrequency{ 15.f };
+        };
+
+        struct statistics final {
+            std::size_t   m_nPasses         { 0 };
+            duration_type m_fDurationMS     { 0 }; //< Most recent pass
+            duration_type m_fMeanDurationMS { 0 }; //< Moving average
+            duration_type m_fMaxDurationMS  { 0 };
+            duration_type m_fIntervalMS     { 0 }; //< Time between most recent passes
+            duration_type m_fJitterMS       { 0 }; //< Moving average of |interval - period|
+        };
+
+    public:
+        AnalysisWorker() noexcept = default;
+
+        ~AnalysisWorker() noexcept {
+            StopThread();
+        }
+
+        AnalysisWorker(const this_class& )            = delete; // No Copy
+        AnalysisWorker(      this_class&&)            = delete; // No Move
+        this_class& operator=(const this_class& )     = delete; // No Copy
+        this_class& operator=(      this_class&&)     = delete; // No Move
+
+    public:
+        bool StartThread(data_manager_pointer pDataManager);
+        void StopThread () noexcept;
+
+        generation_type SetRequest(const request_params& params,
+                                   duration_type fFrequency);
+
+        [[nodiscard]]
+        decltype(auto) GetStatistics() const noexcept { return m_Statistics.Get(); }
+
+    protected: // Worker
+        virtual WorkerStatus OnTick(float fInterp) override;
+
+    private:
+        data_manager_pointer           m_pDataManager{};
+        std::thread                    m_Thread      {};
+
+        protected_variable<request_type> m_Request   {};
+        generation_type                m_nGeneration { 0 }; //< Owned by caller of `SetRequest`
+
+        stop_watch                     m_PassTimer   {};
+        stop_watch                     m_IntervalTimer{};
+        protected_variable<statistics> m_Statistics  {};
+    }; // class AnalysisWorker final
+} // namespace Audio
+
+#endif // GUID_E35191A7_8083_413F_8660_FB0EDA329973
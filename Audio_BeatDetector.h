@@ -0,0 +1,435 @@
+#pragma once
+#ifndef GUID_5261E6C3_8979_43F7_BBED_D8320FDFCC1A
+#define GUID_5261E6C3_8979_43F7_BBED_D8320FDFCC1A
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Util/InterpolateUtil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+//--------------------------------------
+
+namespace Audio::Beat {
+    /**********************************************************************
+     * BeatStateT *
+     **********************************************************************/
+    template <typename SampleTypeT>
+    struct BeatStateT final {
+        using sample_type = SampleTypeT;
+        using count_type  = std::uint32_t;
+
+        sample_type fPhase     { 0 };     //< [0, 1), 0 being on the beat
+        sample_type fStrength  { 0 };     //< [0, 1], set on the beat then decays
+        sample_type fTempo     { 0 };     //< Beats per minute, 0 if unknown
+        sample_type fConfidence{ 0 };     //< [0, 1], of the tempo estimate
+        count_type  nBeatCount { 0 };     //< Beats seen since reset
+        bool        bOnset     { false }; //< Onset detected in this update
+    }; // template <...> struct BeatStateT final
+
+    /**********************************************************************
+     * BeatDataT *
+     **********************************************************************/
+    //
+    // Beat state as seen by the render thread: holds the
+    // last two updates so values can be interpolated in
+    // the same way as the other audio data.
+    template <typename SampleTypeT>
+    class BeatDataT final {
+    private:
+        using this_type = BeatDataT<SampleTypeT>;
+
+    public:
+        using state_type  = BeatStateT<SampleTypeT>;
+        using sample_type = typename state_type::sample_type;
+        using count_type  = typename state_type::count_type;
+
+    public:
+        void clear() noexcept { m_Prev = {}; m_Next = {}; }
+        void reset() noexcept { clear(); }
+        void zero () noexcept { clear(); }
+
+        void update(const state_type& state) noexcept {
+            m_Prev = m_Next;
+            m_Next = state;
+        }
+
+    public:
+        // Phase wraps, so always interpolate forwards
+        [[nodiscard]]
+        sample_type phase_curr(sample_type interp) const noexcept {
+            auto next{ m_Next.fPhase };
+            if (next < m_Prev.fPhase) { next += static_cast<sample_type>(1); }
+            const auto phase{ ::util::lerp(m_Prev.fPhase, next, interp) };
+            return phase - std::floor(phase);
+        }
+
+        [[nodiscard]]
+        sample_type strength_curr(sample_type interp) const noexcept {
+            return ::util::lerp(m_Prev.fStrength, m_Next.fStrength, interp);
+        }
+
+        [[nodiscard]] constexpr auto tempo      () const noexcept { return m_Next.fTempo; }
+        [[nodiscard]] constexpr auto confidence () const noexcept { return m_Next.fConfidence; }
+        [[nodiscard]] constexpr auto beat_count () const noexcept { return m_Next.nBeatCount; }
+        [[nodiscard]] constexpr auto onset      () const noexcept { return m_Next.bOnset; }
+
+    private:
+        state_type m_Prev{ };
+        state_type m_Next{ };
+    }; // template <...> class BeatDataT final
+
+    /**********************************************************************
+     * BeatDetectorT *
+     **********************************************************************/
+    //
+    // Incremental spectral flux onset detector and tempo
+    // tracker, fed one magnitude spectrum per update.
+    //
+    // * Flux: spectra are reduced to `BandCount` log
+    //   spaced, log compressed bands; the onset function
+    //   is the mean positive change between updates.
+    // * Onsets: flux rising above an adaptive threshold
+    //   (running mean + `ThresholdDeviations` standard
+    //   deviations).
+    // * Tempo: the onset function is held on a uniform
+    //   `HistoryRate` grid; every `TempoInterval` slots its
+    //   autocorrelation is searched over the
+    //   [`MinTempo`, `MaxTempo`] range, weighted towards
+    //   `PreferredTempo`.
+    // * Phase: advanced by elapsed time and pulled towards
+    //   detected onsets (a simple phase locked loop).
+    //
+    // All state is fixed size; `update` does not allocate.
+    template <typename SampleTypeT>
+    class BeatDetectorT final {
+    private:
+        using this_type = BeatDetectorT<SampleTypeT>;
+
+    public:
+        using state_type  = BeatStateT<SampleTypeT>;
+        using sample_type = typename state_type::sample_type;
+        using size_type   = std::size_t;
+
+    public:
+        inline static constexpr const size_type   BandCount          { 32 };
+        inline static constexpr const size_type   HistoryCount       { 512 };
+        inline static constexpr const sample_type HistoryRate        { 50 };  //< Slots per second
+        inline static constexpr const size_type   TempoInterval      { 25 };  //< Slots between tempo estimates
+        inline static constexpr const sample_type MinTempo           { 60 };
+        inline static constexpr const sample_type MaxTempo           { 200 };
+        inline static constexpr const sample_type PreferredTempo     { 120 };
+        inline static constexpr const sample_type ThresholdDeviations{ static_cast<sample_type>(1.5) };
+        inline static constexpr const sample_type MinOnsetInterval   { static_cast<sample_type>(.1) }; //< Seconds
+
+    private:
+        inline static constexpr const sample_type Compression      { 100 }; //< log(1 + C * magnitude)
+        inline static constexpr const sample_type StatisticsTime   { 1 };   //< Seconds (running mean/variance)
+        inline static constexpr const sample_type PhaseGain        { static_cast<sample_type>(.25) };
+        inline static constexpr const sample_type PhaseWindow      { static_cast<sample_type>(.35) }; //< Onsets further from a beat pull weakly
+        inline static constexpr const sample_type OctaveRatio      { static_cast<sample_type>(.9) };  //< Half-lag support needed to double the tempo
+        inline static constexpr const sample_type TempoTolerance   { static_cast<sample_type>(.1) };  //< Period change still treated as drift
+        inline static constexpr const sample_type TempoSmoothing   { static_cast<sample_type>(.3) };
+
+    public:
+        void reset() noexcept {
+            const auto nBinCount{ m_nBinCount };
+            const auto bandEdges{ m_BandEdges };
+            *this = this_type{};
+            m_nBinCount = nBinCount;
+            m_BandEdges = bandEdges;
+        }
+
+        [[nodiscard]]
+        constexpr const auto& state() const noexcept { return m_State; }
+
+        //--------------------------------------------------
+        // `spectrum` is `sourceSize / stride` bins of
+        // interleaved magnitudes (all channels are summed);
+        // `nullptr` is treated as silence. `elapsed` is the
+        // time since the previous update in seconds.
+        const state_type& update(const sample_type* spectrum,
+                                 size_type sourceSize,
+                                 size_type stride,
+                                 sample_type elapsed) noexcept {
+            elapsed = std::max(elapsed, static_cast<sample_type>(0));
+            m_fTime += elapsed;
+
+            const auto flux{ this_type::flux(spectrum, sourceSize, stride) };
+            this_type::detect_onset(flux, elapsed);
+            this_type::push_history(flux, elapsed);
+            this_type::advance_phase(elapsed);
+            return m_State;
+        }
+
+    private:
+        void band_edges(size_type nBinCount) noexcept {
+            if (nBinCount == m_nBinCount) { return; }
+            m_nBinCount = nBinCount;
+
+            // Log spaced from bin 1 (DC ignored), each band at
+            // least one bin wide while bins remain
+            const auto fBinCount{ static_cast<sample_type>(nBinCount) };
+            size_type edge{ std::min<size_type>(1, nBinCount) };
+            m_BandEdges[0] = edge;
+            for (size_type b = 1; b <= BandCount; ++b) {
+                const auto fEdge{ std::pow(fBinCount, static_cast<sample_type>(b) / static_cast<sample_type>(BandCount)) };
+                edge = std::max(edge + 1, static_cast<size_type>(fEdge));
+                m_BandEdges[b] = std::min(edge, nBinCount);
+            }
+        }
+
+        sample_type flux(const sample_type* spectrum,
+                         size_type sourceSize,
+                         size_type stride) noexcept {
+            std::array<sample_type, BandCount> bands{ };
+            if (spectrum && stride > 0 && sourceSize >= stride) {
+                this_type::band_edges(sourceSize / stride);
+                for (size_type b = 0; b < BandCount; ++b) {
+                    const auto first{ m_BandEdges[b] };
+                    const auto last { m_BandEdges[b + 1] };
+                    if (first >= last) { continue; }
+                    sample_type acc{ 0 };
+                    const auto* s{ spectrum + first * stride };
+                    const auto* e{ spectrum + last  * stride };
+                    for (; s != e; ++s) { acc += std::fabs(*s); }
+                    acc /= static_cast<sample_type>(last - first);
+                    bands[b] = std::log1p(Compression * acc);
+                }
+            }
+
+            sample_type total{ 0 };
+            for (size_type b = 0; b < BandCount; ++b) {
+                total += std::max(bands[b] - m_PrevBands[b], static_cast<sample_type>(0));
+            }
+            m_PrevBands = bands;
+            return total / static_cast<sample_type>(BandCount);
+        }
+
+        void detect_onset(sample_type flux,
+                          sample_type elapsed) noexcept {
+            const auto deviation{ std::sqrt(m_fFluxVariance) };
+            const auto threshold{ m_fFluxMean + ThresholdDeviations * deviation };
+            const auto bAbove   { flux > threshold && flux > static_cast<sample_type>(0) };
+
+            m_State.bOnset = bAbove && !m_bFluxAbove &&
+                             (m_fTime - m_fLastOnset) >= MinOnsetInterval;
+            m_bFluxAbove = bAbove;
+            if (m_State.bOnset) {
+                m_fLastOnset = m_fTime;
+                const auto excess{ (flux - m_fFluxMean) / (static_cast<sample_type>(3) * deviation + std::numeric_limits<sample_type>::epsilon()) };
+                m_fOnsetStrength = std::clamp(excess, static_cast<sample_type>(0), static_cast<sample_type>(1));
+            }
+
+            // Exponentially weighted mean/variance (West's update)
+            const auto alpha{ std::min(elapsed / StatisticsTime, static_cast<sample_type>(1)) };
+            const auto delta{ flux - m_fFluxMean };
+            m_fFluxMean    += alpha * delta;
+            m_fFluxVariance = (static_cast<sample_type>(1) - alpha) * (m_fFluxVariance + alpha * delta * delta);
+        }
+
+        void push_history(sample_type flux,
+                          sample_type elapsed) noexcept {
+            // Updates may be faster or slower than the slot rate:
+            // keep the largest flux seen until a slot completes,
+            // then hold it over every slot this update covers.
+            m_fPendingFlux = std::max(m_fPendingFlux, flux);
+            m_fSlotFraction += elapsed * HistoryRate;
+            auto slots{ static_cast<size_type>(m_fSlotFraction) };
+            m_fSlotFraction -= static_cast<sample_type>(slots);
+            slots = std::min(slots, HistoryCount);
+            if (slots == 0) { return; }
+
+            for (size_type s = 0; s < slots; ++s) {
+                m_History[m_nHistoryNext] = m_fPendingFlux;
+                m_nHistoryNext = (m_nHistoryNext + 1) % HistoryCount;
+            }
+            m_fPendingFlux = 0;
+            m_nHistoryCount = std::min(m_nHistoryCount + slots, HistoryCount);
+
+            m_nSlotsSinceTempo += slots;
+            if (m_nSlotsSinceTempo >= TempoInterval) {
+                m_nSlotsSinceTempo = 0;
+                this_type::estimate_tempo();
+            }
+        }
+
+        void estimate_tempo() noexcept {
+            const auto minLag{ static_cast<size_type>(std::floor(HistoryRate * static_cast<sample_type>(60) / MaxTempo)) };
+            const auto maxLag{ static_cast<size_type>(std::ceil (HistoryRate * static_cast<sample_type>(60) / MinTempo)) };
+            const auto count { m_nHistoryCount };
+            if (count < maxLag * 2 + 2) { return; }
+
+            // Oldest first, [1 2 1] smoothed so beat periods that
+            // fall between slots don't split the peak, mean removed
+            std::array<sample_type, HistoryCount> odf;
+            const auto start{ (m_nHistoryNext + HistoryCount - count) % HistoryCount };
+            const auto at = [this, start, count](size_type i) noexcept {
+                return m_History[(start + std::min(i, count - 1)) % HistoryCount];
+            };
+            sample_type mean{ 0 };
+            for (size_type i = 0; i < count; ++i) {
+                const auto prev{ at(i > 0 ? i - 1 : 0) };
+                odf[i] = (prev + static_cast<sample_type>(2) * at(i) + at(i + 1)) * static_cast<sample_type>(.25);
+                mean += odf[i];
+            }
+            mean /= static_cast<sample_type>(count);
+            sample_type energy{ 0 };
+            for (size_type i = 0; i < count; ++i) {
+                odf[i] -= mean;
+                energy += odf[i] * odf[i];
+            }
+            if (energy <= std::numeric_limits<sample_type>::epsilon()) { return; }
+            energy /= static_cast<sample_type>(count);
+
+            const auto correlate = [&odf, count](size_type lag) noexcept {
+                sample_type acc{ 0 };
+                for (size_type i = lag; i < count; ++i) { acc += odf[i] * odf[i - lag]; }
+                return acc / static_cast<sample_type>(count - lag);
+            };
+
+            // Log-Gaussian preference (one octave deviation)
+            const auto weight = [](sample_type lag) noexcept {
+                const auto tempo{ HistoryRate * static_cast<sample_type>(60) / lag };
+                const auto octaves{ std::log2(tempo / PreferredTempo) };
+                return std::exp(static_cast<sample_type>(-.5) * octaves * octaves);
+            };
+
+            std::array<sample_type, HistoryCount> acf;
+            size_type bestLag{ 0 };
+            sample_type bestScore{ 0 };
+            for (size_type lag = minLag - 1; lag <= maxLag + 1; ++lag) {
+                acf[lag] = correlate(lag);
+                if (lag < minLag || lag > maxLag) { continue; }
+                const auto score{ acf[lag] * weight(static_cast<sample_type>(lag)) };
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestLag   = lag;
+                }
+            }
+            if (bestLag == 0) { return; }
+
+            // Periodic onsets correlate equally at every multiple
+            // of the beat; prefer half the lag when it is nearly
+            // as well supported
+            if (const auto half{ bestLag / 2 }; half >= minLag) {
+                const auto peak{ std::max(acf[half], acf[bestLag - half]) };
+                if (peak >= acf[bestLag] * OctaveRatio) {
+                    bestLag = (acf[half] >= acf[bestLag - half]) ? half : bestLag - half;
+                }
+            }
+
+            // Parabolic interpolation around the peak
+            const auto y0{ acf[bestLag - 1] }, y1{ acf[bestLag] }, y2{ acf[bestLag + 1] };
+            const auto denom{ y0 - static_cast<sample_type>(2) * y1 + y2 };
+            auto lag{ static_cast<sample_type>(bestLag) };
+            if (std::fabs(denom) > std::numeric_limits<sample_type>::epsilon()) {
+                lag += std::clamp(static_cast<sample_type>(.5) * (y0 - y2) / denom,
+                                  static_cast<sample_type>(-.5), static_cast<sample_type>(.5));
+            }
+
+            // Smooth small drifts; a different tempo (or octave)
+            // is taken as-is rather than blended into a third
+            const auto period{ lag / HistoryRate };
+            const auto bNear { m_fPeriod > 0 && std::fabs(period - m_fPeriod) <= m_fPeriod * TempoTolerance };
+            m_fPeriod = bNear ? ::util::lerp(m_fPeriod, period, TempoSmoothing)
+                              : period;
+            m_State.fTempo      = static_cast<sample_type>(60) / m_fPeriod;
+            m_State.fConfidence = std::clamp(y1 / energy, static_cast<sample_type>(0), static_cast<sample_type>(1));
+        }
+
+        void advance_phase(sample_type elapsed) noexcept {
+            // Strength decays over a quarter beat (or 125ms
+            // without a tempo)
+            const auto decayTime{ (m_fPeriod > 0) ? m_fPeriod * static_cast<sample_type>(.25) : static_cast<sample_type>(.125) };
+            m_State.fStrength *= std::exp(-elapsed / decayTime);
+            m_fOnsetStrength  *= std::exp(-elapsed / decayTime);
+
+            if (m_fPeriod <= 0) {
+                // No tempo yet: every onset is a beat
+                if (m_State.bOnset) {
+                    ++m_State.nBeatCount;
+                    m_State.fStrength = m_fOnsetStrength;
+                }
+                return;
+            }
+
+            auto phase{ m_State.fPhase + elapsed / m_fPeriod };
+            if (m_State.bOnset) {
+                // Onset either just after (error > 0) or just
+                // before (error < 0) the predicted beat
+                const auto wrapped{ phase - std::floor(phase) };
+                const auto error{ (wrapped < static_cast<sample_type>(.5)) ? wrapped : wrapped - static_cast<sample_type>(1) };
+                // Off-beat onsets pull only weakly so syncopation
+                // can't drag the beat, but a lock that started
+                // out of phase still converges
+                const auto gain{ (std::fabs(error) <= PhaseWindow) ? PhaseGain : PhaseGain * static_cast<sample_type>(.25) };
+                phase -= error * gain;
+            }
+
+            if (phase >= static_cast<sample_type>(1)) {
+                phase -= std::floor(phase);
+                ++m_State.nBeatCount;
+                m_State.fStrength = std::max(m_fOnsetStrength, m_State.fConfidence);
+            } else if (phase < 0) {
+                phase += static_cast<sample_type>(1);
+            }
+            m_State.fPhase = phase;
+        }
+
+    private:
+        state_type m_State{ };
+
+        // Bands
+        size_type                              m_nBinCount{ 0 };
+        std::array<size_type, BandCount + 1>   m_BandEdges{ };
+        std::array<sample_type, BandCount>     m_PrevBands{ };
+
+        // Onsets
+        sample_type m_fTime          { 0 };
+        sample_type m_fLastOnset     { -MinOnsetInterval };
+        sample_type m_fFluxMean      { 0 };
+        sample_type m_fFluxVariance  { 0 };
+        sample_type m_fOnsetStrength { 0 };
+        bool        m_bFluxAbove     { false };
+
+        // Tempo
+        std::array<sample_type, HistoryCount> m_History{ };
+        size_type   m_nHistoryNext    { 0 };
+        size_type   m_nHistoryCount   { 0 };
+        size_type   m_nSlotsSinceTempo{ 0 };
+        sample_type m_fSlotFraction   { 0 };
+        sample_type m_fPendingFlux    { 0 };
+        sample_type m_fPeriod         { 0 }; //< Seconds per beat, 0 if unknown
+    }; // template <...> class BeatDetectorT final
+} // namespace Audio::Beat
+
+#endif // GUID_5261E6C3_8979_43F7_BBED_D8320FDFCC1A
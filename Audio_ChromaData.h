@@ -0,0 +1,343 @@
+#pragma once
+#ifndef GUID_F43C131C_CEE7_4430_BB68_F9473221E10D
+#define GUID_F43C131C_CEE7_4430_BB68_F9473221E10D
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Util/InterpolateUtil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+//--------------------------------------
+
+namespace Audio::Chroma {
+    inline constexpr const std::size_t PitchClassCount{ 12 }; //< C, C#, ..., B
+    inline constexpr const std::size_t KeyCount       { 24 }; //< Major (0-11) then minor (12-23), from C
+
+    //**************************************************************************
+    // ChromaStateT
+    //**************************************************************************
+    template <typename SampleTypeT>
+    struct ChromaStateT final {
+        using sample_type = SampleTypeT;
+        using chroma_type = std::array<sample_type, PitchClassCount>;
+        using key_type    = std::int32_t;
+
+        chroma_type chroma       { };      //< [0, 1], loudest pitch class is 1
+        key_type    nKey         { -1 };   //< [0, KeyCount), -1 if unknown
+        sample_type fKeyConfidence{ 0 };   //< [0, 1]
+    }; // template <...> struct ChromaStateT final
+
+    //**************************************************************************
+    // ChromaDataT
+    //**************************************************************************
+    //
+    // Chroma as seen by the render thread: holds the last
+    // two updates so values can be interpolated in the same
+    // way as the other audio data.
+    template <typename SampleTypeT>
+    class ChromaDataT final {
+    private:
+        using this_type = ChromaDataT<SampleTypeT>;
+
+    public:
+        using state_type  = ChromaStateT<SampleTypeT>;
+        using sample_type = typename state_type::sample_type;
+        using chroma_type = typename state_type::chroma_type;
+        using key_type    = typename state_type::key_type;
+
+    public:
+        void clear() noexcept { m_Prev = {}; m_Next = {}; }
+        void reset() noexcept { clear(); }
+        void zero () noexcept { clear(); }
+
+        void update(const state_type& state) noexcept {
+            m_Prev = m_Next;
+            m_Next = state;
+        }
+
+    public:
+        [[nodiscard]]
+        chroma_type chroma_curr(sample_type interp) const noexcept {
+            chroma_type chroma{};
+            for (std::size_t i = 0; i < PitchClassCount; ++i) {
+                chroma[i] = ::util::lerp(m_Prev.chroma[i], m_Next.chroma[i], interp);
+            }
+            return chroma;
+        }
+
+        [[nodiscard]] constexpr auto key           () const noexcept { return m_Next.nKey; }
+        [[nodiscard]] constexpr auto key_confidence() const noexcept { return m_Next.fKeyConfidence; }
+
+    private:
+        state_type m_Prev{ };
+        state_type m_Next{ };
+    }; // template <...> class ChromaDataT final
+
+    //**************************************************************************
+    // ChromaAnalyserT
+    //**************************************************************************
+    //
+    // Folds magnitude spectra into 12 pitch classes and
+    // estimates the key.
+    //
+    // * Folding: a precomputed sparse map gives each FFT
+    //   bin in [`MinFrequency`, `MaxFrequency`] its pitch
+    //   class and a weight, cos^2 of its distance (in
+    //   semitones) from the nearest equal tempered pitch,
+    //   so in-tune partials count fully and quarter tones
+    //   not at all. A semitone spans more FFT bins the
+    //   higher it is, so each weight is then divided by the
+    //   total weight of its semitone: every semitone counts
+    //   the same and the upper octaves don't dominate.
+    //   Bins below the point where a semitone spans
+    //   `MinSemitoneBins` FFT bins are left out as they
+    //   can't be told apart. The map depends only on the
+    //   FFT size and sample rate so folding is one
+    //   multiply-add per mapped bin.
+    // * Display: per update chroma (magnitude, channels
+    //   combined) normalised to its peak and smoothed with
+    //   time constant `DisplayTime`.
+    // * Key: the chroma normalised to its sum is averaged
+    //   over `KeyTime` and correlated against the
+    //   Temperley-Kostka-Payne major/minor profiles in all
+    //   24 rotations; the best match is the key and its
+    //   correlation the confidence. (These profiles are
+    //   less prone than Krumhansl-Kessler to reading the
+    //   dominant as the tonic when partials are strong.)
+    template <typename SampleTypeT>
+    class ChromaAnalyserT final {
+    private:
+        using this_type = ChromaAnalyserT<SampleTypeT>;
+
+    public:
+        using state_type  = ChromaStateT<SampleTypeT>;
+        using sample_type = typename state_type::sample_type;
+        using chroma_type = typename state_type::chroma_type;
+        using key_type    = typename state_type::key_type;
+        using size_type   = std::size_t;
+
+        inline static constexpr const sample_type MinFrequency   { static_cast<sample_type>(65.406391325149658) }; //< C2 (Hz)
+        inline static constexpr const sample_type MaxFrequency   { 5000 };                                       //< Hz
+        inline static constexpr const sample_type MinSemitoneBins{ 1 };
+        inline static constexpr const sample_type DisplayTime    { static_cast<sample_type>(.15) }; //< Seconds
+        inline static constexpr const sample_type KeyTime        { 8 };                             //< Seconds
+
+    private:
+        inline static constexpr const sample_type ReferenceA4{ 440 };
+        inline static constexpr const sample_type SilenceLevel{ static_cast<sample_type>(1e-10) }; //< Mean power per mapped bin
+
+        using profile_type = std::array<sample_type, PitchClassCount>;
+        inline static constexpr const profile_type MajorProfile{
+            static_cast<sample_type>(0.748), static_cast<sample_type>(0.060), static_cast<sample_type>(0.488), static_cast<sample_type>(0.082),
+            static_cast<sample_type>(0.670), static_cast<sample_type>(0.460), static_cast<sample_type>(0.096), static_cast<sample_type>(0.715),
+            static_cast<sample_type>(0.104), static_cast<sample_type>(0.366), static_cast<sample_type>(0.057), static_cast<sample_type>(0.400)
+        };
+        inline static constexpr const profile_type MinorProfile{
+            static_cast<sample_type>(0.712), static_cast<sample_type>(0.084), static_cast<sample_type>(0.474), static_cast<sample_type>(0.618),
+            static_cast<sample_type>(0.049), static_cast<sample_type>(0.460), static_cast<sample_type>(0.105), static_cast<sample_type>(0.747),
+            static_cast<sample_type>(0.404), static_cast<sample_type>(0.067), static_cast<sample_type>(0.133), static_cast<sample_type>(0.330)
+        };
+
+    public:
+        // Keeps the map (it only depends on the FFT size
+        // and sample rate)
+        void reset() noexcept {
+            m_Display = {};
+            m_Key     = {};
+        }
+
+        //--------------------------------------------------
+        // `source` is `sourceSize / stride` FFT bins covering
+        // [0, sampleRate / 2) of `stride` interleaved
+        // channels; `elapsed` is the time since the previous
+        // update in seconds. No data is treated as silence.
+        state_type update(const sample_type* source,
+                          size_type sourceSize,
+                          size_type stride,
+                          sample_type sampleRate,
+                          sample_type elapsed) {
+            chroma_type frame{};
+            bool bSilent{ true };
+            if (source && stride > 0 && sourceSize >= stride && sampleRate > 0) {
+                configure(sourceSize / stride, sampleRate);
+                for (size_type i = 0; i < m_Bin.size(); ++i) {
+                    const auto* s{ source + m_Bin[i] * stride };
+                    sample_type power{ 0 };
+                    for (size_type ch = 0; ch < stride; ++ch) { power += s[ch] * s[ch]; }
+                    frame[m_Class[i]] += m_Weight[i] * std::sqrt(power);
+                }
+                sample_type total{ 0 };
+                for (const auto f : frame) { total += f; }
+                bSilent = !(total > SilenceLevel * static_cast<sample_type>(std::max<size_type>(m_Bin.size(), 1)));
+            }
+
+            const auto fElapsed{ std::max(elapsed, static_cast<sample_type>(0)) };
+            const auto alphaDisplay{ static_cast<sample_type>(1) - std::exp(-fElapsed / DisplayTime) };
+            const auto alphaKey    { static_cast<sample_type>(1) - std::exp(-fElapsed / KeyTime) };
+            if (bSilent) {
+                // Display falls away, key holds
+                for (auto& d : m_Display) { d = ::util::lerp(d, static_cast<sample_type>(0), alphaDisplay); }
+            } else {
+                const auto peak{ *std::max_element(frame.begin(), frame.end()) };
+                sample_type sum{ 0 };
+                for (const auto f : frame) { sum += f; }
+                for (size_type pc = 0; pc < PitchClassCount; ++pc) {
+                    m_Display[pc] = ::util::lerp(m_Display[pc], frame[pc] / peak, alphaDisplay);
+                    m_Key[pc]     = ::util::lerp(m_Key[pc],     frame[pc] / sum,  alphaKey);
+                }
+            }
+
+            state_type state{};
+            const auto displayPeak{ *std::max_element(m_Display.begin(), m_Display.end()) };
+            if (displayPeak > std::numeric_limits<sample_type>::epsilon()) {
+                for (size_type pc = 0; pc < PitchClassCount; ++pc) {
+                    state.chroma[pc] = m_Display[pc] / displayPeak;
+                }
+            }
+            estimate_key(state);
+            return state;
+        }
+
+    public:
+        [[nodiscard]]
+        size_type mapped_bin_count() const noexcept { return m_Bin.size(); }
+
+        // Pitch class of `frequency` (Hz), 0 being C
+        [[nodiscard]]
+        static size_type pitch_class(sample_type frequency) noexcept {
+            assert(frequency > 0);
+            const auto pitch{ static_cast<sample_type>(12) * std::log2(frequency / ReferenceA4) + static_cast<sample_type>(69) };
+            const auto nearest{ static_cast<long>(std::lround(pitch)) };
+            return static_cast<size_type>(((nearest % 12) + 12) % 12);
+        }
+
+        // Key 0-11 is the major key on that pitch class,
+        // 12-23 the minor
+        [[nodiscard]]
+        static constexpr bool is_minor(key_type key) noexcept { return key >= static_cast<key_type>(PitchClassCount); }
+
+        [[nodiscard]]
+        static constexpr size_type tonic(key_type key) noexcept { return static_cast<size_type>(key) % PitchClassCount; }
+
+    private:
+        void configure(size_type fftBinCount,
+                       sample_type sampleRate) {
+            if (fftBinCount == m_nFFTBinCount && sampleRate == m_fSampleRate) { return; }
+            m_nFFTBinCount = fftBinCount;
+            m_fSampleRate  = sampleRate;
+            m_Bin.clear();
+            m_Class.clear();
+            m_Weight.clear();
+
+            constexpr const auto fPi{ static_cast<sample_type>(3.14159265358979323846) };
+            const auto fBinHz{ sampleRate / static_cast<sample_type>(2 * fftBinCount) };
+            const auto fSemitone{ std::exp2(static_cast<sample_type>(1) / static_cast<sample_type>(12)) - static_cast<sample_type>(1) };
+            const auto fLow { std::max(MinFrequency, MinSemitoneBins * fBinHz / fSemitone) };
+            const auto fHigh{ std::min(MaxFrequency, sampleRate * static_cast<sample_type>(.5)) };
+            std::vector<long> notes{ };
+            for (size_type bin = 1; bin < fftBinCount; ++bin) {
+                const auto f{ static_cast<sample_type>(bin) * fBinHz };
+                if (f < fLow) { continue; }
+                if (f > fHigh) { break; }
+                const auto pitch{ static_cast<sample_type>(12) * std::log2(f / ReferenceA4) + static_cast<sample_type>(69) };
+                const auto offset{ pitch - std::round(pitch) };
+                const auto c{ std::cos(fPi * offset) };
+                const auto weight{ c * c };
+                if (weight <= 0) { continue; }
+                m_Bin.push_back(bin);
+                m_Class.push_back(static_cast<std::uint8_t>(pitch_class(f)));
+                m_Weight.push_back(weight);
+                notes.push_back(std::lround(pitch));
+            }
+
+            // Bins ascend, so each semitone is one run
+            for (size_type first = 0, last = 0; first < m_Bin.size(); first = last) {
+                sample_type total{ 0 };
+                for (last = first; last < m_Bin.size() && notes[last] == notes[first]; ++last) { total += m_Weight[last]; }
+                for (auto i = first; i < last; ++i) { m_Weight[i] /= total; }
+            }
+        }
+
+        void estimate_key(state_type& state) const noexcept {
+            sample_type mean{ 0 };
+            for (const auto k : m_Key) { mean += k; }
+            mean /= static_cast<sample_type>(PitchClassCount);
+            sample_type variance{ 0 };
+            for (const auto k : m_Key) { variance += (k - mean) * (k - mean); }
+            if (!(variance > std::numeric_limits<sample_type>::epsilon())) {
+                state.nKey = -1;
+                state.fKeyConfidence = 0;
+                return;
+            }
+
+            auto best{ -std::numeric_limits<sample_type>::max() };
+            key_type nBest{ -1 };
+            for (key_type key = 0; key < static_cast<key_type>(KeyCount); ++key) {
+                const auto r{ correlate(is_minor(key) ? MinorProfile : MajorProfile, tonic(key), mean, variance) };
+                if (r > best) { best = r; nBest = key; }
+            }
+            state.nKey = nBest;
+            state.fKeyConfidence = std::clamp(best, static_cast<sample_type>(0), static_cast<sample_type>(1));
+        }
+
+        // Pearson correlation of the key chroma with
+        // `profile` rotated to start on `tonic`
+        sample_type correlate(const profile_type& profile,
+                              size_type tonic,
+                              sample_type mean,
+                              sample_type variance) const noexcept {
+            sample_type profileMean{ 0 };
+            for (const auto p : profile) { profileMean += p; }
+            profileMean /= static_cast<sample_type>(PitchClassCount);
+
+            sample_type covariance{ 0 }, profileVariance{ 0 };
+            for (size_type i = 0; i < PitchClassCount; ++i) {
+                const auto p{ profile[i] - profileMean };
+                covariance      += (m_Key[(i + tonic) % PitchClassCount] - mean) * p;
+                profileVariance += p * p;
+            }
+            return covariance / std::sqrt(variance * profileVariance);
+        }
+
+    private:
+        std::vector<size_type>    m_Bin         { }; //< Mapped FFT bins...
+        std::vector<std::uint8_t> m_Class       { }; //< ...their pitch class...
+        std::vector<sample_type>  m_Weight      { }; //< ...and weight
+        size_type                 m_nFFTBinCount{ 0 };
+        sample_type               m_fSampleRate { 0 };
+        chroma_type               m_Display     { };
+        chroma_type               m_Key         { };
+    }; // template <...> class ChromaAnalyserT final
+} // namespace Audio::Chroma
+
+#endif // GUID_F43C131C_CEE7_4430_BB68_F9473221E10D
@@ -0,0 +1,202 @@
+#pragma once
+#ifndef GUID_7C45B282_2B02_4201_87AB_121B2CA04EA0
+#define GUID_7C45B282_2B02_4201_87AB_121B2CA04EA0
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+//--------------------------------------
+
+namespace Audio::ConstantQ {
+    //**************************************************************************
+    // SpectralKernelT
+    //**************************************************************************
+    //
+    // Musically spaced (constant-Q) spectrum from a linear
+    // FFT magnitude spectrum.
+    //
+    // Bin `k` is centred on `MinFrequency * 2^(k / B)` (`B`
+    // bins per octave) and weights the FFT bins within one
+    // bin spacing either side with a Hann window, so the
+    // bandwidth is proportional to the centre frequency.
+    // Where that would span fewer than `MinHalfWidth` FFT
+    // bins the width is held there instead (variable-Q), so
+    // the bass bins blend neighbouring FFT bins rather than
+    // repeating one.
+    //
+    // The kernel only depends on the FFT size, sample rate and
+    // `B`, so is built once and stored sparse (each bin's
+    // first FFT bin plus its run of weights); applying it is
+    // one multiply-add per weight. Weights sum to one and are
+    // applied to power, so a flat spectrum is unchanged.
+    template <typename SampleTypeT>
+    class SpectralKernelT final {
+    private:
+        using this_type = SpectralKernelT<SampleTypeT>;
+
+    public:
+        using sample_type = SampleTypeT;
+        using size_type   = std::size_t;
+        using output_type = std::vector<sample_type>;
+
+        inline static constexpr const sample_type MinFrequency{ static_cast<sample_type>(32.703195662574829) }; //< C1 (Hz)
+        inline static constexpr const size_type   OctaveCount { 9 };                                          //< C1 to C10
+        inline static constexpr const sample_type MaxFraction { static_cast<sample_type>(.45) };              //< Of sample rate
+        inline static constexpr const sample_type MinHalfWidth{ static_cast<sample_type>(2) };                //< FFT bins
+
+    public:
+        void reset() noexcept {
+            m_First.clear();
+            m_Offset.clear();
+            m_Weights.clear();
+            m_nFFTBinCount   = 0;
+            m_nBinsPerOctave = 0;
+            m_fSampleRate    = 0;
+        }
+
+        //--------------------------------------------------
+        // `fftBinCount` magnitudes covering [0, sampleRate / 2).
+        // Rebuilds the kernel if anything has changed; returns
+        // the number of constant-Q bins (0 if the FFT can't
+        // reach `MinFrequency`).
+        size_type configure(size_type fftBinCount,
+                            sample_type sampleRate,
+                            size_type binsPerOctave) {
+            if (fftBinCount    == m_nFFTBinCount &&
+                sampleRate     == m_fSampleRate  &&
+                binsPerOctave  == m_nBinsPerOctave) {
+                return bin_count();
+            }
+
+            reset();
+            m_nFFTBinCount   = fftBinCount;
+            m_fSampleRate    = sampleRate;
+            m_nBinsPerOctave = binsPerOctave;
+            if (fftBinCount < 2 || binsPerOctave == 0 || !(sampleRate > 0)) { return 0; }
+
+            const auto fBinHz{ sampleRate / static_cast<sample_type>(2 * fftBinCount) };
+            const auto fTop{
+                std::min(MinFrequency * static_cast<sample_type>(1 << OctaveCount),
+                         MaxFraction * sampleRate)
+            };
+            if (fTop <= MinFrequency) { return 0; }
+
+            const auto fPerOctave{ static_cast<sample_type>(binsPerOctave) };
+            const auto count{ static_cast<size_type>(std::floor(fPerOctave * std::log2(fTop / MinFrequency))) + 1 };
+            const auto fSpacing{ std::exp2(static_cast<sample_type>(1) / fPerOctave) - static_cast<sample_type>(1) };
+            constexpr const auto fPi{ static_cast<sample_type>(3.14159265358979323846) };
+            constexpr const auto fHalf{ static_cast<sample_type>(.5) };
+
+            m_First.reserve(count);
+            m_Offset.reserve(count + 1);
+            m_Offset.push_back(0);
+            for (size_type k = 0; k < count; ++k) {
+                const auto fCentre{ centre_frequency(k) / fBinHz };            //< FFT bins
+                const auto fWidth { std::max(fCentre * fSpacing, MinHalfWidth) }; //< FFT bins, each side
+                const auto first{
+                    static_cast<size_type>(std::max(std::floor(fCentre - fWidth) + 1, static_cast<sample_type>(0)))
+                };
+                const auto last{
+                    std::min(static_cast<size_type>(std::max(std::ceil(fCentre + fWidth) - 1, static_cast<sample_type>(0))),
+                             fftBinCount - 1)
+                };
+
+                const auto offset{ m_Weights.size() };
+                sample_type sum{ 0 };
+                for (auto i = first; i <= last; ++i) {
+                    const auto w{ fHalf + fHalf * std::cos(fPi * (static_cast<sample_type>(i) - fCentre) / fWidth) };
+                    m_Weights.push_back(w);
+                    sum += w;
+                }
+                if (sum > 0) {
+                    for (auto i = offset; i < m_Weights.size(); ++i) { m_Weights[i] /= sum; }
+                    m_First.push_back(first);
+                } else {
+                    // Centre beyond the FFT (can't happen while
+                    // `MaxFraction` < .5, but be safe)
+                    m_Weights.resize(offset);
+                    m_Weights.push_back(1);
+                    m_First.push_back(std::min(static_cast<size_type>(fCentre), fftBinCount - 1));
+                }
+                m_Offset.push_back(m_Weights.size());
+            }
+            return bin_count();
+        }
+
+    public:
+        [[nodiscard]]
+        size_type bin_count() const noexcept { return m_First.size(); }
+
+        [[nodiscard]]
+        size_type weight_count() const noexcept { return m_Weights.size(); }
+
+        [[nodiscard]]
+        sample_type centre_frequency(size_type bin) const noexcept {
+            assert(m_nBinsPerOctave > 0);
+            return MinFrequency * std::exp2(static_cast<sample_type>(bin) /
+                                            static_cast<sample_type>(m_nBinsPerOctave));
+        }
+
+        //--------------------------------------------------
+        // `source` is `sourceSize / stride` (the configured
+        // FFT bin count) frames of `stride` interleaved
+        // channels; the result is `bin_count()` frames in the
+        // same layout.
+        const output_type& apply(const sample_type* source,
+                                 [[maybe_unused]] size_type sourceSize,
+                                 size_type stride) {
+            assert(source && stride > 0);
+            assert(sourceSize / stride == m_nFFTBinCount);
+            const auto count{ bin_count() };
+            m_Output.resize(count * stride);
+            for (size_type ch = 0; ch < stride; ++ch) {
+                const auto* s{ source + ch };
+                auto* d{ m_Output.data() + ch };
+                for (size_type k = 0; k < count; ++k, d += stride) {
+                    const auto* w{ m_Weights.data() + m_Offset[k] };
+                    const auto* e{ m_Weights.data() + m_Offset[k + 1] };
+                    const auto* x{ s + m_First[k] * stride };
+                    sample_type acc{ 0 };
+                    for (; w != e; ++w, x += stride) { acc += *w * *x * *x; }
+                    *d = std::sqrt(acc);
+                }
+            }
+            return m_Output;
+        }
+
+    private:
+        std::vector<size_type>   m_First         { }; //< First FFT bin of each bin
+        std::vector<size_type>   m_Offset        { }; //< Start of each bin's weights (plus end)
+        std::vector<sample_type> m_Weights       { };
+        output_type              m_Output        { };
+        size_type                m_nFFTBinCount  { 0 };
+        size_type                m_nBinsPerOctave{ 0 };
+        sample_type              m_fSampleRate   { 0 };
+    }; // template <...> class SpectralKernelT final
+} // namespace Audio::ConstantQ
+
+#endif // GUID_7C45B282_2B02_4201_87AB_121B2CA04EA0
@@ -0,0 +1,152 @@
+#pragma once
+#ifndef GUID_62E2A4BC_19CE_45AB_9EE9_38555542FED1
+#define GUID_62E2A4BC_19CE_45AB_9EE9_38555542FED1
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Util/InterpolateUtil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+//--------------------------------------
+
+namespace Audio::Correlation {
+    //**************************************************************************
+    // CorrelationDataT
+    //**************************************************************************
+    //
+    // Stereo phase correlation, +1 for identical channels
+    // (mono), 0 for unrelated channels and -1 for inverted
+    // channels.
+    //
+    // The L*R, L*L and R*R means of the frames new since
+    // the last update are folded into running means which
+    // decay with time constant `IntegrationTime` seconds of
+    // audio, so the value follows the ballistics of a
+    // hardware meter however the audio is split between
+    // updates, and each frame is visited once. Without audio
+    // (`decay`) the means fall towards silence in real time.
+    // Silence reads as 0.
+    //
+    // Holds the last two values so the render thread can
+    // interpolate in the same way as the other audio data.
+    template <typename SampleTypeT>
+    class CorrelationDataT final {
+    private:
+        using this_type = CorrelationDataT<SampleTypeT>;
+
+    public:
+        using sample_type = SampleTypeT;
+        using size_type   = std::size_t;
+
+        inline static constexpr const sample_type IntegrationTime{ static_cast<sample_type>(.3) }; //< Seconds
+
+    public:
+        void clear() noexcept { *this = this_type{}; }
+        void reset() noexcept { clear(); }
+        void zero () noexcept {
+            m_fPrev = m_fNext = 0;
+            m_fSumLR = m_fSumLL = m_fSumRR = 0;
+        }
+
+        //--------------------------------------------------
+        // `source` is `sourceSize / stride` frames of
+        // interleaved channels, which must not overlap those
+        // of earlier updates; only the first two channels are
+        // used (a single channel is correlated with itself).
+        // No frames leaves the value where it is.
+        void update(const sample_type* source,
+                    size_type sourceSize,
+                    size_type stride,
+                    size_type sampleRate) noexcept {
+            assert(sampleRate > 0);
+            const auto frameCount{ (source && stride > 0) ? sourceSize / stride : 0 };
+            if (frameCount > 0 && sampleRate > 0) {
+                sample_type blockLR{ 0 }, blockLL{ 0 }, blockRR{ 0 };
+                const auto right{ (stride > 1) ? 1 : 0 };
+                const auto* s{ source };
+                const auto* e{ source + frameCount * stride };
+                for (; s != e; s += stride) {
+                    const auto l{ s[0] };
+                    const auto r{ s[right] };
+                    blockLR += l * r;
+                    blockLL += l * l;
+                    blockRR += r * r;
+                }
+                const auto scale{ static_cast<sample_type>(1) / static_cast<sample_type>(frameCount) };
+                const auto seconds{ static_cast<sample_type>(frameCount) / static_cast<sample_type>(sampleRate) };
+                this_type::fold(blockLR * scale, blockLL * scale, blockRR * scale, seconds);
+            }
+            this_type::publish();
+        }
+
+        //--------------------------------------------------
+        // No audio for `elapsed` seconds
+        void decay(sample_type elapsed) noexcept {
+            this_type::fold(0, 0, 0, elapsed);
+            this_type::publish();
+        }
+
+    public:
+        [[nodiscard]]
+        sample_type correlation_curr(sample_type interp) const noexcept {
+            return ::util::lerp(m_fPrev, m_fNext, interp);
+        }
+
+    private:
+        void fold(sample_type blockLR,
+                  sample_type blockLL,
+                  sample_type blockRR,
+                  sample_type seconds) noexcept {
+            const auto alpha{
+                static_cast<sample_type>(1) - std::exp(-std::max(seconds, static_cast<sample_type>(0)) / IntegrationTime)
+            };
+            m_fSumLR = ::util::lerp(m_fSumLR, blockLR, alpha);
+            m_fSumLL = ::util::lerp(m_fSumLL, blockLL, alpha);
+            m_fSumRR = ::util::lerp(m_fSumRR, blockRR, alpha);
+        }
+
+        void publish() noexcept {
+            const auto energy{ std::sqrt(m_fSumLL * m_fSumRR) };
+            m_fPrev = m_fNext;
+            m_fNext = (energy > std::numeric_limits<sample_type>::epsilon())
+                    ? std::clamp(m_fSumLR / energy, static_cast<sample_type>(-1), static_cast<sample_type>(1))
+                    : static_cast<sample_type>(0);
+        }
+
+    private:
+        sample_type m_fPrev { 0 };
+        sample_type m_fNext { 0 };
+        sample_type m_fSumLR{ 0 };
+        sample_type m_fSumLL{ 0 };
+        sample_type m_fSumRR{ 0 };
+    }; // template <...> class CorrelationDataT final
+} // namespace Audio::Correlation
+
+#endif // GUID_62E2A4BC_19CE_45AB_9EE9_38555542FED1
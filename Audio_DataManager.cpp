@@ -35,8 +35,9 @@ namespace Audio {
     /**************************************************************************
      * IAudioDataManager *
      **************************************************************************/
-    void IAudioDataManager::Update(const Visualisation::RequestParams& request) {
-        m_UsingData = request.Want;
+    void IAudioDataManager::Analyse(const Visualisation::RequestParams& request,
+                                    generation_type generation) {
+        m_Analysis.m_UsingData = request.Want;
 
         update_params params{};
         update_hint_params hints{};
@@ -44,69 +45,242 @@ namespace Audio {
         params.m_WantSpectrum = false;
         params.m_WantWaveform = false;
 
-        if (m_UsingData & (vis_data_type::CombinedWaveform | vis_data_type::Waveform)) {
+        if (m_Analysis.m_UsingData & (vis_data_type::CombinedWaveform | vis_data_type::Waveform)) {
             params.m_WantWaveform = true;
             assert(request.Waveform.nSampleCountHint > 0);
             m_fnWaveformTransform = request.Waveform.fnTransform;
-            m_Waveform.value_count(request.Waveform.nSampleCountHint);
-            m_Waveform.peak_decay_rate(request.Waveform.fPeakDecayRate,
+            m_bWaveformEnvelope   = request.Waveform.bEnvelope;
+            m_eWaveformResample   = request.Waveform.eResampleQuality;
+            if (m_eWaveformTrigger != request.Waveform.eTrigger) {
+                m_eWaveformTrigger = request.Waveform.eTrigger;
+                m_WaveformTrigger.reset();
+            }
+            // Envelope data is stored as [min, max] pairs
+            m_Analysis.m_Waveform.layout(std::max(m_Analysis.m_Waveform.channel_count(), MinChannelCount),
+                                         request.Waveform.nSampleCountHint * (m_bWaveformEnvelope ? 2 : 1));
+            m_Analysis.m_Waveform.peak_decay_rate(request.Waveform.fPeakDecayRate,
                                        request.Waveform.fPeakMininum);
         } else {
-            m_Waveform.clear();
+            m_Analysis.m_Waveform.clear();
             m_fnWaveformTransform = {};
+            m_bWaveformEnvelope   = false;
+            m_eWaveformTrigger    = trigger_mode::None;
         }
 
-        if (m_UsingData & (vis_data_type::CombinedDecibel | vis_data_type::Decibel)) {
+        if (m_Analysis.m_UsingData & vis_data_type::Correlation) {
+            params.m_WantWaveform = true;
+        } else {
+            m_Analysis.m_Correlation.clear();
+        }
+
+        if (m_Analysis.m_UsingData & (vis_data_type::CombinedDecibel | vis_data_type::Decibel)) {
             params.m_WantWaveform = true;
             m_fnDecibelTransform = request.Decibel.fnTransform;
-            m_Decibel.peak_decay_rate(request.Decibel.fPeakDecayRate,
+            m_Analysis.m_Decibel.peak_decay_rate(request.Decibel.fPeakDecayRate,
                                       request.Decibel.fPeakMininum);
         } else {
-            m_Decibel.clear();
+            m_Analysis.m_Decibel.clear();
             m_fnDecibelTransform = {};
         }
 
-        if (m_UsingData & (vis_data_type::CombinedSpectrum | vis_data_type::Spectrum)) {
+        if (m_Analysis.m_UsingData & (vis_data_type::CombinedSpectrum | vis_data_type::Spectrum)) {
             hints.m_SpectrumSize = request.Spectrum.nSampleCountHint;
             params.m_WantSpectrum = true;
             assert(request.Spectrum.nSampleCountHint > 0);
             m_fnSpectrumTransform = request.Spectrum.fnTransform;
-            m_Spectrum.value_count(request.Spectrum.nSampleCountHint);
-            m_Spectrum.peak_decay_rate(request.Spectrum.fPeakDecayRate,
+            m_eSpectrumResample   = request.Spectrum.eResampleQuality;
+            m_nSpectrumBinsPerOctave = request.Spectrum.nBinsPerOctave;
+            if (m_nSpectrumBinsPerOctave > 0) {
+                // Constant-Q bins at the bottom of the range are
+                // only a few Hz apart, so need a long FFT
+                hints.m_SpectrumSize = std::max(hints.m_SpectrumSize, ConstantQSpectrumSize);
+            } else {
+                m_ConstantQ.reset();
+            }
+            m_Analysis.m_Spectrum.layout(std::max(m_Analysis.m_Spectrum.channel_count(), MinChannelCount),
+                                         request.Spectrum.nSampleCountHint);
+            m_Analysis.m_Spectrum.peak_decay_rate(request.Spectrum.fPeakDecayRate,
                                        request.Spectrum.fPeakMininum);
         } else {
-            m_Spectrum.clear();
+            m_Analysis.m_Spectrum.clear();
             m_fnSpectrumTransform = {};
+            m_nSpectrumBinsPerOctave = 0;
+            m_ConstantQ.reset();
+        }
+
+        if (m_Analysis.m_UsingData & vis_data_type::Beat) {
+            // Beat detection is fed from the spectrum, so
+            // fetch one even if it isn't displayed
+            params.m_WantSpectrum = true;
+            if (hints.m_SpectrumSize == 0) {
+                hints.m_SpectrumSize = BeatSpectrumSize;
+            }
+        } else {
+            m_BeatDetector.reset();
+            m_Analysis.m_Beat.clear();
+        }
+
+        if (m_Analysis.m_UsingData & vis_data_type::Chroma) {
+            // Also fed from the (linear) spectrum
+            params.m_WantSpectrum = true;
+            hints.m_SpectrumSize = std::max(hints.m_SpectrumSize, ChromaSpectrumSize);
+        } else {
+            m_ChromaAnalyser.reset();
+            m_Analysis.m_Chroma.clear();
         }
 
+        // Fetch ahead of playback by the measured audio to
+        // display latency; until the display has reported
+        // back, by one update (the interpolation lag)
         const auto elapsed{ m_UpdateTimer.GetElapsedSeconds() };
-        params.m_Offset = elapsed;
+        const auto fetchOffset{ m_fFetchOffset.load(std::memory_order_relaxed) };
+        params.m_Offset = (fetchOffset >= 0) ? fetchOffset : elapsed;
         hints.m_Duration = elapsed;
+        m_fAnalysisElapsed = elapsed;
+        m_Analysis.m_FetchTimestamp = stop_watch::SystemCounter();
+        m_Analysis.m_fUpdatePeriod  = elapsed;
         OnUpdate(params, hints);
         m_UpdateTimer.Start();
+
+        Publish(generation);
+    }
+
+    //--------------------------------------------------------------------------
+
+    void IAudioDataManager::Publish(generation_type generation) noexcept {
+        analysis_frame* pFrame{ nullptr };
+        if (!m_FreeFrames.try_pop(pFrame)) {
+            // Render thread is holding all frames; the next publish will
+            // carry the (newer) working set anyway.
+            m_nDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        assert(pFrame);
+
+        // NOTE: Copy assignment reuses the existing buffer storage
+        //       in the recycled frame, so is allocation free once
+        //       the buffer sizes are stable.
+        *pFrame = m_Analysis;
+        pFrame->m_Generation = generation;
+        pFrame->m_Timestamp  = stop_watch::SystemCounter();
+
+        [[maybe_unused]] const auto bPushed{ m_ReadyFrames.try_push(pFrame) };
+        assert(bPushed); //< Can't fail; there are only as many frames as slots
+        m_nPublished.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool IAudioDataManager::Consume() noexcept {
+        analysis_frame* pLatest{ nullptr };
+        analysis_frame* pFrame { nullptr };
+        while (m_ReadyFrames.try_pop(pFrame)) {
+            if (pLatest) {
+                [[maybe_unused]] const auto bPushed{ m_FreeFrames.try_push(pLatest) };
+                assert(bPushed);
+                ++m_Statistics.m_nSuperseded;
+            }
+            pLatest = pFrame;
+        }
+        if (!pLatest) { return false; }
+
+        [[maybe_unused]] const auto bPushed{ m_FreeFrames.try_push(std::exchange(m_pCurrent, pLatest)) };
+        assert(bPushed);
+
+        constexpr const duration_type fLatencyWeight{ .1f };
+        const auto fLatencyMS{
+            stop_watch::TicksToMilliseconds(stop_watch::SystemCounter() - m_pCurrent->m_Timestamp)
+        };
+        ++m_Statistics.m_nConsumed;
+        m_Statistics.m_fLatencyMS     = fLatencyMS;
+        m_Statistics.m_fMeanLatencyMS = ::util::lerp(m_Statistics.m_fMeanLatencyMS, fLatencyMS, fLatencyWeight);
+        m_Statistics.m_fMaxLatencyMS  = std::max(m_Statistics.m_fMaxLatencyMS, fLatencyMS);
+        return true;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void IAudioDataManager::Presented(interpolation_type interp,
+                                      duration_type fDisplayLagMS) noexcept {
+        const auto& current{ Current() };
+        if (!(current.m_UsingData & ~vis_data_type::TrackDetails) ||
+            current.m_FetchTimestamp == 0) {
+            return;
+        }
+
+        const auto now{ stop_watch::SystemCounter() +
+                        stop_watch::MillisecondsToTicks(std::max(fDisplayLagMS, 0.f)) };
+        const auto fFetchToPresent{ stop_watch::TicksToSeconds(now - current.m_FetchTimestamp) };
+        const auto fOffset{ m_OffsetEstimator.update(fFetchToPresent, interp, current.m_fUpdatePeriod) };
+        m_fFetchOffset.store(fOffset, std::memory_order_relaxed);
+
+        constexpr const duration_type fLatencyWeight{ .1f };
+        const auto fPresentLatencyMS{ m_OffsetEstimator.measured() * 1000.f };
+        ++m_Statistics.m_nPresented;
+        m_Statistics.m_fAnalyseMS            = stop_watch::TicksToMilliseconds(current.m_Timestamp - current.m_FetchTimestamp);
+        m_Statistics.m_fRenderMS             = stop_watch::TicksToMilliseconds(now - m_FrameTimestamp);
+        m_Statistics.m_fPresentLatencyMS     = fPresentLatencyMS;
+        m_Statistics.m_fMeanPresentLatencyMS = ::util::lerp(m_Statistics.m_fMeanPresentLatencyMS, fPresentLatencyMS, fLatencyWeight);
+        m_Statistics.m_fFetchOffsetMS        = fOffset * 1000.f;
     }
 
     //--------------------------------------------------------------------------
 
     void IAudioDataManager::SetWaveformData(const waveform_sample_type* samples,
                                             size_type sampleCount,
-                                            size_type channelCount) {
-        if (m_UsingData & (vis_data_type::CombinedWaveform | vis_data_type::Waveform)) {
+                                            size_type channelCount,
+                                            size_type addedSampleCount,
+                                            size_type sampleRate) {
+        if (m_Analysis.m_UsingData & vis_data_type::Correlation) {
+            // Only the new audio; no data decays towards silence
+            if (samples == nullptr || sampleCount == 0 || channelCount == 0 || sampleRate == 0) {
+                m_Analysis.m_Correlation.decay(m_fAnalysisElapsed);
+            } else {
+                const auto added{ std::min(addedSampleCount, sampleCount) };
+                m_Analysis.m_Correlation.update(samples + (sampleCount - added), added, channelCount,
+                                                sampleRate);
+            }
+        }
+
+        if (m_Analysis.m_UsingData & (vis_data_type::CombinedWaveform | vis_data_type::Waveform)) {
             if (samples == nullptr || sampleCount == 0 || channelCount == 0) {
-                m_Waveform.zero();
+                m_Analysis.m_Waveform.zero();
                 return;
             }
 
-            const auto cUpdated = Samples::update_sample_data(m_Waveform,
-                                                              samples, sampleCount, channelCount,
-                                                              m_fnWaveformTransform);
-            if ((cUpdated > 0) && (m_UsingData & vis_data_type::CombinedWaveform)) {
-                auto combined{ Samples::get_combined_samples(m_Waveform, cUpdated) };
-                m_Waveform.combined_update(std::move(combined));
+            // Triggered: the first half of the data is searched
+            // for where to start, only half is displayed
+            auto waveformSamples    { samples };
+            auto waveformSampleCount{ sampleCount };
+            if (const auto frameCount{ sampleCount / channelCount };
+                m_eWaveformTrigger != trigger_mode::None && frameCount > 1) {
+                const auto windowFrames{ frameCount / 2 };
+                const auto start{ m_WaveformTrigger.find(m_eWaveformTrigger,
+                                                         samples, frameCount, channelCount,
+                                                         windowFrames) };
+                waveformSamples     += start * channelCount;
+                waveformSampleCount  = windowFrames * channelCount;
+            }
+
+            m_Analysis.m_Waveform.channel_count(std::clamp(channelCount, MinChannelCount, MaxChannelCount));
+            if (m_Analysis.m_UsingData & vis_data_type::Waveform) {
+                Samples::update_sample_data(m_Analysis.m_Waveform,
+                                            waveformSamples, waveformSampleCount, channelCount,
+                                            m_fnWaveformTransform,
+                                            static_cast<bool>(m_Analysis.m_UsingData & vis_data_type::CombinedWaveform),
+                                            m_bWaveformEnvelope,
+                                            m_eWaveformResample);
+            } else {
+                Samples::update_combined_sample_data(m_Analysis.m_Waveform,
+                                                     waveformSamples, waveformSampleCount, channelCount,
+                                                     m_fnWaveformTransform,
+                                                     m_WaveformScratch,
+                                                     m_bWaveformEnvelope,
+                                                     m_eWaveformResample);
             }
         }
 
-        if (m_UsingData & (vis_data_type::CombinedDecibel | vis_data_type::Decibel)) {
+        if (m_Analysis.m_UsingData & (vis_data_type::CombinedDecibel | vis_data_type::Decibel)) {
             SetDecibelData(samples, sampleCount, channelCount);
         }
     }
@@ -117,13 +291,14 @@ namespace Audio {
                                            size_type sampleCount,
                                            size_type channelCount) {
         if (samples == nullptr || sampleCount == 0 || channelCount == 0) {
-            m_Decibel.zero();
+            m_Analysis.m_Decibel.zero();
             return;
         }
 
         static constexpr const auto CombineChannelIndex{ static_cast<size_type>(-1) };
 
-        const auto dBChannelCount{ m_Decibel.channel_count() };
+        m_Analysis.m_Decibel.channel_count(std::clamp(channelCount, MinChannelCount, MaxChannelCount));
+        const auto dBChannelCount{ m_Analysis.m_Decibel.channel_count() };
         if (channelCount > 1) {
             auto updateChannelCount{ std::min(dBChannelCount, channelCount) };
             size_type ch{ 0 };
@@ -134,36 +309,36 @@ namespace Audio {
                                             channelCount) };
                 combined += dB;
                 if (m_fnDecibelTransform) { dB = m_fnDecibelTransform(ch, dB); }
-                m_Decibel.channel_update(ch, dB);
+                m_Analysis.m_Decibel.channel_update(ch, dB);
                 ++ch; ++samples;
             }
 
-            if (m_UsingData & vis_data_type::CombinedDecibel) {
+            if (m_Analysis.m_UsingData & vis_data_type::CombinedDecibel) {
                 combined /= static_cast<dB_type>(ch);
                 if (m_fnDecibelTransform) {
                     combined = m_fnDecibelTransform(CombineChannelIndex,
                                                     combined);
                 }
-                m_Decibel.combined_update(combined);
+                m_Analysis.m_Decibel.combined_update(combined);
             } else {
-                m_Decibel.combined_zero();
+                m_Analysis.m_Decibel.combined_zero();
             }
-            while (ch < dBChannelCount) { m_Decibel.channel_zero(ch++); }
+            while (ch < dBChannelCount) { m_Analysis.m_Decibel.channel_zero(ch++); }
         } else {
             constexpr const size_type stride{ 1 };
             const auto dB{ dB::dBFromWavedata(samples, sampleCount, stride) };
             for (size_type ch = 0; ch < dBChannelCount; ++ch) {
                 if (m_fnDecibelTransform) {
-                    m_Decibel.channel_update(ch, m_fnDecibelTransform(ch, dB));
+                    m_Analysis.m_Decibel.channel_update(ch, m_fnDecibelTransform(ch, dB));
                 } else {
-                    m_Decibel.channel_update(ch, dB);
+                    m_Analysis.m_Decibel.channel_update(ch, dB);
                 }
             }
-            if (m_UsingData & vis_data_type::CombinedDecibel) {
+            if (m_Analysis.m_UsingData & vis_data_type::CombinedDecibel) {
                 if (m_fnDecibelTransform) {
-                    m_Decibel.combined_update(m_fnDecibelTransform(CombineChannelIndex, dB));
+                    m_Analysis.m_Decibel.combined_update(m_fnDecibelTransform(CombineChannelIndex, dB));
                 } else {
-                    m_Decibel.combined_update(dB);
+                    m_Analysis.m_Decibel.combined_update(dB);
                 }
             }
         }
@@ -172,19 +347,61 @@ namespace Audio {
 
     void IAudioDataManager::SetSpectrumData(const spectrum_sample_type* samples,
                                             size_type sampleCount,
-                                            size_type channelCount) {
-        if (m_UsingData & (vis_data_type::CombinedSpectrum | vis_data_type::Spectrum)) {
+                                            size_type channelCount,
+                                            size_type sampleRate) {
+        if (m_Analysis.m_UsingData & vis_data_type::Beat) {
+            // Untransformed magnitudes; no data is treated as silence
+            const auto bValid{ samples != nullptr && sampleCount > 0 && channelCount > 0 };
+            m_Analysis.m_Beat.update(m_BeatDetector.update(bValid ? samples : nullptr,
+                                                           bValid ? sampleCount : 0,
+                                                           bValid ? channelCount : 0,
+                                                           m_fAnalysisElapsed));
+        }
+
+        if (m_Analysis.m_UsingData & vis_data_type::Chroma) {
+            const auto bValid{ samples != nullptr && sampleCount > 0 && channelCount > 0 };
+            m_Analysis.m_Chroma.update(m_ChromaAnalyser.update(bValid ? samples : nullptr,
+                                                               bValid ? sampleCount : 0,
+                                                               bValid ? channelCount : 0,
+                                                               static_cast<spectrum_sample_type>(sampleRate),
+                                                               m_fAnalysisElapsed));
+        }
+
+        if (m_Analysis.m_UsingData & (vis_data_type::CombinedSpectrum | vis_data_type::Spectrum)) {
             if (samples == nullptr || sampleCount == 0 || channelCount == 0) {
-                m_Spectrum.zero();
+                m_Analysis.m_Spectrum.zero();
                 return;
             }
 
-            const auto  cUpdated = Samples::update_sample_data(m_Spectrum,
-                                                               samples, sampleCount, channelCount,
-                                                               m_fnSpectrumTransform);
-            if ((cUpdated > 0) && (m_UsingData & vis_data_type::CombinedSpectrum)) {
-                auto combined{ Samples::get_combined_samples(m_Spectrum, cUpdated) };
-                m_Spectrum.combined_update(std::move(combined));
+            // Beat detection (above) stays on the linear bins
+            if (m_nSpectrumBinsPerOctave > 0 && sampleRate > 0) {
+                const auto binCount{
+                    m_ConstantQ.configure(sampleCount / channelCount,
+                                          static_cast<spectrum_sample_type>(sampleRate),
+                                          m_nSpectrumBinsPerOctave)
+                };
+                if (binCount > 0) {
+                    const auto& bins{ m_ConstantQ.apply(samples, sampleCount, channelCount) };
+                    samples     = bins.data();
+                    sampleCount = bins.size();
+                }
+            }
+
+            m_Analysis.m_Spectrum.channel_count(std::clamp(channelCount, MinChannelCount, MaxChannelCount));
+            if (m_Analysis.m_UsingData & vis_data_type::Spectrum) {
+                Samples::update_sample_data(m_Analysis.m_Spectrum,
+                                            samples, sampleCount, channelCount,
+                                            m_fnSpectrumTransform,
+                                            static_cast<bool>(m_Analysis.m_UsingData & vis_data_type::CombinedSpectrum),
+                                            false /*bEnvelope*/,
+                                            m_eSpectrumResample);
+            } else {
+                Samples::update_combined_sample_data(m_Analysis.m_Spectrum,
+                                                     samples, sampleCount, channelCount,
+                                                     m_fnSpectrumTransform,
+                                                     m_SpectrumScratch,
+                                                     false /*bEnvelope*/,
+                                                     m_eSpectrumResample);
             }
         }
     }
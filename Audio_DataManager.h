@@ -26,6 +26,7 @@
 //
 #include "Util/SequentialEnum.h"
 #include "Util/Singleton.h"
+#include "Util/SPSCQueue.h"
 //--------------------------------------
 
 //--------------------------------------
@@ -35,7 +36,13 @@
 #include "Config/Config_TrackDetails.h"
 
 #include "Audio_DecibelData.h"
+#include "Audio_CorrelationData.h"
 #include "Audio_SampleData.h"
+#include "Audio_BeatDetector.h"
+#include "Audio_ChromaData.h"
+#include "Audio_Latency.h"
+#include "Audio_ConstantQ.h"
+#include "Audio_Trigger.h"
 
 #include "Image_ImageData.h"
 //--------------------------------------
@@ -45,6 +52,9 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <array>
+#include <atomic>
+#include <cstdint>
 //--------------------------------------
 
 namespace Audio {
@@ -69,7 +79,27 @@ namespace Audio {
                                                         L"Paused"));
 
     //**************************************************************************
-    // IAudioDataManager
+    // IAudioDataManager:
+    // ------------------
+    //
+    // Audio data is produced ("analysed") and consumed ("rendered") on
+    // different threads:
+    //
+    //  - `Analyse` fetches and processes audio into a private working set,
+    //    then publishes a copy of it (complete with prev/next data for
+    //    interpolation) through a lock-free single-producer/single-consumer
+    //    queue.
+    //  - `Consume` takes the most recent published frame, which is then
+    //    what all `Get...` accessors return.
+    //  - `UpdateMetadata` (play state, track details, album art) happens
+    //    on the render thread alongside `Consume`.
+    //
+    // Frames are recycled through a second queue in the opposite direction,
+    // so no allocation takes place once buffer sizes are stable. If the
+    // render thread falls behind, older frames are superseded by newer ones
+    // rather than queuing up; if the analysis thread has no free frame the
+    // publish is dropped (the working set remains up to date).
+    //
     //**************************************************************************
     class IAudioDataManager :
         public ::util::singleton<IAudioDataManager> {
@@ -77,8 +107,16 @@ namespace Audio {
         using stop_watch = ::Windows::StopWatch;
 
     public:
-        inline static constexpr const auto ChannelCount         { Channel::count() };
+        // `Channel` names the channels every source provides (mono sources
+        // are presented as silent right channel); up to `MaxChannelCount`
+        // are available for multichannel sources.
+        inline static constexpr const std::size_t MinChannelCount{ Channel::count() };
+        inline static constexpr const std::size_t MaxChannelCount{ 8 };
         inline static constexpr const auto TrackDetailsPageCount{ TrackDetailsType::count() };
+        inline static constexpr const std::size_t AnalysisFrameCount{ 4 };
+        inline static constexpr const std::size_t BeatSpectrumSize{ 256 }; //< Used when only beat data is wanted
+        inline static constexpr const std::size_t ConstantQSpectrumSize{ 4096 }; //< Minimum FFT bins for constant-Q bass resolution
+        inline static constexpr const std::size_t ChromaSpectrumSize{ 4096 }; //< Minimum FFT bins to separate semitones
 
     public:
         using image_data_type    = ::Image::ImageData::Compact;
@@ -95,23 +133,42 @@ namespace Audio {
         using spectrum_sample_type        = typename request_params::spectrum_sample_type;
         using spectrum_peak_type          = typename request_params::spectrum_peak_type;
         using spectrum_transform_type     = typename request_params::spectrum_transform_type;
-        using spectrum_data_type          = Samples::SampleDataT<spectrum_sample_type, ChannelCount>;
+        using spectrum_data_type          = Samples::SampleDataT<spectrum_sample_type, MaxChannelCount>;
         using spectrum_sample_buffer_type = typename spectrum_data_type::sample_buffer_type;
 
         using waveform_sample_type        = typename request_params::waveform_sample_type;
         using waveform_peak_type          = typename request_params::waveform_peak_type;
         using waveform_transform_type     = typename request_params::waveform_transform_type;
-        using waveform_data_type          = Samples::SampleDataT<waveform_sample_type, ChannelCount>;
+        using waveform_data_type          = Samples::SampleDataT<waveform_sample_type, MaxChannelCount>;
         using waveform_sample_buffer_type = typename waveform_data_type::sample_buffer_type;
 
         using dB_type                     = typename request_params::dB_type;
         using decibel_type                = typename request_params::decibel_type;
         using dB_peak_type                = typename request_params::dB_peak_type;
         using dB_transform                = typename request_params::dB_transform_type;
-        using dB_data_type                = dB::DecibelDataT<dB_type, ChannelCount>;
+        using dB_data_type                = dB::DecibelDataT<dB_type, MaxChannelCount>;
+
+        using correlation_data_type       = Correlation::CorrelationDataT<waveform_sample_type>;
+
+        using resample_quality            = Samples::ResampleQuality;
+        using trigger_mode                = Samples::TriggerMode;
+        using waveform_trigger_type       = Samples::TriggerT<waveform_sample_type>;
+
+        using beat_data_type              = Beat::BeatDataT<spectrum_sample_type>;
+        using beat_detector_type          = Beat::BeatDetectorT<spectrum_sample_type>;
+
+        using constant_q_type             = ConstantQ::SpectralKernelT<spectrum_sample_type>;
+
+        using chroma_data_type            = Chroma::ChromaDataT<spectrum_sample_type>;
+        using chroma_analyser_type        = Chroma::ChromaAnalyserT<spectrum_sample_type>;
+
+        using offset_estimator_type       = Latency::OffsetEstimatorT<duration_type>;
 
         using track_details_pages         = std::array<string_type, TrackDetailsPageCount>;
 
+        using generation_type             = std::uint32_t;
+        using tick_type                   = typename stop_watch::tick_type;
+
     public:
         struct update_params final {
             duration_type m_Offset      { 0 };
@@ -124,6 +181,39 @@ namespace Audio {
             size_type     m_SpectrumSize{ 0 };
         };
 
+        struct analysis_frame final {
+            vis_data_type         m_UsingData     { vis_data_type::None };
+            generation_type       m_Generation    { 0 };
+            tick_type             m_Timestamp     { 0 }; //< Published
+            tick_type             m_FetchTimestamp{ 0 }; //< Audio fetched
+            duration_type         m_fUpdatePeriod { 0 }; //< Seconds since the previous fetch
+            waveform_data_type    m_Waveform      { };
+            dB_data_type          m_Decibel       { };
+            spectrum_data_type    m_Spectrum      { };
+            beat_data_type        m_Beat          { };
+            correlation_data_type m_Correlation   { };
+            chroma_data_type      m_Chroma        { };
+        };
+
+        struct analysis_statistics final {
+            size_type     m_nPublished           { 0 }; //< Frames published by analysis
+            size_type     m_nDropped             { 0 }; //< Frames not published (no free frame)
+            size_type     m_nConsumed            { 0 }; //< Frames taken by render
+            size_type     m_nSuperseded          { 0 }; //< Frames replaced before being rendered
+            duration_type m_fLatencyMS           { 0 }; //< Publish to consume (most recent)
+            duration_type m_fMeanLatencyMS       { 0 }; //< Publish to consume (moving average)
+            duration_type m_fMaxLatencyMS        { 0 }; //< Publish to consume (maximum)
+            size_type     m_nPresented           { 0 }; //< Frames sent to the display with audio data
+            duration_type m_fAnalyseMS           { 0 }; //< Fetch to publish (most recent)
+            duration_type m_fRenderMS            { 0 }; //< Frame start to present, including vsync (most recent)
+            duration_type m_fPresentLatencyMS    { 0 }; //< Fetch to present plus interpolation lag (most recent)
+            duration_type m_fMeanPresentLatencyMS{ 0 }; //< Fetch to present plus interpolation lag (moving average)
+            duration_type m_fFetchOffsetMS       { 0 }; //< Offset now applied to fetches
+        };
+
+    private:
+        using frame_queue_type = ::util::spsc_queue<analysis_frame*, AnalysisFrameCount>;
+
     public:
         static void destroy() noexcept {
             auto pMgr{ singleton::instance_peek() };
@@ -138,7 +228,13 @@ namespace Audio {
         }
 
     protected:
-        IAudioDataManager() noexcept = default;
+        IAudioDataManager() noexcept {
+            // Frame 0 is the initial current frame, the rest are free
+            for (size_type f = 1; f < AnalysisFrameCount; ++f) {
+                [[maybe_unused]] const auto bPushed{ m_FreeFrames.try_push(&m_Frames[f]) };
+                assert(bPushed);
+            }
+        }
         ~IAudioDataManager() noexcept = default;
 
     public:
@@ -155,6 +251,11 @@ namespace Audio {
         gsl_suppress(26440) // C26440: Function '...' can be declared 'noexcept' (f.6).
         virtual void OnUpdateConfig() {}
 
+        // Called from the render thread
+        gsl_suppress(26440) // C26440: Function '...' can be declared 'noexcept' (f.6).
+        virtual void OnUpdateMetadata() {}
+
+        // Called from the analysis thread
         virtual void OnUpdate(const update_params& params,
                               const update_hint_params& hints) = 0;
 
@@ -173,7 +274,7 @@ namespace Audio {
         void Initialise  () { OnInitialise();   }
         void Uninitialise() { OnUninitialise(); }
 
-        void StartFrame() noexcept {}
+        void StartFrame() noexcept { m_FrameTimestamp = stop_watch::SystemCounter(); }
         void EndFrame  () noexcept {
             m_bTrackChanged = false;
             m_bTrackDetailsChanged = false;
@@ -182,100 +283,276 @@ namespace Audio {
 
         void UpdateConfig() { OnUpdateConfig(); }
 
-        void Update(const Visualisation::RequestParams& params);
+        // Render thread
+        void UpdateMetadata() { OnUpdateMetadata(); }
+        bool Consume() noexcept;
+        // Call once the frame has reached the display, or
+        // has been handed on with `fDisplayLagMS` expected
+        // until it does (e.g. any vsync wait), with the
+        // interpolation it was drawn with; feeds fetch offset
+        // compensation.
+        void Presented(interpolation_type interp,
+                       duration_type fDisplayLagMS = 0) noexcept;
+
+        [[nodiscard]]
+        bool IsCurrent(generation_type generation) const noexcept {
+            return Current().m_Generation == generation;
+        }
+
+        [[nodiscard]]
+        const auto& GetAnalysisStatistics() noexcept {
+            m_Statistics.m_nPublished = m_nPublished.load(std::memory_order_relaxed);
+            m_Statistics.m_nDropped   = m_nDropped.load(std::memory_order_relaxed);
+            return m_Statistics;
+        }
+
+        // Analysis thread
+        void Analyse(const Visualisation::RequestParams& params,
+                     generation_type generation);
 
     public:
+        //-------------------------------------------------
+        // Frame
+        //
+        // Publish time of the current frame; changes only when
+        // `Consume` takes a new frame, so visualisations which
+        // accumulate history can tell an update from a redraw.
+        [[nodiscard]]
+        auto GetFrameTimestamp() const noexcept {
+            return Current().m_Timestamp;
+        }
+        //-------------------------------------------------
+
+        //-------------------------------------------------
+        // Channels
+        //
+        // Number of channels in the most recent data, at least
+        // `MinChannelCount` so `Channel` values are always valid.
+        [[nodiscard]]
+        size_type GetChannelCount() const noexcept {
+            const auto& current{ Current() };
+            if (current.m_UsingData & (vis_data_type::Waveform | vis_data_type::CombinedWaveform)) {
+                return current.m_Waveform.channel_count();
+            } else if (current.m_UsingData & (vis_data_type::Spectrum | vis_data_type::CombinedSpectrum)) {
+                return current.m_Spectrum.channel_count();
+            } else if (current.m_UsingData & (vis_data_type::Decibel | vis_data_type::CombinedDecibel)) {
+                return current.m_Decibel.channel_count();
+            }
+            return MinChannelCount;
+        }
+        //-------------------------------------------------
+
         //-------------------------------------------------
         // Waveform
+        //  (interleaved [min, max] pairs when requested
+        //   with `WaveformParams::bEnvelope`)
         [[nodiscard]]
-        decltype(auto) GetWaveform(channel_type ch,
+        decltype(auto) GetWaveform(size_type ch,
                                    interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::Waveform);
-            assert(ch >= 0 && ch < m_Waveform.channel_count());
-            assert(!m_Waveform.channel(ch).empty());
-            return m_Waveform.channel_samples_curr(ch, interp);
+            assert(Current().m_UsingData & vis_data_type::Waveform);
+            assert(ch < Current().m_Waveform.channel_count());
+            assert(!Current().m_Waveform.empty());
+            return Current().m_Waveform.channel_samples_curr(ch, interp);
         }
         [[nodiscard]]
-        decltype(auto) GetWaveformPeaks(channel_type ch,
+        decltype(auto) GetWaveformPeaks(size_type ch,
                                         interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::Waveform);
-            assert(ch >= 0 && ch < m_Waveform.channel_count());
-            assert(m_Waveform.have_peaks());
-            return m_Waveform.channel_peaks_curr(ch, interp);
+            assert(Current().m_UsingData & vis_data_type::Waveform);
+            assert(ch < Current().m_Waveform.channel_count());
+            assert(Current().m_Waveform.have_peaks());
+            return Current().m_Waveform.channel_peaks_curr(ch, interp);
         }
         [[nodiscard]]
         decltype(auto) GetWaveform(interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::CombinedWaveform);
-            assert(!m_Waveform.combined().empty());
-            return m_Waveform.combined_samples_curr(interp);
+            assert(Current().m_UsingData & vis_data_type::CombinedWaveform);
+            assert(!Current().m_Waveform.empty());
+            return Current().m_Waveform.combined_samples_curr(interp);
         }
         [[nodiscard]]
         decltype(auto) GetWaveformPeaks(interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::CombinedWaveform);
-            assert(m_Waveform.have_peaks());
-            return m_Waveform.combined_peaks_curr(interp);
+            assert(Current().m_UsingData & vis_data_type::CombinedWaveform);
+            assert(Current().m_Waveform.have_peaks());
+            return Current().m_Waveform.combined_peaks_curr(interp);
         }
         //-------------------------------------------------
 
         //-------------------------------------------------
         // dB
         [[nodiscard]]
-        decltype(auto) GetDB(channel_type ch,
+        decltype(auto) GetDB(size_type ch,
                              interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::Decibel);
-            assert(ch >= 0 && ch < m_Decibel.channel_count());
-            return m_Decibel.channel_dB_curr(ch, interp);
+            assert(Current().m_UsingData & vis_data_type::Decibel);
+            assert(ch < Current().m_Decibel.channel_count());
+            return Current().m_Decibel.channel_dB_curr(ch, interp);
         }
         [[nodiscard]]
-        decltype(auto) GetDBPeaks(channel_type ch,
+        decltype(auto) GetDBPeaks(size_type ch,
                                   interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::Decibel);
-            assert(ch >= 0 && ch < m_Decibel.channel_count());
-            assert(m_Decibel.have_peaks());
-            return m_Decibel.channel_peak_curr(ch, interp);
+            assert(Current().m_UsingData & vis_data_type::Decibel);
+            assert(ch < Current().m_Decibel.channel_count());
+            assert(Current().m_Decibel.have_peaks());
+            return Current().m_Decibel.channel_peak_curr(ch, interp);
         }
         [[nodiscard]]
         decltype(auto) GetDB(interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::CombinedDecibel);
-            return m_Decibel.combined_dB_curr(interp);
+            assert(Current().m_UsingData & vis_data_type::CombinedDecibel);
+            return Current().m_Decibel.combined_dB_curr(interp);
         }
         [[nodiscard]]
         decltype(auto) GetDBPeaks(interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::CombinedDecibel);
-            assert(m_Decibel.have_peaks());
-            return m_Decibel.combined_peak_curr(interp);
+            assert(Current().m_UsingData & vis_data_type::CombinedDecibel);
+            assert(Current().m_Decibel.have_peaks());
+            return Current().m_Decibel.combined_peak_curr(interp);
+        }
+        //-------------------------------------------------
+
+        //-------------------------------------------------
+        // Stereo correlation
+        //  (+1 mono, 0 unrelated, -1 inverted)
+        [[nodiscard]]
+        decltype(auto) GetCorrelation(interpolation_type interp) const {
+            assert(Current().m_UsingData & vis_data_type::Correlation);
+            return Current().m_Correlation.correlation_curr(interp);
         }
         //-------------------------------------------------
 
         //-------------------------------------------------
         // Spectrum
         [[nodiscard]]
-        decltype(auto) GetSpectrum(channel_type ch,
+        decltype(auto) GetSpectrum(size_type ch,
                                    interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::Spectrum);
-            assert(ch >= 0 && ch < m_Spectrum.channel_count());
-            assert(!m_Spectrum.channel(ch).empty());
-            return m_Spectrum.channel_samples_curr(ch, interp);
+            assert(Current().m_UsingData & vis_data_type::Spectrum);
+            assert(ch < Current().m_Spectrum.channel_count());
+            assert(!Current().m_Spectrum.empty());
+            return Current().m_Spectrum.channel_samples_curr(ch, interp);
         }
         [[nodiscard]]
-        decltype(auto) GetSpectrumPeaks(channel_type ch,
+        decltype(auto) GetSpectrumPeaks(size_type ch,
                                         interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::Spectrum);
-            assert(ch >= 0 && ch < m_Spectrum.channel_count());
-            assert(m_Spectrum.have_peaks());
-            return m_Spectrum.channel_peaks_curr(ch, interp);
+            assert(Current().m_UsingData & vis_data_type::Spectrum);
+            assert(ch < Current().m_Spectrum.channel_count());
+            assert(Current().m_Spectrum.have_peaks());
+            return Current().m_Spectrum.channel_peaks_curr(ch, interp);
         }
         [[nodiscard]]
         decltype(auto) GetSpectrum(interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::CombinedSpectrum);
-            assert(!m_Spectrum.combined().empty());
-            return m_Spectrum.combined_samples_curr(interp);
+            assert(Current().m_UsingData & vis_data_type::CombinedSpectrum);
+            assert(!Current().m_Spectrum.empty());
+            return Current().m_Spectrum.combined_samples_curr(interp);
         }
         [[nodiscard]]
         decltype(auto) GetSpectrumPeaks(interpolation_type interp) const {
-            assert(m_UsingData & vis_data_type::CombinedSpectrum);
-            assert(m_Spectrum.combined().have_peaks());
-            return m_Spectrum.combined_peaks_curr(interp);
+            assert(Current().m_UsingData & vis_data_type::CombinedSpectrum);
+            assert(Current().m_Spectrum.have_peaks());
+            return Current().m_Spectrum.combined_peaks_curr(interp);
+        }
+        //-------------------------------------------------
+
+        //-------------------------------------------------
+        // Spectrum frames
+        //  (the two frames the getters above interpolate
+        //   between, for drawing which does the blend
+        //   itself; views, valid until the next `Consume`)
+        [[nodiscard]]
+        decltype(auto) GetSpectrumPrev(size_type ch) const noexcept {
+            assert(Current().m_UsingData & vis_data_type::Spectrum);
+            assert(ch < Current().m_Spectrum.channel_count());
+            return Current().m_Spectrum.channel_samples_prev(ch);
+        }
+        [[nodiscard]]
+        decltype(auto) GetSpectrumNext(size_type ch) const noexcept {
+            assert(Current().m_UsingData & vis_data_type::Spectrum);
+            assert(ch < Current().m_Spectrum.channel_count());
+            return Current().m_Spectrum.channel_samples_next(ch);
+        }
+        [[nodiscard]]
+        decltype(auto) GetSpectrumPeaksPrev(size_type ch) const noexcept {
+            assert(Current().m_UsingData & vis_data_type::Spectrum);
+            assert(ch < Current().m_Spectrum.channel_count());
+            assert(Current().m_Spectrum.have_peaks());
+            return Current().m_Spectrum.channel_peaks_prev(ch);
+        }
+        [[nodiscard]]
+        decltype(auto) GetSpectrumPeaksNext(size_type ch) const noexcept {
+            assert(Current().m_UsingData & vis_data_type::Spectrum);
+            assert(ch < Current().m_Spectrum.channel_count());
+            assert(Current().m_Spectrum.have_peaks());
+            return Current().m_Spectrum.channel_peaks_next(ch);
+        }
+        [[nodiscard]]
+        decltype(auto) GetSpectrumPrev() const noexcept {
+            assert(Current().m_UsingData & vis_data_type::CombinedSpectrum);
+            return Current().m_Spectrum.combined_samples_prev();
+        }
+        [[nodiscard]]
+        decltype(auto) GetSpectrumNext() const noexcept {
+            assert(Current().m_UsingData & vis_data_type::CombinedSpectrum);
+            return Current().m_Spectrum.combined_samples_next();
+        }
+        [[nodiscard]]
+        decltype(auto) GetSpectrumPeaksPrev() const noexcept {
+            assert(Current().m_UsingData & vis_data_type::CombinedSpectrum);
+            assert(Current().m_Spectrum.have_peaks());
+            return Current().m_Spectrum.combined_peaks_prev();
+        }
+        [[nodiscard]]
+        decltype(auto) GetSpectrumPeaksNext() const noexcept {
+            assert(Current().m_UsingData & vis_data_type::CombinedSpectrum);
+            assert(Current().m_Spectrum.have_peaks());
+            return Current().m_Spectrum.combined_peaks_next();
+        }
+        //-------------------------------------------------
+
+        //-------------------------------------------------
+        // Beat
+        //  (phase is [0, 1) with 0 on the beat, strength is
+        //   [0, 1] and decays after each beat)
+        [[nodiscard]]
+        decltype(auto) GetBeatPhase(interpolation_type interp) const {
+            assert(Current().m_UsingData & vis_data_type::Beat);
+            return Current().m_Beat.phase_curr(interp);
+        }
+        [[nodiscard]]
+        decltype(auto) GetBeatStrength(interpolation_type interp) const {
+            assert(Current().m_UsingData & vis_data_type::Beat);
+            return Current().m_Beat.strength_curr(interp);
+        }
+        [[nodiscard]]
+        decltype(auto) GetTempo() const {
+            assert(Current().m_UsingData & vis_data_type::Beat);
+            return Current().m_Beat.tempo();
+        }
+        [[nodiscard]]
+        decltype(auto) GetTempoConfidence() const {
+            assert(Current().m_UsingData & vis_data_type::Beat);
+            return Current().m_Beat.confidence();
+        }
+        [[nodiscard]]
+        decltype(auto) GetBeatCount() const {
+            assert(Current().m_UsingData & vis_data_type::Beat);
+            return Current().m_Beat.beat_count();
+        }
+        //-------------------------------------------------
+
+        //-------------------------------------------------
+        // Chroma
+        //  (pitch classes from C, [0, 1] with the loudest
+        //   1; key is [0, 24), major then minor, -1 if
+        //   unknown)
+        [[nodiscard]]
+        decltype(auto) GetChroma(interpolation_type interp) const {
+            assert(Current().m_UsingData & vis_data_type::Chroma);
+            return Current().m_Chroma.chroma_curr(interp);
+        }
+        [[nodiscard]]
+        decltype(auto) GetKey() const {
+            assert(Current().m_UsingData & vis_data_type::Chroma);
+            return Current().m_Chroma.key();
+        }
+        [[nodiscard]]
+        decltype(auto) GetKeyConfidence() const {
+            assert(Current().m_UsingData & vis_data_type::Chroma);
+            return Current().m_Chroma.key_confidence();
         }
         //-------------------------------------------------
 
@@ -326,17 +603,33 @@ namespace Audio {
             m_AlbumArt = std::forward<image_data_type>(image);
         }
 
+        // The last `addedSampleCount` of the samples are
+        // those new since the previous call (the rest repeat
+        // earlier audio); `sampleRate` is only needed for
+        // the correlation meter.
         void SetWaveformData(const waveform_sample_type* samples,
                              size_type sampleCount,
-                             size_type channelCount);
+                             size_type channelCount,
+                             size_type addedSampleCount,
+                             size_type sampleRate);
 
         void SetDecibelData(const dB_type* samples,
                             size_type sampleCount,
                             size_type channelCount);
 
+        // `sampleRate` is only needed for a constant-Q
+        // spectrum and chroma; 0 leaves the spectrum linear
+        // (and chroma silent).
         void SetSpectrumData(const spectrum_sample_type* samples,
                              size_type sampleCount,
-                             size_type channelCount);
+                             size_type channelCount,
+                             size_type sampleRate);
+
+    private:
+        [[nodiscard]]
+        constexpr const auto& Current() const noexcept { assert(m_pCurrent); return *m_pCurrent; }
+
+        void Publish(generation_type generation) noexcept;
 
     private:
         stop_watch          m_UpdateTimer         {};
@@ -350,16 +643,37 @@ namespace Audio {
         bool                m_bAlbumArtChanged    { false };
         image_data_type     m_AlbumArt            { };
 
-        vis_data_type       m_UsingData           { vis_data_type::None };
-
-        waveform_data_type  m_Waveform            { };
+        // Analysis thread only
+        analysis_frame      m_Analysis            { };
         waveform_transform_type  m_fnWaveformTransform { };
-
-        dB_data_type        m_Decibel             { };
         dB_transform        m_fnDecibelTransform  { };
-
-        spectrum_data_type  m_Spectrum            { };
         spectrum_transform_type  m_fnSpectrumTransform { };
+        waveform_sample_buffer_type m_WaveformScratch  { }; //< Scratch for combined-only updates
+        spectrum_sample_buffer_type m_SpectrumScratch  { }; //< Scratch for combined-only updates
+        bool                m_bWaveformEnvelope   { false }; //< Waveform holds [min, max] pairs
+        resample_quality    m_eWaveformResample   { resample_quality::CubicHermite };
+        trigger_mode        m_eWaveformTrigger    { trigger_mode::None };
+        waveform_trigger_type m_WaveformTrigger   { };
+        resample_quality    m_eSpectrumResample   { resample_quality::CubicHermite };
+        size_type           m_nSpectrumBinsPerOctave{ 0 }; //< 0 for linear (FFT) bins
+        constant_q_type     m_ConstantQ           { };
+        beat_detector_type  m_BeatDetector        { };
+        chroma_analyser_type m_ChromaAnalyser     { };
+        duration_type       m_fAnalysisElapsed    { 0 }; //< Seconds since the previous `Analyse`
+
+        // Shared (via queues)
+        std::array<analysis_frame, AnalysisFrameCount> m_Frames{ };
+        frame_queue_type    m_ReadyFrames         { }; //< Analysis -> Render
+        frame_queue_type    m_FreeFrames          { }; //< Render -> Analysis
+        std::atomic<size_type> m_nPublished       { 0 };
+        std::atomic<size_type> m_nDropped         { 0 };
+        std::atomic<duration_type> m_fFetchOffset { -1 }; //< Render -> Analysis; < 0 until measured
+
+        // Render thread only
+        analysis_frame*     m_pCurrent            { &m_Frames[0] };
+        analysis_statistics m_Statistics          { };
+        offset_estimator_type m_OffsetEstimator   { };
+        tick_type           m_FrameTimestamp      { 0 };
     }; // class IAudioDataManager
 } // namespace Audio
 
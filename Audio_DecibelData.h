@@ -29,6 +29,7 @@
 
 //--------------------------------------
 //
+#include <algorithm>
 #include <cassert>
 #include <array>
 //--------------------------------------
@@ -105,10 +106,22 @@ namespace Audio::dB {
         constexpr void zero (size_type ch) noexcept { assert(valid()); m_Channels[ch].zero(); }
 
     public:
+        // NOTE: Storage is always allocated for `ChannelCount`
+        //       channels, only the first `channel_count()`
+        //       are in use.
         [[nodiscard]]
         constexpr decltype(auto) channel_count() const noexcept {
             assert(valid());
-            return m_Channels.size();
+            return m_nChannelCount;
+        }
+
+        constexpr void channel_count(size_type num) noexcept {
+            assert(valid()); assert(num <= ChannelCount);
+            num = std::min(num, ChannelCount);
+            for (auto ch = m_nChannelCount; ch < num; ++ch) {
+                m_Channels[ch].zero();
+            }
+            m_nChannelCount = num;
         }
 
         [[nodiscard]]
@@ -225,6 +238,7 @@ namespace Audio::dB {
 
     private:
         channel_buffer_type m_Channels;
+        size_type           m_nChannelCount{ ChannelCountT };
     };
 
     /**********************************************************************
@@ -338,6 +352,7 @@ namespace Audio::dB {
                                                  peak_type interp)  const noexcept { return channel(ch).peak_curr(interp); }
 
         decltype(auto)  channel_count           ()                  const noexcept { return m_Channels.channel_count(); }
+        constexpr void  channel_count           (size_type num)           noexcept { m_Channels.channel_count(num); }
 
         decltype(auto)  peak_decay_rate         ()                  const noexcept { assert(valid()); return m_Channels.peak_decay_rate(); }
         decltype(auto)  peak_minimum            ()                  const noexcept { assert(valid()); return m_Channels.peak_minimum(); }
@@ -0,0 +1,98 @@
+#pragma once
+#ifndef GUID_8828E44B_F929_4523_B3D1_C5D7E93CDB53
+#define GUID_8828E44B_F929_4523_B3D1_C5D7E93CDB53
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Util/InterpolateUtil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+//--------------------------------------
+
+namespace Audio::Latency {
+    //**************************************************************************
+    // OffsetEstimatorT
+    //**************************************************************************
+    //
+    // Estimates how far ahead of the playback position audio
+    // must be fetched for the display to match what is heard.
+    //
+    // Audio fetched at time `F` with offset `O` covers the
+    // playback position `P(F) + O`; it is presented at `T`
+    // having been interpolated into by `i` of an update
+    // period `U`, so what is shown trails the fetched audio by
+    // `(1 - i) * U`. Matching what is heard at `T`, `P(F) +
+    // (T - F)`, therefore needs
+    //
+    //      O = (T - F) + (1 - i) * U
+    //
+    // which doesn't depend on `O`, so each presented frame
+    // gives a direct measurement with no feedback. Measurements
+    // are smoothed (vsync and scheduling make them jittery)
+    // and the result limited to [0, `MaxOffset`].
+    template <typename DurationT>
+    class OffsetEstimatorT final {
+    private:
+        using this_type = OffsetEstimatorT<DurationT>;
+
+    public:
+        using duration_type = DurationT;
+
+        inline static constexpr const duration_type MaxOffset{ static_cast<duration_type>(.5) };  //< Seconds
+        inline static constexpr const duration_type Smoothing{ static_cast<duration_type>(.05) }; //< Per measurement
+
+    public:
+        void reset() noexcept { *this = this_type{}; }
+
+        //--------------------------------------------------
+        // `fetchToPresent`: seconds from fetching the frame's
+        // audio to it reaching the display; `interp` and
+        // `period`: how far into its update period (seconds)
+        // the frame was. Returns the new offset.
+        duration_type update(duration_type fetchToPresent,
+                             duration_type interp,
+                             duration_type period) noexcept {
+            const auto fLag{ (static_cast<duration_type>(1) - std::clamp(interp, static_cast<duration_type>(0), static_cast<duration_type>(1))) *
+                             std::max(period, static_cast<duration_type>(0)) };
+            m_fMeasured = std::clamp(fetchToPresent + fLag, static_cast<duration_type>(0), MaxOffset);
+            m_fOffset = m_bValid ? ::util::lerp(m_fOffset, m_fMeasured, Smoothing) : m_fMeasured;
+            m_bValid = true;
+            return m_fOffset;
+        }
+
+    public:
+        [[nodiscard]] constexpr bool valid   () const noexcept { return m_bValid; }
+        [[nodiscard]] constexpr auto offset  () const noexcept { return m_fOffset; }   //< Smoothed (seconds)
+        [[nodiscard]] constexpr auto measured() const noexcept { return m_fMeasured; } //< Most recent (seconds)
+
+    private:
+        duration_type m_fOffset  { 0 };
+        duration_type m_fMeasured{ 0 };
+        bool          m_bValid   { false };
+    }; // template <...> class OffsetEstimatorT final
+} // namespace Audio::Latency
+
+#endif // GUID_8828E44B_F929_4523_B3D1_C5D7E93CDB53
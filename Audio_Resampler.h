@@ -0,0 +1,252 @@
+#pragma once
+#ifndef GUID_E985529B_DB1D_49E5_AD1B_DC6C18DB3E1A
+#define GUID_E985529B_DB1D_49E5_AD1B_DC6C18DB3E1A
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Util/MemoryUtil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+//--------------------------------------
+
+namespace Audio::Samples {
+    //**************************************************************************
+    // ResampleQuality
+    //**************************************************************************
+    enum class ResampleQuality : std::uint8_t {
+        Linear,       //< 2 taps
+        CubicHermite, //< 4 taps (Catmull-Rom)
+        WindowedSinc, //< 8 taps (Blackman windowed sinc)
+    }; // enum class ResampleQuality
+
+    //**************************************************************************
+    // ResamplerT
+    //**************************************************************************
+    //
+    // Upsampling (target larger than source) using a
+    // polyphase FIR: for each output sample the fractional
+    // source position is rounded to the nearest of
+    // `PhaseCount` phases and a fixed number of precomputed coefficients
+    // is applied, so the cost per output sample depends
+    // only on the quality. As the source is never reduced
+    // no anti-alias filtering is needed; the sinc kernel
+    // interpolates up to the source Nyquist frequency.
+    //
+    // Output sample `0` and `targetSize - 1` map exactly
+    // onto the first and last source samples; taps falling
+    // outside the source are clamped to the nearest edge.
+    template <typename SampleTypeT>
+    class ResamplerT final {
+    private:
+        using this_type = ResamplerT<SampleTypeT>;
+
+    public:
+        using sample_type      = SampleTypeT;
+        using size_type        = std::size_t;
+        using sample_span_type = ::util::data_span<sample_type>;
+
+        inline static constexpr const size_type PhaseCount{ 256 };
+        inline static constexpr const size_type MaxTapCount{ 8 };
+
+        static constexpr size_type tap_count(ResampleQuality eQuality) noexcept {
+            switch (eQuality) {
+                case ResampleQuality::Linear:       return 2;
+                case ResampleQuality::CubicHermite: return 4;
+                case ResampleQuality::WindowedSinc: return MaxTapCount;
+            }
+            return 2;
+        }
+
+    private:
+        template <typename TypeT>
+        inline static constexpr auto is_not_nullptr_type_v =
+            !std::is_same_v<TypeT, std::nullptr_t>;
+
+        // [phase][tap], only the first `tap_count` taps of
+        // each phase are used; the extra phase (t == 1) lets
+        // positions round to the nearest phase
+        using table_type = std::array<sample_type, (PhaseCount + 1) * MaxTapCount>;
+
+        static table_type make_table(ResampleQuality eQuality) noexcept {
+            constexpr const double Pi{ 3.14159265358979323846 };
+
+            table_type table{ };
+            const auto taps{ tap_count(eQuality) };
+            for (size_type p = 0; p <= PhaseCount; ++p) {
+                const auto t{ static_cast<double>(p) / static_cast<double>(PhaseCount) };
+                auto* coeff{ table.data() + p * MaxTapCount };
+                switch (eQuality) {
+                    case ResampleQuality::Linear: {
+                        coeff[0] = static_cast<sample_type>(1. - t);
+                        coeff[1] = static_cast<sample_type>(t);
+                        break;
+                    }
+
+                    case ResampleQuality::CubicHermite: {
+                        const auto t2{ t * t };
+                        const auto t3{ t2 * t };
+                        coeff[0] = static_cast<sample_type>(-.5 * t3 +       t2 - .5 * t);
+                        coeff[1] = static_cast<sample_type>( 1.5 * t3 - 2.5 * t2 + 1.);
+                        coeff[2] = static_cast<sample_type>(-1.5 * t3 + 2.  * t2 + .5 * t);
+                        coeff[3] = static_cast<sample_type>( .5 * t3 -  .5 * t2);
+                        break;
+                    }
+
+                    case ResampleQuality::WindowedSinc: {
+                        // Tap `k` sits at source offset `k - (taps / 2 - 1)`
+                        const auto halfWidth{ static_cast<double>(taps) * .5 };
+                        double sum{ 0 };
+                        double weights[MaxTapCount]{ };
+                        for (size_type k = 0; k < taps; ++k) {
+                            const auto x{ static_cast<double>(k) - (halfWidth - 1.) - t };
+                            // Exactly 0 at the other samples, so the end
+                            // phases pass samples through unchanged
+                            const auto sinc{ (x == 0.)            ? 1. :
+                                             (x == std::round(x)) ? 0. :
+                                             std::sin(Pi * x) / (Pi * x) };
+                            // Blackman window over [-halfWidth, halfWidth]
+                            const auto w{ (x + halfWidth) / (2. * halfWidth) };
+                            const auto window{ .42 - .5 * std::cos(2. * Pi * w) + .08 * std::cos(4. * Pi * w) };
+                            weights[k] = sinc * window;
+                            sum += weights[k];
+                        }
+                        // Unity gain at DC for every phase
+                        for (size_type k = 0; k < taps; ++k) {
+                            coeff[k] = static_cast<sample_type>(weights[k] / sum);
+                        }
+                        break;
+                    }
+                }
+            }
+            return table;
+        }
+
+        static const table_type& table(ResampleQuality eQuality) noexcept {
+            static const table_type s_Linear      { make_table(ResampleQuality::Linear) };
+            static const table_type s_CubicHermite{ make_table(ResampleQuality::CubicHermite) };
+            static const table_type s_WindowedSinc{ make_table(ResampleQuality::WindowedSinc) };
+            switch (eQuality) {
+                case ResampleQuality::CubicHermite: return s_CubicHermite;
+                case ResampleQuality::WindowedSinc: return s_WindowedSinc;
+                default:                            return s_Linear;
+            }
+        }
+
+        //--------------------------------------------------
+
+        template <size_type TapCountT, typename TransformT>
+        static void resample(sample_span_type& target,
+                             const sample_type* source,
+                             size_type sampleCount,
+                             size_type stride,
+                             const table_type& table,
+                             [[maybe_unused]] TransformT& transform) noexcept {
+            constexpr const auto HaveTransformT{ is_not_nullptr_type_v<TransformT> };
+            constexpr const auto TapOffset{ static_cast<std::ptrdiff_t>(TapCountT / 2) - 1 };
+
+            const auto targetCount{ target.size() };
+            const auto lastSample { static_cast<std::ptrdiff_t>(sampleCount) - 1 };
+
+            // Source position `d * (sampleCount - 1) / (targetCount - 1)`
+            // stepped incrementally as whole + remainder, so the
+            // endpoints land exactly on the first/last samples.
+            const auto range    { sampleCount - 1 };
+            const auto divisor  { std::max<size_type>(targetCount - 1, 1) };
+            const auto stepWhole{ static_cast<std::ptrdiff_t>(range / divisor) };
+            const auto stepRem  { range % divisor };
+
+            std::ptrdiff_t index{ 0 };
+            size_type rem{ 0 };
+            for (size_type d = 0; d < targetCount; ++d) {
+                const auto phase{ (rem * PhaseCount + divisor / 2) / divisor };
+                const auto* coeff{ table.data() + phase * MaxTapCount };
+                const auto first{ index - TapOffset };
+
+                sample_type acc{ 0 };
+                if (first >= 0 && first + static_cast<std::ptrdiff_t>(TapCountT) - 1 <= lastSample) {
+                    const auto* s{ source + first * static_cast<std::ptrdiff_t>(stride) };
+                    for (size_type k = 0; k < TapCountT; ++k) {
+                        acc += coeff[k] * s[k * stride];
+                    }
+                } else {
+                    for (size_type k = 0; k < TapCountT; ++k) {
+                        const auto i{ std::clamp(first + static_cast<std::ptrdiff_t>(k),
+                                                 std::ptrdiff_t{ 0 }, lastSample) };
+                        acc += coeff[k] * source[i * static_cast<std::ptrdiff_t>(stride)];
+                    }
+                }
+
+                if constexpr (HaveTransformT) {
+                    target[d] = transform(acc);
+                } else {
+                    target[d] = acc;
+                }
+
+                index += stepWhole;
+                rem   += stepRem;
+                if (rem >= divisor) {
+                    rem -= divisor;
+                    ++index;
+                }
+            }
+        }
+
+    public:
+        template <typename TransformT>
+        static void resample(ResampleQuality eQuality,
+                             sample_span_type& target,
+                             const sample_type* source,
+                             size_type sourceSize,
+                             size_type stride,
+                             TransformT& transform) noexcept {
+            assert(source); assert(stride > 0);
+            const auto sampleCount{ sourceSize / stride };
+            assert(sampleCount > 0);
+            if (target.empty()) { return; }
+
+            const auto& coefficients{ table(eQuality) };
+            switch (eQuality) {
+                case ResampleQuality::CubicHermite:
+                    this_type::resample<4>(target, source, sampleCount, stride, coefficients, transform);
+                    break;
+                case ResampleQuality::WindowedSinc:
+                    this_type::resample<MaxTapCount>(target, source, sampleCount, stride, coefficients, transform);
+                    break;
+                default:
+                    this_type::resample<2>(target, source, sampleCount, stride, coefficients, transform);
+                    break;
+            }
+        }
+    }; // template <...> class ResamplerT final
+} // namespace Audio::Samples
+
+#endif // GUID_E985529B_DB1D_49E5_AD1B_DC6C18DB3E1A
@@ -24,40 +24,74 @@
 
 //--------------------------------------
 //
-#include "Audio_SampleData_Impl.h"
+#include "Util/InterpolateUtil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include <cassert>
 //--------------------------------------
 
 namespace Audio::Samples {
     /**********************************************************************
      * InterpolatedChannelsT *
+     **********************************************************************
+     *
+     * Structure-of-arrays storage for a runtime number of channels (up to
+     * `MaxChannelCountT`). Previous/next samples and peaks for all channels
+     * are held in a single contiguous block, arranged as planes:
+     *
+     *      [ samples 0 | samples 1 | peaks 0 | peaks 1 ]
+     *
+     * Each plane holds `channel_count()` rows of `stride()` values, with
+     * rows padded to a whole number of cache lines so every channel starts
+     * at the same alignment. Which of plane 0/1 is "next" is selected by
+     * index, so advancing to a new update never copies or swaps buffers,
+     * and peak decay runs as a single pass over every channel.
+     *
+     * NOTE: Peak planes are only present if peaks are in use.
+     *
+     * NOTE: Changing the channel or value count reallocates and zeroes
+     *       the block; layout changes only happen when the source or
+     *       the request changes, so this is not worth avoiding.
      **********************************************************************/
     template <
         typename SampleTypeT,
-        std::size_t ChannelCountT,
+        std::size_t MaxChannelCountT,
         class AllocatorT = std::allocator<SampleTypeT>
     >
     class InterpolatedChannelsT final {
     private:
-        using this_type = Samples::InterpolatedChannelsT<SampleTypeT, ChannelCountT, AllocatorT>;
+        using this_type = Samples::InterpolatedChannelsT<SampleTypeT, MaxChannelCountT, AllocatorT>;
 
     public:
-        using channel_data_type      = Samples::InterpolatedChannelDataT<SampleTypeT, AllocatorT>;
-        using channel_buffer_type    = std::array<channel_data_type, ChannelCountT>;
-        using sample_type            = typename channel_data_type::sample_type;
-        using sample_buffer_type     = typename channel_data_type::sample_buffer_type;
-        using sample_span_type       = typename channel_data_type::sample_span_type;
-        using sample_const_span_type = typename channel_data_type::sample_const_span_type;
-        using samples_type           = typename channel_data_type::samples_type;
-        using peak_type              = typename channel_data_type::peak_type;
-        using peak_buffer_type       = typename channel_data_type::peak_buffer_type;
-        using peaks_type             = typename channel_data_type::peaks_type;
-        using peak_type              = typename channel_data_type::peak_type;
-        using peak_span_type         = typename channel_data_type::peak_span_type;
-        using peak_const_span_type   = typename channel_data_type::peak_const_span_type;
-        using size_type              = typename channel_data_type::size_type;
+        using block_type             = std::vector<SampleTypeT, AllocatorT>;
+        using sample_buffer_type     = block_type;
+        using sample_type            = typename block_type::value_type;
+        using peak_type              = sample_type;
+        using size_type              = typename block_type::size_type;
+        using sample_span_type       = ::util::data_span<sample_type>;
+        using sample_const_span_type = ::util::data_span<const sample_type>;
+        using peak_span_type         = sample_span_type;
+        using peak_const_span_type   = sample_const_span_type;
 
     public:
-        inline static constexpr const auto ChannelCount{ ChannelCountT };
+        inline static constexpr const auto MaxChannelCount{ MaxChannelCountT };
+
+        // Rows are padded to this many values (one cache line)
+        inline static constexpr const size_type RowAlignment{
+            std::max<size_type>(64 / sizeof(sample_type), 1)
+        };
+
+        static_assert(MaxChannelCount > 0, "Must allow at least one channel");
+        static_assert(std::is_floating_point_v<sample_type>, "Sample type must be floating point");
+
+    private:
+        inline static constexpr const size_type SamplePlane{ 0 };
+        inline static constexpr const size_type PeakPlane  { 2 };
 
     public:
         InterpolatedChannelsT()                   noexcept  = default;
@@ -68,490 +102,406 @@ namespace Audio::Samples {
         this_type& operator=(      this_type&&)   noexcept  = default;
 
     public:
-        InterpolatedChannelsT(size_type num,
+        InterpolatedChannelsT(size_type channels,
+                              size_type num,
                               peak_type decay,
                               peak_type minimum) {
-            channel_value_count(num);
             peak_decay_rate(decay, minimum);
+            layout(channels, num);
         }
 
     public:
-        constexpr decltype(auto) begin  ()       noexcept { assert(valid()); return m_Channels.begin(); }
-        constexpr decltype(auto) begin  () const noexcept { assert(valid()); return m_Channels.begin(); }
-        constexpr decltype(auto) cbegin () const noexcept { assert(valid()); return m_Channels.cbegin(); }
+        void swap(this_type& other) noexcept {
+            assert(valid()); assert(other.valid());
+            using std::swap;
+            swap(m_Block        , other.m_Block);
+            swap(m_nChannelCount, other.m_nChannelCount);
+            swap(m_nValueCount  , other.m_nValueCount);
+            swap(m_nStride      , other.m_nStride);
+            swap(m_nNext        , other.m_nNext);
+            swap(m_PeakMinimum  , other.m_PeakMinimum);
+            swap(m_PeakDecayRate, other.m_PeakDecayRate);
+        }
 
-        constexpr decltype(auto) end    ()       noexcept { assert(valid()); return m_Channels.end(); }
-        constexpr decltype(auto) end    () const noexcept { assert(valid()); return m_Channels.end(); }
-        constexpr decltype(auto) cend   () const noexcept { assert(valid()); return m_Channels.cend(); }
+        void clear() noexcept {
+            assert(valid());
+            m_Block.clear();
+            m_nChannelCount = m_nValueCount = m_nStride = m_nNext = 0;
+        }
 
-        constexpr decltype(auto) rbegin ()       noexcept { assert(valid()); return m_Channels.rbegin(); }
-        constexpr decltype(auto) rbegin () const noexcept { assert(valid()); return m_Channels.rbegin(); }
-        constexpr decltype(auto) crbegin() const noexcept { assert(valid()); return m_Channels.crbegin(); }
+        void shrink_to_fit() { assert(valid()); m_Block.shrink_to_fit(); }
+        void reset        () { clear(); shrink_to_fit(); }
 
-        constexpr decltype(auto) rend   ()       noexcept { assert(valid()); return m_Channels.rend(); }
-        constexpr decltype(auto) rend   () const noexcept { assert(valid()); return m_Channels.rend(); }
-        constexpr decltype(auto) crend  () const noexcept { assert(valid()); return m_Channels.crend(); }
+        void zero_samples() noexcept {
+            assert(valid());
+            if (m_Block.empty()) { return; }
+            ::util::zero_n(row(SamplePlane, 0), plane_size() * 2);
+        }
 
-        constexpr decltype(auto) front  ()       noexcept { assert(valid());  return m_Channels.front(); }
-        constexpr decltype(auto) front  () const noexcept { assert(valid()); return m_Channels.front(); }
-        constexpr decltype(auto) back   ()       noexcept { assert(valid()); return m_Channels.back(); }
-        constexpr decltype(auto) back   () const noexcept { assert(valid()); return m_Channels.back(); }
+        void zero_peaks() noexcept {
+            assert(valid());
+            if (!have_peaks() || m_Block.empty()) { return; }
+            ::util::zero_n(row(PeakPlane, 0), plane_size() * 2);
+        }
 
-        constexpr decltype(auto) data   ()       noexcept { assert(valid()); return m_Channels.data(); }
-        constexpr decltype(auto) data   () const noexcept { assert(valid()); return m_Channels.data(); }
+        void zero() noexcept {
+            assert(valid());
+            if (m_Block.empty()) { return; }
+            ::util::zero(m_Block);
+        }
 
-        constexpr decltype(auto) size   () const noexcept { assert(valid()); return m_Channels.size(); }
+        void zero(size_type ch) noexcept {
+            assert(valid()); assert(ch < channel_count());
+            ::util::zero_n(row(SamplePlane + 0, ch), m_nStride);
+            ::util::zero_n(row(SamplePlane + 1, ch), m_nStride);
+            if (have_peaks()) {
+                ::util::zero_n(row(PeakPlane + 0, ch), m_nStride);
+                ::util::zero_n(row(PeakPlane + 1, ch), m_nStride);
+            }
+        }
 
     public:
-        void swap(this_type& other) noexcept {
-            assert(valid()); assert(other.valid());
-            using std::swap;
-            swap(m_Channels, other.m_Channels);
-        }
+        [[nodiscard]]
+        constexpr auto channel_count() const noexcept { return m_nChannelCount; }
 
-        void clear        () noexcept { assert(valid()); for (auto& c : m_Channels) { c.clear(); } }
-        void shrink_to_fit()          { assert(valid()); for (auto& c : m_Channels) { c.shrink_to_fit(); } }
-        void reset        ()          { assert(valid()); for (auto& c : m_Channels) { c.reset(); } }
-        void zero_samples () noexcept { assert(valid()); for (auto& c : m_Channels) { c.zero_samples(); } }
-        void zero_peaks   () noexcept { assert(valid()); for (auto& c : m_Channels) { c.zero_peaks(); } }
-        void zero         () noexcept { assert(valid()); for (auto& c : m_Channels) { c.zero(); } }
+        void channel_count(size_type num) { layout(num, m_nValueCount); }
 
-        void clear        (size_type ch) noexcept { assert(valid()); m_Channels[ch].clear(); }
-        void shrink_to_fit(size_type ch)          { assert(valid()); m_Channels[ch].shrink_to_fit(); }
-        void reset        (size_type ch)          { assert(valid()); m_Channels[ch].reset(); }
-        void zero_samples (size_type ch) noexcept { assert(valid()); m_Channels[ch].zero_samples(); }
-        void zero_peaks   (size_type ch) noexcept { assert(valid()); m_Channels[ch].zero_peaks(); }
-        void zero         (size_type ch) noexcept { assert(valid()); m_Channels[ch].zero(); }
+        [[nodiscard]]
+        constexpr auto channel_value_count() const noexcept { return m_nValueCount; }
+
+        void channel_value_count(size_type num) { layout(m_nChannelCount, num); }
 
-    public:
         [[nodiscard]]
-        constexpr decltype(auto) channel_count() const noexcept {
-            assert(valid());
-            return m_Channels.size();
-        }
+        constexpr auto stride() const noexcept { return m_nStride; }
 
         [[nodiscard]]
         decltype(auto) empty() const noexcept {
             assert(valid());
-            return m_Channels[0].empty();
+            return m_nValueCount == 0;
         }
 
-        //--------------------------------------------------
-        // `channel_value_count`:
-        // ----------------------
-        //
-        // Want to ensure that all channels **always**
-        // have the same size, even on error.
-        //
-        // Simplest solution is to do the reallocation
-        // in temporary variables, as is done here. This
-        // should be no different in performance than
-        // simply resizing the buffers, but ensures both
-        // buffers maintain the same size at all times.
-        //
-        // Unfortunately if an error does occur the
-        // buffers will be left empty, but avoiding this
-        // requires more complex code which is likely
-        // overkill for a worst case scenario which is
-        // likely to be fatal anyway.
-        //
-        // NOTE: Assumes `move` is `noexcept`
         [[nodiscard]]
-        decltype(auto) channel_value_count() const noexcept {
-            assert(valid());
-            return m_Channels[0].count();
-        }
+        decltype(auto) block() const noexcept { return (m_Block); }
 
-        void channel_value_count(size_type num) {
-            assert(valid());
-            if (num == channel_value_count()) { return; }
-            auto temp{ std::move(m_Channels) };
-            for (auto& c : temp) { c.count(num); }
-            m_Channels = std::move(temp);
+        void layout(size_type channels,
+                    size_type num) {
+            assert(channels <= MaxChannelCount);
+            channels = std::min(channels, MaxChannelCount);
+            if (channels == m_nChannelCount && num == m_nValueCount) { return; }
+
+            const auto stride{ ((num + RowAlignment - 1) / RowAlignment) * RowAlignment };
+            const auto size  { plane_count() * channels * stride };
+            // See notes for `interpolated_buffer::resize`
+            block_type block(size, static_cast<sample_type>(0), m_Block.get_allocator());
+            m_Block         = std::move(block);
+            m_nChannelCount = channels;
+            m_nValueCount   = num;
+            m_nStride       = stride;
+            m_nNext         = 0;
             assert(valid());
         }
-        //--------------------------------------------------
 
     public:
-        [[nodiscard]]
-        decltype(auto) data_for_update(size_type ch) noexcept {
+        //--------------------------------------------------
+        // Updating:
+        // ---------
+        //
+        // `begin_update` makes the current "next" data the
+        // "previous" data; every channel must then have its
+        // next samples written (or zeroed) before calling
+        // `end_update`, which derives peaks from them.
+        void begin_update() noexcept {
             assert(valid());
-            return m_Channels[ch].data_for_update();
+            m_nNext ^= 1;
         }
 
-        void update(size_type ch, const sample_buffer_type& samples) {
-            assert(valid());
-            m_Channels[ch].update(samples);
+        [[nodiscard]]
+        auto samples_for_update(size_type ch) noexcept {
+            assert(valid()); assert(ch < channel_count());
+            return sample_span_type{ row(SamplePlane + m_nNext, ch), m_nValueCount };
         }
 
-        void update(size_type ch, sample_buffer_type&& samples) {
+        void end_update() noexcept {
             assert(valid());
-            m_Channels[ch].update(std::forward<sample_buffer_type>(samples));
-        }
+            if (!have_peaks() || m_Block.empty()) { return; }
 
-        void update(size_type ch,
-                    sample_const_span_type samples) noexcept {
-            assert(valid());
-            m_Channels[ch].update(samples);
+            const auto* samples  { row(SamplePlane + m_nNext    , 0) };
+            const auto* peaksPrev{ row(PeakPlane   + prev_index(), 0) };
+                  auto* peaksNext{ row(PeakPlane   + m_nNext    , 0) };
+            const auto  count    { plane_size() };
+            const auto  minimum  { m_PeakMinimum };
+            const auto  decay    { m_PeakDecayRate };
+            for (size_type i = 0; i < count; ++i) {
+                const auto peak{ peaksPrev[i] };
+                const auto decayed{ (peak > minimum) ? (peak - decay) : minimum };
+                peaksNext[i] = (samples[i] > peak) ? samples[i] : decayed;
+            }
         }
+        //--------------------------------------------------
 
     public:
         [[nodiscard]]
-        decltype(auto) samples_prev(size_type ch) const noexcept { assert(valid()); return m_Channels[ch].samples_prev(); }
-        [[nodiscard]]
-        decltype(auto) samples_next(size_type ch)       noexcept { assert(valid()); return m_Channels[ch].samples_next(); }
+        auto samples_prev(size_type ch) const noexcept {
+            assert(valid()); assert(ch < channel_count());
+            return sample_const_span_type{ row(SamplePlane + prev_index(), ch), m_nValueCount };
+        }
         [[nodiscard]]
-        decltype(auto) samples_next(size_type ch) const noexcept { assert(valid()); return m_Channels[ch].samples_next(); }
+        auto samples_next(size_type ch) const noexcept {
+            assert(valid()); assert(ch < channel_count());
+            return sample_const_span_type{ row(SamplePlane + m_nNext, ch), m_nValueCount };
+        }
 
         [[nodiscard]]
         decltype(auto) sample_prev(size_type ch,
-                                   size_type pos) const noexcept { assert(valid()); return m_Channels[ch].sample_prev(pos); }
-        [[nodiscard]]
-        decltype(auto) sample_next(size_type ch,
-                                   size_type pos)       noexcept { assert(valid()); return m_Channels[ch].sample_next(pos); }
+                                   size_type pos) const noexcept {
+            assert(valid()); assert(ch < channel_count()); assert(pos < m_nValueCount);
+            return row(SamplePlane + prev_index(), ch)[pos];
+        }
         [[nodiscard]]
         decltype(auto) sample_next(size_type ch,
-                                   size_type pos) const noexcept { assert(valid()); return m_Channels[ch].sample_next(pos); }
+                                   size_type pos) const noexcept {
+            assert(valid()); assert(ch < channel_count()); assert(pos < m_nValueCount);
+            return row(SamplePlane + m_nNext, ch)[pos];
+        }
 
         [[nodiscard]]
-        decltype(auto) samples_curr(size_type ch,
-                                    sample_type interp) const {
-            assert(valid());
-            return m_Channels[ch].samples_curr(interp);
+        auto samples_curr(size_type ch,
+                          sample_type interp) const {
+            return curr(SamplePlane, ch, interp);
         }
 
         [[nodiscard]]
         decltype(auto) sample_curr(size_type ch,
                                    size_type pos,
                                    sample_type interp) const noexcept {
-            assert(valid());
-            return m_Channels[ch].sample_curr(pos, interp);
-        }
-
-        [[nodiscard]]
-        decltype(auto) sample_curr_at(size_type ch,
-                                      size_type pos,
-                                      sample_type interp) const noexcept {
-            assert(valid());
-            return m_Channels[ch].sample_curr_at(pos, interp);
+            return ::util::lerp(sample_prev(ch, pos), sample_next(ch, pos), interp);
         }
 
     public:
         [[nodiscard]]
-        decltype(auto) peaks_prev(size_type ch) const noexcept { assert(valid()); return m_Channels[ch].peaks_prev(); }
-        [[nodiscard]]
-        decltype(auto) peaks_next(size_type ch)       noexcept { assert(valid()); return m_Channels[ch].peaks_next(); }
+        auto peaks_prev(size_type ch) const noexcept {
+            assert(valid()); assert(have_peaks()); assert(ch < channel_count());
+            return peak_const_span_type{ row(PeakPlane + prev_index(), ch), m_nValueCount };
+        }
         [[nodiscard]]
-        decltype(auto) peaks_next(size_type ch) const noexcept { assert(valid()); return m_Channels[ch].peaks_next(); }
+        auto peaks_next(size_type ch) const noexcept {
+            assert(valid()); assert(have_peaks()); assert(ch < channel_count());
+            return peak_const_span_type{ row(PeakPlane + m_nNext, ch), m_nValueCount };
+        }
 
         [[nodiscard]]
         decltype(auto) peak_prev(size_type ch,
-                                 size_type pos) const noexcept { assert(valid()); return m_Channels[ch].peak_prev(pos); }
-        [[nodiscard]]
-        decltype(auto) peak_next(size_type ch,
-                                 size_type pos)       noexcept { assert(valid()); return m_Channels[ch].peak_next(pos); }
+                                 size_type pos) const noexcept {
+            assert(valid()); assert(have_peaks()); assert(ch < channel_count()); assert(pos < m_nValueCount);
+            return row(PeakPlane + prev_index(), ch)[pos];
+        }
         [[nodiscard]]
         decltype(auto) peak_next(size_type ch,
-                                 size_type pos) const noexcept { assert(valid()); return m_Channels[ch].peak_next(pos); }
+                                 size_type pos) const noexcept {
+            assert(valid()); assert(have_peaks()); assert(ch < channel_count()); assert(pos < m_nValueCount);
+            return row(PeakPlane + m_nNext, ch)[pos];
+        }
 
         [[nodiscard]]
-        decltype(auto) peaks_curr(size_type ch,
-                                  peak_type interp) const {
-            assert(valid());
-            return m_Channels[ch].peaks_curr(interp);
+        auto peaks_curr(size_type ch,
+                        peak_type interp) const {
+            assert(have_peaks());
+            return curr(PeakPlane, ch, interp);
         }
 
         [[nodiscard]]
         decltype(auto) peak_curr(size_type ch,
                                  size_type pos,
                                  peak_type interp) const noexcept {
-            assert(valid());
-            return m_Channels[ch].peak_curr(pos, interp);
-        }
-
-        [[nodiscard]]
-        decltype(auto) peak_curr_at(size_type ch,
-                                    size_type pos,
-                                    peak_type interp) const noexcept {
-            assert(valid());
-            return m_Channels[ch].peak_curr_at(pos, interp);
+            return ::util::lerp(peak_prev(ch, pos), peak_next(ch, pos), interp);
         }
 
     public:
         void peak_decay_rate(peak_type decay,
-                             peak_type minimum) noexcept {
-            assert(valid());
-            for (auto& c : m_Channels) { c.peak_decay_rate(decay, minimum); }
-        }
-
-        void peak_decay_rate(peak_type decay) {
+                             peak_type minimum) {
+            assert(valid());
+            const auto bHadPeaks{ have_peaks() };
+            m_PeakDecayRate = decay;
+            m_PeakMinimum   = minimum;
+            if (bHadPeaks != have_peaks()) {
+                // Peak planes follow the sample planes, so only
+                // the tail of the block is affected
+                m_Block.resize(plane_count() * plane_size(), static_cast<sample_type>(0));
+            }
             assert(valid());
-            for (auto& c : m_Channels) { c.peak_decay_rate(decay); }
         }
 
-        void peak_minimum(peak_type minimum) {
-            assert(valid());
-            for (auto& c : m_Channels) { c.peak_minimum(decay); }
-        }
+        void peak_decay_rate(peak_type decay) { peak_decay_rate(decay, m_PeakMinimum); }
+        void peak_minimum   (peak_type minimum) { peak_decay_rate(m_PeakDecayRate, minimum); }
 
         [[nodiscard]]
-        constexpr decltype(auto) peak_decay_rate() const noexcept {
-            assert(valid());
-            return m_Channels[0].peak_decay_rate();
-        }
-
+        constexpr auto peak_decay_rate() const noexcept { return m_PeakDecayRate; }
         [[nodiscard]]
-        constexpr decltype(auto) peak_minimum() const noexcept {
-            assert(valid());
-            return m_Channels[0].peak_minimum();
-        }
-
+        constexpr auto peak_minimum   () const noexcept { return m_PeakMinimum; }
         [[nodiscard]]
-        constexpr decltype(auto) have_peaks() const noexcept {
-            assert(valid());
-            return m_Channels[0].have_peaks();
-        }
+        constexpr auto have_peaks     () const noexcept { return m_PeakDecayRate > 0; }
 
-    public:
-        [[nodiscard]]
-              auto& channels()       noexcept { assert(valid()); return m_Channels; }
+    private:
         [[nodiscard]]
-        const auto& channels() const noexcept { assert(valid()); return m_Channels; }
-
+        constexpr size_type plane_count() const noexcept { return have_peaks() ? 4 : 2; }
         [[nodiscard]]
-        decltype(auto) at(size_type pos)       { assert(valid()); return m_Channels.at(pos); }
+        constexpr size_type plane_size () const noexcept { return m_nChannelCount * m_nStride; }
         [[nodiscard]]
-        decltype(auto) at(size_type pos) const { assert(valid()); return m_Channels.at(pos); }
+        constexpr size_type prev_index () const noexcept { return m_nNext ^ 1; }
 
         [[nodiscard]]
-        decltype(auto) operator[](size_type pos)       noexcept { assert(valid()); return m_Channels[pos]; }
+        auto row(size_type plane, size_type ch)       noexcept { return m_Block.data() + ((plane * m_nChannelCount) + ch) * m_nStride; }
         [[nodiscard]]
-        decltype(auto) operator[](size_type pos) const noexcept { assert(valid()); return m_Channels[pos]; }
+        auto row(size_type plane, size_type ch) const noexcept { return m_Block.data() + ((plane * m_nChannelCount) + ch) * m_nStride; }
 
-    public:
-        constexpr operator const channel_buffer_type& () const noexcept { return m_Channels; }
-        constexpr operator       channel_buffer_type& ()       noexcept { return m_Channels; }
+        [[nodiscard]]
+        auto curr(size_type plane,
+                  size_type ch,
+                  sample_type interp) const {
+            assert(valid()); assert(ch < channel_count());
+            sample_buffer_type current{};
+            current.resize(m_nValueCount);
+            if (m_nValueCount > 0) {
+                ::util::lerp(sample_span_type{ current },
+                             sample_const_span_type{ row(plane + prev_index(), ch), m_nValueCount },
+                             sample_const_span_type{ row(plane + m_nNext, ch), m_nValueCount },
+                             interp);
+            }
+            return current;
+        }
 
-    private:
         [[nodiscard]]
         bool valid() const noexcept {
-            const auto num_samples = m_Channels[0].count();
-            for (const auto& c : m_Channels) {
-                if (num_samples != c.count()) { return false; }
-            }
-            return true;
+            if (m_nChannelCount > MaxChannelCount) { return false; }
+            if (m_nStride < m_nValueCount)         { return false; }
+            if ((m_nStride % RowAlignment) != 0)   { return false; }
+            if (m_nNext > 1)                       { return false; }
+            return m_Block.size() == plane_count() * plane_size();
         }
 
     private:
-        channel_buffer_type m_Channels;
-    };
+        block_type m_Block        {};
+        size_type  m_nChannelCount{ 0 };
+        size_type  m_nValueCount  { 0 };
+        size_type  m_nStride      { 0 };
+        size_type  m_nNext        { 0 };
+        peak_type  m_PeakMinimum  { 0 };
+        peak_type  m_PeakDecayRate{ 0 };
+    }; // template <...> class InterpolatedChannelsT final
 
     /**********************************************************************
      * SampleDataT *
+     **********************************************************************
+     *
+     * Per-channel and combined sample data for a single frame. The combined
+     * data is stored as an extra row after the channels, so the whole frame
+     * shares one block (see `InterpolatedChannelsT`).
      **********************************************************************/
     template <
         typename SampleTypeT,
-        std::size_t ChannelCountT,
+        std::size_t MaxChannelCountT,
         class AllocatorT = std::allocator<SampleTypeT>
     >
     class SampleDataT final {
     private:
-        using this_type = Samples::SampleDataT<SampleTypeT, ChannelCountT, AllocatorT>;
+        using this_type = Samples::SampleDataT<SampleTypeT, MaxChannelCountT, AllocatorT>;
 
     public:
-        using channels_type          = Samples::InterpolatedChannelsT<SampleTypeT, ChannelCountT, AllocatorT>;
-        using combined_type          = Samples::InterpolatedChannelDataT<SampleTypeT, AllocatorT>;
-        using channel_data_type      = typename channels_type::channel_data_type;
-        using channel_buffer_type    = typename channels_type::channel_buffer_type;
+        using channels_type          = Samples::InterpolatedChannelsT<SampleTypeT, MaxChannelCountT + 1, AllocatorT>;
         using sample_type            = typename channels_type::sample_type;
         using sample_buffer_type     = typename channels_type::sample_buffer_type;
         using sample_span_type       = typename channels_type::sample_span_type;
         using sample_const_span_type = typename channels_type::sample_const_span_type;
-        using samples_type           = typename channels_type::samples_type;
-        using peak_type              = typename channels_type::peak_type;
-        using peak_buffer_type       = typename channels_type::peak_buffer_type;
-        using peaks_type             = typename channels_type::peaks_type;
         using peak_type              = typename channels_type::peak_type;
         using peak_span_type         = typename channels_type::peak_span_type;
         using peak_const_span_type   = typename channels_type::peak_const_span_type;
         using size_type              = typename channels_type::size_type;
 
     public:
-        inline static constexpr const auto ChannelCount{ ChannelCountT };
+        inline static constexpr const auto MaxChannelCount{ MaxChannelCountT };
 
     public:
-        constexpr SampleDataT() noexcept = default;
+        SampleDataT()                   noexcept = default;
+        SampleDataT(const this_type& )           = default;
+        SampleDataT(      this_type&&)  noexcept = default;
 
-        constexpr SampleDataT(const this_type& ) noexcept = default;
-        constexpr SampleDataT(      this_type&&) noexcept = default;
-
-        constexpr this_type& operator=(const this_type& ) noexcept = default;
-        constexpr this_type& operator=(      this_type&&) noexcept = default;
+        this_type& operator=(const this_type& )          = default;
+        this_type& operator=(      this_type&&) noexcept = default;
 
     public:
-        constexpr void channels_clear   ()              noexcept { m_Channels.clear(); }
-        constexpr void channels_reset   ()              noexcept { m_Channels.reset(); }
-        constexpr void channels_zero    ()              noexcept { m_Channels.zero(); }
-
-        constexpr void channel_clear    (size_type ch)  noexcept { m_Channels.clear(ch); }
-        constexpr void channel_reset    (size_type ch)  noexcept { m_Channels.reset(ch); }
-        constexpr void channel_zero     (size_type ch)  noexcept { m_Channels.zero(ch); }
-
-        constexpr void combined_clear   ()              noexcept { m_Combined.clear(); }
-        constexpr void combined_reset   ()              noexcept { m_Combined.reset(); }
-        constexpr void combined_zero    ()              noexcept { m_Combined.zero(); }
-
-        constexpr void clear            ()              noexcept { channels_clear(); combined_clear(); }
-        constexpr void reset            ()              noexcept { channels_reset(); combined_reset(); }
-        constexpr void zero             ()              noexcept { channels_zero();  combined_zero(); }
+        void clear        () noexcept { m_Channels.clear(); }
+        void reset        ()          { m_Channels.reset(); }
+        void zero         () noexcept { m_Channels.zero(); }
+        void channel_zero (size_type ch) noexcept { assert(ch < channel_count()); m_Channels.zero(ch); }
+        void combined_zero() noexcept { m_Channels.zero(combined_row()); }
 
         [[nodiscard]]
-        decltype(auto) value_count() const noexcept {
-            assert(valid());
-            return m_Channels[0].count();
-        }
+        decltype(auto) empty() const noexcept { return m_Channels.empty(); }
 
-        void value_count(size_type num) {
-            assert(valid());
-            if (num == value_count()) { return; }
-            auto channels{ std::move(m_Channels) };
-            auto combined{ std::move(m_Combined) };
-            channels.channel_value_count(num);
-            combined.count(num);
-            m_Channels = std::move(channels);
-            m_Combined = std::move(combined);
-            assert(valid());
-        }
-
-        void peak_decay_rate(peak_type decay,
-                             peak_type minimum) noexcept {
-            m_Channels.peak_decay_rate(decay, minimum);
-            m_Combined.peak_decay_rate(decay, minimum);
-        }
-
-        void peak_decay_rate(peak_type decay) noexcept {
-            m_Channels.peak_decay_rate(decay);
-            m_Combined.peak_decay_rate(decay);
-        }
-
-        void peak_minimum(peak_type minimum) noexcept {
-            m_Channels.peak_minimum(minimum);
-            m_Combined.peak_minimum(minimum);
-        }
-
-    public:
         [[nodiscard]]
-        decltype(auto) channel_data_for_update(size_type ch) noexcept {
-            assert(valid());
-            return m_Channels[ch].data_for_update();
-        }
+        decltype(auto) value_count() const noexcept { return m_Channels.channel_value_count(); }
 
-        void channel_update(size_type ch,
-                            const sample_buffer_type& samples) {
-            assert(valid());
-            m_Channels[ch].update(samples);
-        }
-
-        void channel_update(size_type ch,
-                            sample_buffer_type&& samples) {
-            assert(valid());
-            m_Channels[ch].update(std::forward<sample_buffer_type>(samples));
-        }
-
-        void channel_update(size_type ch,
-                            sample_const_span_type samples) noexcept {
-            assert(valid());
-            m_Channels[ch].update(samples);
-        }
+        void value_count(size_type num) { layout(channel_count(), num); }
 
         [[nodiscard]]
-        decltype(auto) combined_data_for_update() noexcept {
-            assert(valid());
-            return m_Combined.data_for_update();
+        size_type channel_count() const noexcept {
+            const auto rows{ m_Channels.channel_count() };
+            return (rows > 0) ? (rows - 1) : 0;
         }
 
-        void combined_update(const sample_buffer_type& samples) {
-            assert(valid());
-            m_Combined.update(samples);
-        }
+        void channel_count(size_type num) { layout(num, value_count()); }
 
-        void combined_update(sample_buffer_type&& samples) noexcept {
-            assert(valid());
-            m_Combined.update(std::forward<sample_buffer_type>(samples));
-        }
-
-        void combined_update(sample_const_span_type samples) noexcept {
-            assert(valid());
-            m_Combined.update(samples);
+        void layout(size_type channels,
+                    size_type num) {
+            assert(channels <= MaxChannelCount);
+            m_Channels.layout(std::min(channels, MaxChannelCount) + 1, num);
         }
 
-    public:
-              auto&     combined_data           ()                        noexcept { return m_Combined; }
-        const auto&     combined_data           ()                  const noexcept { return m_Combined; }
-
-        decltype(auto)  combined                ()                        noexcept { return combined_data(); }
-        decltype(auto)  combined                ()                  const noexcept { return combined_data(); }
+        void peak_decay_rate(peak_type decay,
+                             peak_type minimum)    { m_Channels.peak_decay_rate(decay, minimum); }
+        void peak_decay_rate(peak_type decay)      { m_Channels.peak_decay_rate(decay); }
+        void peak_minimum   (peak_type minimum)    { m_Channels.peak_minimum(minimum); }
 
-        decltype(auto)  combined_samples_prev    ()                  const noexcept { return m_Combined.samples_prev(); }
-        decltype(auto)  combined_samples_next    ()                        noexcept { return m_Combined.samples_next(); }
-        decltype(auto)  combined_samples_next    ()                  const noexcept { return m_Combined.samples_next(); }
-        decltype(auto)  combined_samples_curr    (sample_type interp)    const { return m_Combined.samples_curr(interp); }
+        decltype(auto) peak_decay_rate() const noexcept { return m_Channels.peak_decay_rate(); }
+        decltype(auto) peak_minimum   () const noexcept { return m_Channels.peak_minimum(); }
+        decltype(auto) have_peaks     () const noexcept { return m_Channels.have_peaks(); }
 
-        decltype(auto)  combined_peaks_prev      ()                  const noexcept { return m_Combined.peaks_prev(); }
-        decltype(auto)  combined_peaks_next      ()                        noexcept { return m_Combined.peaks_next(); }
-        decltype(auto)  combined_peaks_next      ()                  const noexcept { return m_Combined.peaks_next(); }
-        decltype(auto)  combined_peaks_curr      (sample_type interp)    const { return m_Combined.peaks_curr(interp); }
+    public:
+        void           begin_update            ()                        noexcept { m_Channels.begin_update(); }
+        decltype(auto) channel_data_for_update (size_type ch)            noexcept { assert(ch < channel_count()); return m_Channels.samples_for_update(ch); }
+        decltype(auto) combined_data_for_update()                        noexcept { return m_Channels.samples_for_update(combined_row()); }
+        void           end_update              ()                        noexcept { m_Channels.end_update(); }
 
     public:
-              auto&     channel_data            ()                        noexcept { return m_Channels; }
         const auto&     channel_data            ()                  const noexcept { return m_Channels; }
 
-              auto&     channel                 (size_type ch)            noexcept { return m_Channels[ch]; }
-        const auto&     channel                 (size_type ch)      const noexcept { return m_Channels[ch]; }
-
-        decltype(auto)  channels                ()                        noexcept { return m_Channels.channels(); }
-        decltype(auto)  channels                ()                  const noexcept { return m_Channels.channels(); }
-
-        decltype(auto)  channel_samples_prev     (size_type ch)      const noexcept { return channel(ch).samples_prev(); }
-        decltype(auto)  channel_samples_next     (size_type ch)            noexcept { return channel(ch).samples_next(); }
-        decltype(auto)  channel_samples_next     (size_type ch)      const noexcept { return channel(ch).samples_next(); }
+        decltype(auto)  channel_samples_prev     (size_type ch)      const noexcept { assert(ch < channel_count()); return m_Channels.samples_prev(ch); }
+        decltype(auto)  channel_samples_next     (size_type ch)      const noexcept { assert(ch < channel_count()); return m_Channels.samples_next(ch); }
         decltype(auto)  channel_samples_curr     (size_type ch,
-                                                  sample_type interp) const         { return channel(ch).samples_curr(interp); }
+                                                  sample_type interp) const         { assert(ch < channel_count()); return m_Channels.samples_curr(ch, interp); }
 
-        decltype(auto)  channel_peaks_prev       (size_type ch)      const noexcept { return channel(ch).peaks_prev(); }
-        decltype(auto)  channel_peaks_next       (size_type ch)            noexcept { return channel(ch).peaks_next(); }
-        decltype(auto)  channel_peaks_next       (size_type ch)      const noexcept { return channel(ch).peaks_next(); }
+        decltype(auto)  channel_peaks_prev       (size_type ch)      const noexcept { assert(ch < channel_count()); return m_Channels.peaks_prev(ch); }
+        decltype(auto)  channel_peaks_next       (size_type ch)      const noexcept { assert(ch < channel_count()); return m_Channels.peaks_next(ch); }
         decltype(auto)  channel_peaks_curr       (size_type ch,
-                                                  peak_type interp)  const          { return channel(ch).peaks_curr(interp); }
-
-        decltype(auto)  channel_count           ()                  const noexcept { return m_Channels.channel_count(); }
+                                                  peak_type interp)  const          { assert(ch < channel_count()); return m_Channels.peaks_curr(ch, interp); }
 
-        decltype(auto)  peak_decay_rate         ()                  const noexcept { assert(valid()); return m_Channels.peak_decay_rate(); }
-        decltype(auto)  peak_minimum            ()                  const noexcept { assert(valid()); return m_Channels.peak_minimum(); }
+        decltype(auto)  combined_samples_prev    ()                  const noexcept { return m_Channels.samples_prev(combined_row()); }
+        decltype(auto)  combined_samples_next    ()                  const noexcept { return m_Channels.samples_next(combined_row()); }
+        decltype(auto)  combined_samples_curr    (sample_type interp) const         { return m_Channels.samples_curr(combined_row(), interp); }
 
-        decltype(auto)  have_peaks              ()                  const noexcept { assert(valid()); return m_Channels.have_peaks(); }
-
-    public:
-        constexpr operator const channels_type&       () const noexcept { return channel_data(); }
-        constexpr operator       channels_type&       ()       noexcept { return channel_data(); }
-
-        constexpr operator const combined_type&       () const noexcept { return combined_data(); }
-        constexpr operator       combined_type&       ()       noexcept { return combined_data(); }
-
-        constexpr operator const channel_buffer_type& () const noexcept { return channels(); }
-        constexpr operator       channel_buffer_type& ()       noexcept { return channels(); }
+        decltype(auto)  combined_peaks_prev      ()                  const noexcept { return m_Channels.peaks_prev(combined_row()); }
+        decltype(auto)  combined_peaks_next      ()                  const noexcept { return m_Channels.peaks_next(combined_row()); }
+        decltype(auto)  combined_peaks_curr      (peak_type interp)  const          { return m_Channels.peaks_curr(combined_row(), interp); }
 
     private:
-        bool valid() const noexcept {
-            if (m_Channels.have_peaks()      != m_Combined.have_peaks())       { return false; }
-            if (m_Channels.peak_decay_rate() != m_Combined.peak_decay_rate()) { return false; }
-            if (m_Channels.peak_minimum()    != m_Combined.peak_minimum())    { return false; }
-            return true;
+        [[nodiscard]]
+        size_type combined_row() const noexcept {
+            assert(m_Channels.channel_count() > 0);
+            return channel_count();
         }
 
     private:
         channels_type m_Channels{};
-        combined_type m_Combined{};
     }; // template <...> class SampleDataT final
 } // namespace Audio::Samples
 
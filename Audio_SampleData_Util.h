@@ -25,11 +25,15 @@
 //--------------------------------------
 //
 #include "Audio_SampleData.h"
+#include "Audio_Resampler.h"
 //--------------------------------------
 
 //--------------------------------------
 //
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cmath>
 //--------------------------------------
 
 namespace Audio::Samples::detail {
@@ -42,11 +46,14 @@ namespace Audio::Samples::detail {
         using this_type = ChannelSamplesUtilImplT<SampleTypeT>;
 
     public:
-        using channel_type       = ::Audio::Samples::InterpolatedChannelDataT<SampleTypeT>;
-        using sample_buffer_type = typename channel_type::sample_buffer_type;
-        using sample_type        = typename channel_type::sample_type;
-        using peak_type          = typename channel_type::peak_type;
-        using size_type          = typename channel_type::size_type;
+        using sample_type      = SampleTypeT;
+        using peak_type        = SampleTypeT;
+        using size_type        = std::size_t;
+        using sample_span_type = ::util::data_span<sample_type>;
+        using resampler_type   = ::Audio::Samples::ResamplerT<sample_type>;
+
+        // Independent min/max accumulators used for envelopes
+        inline static constexpr const size_type LaneCount{ 8 };
 
     private:
         template <typename TypeT>
@@ -68,7 +75,7 @@ namespace Audio::Samples::detail {
     private:
         // targetCount < sourceCount
         template <typename TransformT>
-        static void bin_data(channel_type& channel,
+        static void bin_data(sample_span_type& target,
                              const sample_type* source,
                              size_type sourceSize,
                              size_type stride,
@@ -76,8 +83,6 @@ namespace Audio::Samples::detail {
             constexpr const auto HaveTransformT{ is_not_nullptr_type_v<TransformT> };
             constexpr auto fracMax{ static_cast<sample_type>(1) };
 
-            auto target{ channel.data_for_sample_update() };
-
             const auto sampleCount        = sourceSize / stride;
             const auto samplesPerBinExact = static_cast<sample_type>(sampleCount) / static_cast<sample_type>(target.size());
             const auto samplesPerBinWhole = std::trunc(samplesPerBinExact);
@@ -114,55 +119,33 @@ namespace Audio::Samples::detail {
         //--------------------------------------------------
 
         // targetCount > sourceCount
-        // TODO: Implement this properly (i.e. expand data to fill range)
         template <typename TransformT>
-        static void expand_data(channel_type& channel,
-                               const sample_type* source,
-                               size_type sourceSize,
-                               size_type stride,
-                               [[maybe_unused]] TransformT transform) noexcept {
-            constexpr const auto HaveTransformT{ is_not_nullptr_type_v<TransformT> };
-            const auto sampleCount = sourceSize / stride;
-            if (stride == 1 && !HaveTransformT) {
-                channel.update_samples({ source, sourceSize });
-            } else {
-                auto data{ channel.data_for_sample_update() };
-                size_type s{ 0 }, d{ 0 };
-                while (s < sourceSize) {
-                    if constexpr (HaveTransformT) {
-                        data[d] = transform(source[s]);
-                    } else {
-                        data[d] = source[s];
-                    }
-                    ++d;
-                    s += stride;
-                }
-                while (d < sampleCount) {
-                    if constexpr (HaveTransformT) {
-                        data[d] = transform(0);
-                    } else {
-                        data[d] = 0;
-                    }
-                    ++d;
-                }
-            }
+        static void expand_data(sample_span_type& target,
+                                const sample_type* source,
+                                size_type sourceSize,
+                                size_type stride,
+                                TransformT transform,
+                                ResampleQuality eQuality) noexcept {
+            resampler_type::resample(eQuality,
+                                     target,
+                                     source, sourceSize, stride,
+                                     transform);
         }
 
         //--------------------------------------------------
 
         // targetCount == sourceCount
         template <typename TransformT>
-        static void copy_data(channel_type& channel,
+        static void copy_data(sample_span_type& target,
                               const sample_type* source,
-                              size_type sourceSize,
+                              [[maybe_unused]] size_type sourceSize,
                               size_type stride,
                               [[maybe_unused]] TransformT transform) noexcept {
             constexpr const auto HaveTransformT{ is_not_nullptr_type_v<TransformT> };
             if (stride == 1 && !HaveTransformT) {
-                channel.update_samples({ source, sourceSize });
+                ::util::copy_n(target.data(), source, target.size());
             } else {
-                auto data{ channel.data_for_sample_update() };
-                for (auto& bin : data) {
+                for (auto& bin : target) {
                     if constexpr (HaveTransformT) {
                         bin = transform(*source);
                     } else {
@@ -175,33 +158,135 @@ namespace Audio::Samples::detail {
 
         //--------------------------------------------------
 
+        // Branch free, with independent lanes so the reduction
+        // isn't serialised on a single compare chain; for
+        // contiguous data (stride 1) the compiler can also
+        // vectorise the lanes.
+        static void min_max(const sample_type* source,
+                            size_type count,
+                            size_type stride,
+                            sample_type& lo,
+                            sample_type& hi) noexcept {
+            assert(count > 0);
+
+            size_type s{ 0 };
+            if (count >= LaneCount) {
+                sample_type laneLo[LaneCount], laneHi[LaneCount];
+                for (size_type l = 0; l < LaneCount; ++l) {
+                    laneLo[l] = laneHi[l] = source[l * stride];
+                }
+                for (s = LaneCount; s + LaneCount <= count; s += LaneCount) {
+                    for (size_type l = 0; l < LaneCount; ++l) {
+                        const auto v{ source[(s + l) * stride] };
+                        laneLo[l] = (v < laneLo[l]) ? v : laneLo[l];
+                        laneHi[l] = (laneHi[l] < v) ? v : laneHi[l];
+                    }
+                }
+                lo = laneLo[0]; hi = laneHi[0];
+                for (size_type l = 1; l < LaneCount; ++l) {
+                    lo = (laneLo[l] < lo) ? laneLo[l] : lo;
+                    hi = (hi < laneHi[l]) ? laneHi[l] : hi;
+                }
+            } else {
+                lo = hi = source[0];
+                s = 1;
+            }
+
+            for (; s < count; ++s) {
+                const auto v{ source[s * stride] };
+                lo = (v < lo) ? v : lo;
+                hi = (hi < v) ? v : hi;
+            }
+        }
+
+        //--------------------------------------------------
+
+        // target holds interleaved [min, max] pairs
+        template <typename TransformT>
+        static void envelope_data(sample_span_type& target,
+                                  const sample_type* source,
+                                  size_type sourceSize,
+                                  size_type stride,
+                                  [[maybe_unused]] TransformT transform) noexcept {
+            constexpr const auto HaveTransformT{ is_not_nullptr_type_v<TransformT> };
+
+            const auto pairCount  { target.size() / 2 };
+            const auto sampleCount{ sourceSize / stride };
+            assert(pairCount > 0); assert(sampleCount > 0);
+
+            // Integer bin edges: when binning every source sample
+            // is read exactly once; when expanding, samples are
+            // repeated across neighbouring pairs.
+            auto* pair{ target.data() };
+            for (size_type p = 0; p < pairCount; ++p) {
+                const auto begin{ (p * sampleCount) / pairCount };
+                const auto end  { std::max(((p + 1) * sampleCount) / pairCount, begin + 1) };
+
+                sample_type lo, hi;
+                this_type::min_max(source + begin * stride, end - begin, stride, lo, hi);
+
+                if constexpr (HaveTransformT) {
+                    const auto tlo{ transform(lo) };
+                    const auto thi{ transform(hi) };
+                    // Transform need not be monotonic
+                    pair[0] = std::min(tlo, thi);
+                    pair[1] = std::max(tlo, thi);
+                } else {
+                    pair[0] = lo;
+                    pair[1] = hi;
+                }
+                pair += 2;
+            }
+        }
+
+        //--------------------------------------------------
+
     public:
+        //--------------------------------------------------
+        // `update`:
+        // ---------
+        //
+        // When `bEnvelope` is set `target` is treated as
+        // `target.size() / 2` interleaved `[min, max]` pairs
+        // rather than as individual (averaged) samples; this
+        // keeps transients visible when there are many more
+        // samples than points to display.
+        //
+        // `eQuality` selects the interpolation used when
+        // there are fewer samples than points to display.
         template <typename TransformT = std::nullptr_t>
-        static void update(channel_type& channel,
+        static void update(sample_span_type target,
                            const sample_type* source,
                            size_type sourceSize,
                            size_type stride,
-                           [[maybe_unused]] TransformT transform = {}) noexcept {
+                           [[maybe_unused]] TransformT transform = {},
+                           bool bEnvelope = false,
+                           ResampleQuality eQuality = ResampleQuality::CubicHermite) noexcept {
             assert(source); assert(sourceSize > 0);
             assert(stride > 0 && stride < sourceSize);
 
-            const auto targetCount{ channel.count() };
+            const auto targetCount{ target.size() };
             const auto sampleCount{ sourceSize / stride };
-
-            if (sampleCount == targetCount) {
-                this_type::copy_data(channel,
+            if (targetCount == 0) { return; }
+
+            if (bEnvelope) {
+                assert((targetCount % 2) == 0);
+                this_type::envelope_data(target,
+                                         source, sourceSize, stride,
+                                         transform);
+            } else if (sampleCount == targetCount) {
+                this_type::copy_data(target,
                                      source, sourceSize, stride,
                                      transform);
             } else if (sampleCount > targetCount) {
-                this_type::bin_data(channel,
+                this_type::bin_data(target,
                                     source, sourceSize, stride,
                                     transform);
             } else { // sampleCount < targetCount
-                this_type::expand_data(channel,
+                this_type::expand_data(target,
                                        source, sourceSize, stride,
-                                       transform);
+                                       transform, eQuality);
             }
-            channel.update_peaks_from_samples();
         }
    }; // template <...> struct ChannelSamplesUtilImplT final
 
@@ -210,45 +295,164 @@ namespace Audio::Samples::detail {
     //**************************************************************************
     template <
         typename SampleTypeT,
-        std::size_t CountT
+        std::size_t MaxChannelCountT,
+        class AllocatorT
     >
     class SamplesUtilImplT final {
     private:
-        using this_type = SamplesUtilImplT<SampleTypeT, CountT>;
+        using this_type = SamplesUtilImplT<SampleTypeT, MaxChannelCountT, AllocatorT>;
 
     public:
-        using channels_util_type            = ::Audio::Samples::detail::ChannelSamplesUtilImplT<SampleTypeT>;
-        using channels_type                 = ::Audio::Samples::InterpolatedChannelsT<SampleTypeT, CountT>;
-        using sample_buffer_type            = typename channels_util_type::sample_buffer_type;
-        using sample_type                   = typename channels_util_type::sample_type;
-        using peak_type                     = typename channels_util_type::peak_type;
-        using single_channel_type           = typename channels_util_type::channel_type;
-        using size_type                     = typename channels_util_type::size_type;
+        using channels_util_type = ::Audio::Samples::detail::ChannelSamplesUtilImplT<SampleTypeT>;
+        using sample_data_type   = ::Audio::Samples::SampleDataT<SampleTypeT, MaxChannelCountT, AllocatorT>;
+        using sample_type        = typename sample_data_type::sample_type;
+        using sample_buffer_type = typename sample_data_type::sample_buffer_type;
+        using sample_span_type   = typename channels_util_type::sample_span_type;
+        using size_type          = typename sample_data_type::size_type;
 
     public:
+        // Average of the first `channelCount` channels, written directly
+        // into the combined row (no intermediate buffer). For envelope
+        // data this averages the per-channel minima/maxima, which stays
+        // ordered but is only an approximation of the downmix envelope.
+        static void combine(sample_data_type& data,
+                            size_type channelCount) noexcept {
+            channelCount = std::min(channelCount, data.channel_count());
+            auto combined{ data.combined_data_for_update() };
+            ::util::zero_n(combined.data(), combined.size());
+            if (channelCount == 0) { return; }
+
+            const auto channelWeight{ static_cast<sample_type>(1.) / static_cast<sample_type>(channelCount) };
+            const auto sampleCount  { combined.size() };
+            for (size_type ch = 0; ch < channelCount; ++ch) {
+                const auto channelSamples{ data.channel_samples_next(ch) };
+                for (size_type s = 0; s < sampleCount; ++s) {
+                    combined[s] += channelSamples[s] * channelWeight;
+                }
+            }
+        }
+
+        //--------------------------------------------------
+        // `envelope_interleaved`:
+        // -----------------------
+        //
+        // Min/max envelope for every channel in a single
+        // pass over the interleaved source. Requires that
+        // `stride` divides `LaneCount`, so lane `l` always
+        // holds channel `l % stride` and each bin (a whole
+        // number of frames) can be reduced over contiguous
+        // memory.
+        template <typename TransformT>
+        static void envelope_interleaved(sample_data_type& data,
+                                         const sample_type* source,
+                                         size_type sourceSize,
+                                         size_type stride,
+                                         TransformT& transform) {
+            constexpr const auto LaneCount{ channels_util_type::LaneCount };
+            assert(stride > 0 && stride <= MaxChannelCountT);
+            assert((LaneCount % stride) == 0);
+
+            const auto pairCount { data.value_count() / 2 };
+            const auto frameCount{ sourceSize / stride };
+            const auto laneMask  { stride - 1 }; //< stride is a power of 2
+            assert(pairCount > 0); assert(frameCount > 0);
+
+            std::array<sample_type*, MaxChannelCountT> targets{ };
+            for (size_type ch = 0; ch < stride; ++ch) {
+                targets[ch] = data.channel_data_for_update(ch).data();
+            }
+
+            sample_type laneLo[LaneCount], laneHi[LaneCount];
+            std::array<sample_type, MaxChannelCountT> lo{ }, hi{ };
+            for (size_type p = 0; p < pairCount; ++p) {
+                const auto begin{ (p * frameCount) / pairCount };
+                const auto end  { std::max(((p + 1) * frameCount) / pairCount, begin + 1) };
+                const auto count{ (end - begin) * stride };
+                const sample_type* bin{ source + begin * stride };
+
+                for (size_type ch = 0; ch < stride; ++ch) {
+                    lo[ch] = hi[ch] = bin[ch];
+                }
+
+                size_type i{ 0 };
+                if (count >= LaneCount) {
+                    for (size_type l = 0; l < LaneCount; ++l) {
+                        laneLo[l] = laneHi[l] = bin[l];
+                    }
+                    for (i = LaneCount; i + LaneCount <= count; i += LaneCount) {
+                        for (size_type l = 0; l < LaneCount; ++l) {
+                            const auto v{ bin[i + l] };
+                            laneLo[l] = (v < laneLo[l]) ? v : laneLo[l];
+                            laneHi[l] = (laneHi[l] < v) ? v : laneHi[l];
+                        }
+                    }
+                    for (size_type l = 0; l < LaneCount; ++l) {
+                        const auto ch{ l & laneMask };
+                        lo[ch] = (laneLo[l] < lo[ch]) ? laneLo[l] : lo[ch];
+                        hi[ch] = (hi[ch] < laneHi[l]) ? laneHi[l] : hi[ch];
+                    }
+                }
+                for (; i < count; ++i) {
+                    const auto ch{ i & laneMask };
+                    const auto v { bin[i] };
+                    lo[ch] = (v < lo[ch]) ? v : lo[ch];
+                    hi[ch] = (hi[ch] < v) ? v : hi[ch];
+                }
+
+                for (size_type ch = 0; ch < stride; ++ch) {
+                    auto* pair{ targets[ch] + p * 2 };
+                    if (transform) {
+                        // Transform need not be monotonic
+                        const auto tlo{ transform(ch, lo[ch]) };
+                        const auto thi{ transform(ch, hi[ch]) };
+                        pair[0] = std::min(tlo, thi);
+                        pair[1] = std::max(tlo, thi);
+                    } else {
+                        pair[0] = lo[ch];
+                        pair[1] = hi[ch];
+                    }
+                }
+            }
+        }
+
+        //--------------------------------------------------
+
         template <typename TransformT>
-        static auto update(channels_type& channels,
+        static auto update(sample_data_type& data,
                            const sample_type* source,
                            size_type sourceSize,
                            size_type stride,
-                           TransformT transform) {
-            const auto channelCount{ channels.channel_count() };
-            auto maxCount{ std::min(channelCount, stride) };
+                           TransformT transform,
+                           bool bCombine,
+                           bool bEnvelope = false,
+                           ResampleQuality eQuality = ResampleQuality::CubicHermite) {
+            const auto channelCount{ data.channel_count() };
+            const auto maxCount{ std::min(channelCount, stride) };
+
+            data.begin_update();
+
             size_type ch{ 0 };
+            if (bEnvelope && maxCount == stride &&
+                (channels_util_type::LaneCount % stride) == 0) {
+                this_type::envelope_interleaved(data, source, sourceSize, stride, transform);
+                ch = maxCount;
+            }
             while (ch < maxCount) {
                 if (transform) {
                     channels_util_type::update(
-                        channels[ch],
+                        data.channel_data_for_update(ch),
                         source, sourceSize, stride,
                         [ch,&transform](sample_type s)
                             -> sample_type {
                             return transform(ch, s);
-                        }
+                        },
+                        bEnvelope, eQuality
                     );
                 } else {
                     channels_util_type::update(
-                        channels[ch],
-                        source, sourceSize, stride
+                        data.channel_data_for_update(ch),
+                        source, sourceSize, stride,
+                        nullptr, bEnvelope, eQuality
                     );
                 }
                 ++ch;
@@ -256,11 +460,170 @@ namespace Audio::Samples::detail {
             }
             const auto cUpdated{ ch };
             while (ch < channelCount) {
-                channels[ch].zero();
+                auto samples{ data.channel_data_for_update(ch) };
+                ::util::zero_n(samples.data(), samples.size());
                 ++ch;
             }
+
+            if (bCombine && cUpdated > 0) {
+                this_type::combine(data, cUpdated);
+            } else {
+                auto combined{ data.combined_data_for_update() };
+                ::util::zero_n(combined.data(), combined.size());
+            }
+
+            data.end_update();
             return cUpdated;
         }
+
+        //--------------------------------------------------
+        // `update_combined`:
+        // ------------------
+        //
+        // Used when only the combined data is wanted: gives
+        // exactly the combined row `update` would (the same
+        // operations in the same order, so bit for bit, for
+        // any transform) without writing the channel rows.
+        //
+        // Binning, by far the most common case, reads every
+        // channel in a single pass over the interleaved
+        // source (see `bin_combined`), as do envelopes when
+        // `envelope_interleaved` can be used. Anything else
+        // is processed a channel at a time through `scratch`,
+        // caller provided so repeated updates don't allocate.
+        template <typename TransformT>
+        static auto update_combined(sample_data_type& data,
+                                    const sample_type* source,
+                                    size_type sourceSize,
+                                    size_type stride,
+                                    TransformT transform,
+                                    sample_buffer_type& scratch,
+                                    bool bEnvelope = false,
+                                    ResampleQuality eQuality = ResampleQuality::CubicHermite) {
+            assert(stride > 0);
+            const auto channelCount{ std::min(data.channel_count(), stride) };
+            const auto frameCount  { sourceSize / stride };
+
+            data.begin_update();
+
+            auto combined{ data.combined_data_for_update() };
+            ::util::zero_n(combined.data(), combined.size());
+            if (channelCount == 0 || frameCount < 2 || combined.size() == 0) {
+                // Nothing to show
+            } else if (!bEnvelope && frameCount > combined.size()) {
+                this_type::bin_combined(combined, source, frameCount, stride, channelCount, transform);
+            } else if (bEnvelope && channelCount == stride &&
+                       (channels_util_type::LaneCount % stride) == 0) {
+                // Single pass, through the channel rows as in
+                // `update` (they are cleared again below)
+                this_type::envelope_interleaved(data, source, sourceSize, stride, transform);
+                this_type::combine(data, channelCount);
+            } else {
+                // As `combine`
+                const auto channelWeight{ static_cast<sample_type>(1.) / static_cast<sample_type>(channelCount) };
+                scratch.resize(combined.size());
+                for (size_type ch = 0; ch < channelCount; ++ch) {
+                    if (transform) {
+                        channels_util_type::update(
+                            sample_span_type{ scratch },
+                            source + ch, sourceSize, stride,
+                            [ch,&transform](sample_type s)
+                                -> sample_type {
+                                return transform(ch, s);
+                            },
+                            bEnvelope, eQuality
+                        );
+                    } else {
+                        channels_util_type::update(
+                            sample_span_type{ scratch },
+                            source + ch, sourceSize, stride,
+                            nullptr, bEnvelope, eQuality
+                        );
+                    }
+                    for (size_type s = 0; s < combined.size(); ++s) {
+                        combined[s] += scratch[s] * channelWeight;
+                    }
+                }
+            }
+
+            for (size_type ch = 0; ch < data.channel_count(); ++ch) {
+                auto samples{ data.channel_data_for_update(ch) };
+                ::util::zero_n(samples.data(), samples.size());
+            }
+
+            data.end_update();
+            return (frameCount < 2 || combined.size() == 0) ? size_type{ 0 } : channelCount;
+        }
+
+    private:
+        //--------------------------------------------------
+        // `bin_combined`:
+        // ---------------
+        //
+        // `ChannelSamplesUtilImplT::bin_data` for every
+        // channel at once, each channel's bin then being
+        // transformed and averaged as `combine` does. The
+        // common layouts get a fixed channel count, so the
+        // per-channel sums can stay in registers.
+        template <typename TransformT>
+        static void bin_combined(sample_span_type& combined,
+                                 const sample_type* source,
+                                 size_type frameCount,
+                                 size_type stride,
+                                 size_type channelCount,
+                                 TransformT& transform) {
+            switch (channelCount) {
+                case 1:  this_type::bin_combined<1>(combined, source, frameCount, stride, 1, transform); break;
+                case 2:  this_type::bin_combined<2>(combined, source, frameCount, stride, 2, transform); break;
+                case 6:  this_type::bin_combined<6>(combined, source, frameCount, stride, 6, transform); break;
+                default: this_type::bin_combined<MaxChannelCountT>(combined, source, frameCount, stride, channelCount, transform); break;
+            }
+        }
+
+        template <size_type ChannelCountT, typename TransformT>
+        static void bin_combined(sample_span_type& combined,
+                                 const sample_type* source,
+                                 size_type frameCount,
+                                 size_type stride,
+                                 size_type channelCount,
+                                 TransformT& transform) {
+            assert(channelCount > 0 && channelCount <= ChannelCountT);
+            assert(frameCount > combined.size());
+            constexpr auto fracMax{ static_cast<sample_type>(1) };
+
+            const auto channelWeight      = static_cast<sample_type>(1.) / static_cast<sample_type>(channelCount);
+            const auto samplesPerBinExact = static_cast<sample_type>(frameCount) / static_cast<sample_type>(combined.size());
+            const auto samplesPerBinWhole = std::trunc(samplesPerBinExact);
+            const auto samplesPerBinFrac  = samplesPerBinExact - samplesPerBinWhole;
+            gsl_suppress(26467) // C26467: Converting from floating point to unsigned integral types results in non-portable code if the double/float has a negative value.
+            const auto samplesPerBin      = static_cast<size_type>(samplesPerBinWhole);
+            assert(samplesPerBin > 0);
+
+            sample_type frac{ 0 };
+            for (auto& bin : combined) {
+                // An extra sample is added, as in `bin_data`,
+                // whenever the fractional part carries
+                frac += samplesPerBinFrac;
+                const auto bExtra{ frac >= fracMax };
+                if (bExtra) { frac -= fracMax; }
+                const auto binFrames{ samplesPerBin + (bExtra ? 1 : 0) };
+                const auto divisor  { bExtra ? (samplesPerBinWhole + static_cast<sample_type>(1)) : samplesPerBinWhole };
+
+                sample_type acc[ChannelCountT];
+                for (size_type ch = 0; ch < channelCount; ++ch) { acc[ch] = 0; }
+                for (size_type f = 0; f < binFrames; ++f) {
+                    for (size_type ch = 0; ch < channelCount; ++ch) { acc[ch] += source[ch]; }
+                    source += stride;
+                }
+
+                sample_type sum{ 0 };
+                for (size_type ch = 0; ch < channelCount; ++ch) {
+                    const auto value{ acc[ch] / divisor };
+                    sum += (transform ? transform(ch, value) : value) * channelWeight;
+                }
+                bin = sum;
+            }
+        }
     }; // template <...> class SamplesUtilImplT final
 } // namespace Audio::Samples::detail
 
@@ -272,80 +635,29 @@ namespace Audio::Samples {
     //**************************************************************************
     template <
         typename SampleTypeT,
+        std::size_t MaxChannelCountT,
+        class AllocatorT,
         typename... ArgPackT
     >
-    inline void update_sample_data(::Audio::Samples::InterpolatedChannelDataT<SampleTypeT>& channel,
-                                   ArgPackT&& ...argpack) {
-        using util_type = Audio::Samples::detail::SampleDataUtilImplT<SampleTypeT>;
-        util_type::update(channel, source, std::forward<ArgPackT>(argpack)...);
-    }
-
-    //--------------------------------------------------------------------------
-
-    template <
-        typename SampleTypeT,
-        std::size_t CountT,
-        typename... ArgPackT
-    >
-    inline auto update_sample_data(::Audio::Samples::InterpolatedChannelsT<SampleTypeT, CountT>& channels,
+    inline auto update_sample_data(::Audio::Samples::SampleDataT<SampleTypeT, MaxChannelCountT, AllocatorT>& data,
                                    ArgPackT&& ...argpack) {
-        using util_type = ::Audio::Samples::detail::SamplesUtilImplT<SampleTypeT, CountT>;
-        return util_type::update(channels, std::forward<ArgPackT>(argpack)...);
+        using util_type = ::Audio::Samples::detail::SamplesUtilImplT<SampleTypeT, MaxChannelCountT, AllocatorT>;
+        return util_type::update(data, std::forward<ArgPackT>(argpack)...);
     }
 
     //--------------------------------------------------------------------------
 
     template <
         typename SampleTypeT,
-        std::size_t CountT,
+        std::size_t MaxChannelCountT,
+        class AllocatorT,
         typename... ArgPackT
     >
-    inline auto update_sample_data(Samples::SampleDataT<SampleTypeT, CountT>& channels,
-                                   ArgPackT&& ...argpack) {
-        using util_type = Samples::detail::SamplesUtilImplT<SampleTypeT, CountT>;
-        return util_type::update(channels.channel_data(), std::forward<ArgPackT>(argpack)...);
-    }
-
-    //**************************************************************************
-    // get_combined_samples
-    //**************************************************************************
-    template <
-        typename SampleTypeT,
-        std::size_t CountT
-    >
-    inline [[nodiscard]]
-    auto get_combined_samples(const ::Audio::Samples::InterpolatedChannelsT<SampleTypeT, CountT>& channels,
-                              std::size_t channelCount = CountT) {
-        using sample_type        = typename Samples::InterpolatedChannelsT<SampleTypeT, CountT>::sample_type;
-        using sample_buffer_type = typename Samples::InterpolatedChannelsT<SampleTypeT, CountT>::sample_buffer_type;
-        using size_type          = typename Samples::InterpolatedChannelsT<SampleTypeT, CountT>::size_type;
-
-        channelCount = std::min(channelCount, channels.channel_count());
-        const auto channelWeight = static_cast<sample_type>(1.) / static_cast<sample_type>(channelCount);
-        const auto sampleCount   = channels.channel_value_count();
-        sample_buffer_type combinedSamples{};
-        combinedSamples.resize(sampleCount, 0);
-        for (size_type ch = 0; ch < channelCount; ++ch) {
-            const auto& channelSamples = channels.samples_next(ch);
-            for (size_type s = 0; s < sampleCount; ++s) {
-                combinedSamples[s] += channelSamples[s] * channelWeight;
-            }
-        }
-        return combinedSamples;
-    }
-
-    //--------------------------------------------------------------------------
-
-    template <
-        typename SampleTypeT,
-        std::size_t CountT
-    >
-    inline [[nodiscard]]
-    decltype(auto) get_combined_samples(const ::Audio::Samples::SampleDataT<SampleTypeT, CountT>& channels,
-                                        std::size_t channelCount = CountT) {
-        return ::Audio::Samples::get_combined_samples(channels.channel_data(),
-                                                      channelCount);
+    inline auto update_combined_sample_data(::Audio::Samples::SampleDataT<SampleTypeT, MaxChannelCountT, AllocatorT>& data,
+                                            ArgPackT&& ...argpack) {
+        using util_type = ::Audio::Samples::detail::SamplesUtilImplT<SampleTypeT, MaxChannelCountT, AllocatorT>;
+        return util_type::update_combined(data, std::forward<ArgPackT>(argpack)...);
     }
 } // namespace Audio::Samples
 
-#endif // GUID_CA6B910B_3B48_4B75_AD8F_85C6147FECA1
\ No newline at end of file
+#endif // GUID_CA6B910B_3B48_4B75_AD8F_85C6147FECA1
@@ -0,0 +1,277 @@
+#pragma once
+#ifndef GUID_E5C47604_EEEC_44BE_8C1C_78439DD2EAC8
+#define GUID_E5C47604_EEEC_44BE_8C1C_78439DD2EAC8
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <limits>
+//--------------------------------------
+
+namespace Audio::Samples {
+    //**************************************************************************
+    // TriggerMode
+    //**************************************************************************
+    enum class TriggerMode : std::uint8_t {
+        None,       //< Most recent window (free running)
+        RisingEdge, //< Latest rising zero crossing (with hysteresis)
+        PeriodLock, //< Best match against a reference window
+    }; // enum class TriggerMode
+
+    //**************************************************************************
+    // TriggerT
+    //**************************************************************************
+    //
+    // Picks where an oscilloscope window starts within a
+    // longer block of recent audio so that periodic signals
+    // are drawn at the same phase every update, rather than
+    // drifting with the update timing.
+    //
+    // * `RisingEdge`: the latest point at which the (channel
+    //   averaged) signal rises through `Level` having first
+    //   fallen below `Level - Hysteresis`.
+    // * `PeriodLock`: the window position with the highest
+    //   normalised cross correlation against a reference
+    //   window is chosen. The block is first decimated to at
+    //   most `ScanCount` points to find roughly where the
+    //   best match is; the position is then refined at full
+    //   resolution against the `ReferenceCount` frames at
+    //   the centre of the reference, over one decimated point
+    //   either side. Tones too high to survive decimation
+    //   still lock, as that span always holds a whole period.
+    //   The reference is only replaced when either match
+    //   weakens, so a steady signal can't drift; when there
+    //   is no good match the edge trigger is used instead.
+    //
+    // With `ScanCount` fixed the coarse search costs at most
+    // `(ScanCount - ReferenceCount) * ReferenceCount`
+    // multiply-adds whatever the block length; refining
+    // reads `(2 * decimation + 1) * ReferenceCount` frames.
+    // All state is fixed size; `find` does not allocate.
+    template <typename SampleTypeT>
+    class TriggerT final {
+    private:
+        using this_type = TriggerT<SampleTypeT>;
+
+    public:
+        using sample_type = SampleTypeT;
+        using size_type   = std::size_t;
+
+        inline static constexpr const size_type   ReferenceCount{ 256 };
+        inline static constexpr const size_type   ScanCount     { ReferenceCount * 2 };
+        inline static constexpr const sample_type Level         { 0 };
+        inline static constexpr const sample_type Hysteresis    { static_cast<sample_type>(.02) };
+
+    private:
+        inline static constexpr const sample_type RefreshCorrelation{ static_cast<sample_type>(.9) }; //< Replace reference below this
+        inline static constexpr const sample_type MinCorrelation    { static_cast<sample_type>(.5) }; //< Use edge trigger below this
+
+    public:
+        void reset() noexcept {
+            m_nReferenceCount = 0;
+            m_nFineCount      = 0;
+            m_nDecimation     = 0;
+        }
+
+        //--------------------------------------------------
+        // `source` is `frameCount` frames of `stride`
+        // interleaved channels. Returns the first frame of a
+        // `windowFrames` long window, in
+        // [0, `frameCount - windowFrames`].
+        size_type find(TriggerMode eMode,
+                       const sample_type* source,
+                       size_type frameCount,
+                       size_type stride,
+                       size_type windowFrames) noexcept {
+            assert(source || frameCount == 0);
+            assert(stride > 0);
+            windowFrames = std::min(windowFrames, frameCount);
+            const auto lastStart{ frameCount - windowFrames };
+            if (lastStart == 0) { return 0; }
+
+            switch (eMode) {
+                case TriggerMode::RisingEdge:
+                    return this_type::rising_edge(source, stride, lastStart);
+                case TriggerMode::PeriodLock:
+                    return this_type::period_lock(source, frameCount, stride, windowFrames);
+                case TriggerMode::None:
+                default:
+                    return lastStart;
+            }
+        }
+
+    private:
+        [[nodiscard]]
+        static sample_type mono(const sample_type* source,
+                                size_type frame,
+                                size_type stride) noexcept {
+            const auto* s{ source + frame * stride };
+            sample_type acc{ 0 };
+            for (size_type ch = 0; ch < stride; ++ch) { acc += s[ch]; }
+            return acc / static_cast<sample_type>(stride);
+        }
+
+        // Latest qualifying crossing in [1, lastStart], or
+        // `lastStart` (free running) if there is none
+        static size_type rising_edge(const sample_type* source,
+                                     size_type stride,
+                                     size_type lastStart) noexcept {
+            size_type start{ lastStart };
+            bool bArmed{ this_type::mono(source, 0, stride) < Level - Hysteresis };
+            for (size_type i = 1; i <= lastStart; ++i) {
+                const auto value{ this_type::mono(source, i, stride) };
+                if (value < Level - Hysteresis) {
+                    bArmed = true;
+                } else if (bArmed && value >= Level) {
+                    bArmed = false;
+                    start  = i;
+                }
+            }
+            return start;
+        }
+
+        size_type period_lock(const sample_type* source,
+                              size_type frameCount,
+                              size_type stride,
+                              size_type windowFrames) noexcept {
+            const auto lastStart{ frameCount - windowFrames };
+
+            // Box filter decimation (also the anti-alias filter)
+            const auto decimation{ std::max<size_type>((frameCount + ScanCount - 1) / ScanCount, 1) };
+            const auto scanCount { frameCount / decimation };
+            const auto refCount  { std::min(windowFrames / decimation, ReferenceCount) };
+            const auto fineCount { std::min(windowFrames, ReferenceCount) };
+            const auto fineOffset{ (windowFrames - fineCount) / 2 };
+            const auto lastScan  { lastStart / decimation };
+            {
+                const auto scale{ static_cast<sample_type>(1) / static_cast<sample_type>(decimation * stride) };
+                const auto* s{ source };
+                for (size_type k = 0; k < scanCount; ++k) {
+                    sample_type acc{ 0 };
+                    for (const auto* e{ s + decimation * stride }; s != e; ++s) { acc += *s; }
+                    m_Scan[k] = acc * scale;
+                }
+            }
+            if (refCount < 2 || lastScan == 0) {
+                return this_type::rising_edge(source, stride, lastStart);
+            }
+
+            const auto capture = [this, source, stride, refCount, fineCount, fineOffset, decimation](size_type start) noexcept {
+                const auto first{ start / decimation };
+                std::copy_n(m_Scan.data() + first, refCount, m_Reference.data());
+                m_fReferenceEnergy = 0;
+                for (size_type j = 0; j < refCount; ++j) { m_fReferenceEnergy += m_Reference[j] * m_Reference[j]; }
+                m_fFineEnergy = 0;
+                for (size_type j = 0; j < fineCount; ++j) {
+                    m_Fine[j] = this_type::mono(source, start + fineOffset + j, stride);
+                    m_fFineEnergy += m_Fine[j] * m_Fine[j];
+                }
+                m_nReferenceCount = refCount;
+                m_nFineCount      = fineCount;
+                m_nDecimation     = decimation;
+                return start;
+            };
+            const auto edge = [&]() noexcept {
+                return capture(this_type::rising_edge(source, stride, lastStart));
+            };
+
+            // Reference must be at the same resolution
+            constexpr const auto epsilon{ std::numeric_limits<sample_type>::epsilon() };
+            if (m_nReferenceCount != refCount || m_nFineCount != fineCount ||
+                m_nDecimation != decimation || m_fFineEnergy <= epsilon) {
+                return edge();
+            }
+
+            // Coarse: normalised cross correlation of the
+            // decimated block; window energy is a running sum.
+            // A reference with (next to) no energy left after
+            // decimation scores nothing anywhere, so the latest
+            // position is refined.
+            size_type   bestScan  { lastScan };
+            sample_type coarseScore{ 1 };
+            if (m_fReferenceEnergy > epsilon) {
+                sample_type energy{ 0 };
+                for (size_type j = 0; j < refCount; ++j) { energy += m_Scan[j] * m_Scan[j]; }
+                sample_type bestScore{ -2 };
+                for (size_type k = 0; k <= lastScan; ++k) {
+                    if (k > 0) {
+                        const auto outgoing{ m_Scan[k - 1] };
+                        const auto incoming{ m_Scan[k + refCount - 1] };
+                        energy += incoming * incoming - outgoing * outgoing;
+                    }
+                    sample_type dot{ 0 };
+                    const auto* s{ m_Scan.data() + k };
+                    for (size_type j = 0; j < refCount; ++j) { dot += s[j] * m_Reference[j]; }
+                    const auto norm { std::sqrt(std::max(energy, static_cast<sample_type>(0)) * m_fReferenceEnergy) };
+                    const auto score{ (norm > epsilon) ? dot / norm : static_cast<sample_type>(0) };
+                    if (score >= bestScore) { // Prefer the latest of equals
+                        bestScore = score;
+                        bestScan  = k;
+                    }
+                }
+                coarseScore = bestScore;
+            }
+
+            // Fine: every frame within a decimated point of
+            // the coarse match, at full resolution
+            const auto coarse{ bestScan * decimation };
+            const auto first { (coarse > decimation) ? (coarse - decimation) : size_type{ 0 } };
+            const auto last  { std::min(coarse + decimation, lastStart) };
+            size_type   start{ last };
+            sample_type bestScore{ -2 };
+            for (size_type i = first; i <= last; ++i) {
+                sample_type dot{ 0 }, energy{ 0 };
+                for (size_type j = 0; j < fineCount; ++j) {
+                    const auto value{ this_type::mono(source, i + fineOffset + j, stride) };
+                    dot    += value * m_Fine[j];
+                    energy += value * value;
+                }
+                const auto norm { std::sqrt(energy * m_fFineEnergy) };
+                const auto score{ (norm > epsilon) ? dot / norm : static_cast<sample_type>(0) };
+                if (score >= bestScore) { // Prefer the latest of equals
+                    bestScore = score;
+                    start     = i;
+                }
+            }
+            if (bestScore < MinCorrelation) { return edge(); }
+            return (std::min(bestScore, coarseScore) < RefreshCorrelation) ? capture(start) : start;
+        }
+
+    private:
+        std::array<sample_type, ScanCount>      m_Scan            { };
+        std::array<sample_type, ReferenceCount> m_Reference       { }; //< Decimated
+        std::array<sample_type, ReferenceCount> m_Fine            { }; //< Full resolution (channel averaged)
+        sample_type                             m_fReferenceEnergy{ 0 };
+        sample_type                             m_fFineEnergy     { 0 };
+        size_type                               m_nReferenceCount { 0 };
+        size_type                               m_nFineCount      { 0 };
+        size_type                               m_nDecimation     { 0 };
+    }; // template <...> class TriggerT final
+} // namespace Audio::Samples
+
+#endif // GUID_E5C47604_EEEC_44BE_8C1C_78439DD2EAC8
@@ -54,6 +54,11 @@
 //       support for monochrome is not required. The main issue is access to
 //       the pixel data, which for modern OpenGL is relatively easy and
 //       relatively fast.
+//
+// Each frame is drawn in full, but only the area it changed from the last
+// (see `Invalidate`) is read back, converted and handed on; the rest of the
+// frame data is left as it was cleared, so consumers must keep their copy of
+// the previous frame.
 //==============================================================================
 
 //--------------------------------------
@@ -80,6 +85,25 @@
 #include "ColorBlend.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include "Util/BitPlane.h"
+#include "Util/FrameCopy.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
+#include "GL/glprogramcache.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+//--------------------------------------
+
 namespace {
     static constexpr const auto* const s_szWindowName{ TEXT("foo_logitech_lcd canvas") };
     static constexpr const auto* const s_szClassName { TEXT("foo_logitech_lcd canvas class") };
@@ -87,6 +111,13 @@ namespace {
     //--------------------------------------------------------------------------
 
     Windows::UI::WindowClass g_WindowClass{};
+
+    //--------------------------------------------------------------------------
+
+    // Per frame decay of a persisting trail, as the 10% of
+    // the background a blended trail clears to each frame
+    static constexpr const auto TrailDecay{ ::util::persistence::to_decay(.9f) };
+
 } // namespace <anonymous>
 
 //==============================================================================
@@ -122,7 +153,8 @@ namespace Windows {
     void Canvas::Initialise(_In_ coord_type iWidth,
                             _In_ coord_type iHeight,
                             _In_ BYTE cColorBits,
-                            _In_ bool bTryUseGLWindow) {
+                            _In_ bool bTryUseGLWindow,
+                            _In_ bool bTryUseFramebuffer) {
         Uninitialise();
 
         InitialiseDebugCanvas({ iWidth , iHeight });
@@ -133,7 +165,10 @@ namespace Windows {
 
         InitialiseBitmapCanvas(iWidth, iHeight, cColorBits);
 
-        InitialiseOpenGL();
+        InitialiseOpenGL(bTryUseFramebuffer);
+
+        m_PendingRect = {};
+        Invalidate();
     }
 
     //--------------------------------------------------------------------------
@@ -206,9 +241,11 @@ namespace Windows {
      * manually.
      *
      * In contrast to the Window Canvas, the color depth is set appropriate
-     * for the output, so monochrome output uses single bytes for pixels.
-     * When copying from the Window Canvas, Windows will do an automatic
-     * conversion of the pixels.
+     * for the output. Monochrome output with a Window Canvas uses a single
+     * bit per pixel (see `util::bit_plane`): GDI draws to it directly and
+     * the OpenGL pixels are packed into it. Without a Window Canvas OpenGL
+     * needs to draw to the Bitmap Canvas, which it can't at one bit per
+     * pixel, so single bytes are used and packed at the end of the frame.
      *
      * NOTE:
      *  - The GDI co-ordinate system and color channel order are different
@@ -243,11 +280,16 @@ namespace Windows {
                                         PFD_SUPPORT_GDI |
                                         PFD_DEPTH_DONTCARE |
                                         PFD_DOUBLEBUFFER_DONTCARE;
-        auto canvas = (cColorBits == 1)
-            ? bitmap_canvas::CreateMonochrome(srcDC, bmWidth,
-                                              bmHeight, pfdFlags)
-            : bitmap_canvas::Create(srcDC, bmWidth, bmHeight,
-                                    pfdFlags, cColorBits);
+        auto canvas = (cColorBits == 1 && m_WindowCanvas)
+            ? bitmap_canvas::CreatePacked(srcDC, bmWidth, bmHeight)
+            : bitmap_canvas{};
+        if (!canvas) {
+            canvas = (cColorBits == 1)
+                ? bitmap_canvas::CreateMonochrome(srcDC, bmWidth,
+                                                  bmHeight, pfdFlags)
+                : bitmap_canvas::Create(srcDC, bmWidth, bmHeight,
+                                        pfdFlags, cColorBits);
+        }
         WinAPIAssert(canvas);
         if (canvas) {
             CDCHandle dc{ canvas.GetDeviceContext() };
@@ -279,6 +321,11 @@ namespace Windows {
                                                            m_BitmapCanvas.GetHeight(),
                                                            data.data());
                     m_pGDIClearImage->SetTargetDC(m_BitmapCanvas);
+
+                    if (m_BitmapCanvas.IsMonochrome() && !m_BitmapCanvas.IsPacked()) {
+                        m_PackedPixels.resize(::util::bit_plane::byte_size(m_BitmapCanvas.GetWidth(),
+                                                                           m_BitmapCanvas.GetHeight()));
+                    }
                 }
             }
         }
@@ -293,7 +340,7 @@ namespace Windows {
      * Initialise and configure OpenGL. Much of the configuration is not really
      * required, but harmless to set and ensures everything is in a known state.
      */
-    void Canvas::InitialiseOpenGL() {
+    void Canvas::InitialiseOpenGL(_In_ bool bTryUseFramebuffer) {
         // HACK:
         //  - glew provides no way to "un-initialise" which is a problem since
         //    changing between hardware and software means changing OpenGL
@@ -301,6 +348,8 @@ namespace Windows {
         //    to false before initialisation.
         __GLEW_ARB_texture_non_power_of_two = GL_FALSE;
         __GLEW_ARB_texture_rectangle        = GL_FALSE;
+        __GLEW_ARB_vertex_buffer_object     = GL_FALSE;
+        __GLEW_EXT_multi_draw_arrays        = GL_FALSE;
 
         const auto err = ::glewInit();
         if (err != GLEW_OK) {
@@ -321,7 +370,7 @@ namespace Windows {
             // Very likely no hardware does **not** support
             // PBOs anymore, but check anyway
             if (GLEW_ARB_pixel_buffer_object) {
-                m_PixelBufferObject.create(m_WindowCanvas.GetColorByteSize(),
+                m_PixelBufferObject.create(GetReadbackByteSize(),
                                            GL_STREAM_READ_ARB);
             } else {
                 m_PixelBufferObject.destroy();
@@ -335,7 +384,21 @@ namespace Windows {
             // the PBO that would otherwise be used).
             if (!m_PixelBufferObject) {
                 SPDLOG_INFO("Warning: OpenGL Pixel Buffer Object could not be created 'Hardware Accelerated Mode' may be slow!");
-                m_OpenGLPixels.resize(m_WindowCanvas.GetColorByteSize());
+                m_OpenGLPixels.resize(GetReadbackByteSize());
+            }
+
+            if (m_BitmapCanvas.IsPacked()) {
+                // Read back as luminance with each colour channel
+                // mapped to 0 or 1 by its top bit (luminance is the
+                // clamped sum of the channels): a pixel is then set
+                // exactly when any channel has its top bit set, as
+                // with 32-bit pixels, for a quarter of the data
+                std::array<GLushort, 256> channelMap{};
+                std::fill(channelMap.begin() + channelMap.size() / 2, channelMap.end(), GLushort{ 0xFFFF });
+                ::glPixelMapusv(GL_PIXEL_MAP_R_TO_R, static_cast<GLsizei>(channelMap.size()), channelMap.data());
+                ::glPixelMapusv(GL_PIXEL_MAP_G_TO_G, static_cast<GLsizei>(channelMap.size()), channelMap.data());
+                ::glPixelMapusv(GL_PIXEL_MAP_B_TO_B, static_cast<GLsizei>(channelMap.size()), channelMap.data());
+                OpenGLAssertNoError();
             }
 
             ::glHint(GL_FOG_HINT                   , GL_NICEST);
@@ -343,6 +406,10 @@ namespace Windows {
             ::glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
             ::glHint(GL_POINT_SMOOTH_HINT          , GL_NICEST);
             ::glHint(GL_POLYGON_SMOOTH_HINT        , GL_NICEST);
+
+            if (bTryUseFramebuffer) {
+                InitialiseFramebuffer();
+            }
         } else {
             ::glHint(GL_FOG_HINT                   , GL_FASTEST);
             ::glHint(GL_LINE_SMOOTH_HINT           , GL_FASTEST);
@@ -392,6 +459,68 @@ namespace Windows {
         return;
     }
 
+    //--------------------------------------------------------------------------
+
+    /*
+     * InitialiseFramebuffer
+     * ---------------------
+     *
+     * Render to a texture of exactly the canvas size rather than to the
+     * Window Canvas, which is only needed for the render context (and whose
+     * pixels OpenGL need not even keep, the window being hidden).
+     *
+     * For a packed canvas a final pass over that texture produces the bit
+     * plane itself (see `OpenGL::glBitPlanePacker`), at the layout of the
+     * Bitmap Canvas, so it is read straight into it with no conversion on
+     * the CPU and a 32nd of the data read back as BGRA. Colour is still
+     * read back as BGRA: the alpha fix up in `EndFrame` is for what GDI
+     * draws afterwards, so can't move here.
+     *
+     * Anything unsupported leaves rendering to the Window Canvas (or the
+     * packing to the CPU).
+     */
+    void Canvas::InitialiseFramebuffer() {
+        if (!::OpenGL::glFramebuffer::is_supported() ||
+            !(GLEW_VERSION_2_0 || GLEW_ARB_texture_non_power_of_two)) {
+            SPDLOG_INFO("OpenGL framebuffer objects unsupported, rendering to the window");
+            return;
+        }
+
+        const auto width { static_cast<GLsizei>(m_BitmapCanvas.GetWidth()) };
+        const auto height{ static_cast<GLsizei>(m_BitmapCanvas.GetHeight()) };
+
+        const auto createTarget = [](gl_texture& texture,
+                                     gl_framebuffer& framebuffer,
+                                     GLsizei w, GLsizei h) {
+            texture.create(GL_TEXTURE_2D, GL_RGBA8, w, h, 0,
+                           GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            if (!texture) { return false; }
+            {
+                // Read back texel for texel, never filtered
+                const auto bind_{ texture.scoped_bind(GL_TEXTURE_2D) };
+                gl_texture::parameter(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                gl_texture::parameter(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            }
+            return framebuffer.create(texture);
+        };
+
+        if (!createTarget(m_SceneTexture, m_SceneFramebuffer, width, height)) {
+            SPDLOG_INFO("Failed to create OpenGL framebuffer, rendering to the window");
+            UninitialiseFramebuffer();
+            return;
+        }
+
+        if (m_BitmapCanvas.IsPacked() && gl_packer::is_supported() &&
+            !m_BitPlanePacker.create(width, height)) {
+            SPDLOG_INFO("Failed to create OpenGL packing pass, packing on the CPU");
+        }
+
+        // Stays bound: everything is drawn offscreen
+        m_SceneFramebuffer.bind();
+        ::glViewport(0, 0, width, height);
+        OpenGLAssertNoError();
+    }
+
     //--------------------------------------------------------------------------
     // Uninitialise
     //--------------------------------------------------------------------------
@@ -418,15 +547,35 @@ namespace Windows {
             m_PixelBufferObject.destroy();
         }
 
+        UninitialiseFramebuffer();
+
+        ::OpenGL::glVertexBatch::instance().destroy();
+        ::OpenGL::glProgramCache::instance().destroy();
+
         if (!m_OpenGLPixels.empty()) {
             m_OpenGLPixels.clear();
         }
 
+        if (!m_TrailPixels.empty()) {
+            m_TrailPixels.clear();
+        }
+
         UninitialiseRenderContext();
     };
 
     //--------------------------------------------------------------------------
 
+    void Canvas::UninitialiseFramebuffer() noexcept {
+        if (m_SceneFramebuffer) {
+            ::OpenGL::glFramebuffer::unbind();
+        }
+        m_BitPlanePacker.destroy();
+        m_SceneFramebuffer.destroy();
+        m_SceneTexture.destroy();
+    }
+
+    //--------------------------------------------------------------------------
+
     void Canvas::UninitialiseRenderContext() noexcept {
         if (m_RenderContext) {
             m_RenderContext.Destroy();
@@ -449,6 +598,9 @@ namespace Windows {
         if (m_pGDIClearImage) {
             m_pGDIClearImage.reset();
         }
+        if (!m_PackedPixels.empty()) {
+            m_PackedPixels.clear();
+        }
         if (m_BitmapCanvas) {
             m_BitmapCanvas.Destroy();
         }
@@ -462,7 +614,8 @@ namespace Windows {
 
         const auto glFGColor{ m_glFGColor };
         auto glBGColor{ m_glBGColor };
-        if (m_bTransparentClears) {
+        const bool bBlendedTrail{ IsBlendedTrail() };
+        if (bBlendedTrail) {
             ::glEnable(GL_BLEND);
             ::glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             // BUG: The alpha needs adjusted depending on current frame rate
@@ -496,7 +649,7 @@ namespace Windows {
                                     m_iWallpaperX1, m_iWallpaperY1,
                                     glBGColor.a());
         } else {
-            if (m_bTransparentClears && m_ImageMode == ImageMode::None) {
+            if (bBlendedTrail && m_ImageMode == ImageMode::None) {
                 ::glColor4f(glBGColor.r(), glBGColor.g(),
                             glBGColor.b(), glBGColor.a());
                 ::glRecti(0, 0, canvasWidth, canvasHeight);
@@ -505,12 +658,13 @@ namespace Windows {
             } else {
                 // If m_ImageMode == ImageMode::GDI then the OpenGL buffer
                 // is cleared as the contents are not needed even if there
-                // are transparent clears
+                // are transparent clears (as is the case for a persisting
+                // trail, which is kept separately)
                 ::glClear(GL_COLOR_BUFFER_BIT);
             }
         }
 
-        if (m_bTransparentClears) {
+        if (bBlendedTrail) {
             ::glBlendFunc(GL_ONE, GL_ZERO);
             ::glDisable(GL_BLEND);
         }
@@ -524,7 +678,7 @@ namespace Windows {
         // BUG: The alpha needs adjusted depending on current frame rate
         //      (although this is a really shit way of doing this effect
         //       anyway, so probably worth just doing it "properly")
-        const std::uint8_t alpha = m_bTransparentClears ? 25 : 255; //< 25 ~~ 10%
+        const std::uint8_t alpha = IsBlendedTrail() ? 25 : 255; //< 25 ~~ 10%
         if (m_ImageMode == ImageMode::GDI) {
             if (m_pGDIClearImage && m_iWallpaperX0 != 0) {
                 m_pGDIClearImage->DrawBlendAuto(0, 0,
@@ -544,7 +698,7 @@ namespace Windows {
             m_pImage->DrawBlendAuto(m_iWallpaperX0, m_iWallpaperY0,
                                     m_iWallpaperX1, m_iWallpaperY1,
                                     alpha);
-        } else if (!m_WindowCanvas && m_bTransparentClears) {
+        } else if (!m_WindowCanvas && IsBlendedTrail()) {
             m_pGDIClearImage->DrawBlendAuto(0, 0,
                                             canvasWidth, canvasHeight,
                                             alpha);
@@ -562,6 +716,15 @@ namespace Windows {
     //--------------------------------------------------------------------------
 
     void Canvas::StartFrame() noexcept {
+        // Trails change every pixel they cover every frame
+        const auto canvasWidth = m_BitmapCanvas.GetWidth();
+        const auto canvasHeight = m_BitmapCanvas.GetHeight();
+        m_DirtyRect = (m_bInvalidateAll || m_bTransparentClears)
+            ? dirty_rect::all(canvasWidth, canvasHeight)
+            : m_PendingRect;
+        m_PendingRect    = {};
+        m_bInvalidateAll = false;
+
         // Clear
         // - Only clear using OpenGL if there are two canvases,
         //   the GDI clear will do the work if there is only
@@ -585,9 +748,6 @@ namespace Windows {
         //   frame has little cost and ensures the frame always starts
         //   with the same settings.
 
-        const auto canvasWidth = m_BitmapCanvas.GetWidth();
-        const auto canvasHeight = m_BitmapCanvas.GetHeight();
-
         { // GDI
             WinAPIVerify(::SetViewportOrgEx(m_BitmapCanvas, 0, 0, NULL));
             WinAPIVerify(::SetViewportExtEx(m_BitmapCanvas,
@@ -616,8 +776,13 @@ namespace Windows {
             } else {
                 ::glColor4f(m_glFGColor.r(), m_glFGColor.g(), m_glFGColor.b(), 1.f);
                 //::glRecti(0, 0, canvasWidth, canvasHeight);
-                ::glClearColor(m_glBGColor.r(), m_glBGColor.g(),
-                               m_glBGColor.b(), 0.f);
+                if (IsPersistentTrail()) {
+                    // Premultiplied, as the trail accumulates it
+                    ::glClearColor(0.f, 0.f, 0.f, 0.f);
+                } else {
+                    ::glClearColor(m_glBGColor.r(), m_glBGColor.g(),
+                                   m_glBGColor.b(), 0.f);
+                }
             }
         }
     }
@@ -631,19 +796,42 @@ namespace Windows {
     void Canvas::EndPass(RenderPass pass) noexcept {
         switch (pass) {
             case RenderPass::OpenGL: {
+                ::OpenGL::glVertexBatch::instance().flush();
                 ::glFlush();
-                if (m_WindowCanvas) {
-                    constexpr const GLenum glPixelFormat = GL_BGRA;
+                if (!m_DirtyRect) {
+                    // Nothing to read back
+                } else if (m_WindowCanvas && CanPackOnGPU()) {
+                    PackFramebufferToBitmap();
+                } else if (m_WindowCanvas) {
+                    const bool bPacked{ m_BitmapCanvas.IsPacked() };
+                    const GLenum glPixelFormat = bPacked ? GL_LUMINANCE : GL_BGRA;
                     constexpr const GLenum glPixelType = GL_UNSIGNED_BYTE;
                     const auto width = m_WindowCanvas.GetWidth();
-                    const auto height = m_WindowCanvas.GetHeight();
+
+                    // Only changed rows (canvas rows are GL rows, see
+                    // `StartFrame`); packing works on whole frames
+                    const auto rowTop   { bPacked ? 0 : m_DirtyRect.top };
+                    const auto rowCount { bPacked ? m_WindowCanvas.GetHeight() : m_DirtyRect.height() };
+                    const auto rowOffset{ static_cast<std::size_t>(rowTop) * GetReadbackStride() };
+
+                    // Thresholding uses the channel maps (see `InitialiseOpenGL`);
+                    // dithering needs the grey levels, so read back luma instead
+                    // (GL_LUMINANCE is otherwise the clamped sum of R, G and B)
+                    const bool bDither{ bPacked && m_DitherMethod != ::util::dither::method::threshold };
+                    const ::OpenGL::glScopedPushAttrib _attrib{ GL_PIXEL_MODE_BIT };
+                    ::glPixelTransferi(GL_MAP_COLOR, (bPacked && !bDither) ? GL_TRUE : GL_FALSE);
+                    if (bDither) {
+                        ::glPixelTransferf(GL_RED_SCALE  , .299f);
+                        ::glPixelTransferf(GL_GREEN_SCALE, .587f);
+                        ::glPixelTransferf(GL_BLUE_SCALE , .114f);
+                    }
                     if (m_PixelBufferObject) {
                         m_PixelBufferObject.bind();
-                        ::glReadPixels(0, 0,
-                                       width, height,
+                        ::glReadPixels(0, rowTop,
+                                       width, rowCount,
                                        glPixelFormat,
                                        glPixelType,
-                                       0);
+                                       reinterpret_cast<GLvoid*>(rowOffset));
                         OpenGLAssertNoError();
                         GLvoid* pBits{ nullptr };
                         m_PixelBufferObject.map(pBits, GL_READ_ONLY_ARB);
@@ -654,11 +842,11 @@ namespace Windows {
                         m_PixelBufferObject.unbind();
                     } else {
                         WinAPIAssert(!m_OpenGLPixels.empty());
-                        ::glReadPixels(0, 0,
-                                       width, height,
+                        ::glReadPixels(0, rowTop,
+                                       width, rowCount,
                                        glPixelFormat,
                                        glPixelType,
-                                       m_OpenGLPixels.data());
+                                       m_OpenGLPixels.data() + rowOffset);
                         OpenGLAssertNoError();
                         WindowBitsToBitmap(m_OpenGLPixels.data());
                     }
@@ -679,7 +867,8 @@ namespace Windows {
 
     //--------------------------------------------------------------------------
 
-    void* Canvas::EndFrame() noexcept {
+    void* Canvas::EndFrame(void* pTarget,
+                           const dirty_rect& stale) noexcept {
         if (!m_BitmapCanvas) {
             return NULL;
         }
@@ -707,15 +896,44 @@ namespace Windows {
             If migrating to OpenGL for all rendering (GDI is currently used only
             for text) then this is not necessary and should be removed.
         */
-        if (!m_BitmapCanvas.IsMonochrome()) {
-            DWORD* pSrc = static_cast<DWORD*>(pBits);
-            for (auto i = 0; i < m_BitmapCanvas.GetPixelCount(); ++i) {
-                (*pSrc++) |= 0xFF000000;
+        auto&      rect{ m_DirtyRect };
+        const auto width{ m_BitmapCanvas.GetWidth() };
+        if (pTarget && !m_BitmapCanvas.IsMonochrome()) {
+            // The frame is finished, so the alpha is set on the way
+            // to its destination rather than in place and copied
+            // after. Rows that come out the same as were there
+            // narrow the dirty rect (to nothing if none changed).
+            rect = ::util::frame::copy_opaque(static_cast<const std::uint32_t*>(pBits),
+                                              static_cast<std::uint32_t*>(pTarget),
+                                              width,
+                                              rect,
+                                              stale.clipped(width, m_BitmapCanvas.GetHeight()));
+            pBits = pTarget;
+        } else if (!m_BitmapCanvas.IsMonochrome()) {
+            DWORD* pRow = static_cast<DWORD*>(pBits) + rect.top * width + rect.left;
+            for (auto row = rect.top; row < rect.bottom; ++row) {
+                DWORD* pSrc = pRow;
+                for (auto i = 0; i < rect.width(); ++i) {
+                    (*pSrc++) |= 0xFF000000;
+                }
+                pRow += width;
             }
+        } else if (!m_BitmapCanvas.IsPacked()) {
+            // Monochrome output is always packed, but OpenGL
+            // drew straight to this canvas so it couldn't be
+            // (changed rows only)
+            const auto srcStride{ m_BitmapCanvas.GetColorStride() };
+            const auto dstStride{ ::util::bit_plane::stride(width) };
+            ::util::bit_plane::pack(static_cast<const std::uint8_t*>(pBits) + rect.top * srcStride,
+                                    srcStride,
+                                    m_PackedPixels.data() + rect.top * dstStride,
+                                    width,
+                                    rect.height());
+            pBits = m_PackedPixels.data();
         }
 
         UpdateDebugCanvas(m_BitmapCanvas.GetDimensions(),
-                          m_BitmapCanvas.GetColorBitsPerPixel(),
+                          m_BitmapCanvas.IsMonochrome() ? 1 : m_BitmapCanvas.GetColorBitsPerPixel(),
                           pBits);
         return pBits;
     }
@@ -731,6 +949,7 @@ namespace Windows {
         if (m_pImage) {
             m_pImage.reset();
         }
+        Invalidate(); //< Also covers `SetWallpaper`
     }
 
     //--------------------------------------------------------------------------
@@ -823,6 +1042,7 @@ namespace Windows {
         }
 
         m_FGColor = color;
+        Invalidate();
         ::Color::PackedColor32ui::ABGR::Unpack(m_FGColor,
                                                m_glFGColor);
         m_glFGColor.a(1.f);
@@ -865,6 +1085,7 @@ namespace Windows {
         }
 
         m_BGColor = color;
+        Invalidate();
         ::Color::PackedColor32ui::ABGR::Unpack(m_BGColor,
                                                m_glBGColor);
         m_glBGColor.a(0.f);
@@ -883,6 +1104,19 @@ namespace Windows {
 
     //--------------------------------------------------------------------------
 
+    void Canvas::SetTrailMode(trail_mode eMode) {
+        m_TrailMode = eMode;
+        Invalidate();
+        if (eMode != trail_mode::blend && m_WindowCanvas && IsColor()) {
+            m_TrailPixels.assign(static_cast<std::size_t>(m_BitmapCanvas.GetPixelCount()), 0);
+        } else {
+            m_TrailPixels.clear();
+            m_TrailPixels.shrink_to_fit();
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
     bool Canvas::IsValid() noexcept {
         return (m_BitmapCanvas || m_WindowCanvas) && m_RenderContext;
     }
@@ -892,57 +1126,86 @@ namespace Windows {
     //--------------------------------------------------------------------------
 
     void Canvas::WindowBitsToBitmap(void* pBits) noexcept {
+        if (m_BitmapCanvas.IsPacked()) {
+            if (m_DitherMethod == ::util::dither::method::threshold) {
+                // Already thresholded on read back (0x00 or 0xFF)
+                ::util::bit_plane::pack(static_cast<const std::uint8_t*>(pBits),
+                                        GetReadbackStride(),
+                                        static_cast<std::uint8_t*>(m_BitmapCanvas.GetBitmapBits()),
+                                        m_BitmapCanvas.GetWidth(),
+                                        m_BitmapCanvas.GetHeight());
+            } else {
+                // Grey (luma) on read back
+                m_Ditherer(m_DitherMethod,
+                           static_cast<const std::uint8_t*>(pBits),
+                           GetReadbackStride(),
+                           static_cast<std::uint8_t*>(m_BitmapCanvas.GetBitmapBits()),
+                           m_BitmapCanvas.GetWidth(),
+                           m_BitmapCanvas.GetHeight());
+            }
+            return;
+        }
+
+        // Only what changed (whole rows for monochrome)
+        const auto& rect  { m_DirtyRect };
+        const auto  width { m_BitmapCanvas.GetWidth() };
+        const auto  offset{ static_cast<std::size_t>(rect.top) * width };
+
         if (m_BitmapCanvas.IsMonochrome()) {
-            auto* pSrc{ static_cast<const std::uint32_t*>(pBits) };
-            auto* pDst{ static_cast<std::uint8_t*>(m_BitmapCanvas.GetBitmapBits()) };
-            for (auto pixel = 0; pixel < m_BitmapCanvas.GetPixelCount(); ++pixel) {
+            auto* pSrc{ static_cast<const std::uint32_t*>(pBits) + offset };
+            auto* pDst{ static_cast<std::uint8_t*>(m_BitmapCanvas.GetBitmapBits()) + offset };
+            for (auto pixel = 0; pixel < rect.height() * width; ++pixel) {
                 // if top bit is set in _any_ component, pixel is
                 // considered "set" otherwise "unset"
                 *pDst++ = (*pSrc++ & 0x00808080) ? 0xFF : 0x00;
             }
-        } else if (m_ImageMode == ImageMode::GDI) {
-            if (m_bTransparentClears) {
-                // FIXME: This is not really the best way to deal with this:
-                //        software alpha blending will be pretty slow for larger
-                //        screens. However, this code is not likely to be used
-                //        (requires a hardware OpenGL that does not support
-                //         suitable image formats _and_ using transparent
-                //         clears).
-                //
-                // NOTE: There is a GDI blending function that
-                //       might be useful here.
-                auto* pSrc{ static_cast<const std::uint32_t*>(pBits) };
-                auto* pDst{ static_cast<std::uint32_t*>(m_BitmapCanvas.GetBitmapBits()) };
-                for (auto pixel = 0; pixel < m_BitmapCanvas.GetPixelCount(); ++pixel) {
-                    const auto src4ub{ Color::PackedColor32ui::ABGR::Unpack<Color::Color4ub>(*pSrc) };
-                    if (src4ub.a() == Color::Color4ub::ChannelMax) {
-                        *pDst = *pSrc;
-                    } else if (src4ub.a() > Color::Color4ub::ChannelMin) {
-                        const auto src{ Color::color_cast<Color::Color4f>(src4ub) };
-                        const auto dst{ Color::PackedColor32ui::ABGR::Unpack<Color::Color4f>(*pDst) };
-                        const auto blend{ Color::ColorAlphaBlend(src, dst) };
-                        *pDst = Color::PackedColor32ui::ABGR::Pack(blend);
+        } else if (IsPersistentTrail()) {
+            // Always the whole frame (see `StartFrame`)
+            assert(rect.covers(width, m_BitmapCanvas.GetHeight()));
+            // The frame (cleared to transparent black, see `StartFrame`)
+            // goes into the trail, which then goes over the background
+            // (colour or wallpaper) already in the bitmap
+            const auto count{ static_cast<std::size_t>(m_BitmapCanvas.GetPixelCount()) };
+            ::util::persistence::accumulate(m_TrailMode,
+                                            static_cast<const std::uint32_t*>(pBits),
+                                            m_TrailPixels.data(),
+                                            count,
+                                            TrailDecay);
+            ::util::persistence::composite(m_TrailPixels.data(),
+                                           static_cast<std::uint32_t*>(m_BitmapCanvas.GetBitmapBits()),
+                                           count);
+        } else {
+            const auto* pSrc{ static_cast<const std::uint32_t*>(pBits) + offset + rect.left };
+            auto*       pDst{ static_cast<std::uint32_t*>(m_BitmapCanvas.GetBitmapBits()) + offset + rect.left };
+            const auto  count{ static_cast<std::size_t>(rect.width()) };
+            for (auto row = rect.top; row < rect.bottom; ++row) {
+                if (m_ImageMode != ImageMode::GDI) {
+                    std::memcpy(pDst, pSrc, count * sizeof(*pDst));
+                } else if (m_bTransparentClears) {
+                    ::util::persistence::blend(pSrc, pDst, count);
+                } else {
+                    for (std::size_t pixel = 0; pixel < count; ++pixel) {
+                        if (pSrc[pixel] & 0xFF000000) { pDst[pixel] = pSrc[pixel]; }
                     }
-                    ++pDst;
-                    ++pSrc;
-                }
-            } else {
-                auto* pSrc = static_cast<const std::uint32_t*>(pBits);
-                auto* pDst = static_cast<std::uint32_t*>(m_BitmapCanvas.GetBitmapBits());
-                for (auto pixel = 0; pixel < m_BitmapCanvas.GetPixelCount(); ++pixel) {
-                    if (*pSrc & 0xFF000000) { *pDst = *pSrc; }
-                    ++pDst;
-                    ++pSrc;
                 }
+                pSrc += width;
+                pDst += width;
             }
-        } else {
-            std::memcpy(m_BitmapCanvas.GetBitmapBits(),
-                        pBits, m_BitmapCanvas.GetColorByteSize());
         }
     }
 
     //--------------------------------------------------------------------------
 
+    void Canvas::PackFramebufferToBitmap() noexcept {
+        // Rows of the bit plane are GL rows, as canvas rows
+        // are (see `StartFrame`)
+        m_BitPlanePacker.pack(m_SceneTexture,
+                              m_DitherMethod == ::util::dither::method::bayer,
+                              m_BitmapCanvas.GetBitmapBits());
+    }
+
+    //--------------------------------------------------------------------------
+
     LRESULT Canvas::WindowProc(_In_ HWND hWnd,
                                _In_ UINT uMsg,
                                _In_ WPARAM wParam,
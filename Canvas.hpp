@@ -29,7 +29,10 @@
 
 //--------------------------------------
 //
+#include "Util/DirtyRect.h"
+#include "Util/Dither.h"
 #include "Util/FlagEnum.h"
+#include "Util/Persistence.h"
 #include "Util/Singleton.h"
 //--------------------------------------
 
@@ -42,7 +45,10 @@
 //--------------------------------------
 //
 #include "GL/wglcore.h"
+#include "GL/glbitplane.h"
 #include "GL/glbuffer.h"
+#include "GL/glframebuffer.h"
+#include "GL/gltexture.h"
 //--------------------------------------
 
 //--------------------------------------
@@ -82,6 +88,12 @@ namespace Windows {
         using gl_color_type   = ::Color::Color4f;
         using gl_pixel_buffer = ::OpenGL::glPixelPackBuffer;
         using gl_pixel_data   = std::vector<std::uint8_t>;
+        using trail_mode      = ::util::persistence::mode;
+        using trail_data      = std::vector<::util::persistence::pixel_type>;
+        using dirty_rect      = ::util::dirty_rect;
+        using gl_texture      = ::OpenGL::glTexture;
+        using gl_framebuffer  = ::OpenGL::glFramebuffer;
+        using gl_packer       = ::OpenGL::glBitPlanePacker;
 
     public:
         Canvas() = delete;
@@ -108,7 +120,8 @@ namespace Windows {
         void Initialise(_In_ coord_type iWidth,
                         _In_ coord_type iHeight,
                         _In_ BYTE cColorBits,
-                        _In_ bool bTryUseGLWindow);
+                        _In_ bool bTryUseGLWindow,
+                        _In_ bool bTryUseFramebuffer = false);
         void Uninitialise() noexcept;
 
         bool IsValid() noexcept;
@@ -116,7 +129,11 @@ namespace Windows {
         void  StartFrame() noexcept;
         void  StartPass (RenderPass pass) noexcept;
         void  EndPass   (RenderPass pass) noexcept;
-        void* EndFrame  () noexcept;
+        // Returns the finished frame: in place, or written to
+        // `pTarget` (a colour frame of the same size, holding
+        // the last but for `stale`, which is rewritten) if given
+        void* EndFrame  (void* pTarget = nullptr,
+                         const dirty_rect& stale = {}) noexcept;
 
 
         void SetWallpaper(const image_data& image,
@@ -126,7 +143,35 @@ namespace Windows {
         void SetFGColor(color_type color) noexcept;
         void SetBGColor(color_type color) noexcept;
 
-        void SetTransparentClears(bool bEnable) noexcept { m_bTransparentClears = bEnable; }
+        void SetTransparentClears(bool bEnable) noexcept {
+            if (m_bTransparentClears != bEnable) {
+                m_bTransparentClears = bEnable;
+                Invalidate();
+            }
+        }
+
+        // Persisting trails only apply to a colour, hardware canvas
+        // without an OpenGL wallpaper; otherwise trails blend
+        void SetTrailMode(trail_mode eMode);
+
+        // Only applies to a packed (monochrome, hardware) canvas
+        void SetDitherMethod(::util::dither::method eMethod) noexcept { m_DitherMethod = eMethod; }
+
+        // What the next frame changes from the last: all of it,
+        // or `rect` (merged with anything else invalidated)
+        void Invalidate() noexcept { m_bInvalidateAll = true; }
+        void Invalidate(const dirty_rect& rect) noexcept {
+            m_PendingRect.merge(rect.clipped(GetWidth(), GetHeight()));
+        }
+
+        // Whether the next frame will differ from the last
+        constexpr bool IsDirty() const noexcept {
+            return m_bInvalidateAll || m_bTransparentClears || !m_PendingRect.empty();
+        }
+
+        // Area the current frame changed (fixed at `StartFrame`);
+        // `EndFrame` data is only valid within it
+        constexpr const auto& GetDirtyRect() const noexcept { return m_DirtyRect; }
 
         decltype(auto) GetDC() const noexcept { return m_BitmapCanvas.GetDeviceContext(); }
 
@@ -138,6 +183,9 @@ namespace Windows {
 
         constexpr auto HasWallpaper() const noexcept { return m_ImageMode != ImageMode::None; }
 
+        // OpenGL renders offscreen (see `InitialiseFramebuffer`)
+        constexpr auto IsOffscreen() const noexcept { return static_cast<bool>(m_SceneFramebuffer); }
+
         constexpr auto GetFGColor() const noexcept { return m_FGColor; }
         constexpr auto GetBGColor() const noexcept { return m_BGColor; }
 
@@ -149,10 +197,12 @@ namespace Windows {
         void InitialiseBitmapCanvas (_In_ coord_type iWidth,
                                      _In_ coord_type iHeight,
                                      _In_ BYTE cColorBits);
-        void InitialiseOpenGL       ();
+        void InitialiseOpenGL       (_In_ bool bTryUseFramebuffer);
+        void InitialiseFramebuffer  ();
         void InitialiseRenderContext(_In_ HDC dc) noexcept;
 
         void UninitialiseOpenGL       () noexcept;
+        void UninitialiseFramebuffer  () noexcept;
         void UninitialiseRenderContext() noexcept;
         void UninitialiseBitmapCanvas () noexcept;
         void UninitialiseWindowCanvas () noexcept;
@@ -162,15 +212,67 @@ namespace Windows {
 
         void WindowBitsToBitmap(void* pBits) noexcept;
 
+        // Trail kept in `m_TrailPixels` rather than by
+        // partially clearing the render target
+        constexpr auto IsPersistentTrail() const noexcept {
+            return m_bTransparentClears &&
+                   m_TrailMode != trail_mode::blend &&
+                   !m_TrailPixels.empty() &&
+                   m_ImageMode != ImageMode::OpenGL;
+        }
+
+        constexpr auto IsBlendedTrail() const noexcept {
+            return m_bTransparentClears && !IsPersistentTrail();
+        }
+
+        // The packing pass handles thresholding and ordered
+        // dithering; error diffusion is serial so stays on
+        // the CPU
+        constexpr auto CanPackOnGPU() const noexcept {
+            return m_BitPlanePacker &&
+                   (m_DitherMethod == ::util::dither::method::threshold ||
+                    m_DitherMethod == ::util::dither::method::bayer);
+        }
+
+        void PackFramebufferToBitmap() noexcept;
+
+        // Bytes per row read back from OpenGL: one per pixel
+        // for a packed canvas, otherwise BGRA (rows are 4 byte
+        // aligned, the default GL_PACK_ALIGNMENT)
+        constexpr auto GetReadbackStride() const noexcept {
+            return m_BitmapCanvas.IsPacked()
+                ? (m_WindowCanvas.GetWidth() + 3) & ~3
+                : m_WindowCanvas.GetWidth() * 4;
+        }
+
+        constexpr auto GetReadbackByteSize() const noexcept {
+            return GetReadbackStride() * m_WindowCanvas.GetHeight();
+        }
+
     private:
         bool m_bTransparentClears{ false };
 
+        ::util::dither::method   m_DitherMethod{ ::util::dither::method::threshold };
+        ::util::dither::ditherer m_Ditherer    {};
+
+        trail_mode m_TrailMode  { trail_mode::blend };
+        trail_data m_TrailPixels{}; //< Premultiplied
+
+        dirty_rect m_DirtyRect     {}; //< Current frame
+        dirty_rect m_PendingRect   {}; //< Next frame
+        bool       m_bInvalidateAll{ true };
+
     private:
         window_canvas   m_WindowCanvas     {};
         bitmap_canvas   m_BitmapCanvas     {};
         render_context  m_RenderContext    {};
         gl_pixel_buffer m_PixelBufferObject{};
         gl_pixel_data   m_OpenGLPixels     {};
+        gl_pixel_data   m_PackedPixels     {}; //< Monochrome canvas that isn't packed
+
+        gl_texture      m_SceneTexture       {};
+        gl_framebuffer  m_SceneFramebuffer   {};
+        gl_packer       m_BitPlanePacker     {};
 
         color_type m_FGColor{ RGB(255, 255, 255) };
         color_type m_BGColor{ RGB(0, 0, 0) };
@@ -257,6 +257,10 @@ namespace {
                 for (auto i = (BitmapInfo256::ColorCount / 2); i < BitmapInfo256::ColorCount; ++i) {
                     bmi.bmiColors[i] = RGBQUAD{ 255, 255, 255, 0 };
                 }
+            } else if (cColorBits == 1) {
+                bmi.bmiHeader.biBitCount = 1; //< Packed, see `util::bit_plane`
+                bmi.bmiHeader.biClrUsed = 2;
+                bmi.bmiColors[1] = RGBQUAD{ 255, 255, 255, 0 };
             } else {
                 bmi.bmiHeader.biBitCount = cColorBits;
             }
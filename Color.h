@@ -49,7 +49,10 @@ namespace Color::detail {
         using base_type = std::array<ComponentT, CountT>;
 
     public:
-        using component_type = base_type::value_type;
+        using component_type = typename base_type::value_type;
+        using typename base_type::value_type;
+        using typename base_type::size_type;
+        using base_type::size;
 
     public:
         inline static constexpr const auto Count     { CountT };
@@ -161,6 +164,10 @@ namespace Color {
     template <typename ComponentT, std::size_t CountT>
     class ColorT {};
 
+    // Defined in "ColorCast.h"
+    template <typename TargetT, typename SourceT, std::size_t CountT>
+    inline constexpr decltype(auto) color_cast(const ::Color::ColorT<SourceT, CountT>& source) noexcept;
+
     //==========================================================================
 
     template <typename ComponentT>
@@ -168,7 +175,7 @@ namespace Color {
         public ::Color::detail::ColorCommonT<ComponentT, 1> {
     private:
         using this_type = ColorT<ComponentT, 1>;
-        using base_type = ColorCommonT<ComponentT, 1>;
+        using base_type = ::Color::detail::ColorCommonT<ComponentT, 1>;
 
     public:
         using typename base_type::component_type;
@@ -212,7 +219,7 @@ namespace Color {
         public ::Color::detail::ColorCommonT<ComponentT, 2> {
     private:
         using this_type = ColorT<ComponentT, 2>;
-        using base_type = ColorCommonT<ComponentT, 2>;
+        using base_type = ::Color::detail::ColorCommonT<ComponentT, 2>;
 
     public:
         using typename base_type::component_type;
@@ -256,7 +263,7 @@ namespace Color {
         public ::Color::detail::ColorCommonT<ComponentT, 3> {
     private:
         using this_type = ColorT<ComponentT, 3>;
-        using base_type = ColorCommonT<ComponentT, 3>;
+        using base_type = ::Color::detail::ColorCommonT<ComponentT, 3>;
 
     public:
         using typename base_type::component_type;
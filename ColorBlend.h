@@ -29,6 +29,16 @@
 #include "Util/TypeTraits.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+//--------------------------------------
+
 namespace Color {
     //**************************************************************************
     // ColorValueBlend
@@ -71,6 +81,93 @@ namespace Color {
         return result;
     }
 
+    //**************************************************************************
+    // ColorGradientT
+    //**************************************************************************
+    //
+    // `ColorBlend` between two colours baked into a table
+    // with an entry per pixel of the bar (or line) drawn
+    // with it, for drawing which would otherwise blend per
+    // vertex with colours which only change with the
+    // configuration. Entry `i` of `steps` is exactly
+    // `ColorBlend(c0, c1, i / steps)`, so colours match
+    // blending at the pixel a bar ends on; `operator()`
+    // rounds a blend value to a pixel as
+    // `SpectrumAnalyser::Util::Draw` does. Out of range
+    // pixels and blends are clamped to the ends.
+    template <typename ColorT>
+    class ColorGradientT final {
+    private:
+        using this_type = ColorGradientT<ColorT>;
+
+    public:
+        using color_type     = ColorT;
+        using component_type = typename color_type::component_type;
+        using float_type     = ::util::floating_point_type_t<component_type>;
+        using size_type      = std::size_t;
+        using table_type     = std::vector<color_type>;
+
+    public:
+        ColorGradientT() = default;
+
+        ColorGradientT(const color_type& c0,
+                       const color_type& c1,
+                       size_type steps) {
+            set(c0, c1, steps);
+        }
+
+    public:
+        void set(const color_type& c0,
+                 const color_type& c1,
+                 size_type steps) {
+            steps = std::max<size_type>(steps, 1);
+            m_Front  = c0;
+            m_Back   = c1;
+            m_fSteps = static_cast<float_type>(steps);
+            m_Table.resize(steps + 1);
+            for (size_type i = 0; i <= steps; ++i) {
+                m_Table[i] = ::Color::ColorBlend(c0, c1, static_cast<float_type>(i) / m_fSteps);
+            }
+        }
+
+        // Entry for pixel `index`
+        template <typename IndexT>
+        [[nodiscard]]
+        const color_type& operator[](IndexT index) const noexcept {
+            static_assert(std::is_integral_v<IndexT>, "Index must be integral");
+            assert(!m_Table.empty());
+            if constexpr (std::is_signed_v<IndexT>) {
+                if (index < 0) { return m_Table.front(); }
+            }
+            return m_Table[std::min(static_cast<size_type>(index), m_Table.size() - 1)];
+        }
+
+        // Entry for the pixel `blend` (in [0,1]) rounds to
+        template <typename BlendT>
+        [[nodiscard]]
+        const color_type& operator()(BlendT blend) const noexcept {
+            assert(!m_Table.empty());
+            const auto fBlend{ static_cast<float_type>(blend) };
+            // Written so NaN selects the first entry
+            if (!(fBlend > 0)) { return m_Table.front(); }
+            if (fBlend >= 1)   { return m_Table.back(); }
+            return m_Table[static_cast<size_type>(std::round(fBlend * m_fSteps))];
+        }
+
+        size_type steps() const noexcept { return m_Table.empty() ? 0 : m_Table.size() - 1; }
+
+        constexpr const color_type& front() const noexcept { return m_Front; }
+        constexpr const color_type& back () const noexcept { return m_Back; }
+
+    private:
+        color_type m_Front {};
+        color_type m_Back  {};
+        float_type m_fSteps{ 1 };
+        table_type m_Table {};
+    }; // template <...> class ColorGradientT final
+
+    using ColorGradient3f = ::Color::ColorGradientT<::Color::Color3f>;
+
     //**************************************************************************
     // ColorValueAlphaBlend
     //**************************************************************************
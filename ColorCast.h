@@ -30,6 +30,12 @@
 #include "Util/TypeTraits.h"
 //--------------------------------------
 
+namespace Color {
+    // Defined below, used by `ColorCastImplT`
+    template <typename TargetT, typename SourceT>
+    inline constexpr auto color_value_cast(SourceT val) noexcept;
+} // namespace Color
+
 namespace Color::detail {
     //**************************************************************************
     // ColorValueFloatCastT
@@ -159,7 +165,6 @@ namespace Color::detail {
     struct ColorCastImplT {
         template <typename SourceT, std::size_t CountT>
         static constexpr auto color_cast(const ::Color::ColorT<SourceT, CountT>& source) noexcept {
-            using source_type       = ::Color::ColorT<SourceT, CountT>;
             using target_type       = ::Color::ColorT<TargetT, CountT>;
             using target_value_type = typename target_type::value_type;
             using size_type         = typename target_type::size_type;
@@ -178,7 +183,6 @@ namespace Color::detail {
     struct ColorCastImplT<::Color::ColorT<TargetT, TargetCountT>> {
         template <typename SourceT, std::size_t SourceCountT>
         static constexpr auto color_cast(const ::Color::ColorT<SourceT, SourceCountT>& source) noexcept {
-            using source_type       = ::Color::ColorT<SourceT, SourceCountT>;
             using target_type       = ::Color::ColorT<TargetT, TargetCountT>;
             using target_value_type = typename target_type::value_type;
             using size_type         = typename target_type::size_type;
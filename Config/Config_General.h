@@ -66,6 +66,30 @@ SEQUENTIAL_NAMED_ENUM(AlbumArtType,
                                                     L"Any"));
 
 
+//******************************************************************************
+// DitherMode
+//******************************************************************************
+SEQUENTIAL_NAMED_ENUM(DitherMode,
+                      SEQUENTIAL_ENUM_VALUES(SEQUENTIAL_ENUM_FIRST(Threshold, 0),
+                                             Bayer,
+                                             FloydSteinberg,
+                                             Atkinson),
+                      SEQUENTIAL_NAMED_ENUM_STRINGS(L"None (Threshold)",
+                                                    L"Ordered (Bayer)",
+                                                    L"Floyd-Steinberg",
+                                                    L"Atkinson"));
+
+//******************************************************************************
+// TrailMode
+//******************************************************************************
+SEQUENTIAL_NAMED_ENUM(TrailMode,
+                      SEQUENTIAL_ENUM_VALUES(SEQUENTIAL_ENUM_FIRST(Blend, 0),
+                                             Max,
+                                             Additive),
+                      SEQUENTIAL_NAMED_ENUM_STRINGS(L"Blend",
+                                                    L"Persist (Max)",
+                                                    L"Persist (Additive)"));
+
 //******************************************************************************
 // VisualisationMode
 //******************************************************************************
@@ -134,7 +158,11 @@ namespace Config {
 
             bool            m_bPreferHardwareCanvas{ true  };
             bool            m_bUseTrailEffect      { false };
+            TrailMode       m_TrailMode            { TrailMode::Blend }; //< Persist modes: colour hardware canvas only
             WallpaperConfig m_Wallpaper            { };
+            DitherMode      m_DitherMode           { DitherMode::Threshold }; //< Monochrome only
+            bool            m_bOffscreenRendering  { false }; //< Hardware canvas only
+            bool            m_bGPUInterpolation    { false }; //< Hardware canvas only
         }; // struct CanvasConfig final
         //---------------------------------------
 
@@ -170,7 +198,7 @@ namespace Config {
         //---------------------------------------
 
     public:
-        inline static constexpr const version_type Version{ 1 };
+        inline static constexpr const version_type Version{ 5 };
 
     public:
         constexpr GeneralConfig() noexcept = default;
@@ -47,13 +47,26 @@ SEQUENTIAL_NAMED_ENUM(OscilloscopeType,
                                              LineMono,
                                              LineStereo,
                                              CircleMono,
-                                             StarBurstMono),
+                                             StarBurstMono,
+                                             GoniometerStereo),
                       SEQUENTIAL_NAMED_ENUM_STRINGS(L"Dot Oscilloscope (Mono)",
                                                     L"Dot Oscilloscope (Stereo)",
                                                     L"Line Oscilloscope (Mono)",
                                                     L"Line Oscilloscope (Stereo)",
                                                     L"Circle Oscilloscope (Mono)",
-                                                    L"StarBurst (Mono)"));
+                                                    L"StarBurst (Mono)",
+                                                    L"Goniometer (Stereo)"));
+
+//******************************************************************************
+// OscilloscopeTrigger
+//******************************************************************************
+SEQUENTIAL_NAMED_ENUM(OscilloscopeTrigger,
+                      SEQUENTIAL_ENUM_VALUES(SEQUENTIAL_ENUM_FIRST(Off, 0),
+                                             RisingEdge,
+                                             PeriodLock),
+                      SEQUENTIAL_NAMED_ENUM_STRINGS(L"Off",
+                                                    L"Rising Edge",
+                                                    L"Period Lock"));
 
 //==============================================================================
 
@@ -65,23 +78,26 @@ namespace Config {
     public:
         using config_type  = OscilloscopeConfig;
         using enum_type    = OscilloscopeType;
+        using trigger_type = OscilloscopeTrigger;
         using array_type   = std::array<config_type, enum_type::count()>;
 
         using version_type = std::uint32_t;
 
     public:
-        inline static constexpr const version_type Version{ 1 };
+        inline static constexpr const version_type Version{ 3 };
 
     public:
         constexpr OscilloscopeConfig() noexcept = default;
         constexpr OscilloscopeConfig(enum_type /*type*/) noexcept {}
 
     public:
-        bool        m_bEnabled  { true };
-        float       m_fScale    { 4.f };
-        float       m_fLineWidth{ 2.f };
-        float       m_fPointSize{ 2.f };
-        ColorConfig m_Color     { };
+        bool         m_bEnabled  { true };
+        float        m_fScale    { 4.f };
+        float        m_fLineWidth{ 2.f };
+        float        m_fPointSize{ 2.f };
+        bool         m_bEnvelope { false }; //< Min/max per column rather than average
+        trigger_type m_eTrigger  { trigger_type::Off }; //< Where each update's window starts
+        ColorConfig  m_Color     { };
 
     public:
         static const config_type& get(enum_type type);
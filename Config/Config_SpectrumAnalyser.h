@@ -53,6 +53,17 @@ SEQUENTIAL_NAMED_ENUM(SpectrumAnalyserMode,
                                                     L"Non-Linear 3",
                                                     L"Non-Linear 4"));
 
+//******************************************************************************
+// SpectrumAnalyserScale
+//******************************************************************************
+SEQUENTIAL_NAMED_ENUM(SpectrumAnalyserScale,
+                      SEQUENTIAL_ENUM_VALUES(SEQUENTIAL_ENUM_FIRST(Linear, 0),
+                                             ConstantQ12,
+                                             ConstantQ24),
+                      SEQUENTIAL_NAMED_ENUM_STRINGS(L"Linear (FFT)",
+                                                    L"Constant-Q (12/Octave)",
+                                                    L"Constant-Q (24/Octave)"));
+
 //******************************************************************************
 // SpectrumAnalyserType
 //******************************************************************************
@@ -60,11 +71,17 @@ SEQUENTIAL_NAMED_ENUM(SpectrumAnalyserType,
                       SEQUENTIAL_ENUM_VALUES(SEQUENTIAL_ENUM_FIRST(Mono, 0),
                                              MonoBlock,
                                              Stereo,
-                                             StereoBlock),
+                                             StereoBlock,
+                                             Spectrogram,
+                                             Chromagram,
+                                             Shader),
                       SEQUENTIAL_NAMED_ENUM_STRINGS(L"Spectrum Analyser (Mono)",
                                                     L"Block Spectrum Analyser (Mono)",
                                                     L"Spectrum Analyser (Stereo)",
-                                                    L"Block Spectrum Analyser (Stereo)"));
+                                                    L"Block Spectrum Analyser (Stereo)",
+                                                    L"Spectrogram (Mono)",
+                                                    L"Chromagram (Mono)",
+                                                    L"GLSL Shader (Mono)"));
 
 //==============================================================================
 
@@ -79,6 +96,7 @@ namespace Config {
         using array_type   = std::array<config_type, enum_type::count()>;
 
         using mode_type    = SpectrumAnalyserMode;
+        using scale_type   = SpectrumAnalyserScale;
         using version_type = std::uint32_t;
         using size_type    = std::uint32_t;
 
@@ -90,7 +108,7 @@ namespace Config {
         //---------------------------------------
 
     public:
-        inline static constexpr const version_type Version{ 1 };
+        inline static constexpr const version_type Version{ 2 };
 
     public:
         SpectrumAnalyserConfig() noexcept = default;
@@ -105,6 +123,7 @@ namespace Config {
         PeakConfig  m_Peak        { };
         ColorConfig m_Color       { };
         BlockConfig m_Block       { };
+        scale_type  m_Scale       { scale_type::Linear }; //< Frequency axis
 
     public:
         static const config_type& get(enum_type type);
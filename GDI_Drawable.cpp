@@ -45,6 +45,7 @@ namespace Windows::GDI {
     void CDrawable::Color(_In_ Layer eLayer,
                           _In_ COLORREF color) {
         if (m_Layer[static_cast<int>(eLayer)].Color(color)) {
+            Invalidate();
             OnChanged(GDIChange::Color,
                       (LPARAM)(eLayer),
                       (WPARAM)(color));
@@ -56,6 +57,7 @@ namespace Windows::GDI {
     void CDrawable::Brush(_In_ Layer eLayer,
                           _In_ HBRUSH hBrush) {
         if (m_Layer[static_cast<int>(eLayer)].Brush(hBrush)) {
+            Invalidate();
             OnChanged(GDIChange::Brush,
                       (LPARAM)(eLayer),
                       (WPARAM)(hBrush));
@@ -67,6 +69,7 @@ namespace Windows::GDI {
     void CDrawable::Pen(_In_ Layer eLayer,
                         _In_ HPEN hPen) {
         if (m_Layer[static_cast<int>(eLayer)].Pen(hPen)) {
+            Invalidate();
             OnChanged(GDIChange::Pen,
                       (LPARAM)(eLayer),
                       (WPARAM)(hPen));
@@ -78,6 +81,7 @@ namespace Windows::GDI {
     void CDrawable::PenWidth(_In_ Layer eLayer,
                              _In_ int nWidth) {
         if (m_Layer[static_cast<int>(eLayer)].PenWidth(nWidth)) {
+            Invalidate();
             OnChanged(GDIChange::PenWidth,
                       (LPARAM)(eLayer),
                       (WPARAM)(nWidth));
@@ -89,6 +93,7 @@ namespace Windows::GDI {
     void CDrawable::SetPosition(_In_ POINT pos) {
         if (m_Position.x != pos.x || m_Position.y != pos.y) {
             m_Position = pos;
+            Invalidate();
             OnChanged(GDIChange::Position,
                       (LPARAM)pos.x, (WPARAM)pos.y);
         }
@@ -99,6 +104,7 @@ namespace Windows::GDI {
     void CDrawable::SetSize(_In_ SIZE size) {
         if (m_Size.cx != size.cx || m_Size.cy != size.cy) {
             m_Size = size;
+            Invalidate();
             OnChanged(GDIChange::Size,
                       (LPARAM)size.cx, (WPARAM)size.cy);
         }
@@ -110,6 +116,7 @@ namespace Windows::GDI {
         if (m_Clip.left  != rect.left  || m_Clip.top    != rect.top ||
             m_Clip.right != rect.right || m_Clip.bottom != rect.bottom) {
             m_Clip = rect;
+            Invalidate();
             gsl_suppress(26447) // C26447: The function is declared 'noexcept' but calls function '...' which may throw exceptions (f.6).
             m_Region = ::CreateRectRgn(m_Clip.left, m_Clip.top,
                                        m_Clip.right, m_Clip.bottom);
@@ -121,6 +128,16 @@ namespace Windows::GDI {
 
     //------------------------------------------------------
 
+    RECT CDrawable::GetDrawRect() const noexcept {
+        if (!::IsRectEmpty(&m_Clip)) { return m_Clip; }
+        return RECT{ m_Position.x,
+                     m_Position.y,
+                     m_Position.x + m_Size.cx,
+                     m_Position.y + m_Size.cy };
+    }
+
+    //------------------------------------------------------
+
     void CDrawable::Draw(_In_ float fInterp) {
         ScopedSetBkMode       _bkMode{ m_DC, TRANSPARENT };
         ScopedSetBkColor      _bkColor{ m_DC, Color(Layer::Background) };
@@ -134,6 +151,21 @@ namespace Windows::GDI {
         OnDraw(fInterp);
         PopClip();
         PopViewport();
+
+        m_DrawnRect     = GetDrawRect();
+        m_bInvalid      = false;
+        m_bWasAnimating = IsAnimating();
+    }
+
+    //------------------------------------------------------
+
+    RECT CDrawable::GetDirtyRect() const noexcept {
+        // Includes where it was last drawn in case it moved
+        RECT rect{ GetDrawRect() };
+        if (!::IsRectEmpty(&m_DrawnRect)) {
+            ::UnionRect(&rect, &rect, &m_DrawnRect);
+        }
+        return rect;
     }
 
     //------------------------------------------------------
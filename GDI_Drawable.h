@@ -207,6 +207,13 @@ namespace Windows::GDI {
 
         virtual void OnDebugDraw() throw();
 
+        // Something `OnDraw` depends on has changed
+        constexpr void Invalidate() noexcept { m_bInvalid = true; }
+
+        // Drawing changes from one `Draw` to the next without
+        // being invalidated (e.g. while scrolling)
+        virtual bool IsAnimating() const noexcept { return false; }
+
     public:
         static void Flush() throw() { WinAPIVerify(::GdiFlush()); }
 
@@ -280,6 +287,15 @@ namespace Windows::GDI {
 
         constexpr void EnableClipping(BOOL bClip) throw() { m_bUseClipping = bClip; }
 
+        // Whether the next `Draw` will differ from the last;
+        // if so, only within `GetDirtyRect` (device units),
+        // provided drawing keeps within `Clip` (or the bounds
+        // when there is no clip)
+        bool IsDirty() const noexcept {
+            return m_bInvalid || m_bWasAnimating || IsAnimating();
+        }
+        RECT GetDirtyRect() const noexcept;
+
     public:
         gsl_suppress(26447) // C26447: The function is declared 'noexcept' but calls function '...' which may throw exceptions (f.6).
         BOOL DrawRect(_In_ INT iLeft, _In_ INT iTop,
@@ -352,7 +368,13 @@ namespace Windows::GDI {
         RECT  m_Clip       { 0, 0, 0, 0 };
         BOOL m_bUseClipping{ TRUE };
 
+        RECT m_DrawnRect    { 0, 0, 0, 0 }; //< Area of the last `Draw`
+        bool m_bInvalid     { true };
+        bool m_bWasAnimating{ false }; //< Last `Draw`, so the frame it stops is redrawn
+
     private:
+        RECT GetDrawRect() const noexcept;
+
         template <class T>
         static auto SimpleArrayPop(CSimpleArray<T>& array) {
             const auto last = array.GetSize() - 1;
@@ -47,7 +47,16 @@ namespace Windows::GDI {
 
     void CProgressBar::Update(_In_ float fProgress) {
         if (m_Progress.Current(fProgress)) {
+            // Most updates move neither the fill nor the text
+            const auto    iFillRight{ m_FillRect.right };
+            const CString strLeft   { m_Text[TextLeft].m_strText };
+            const CString strRight  { m_Text[TextRight].m_strText };
             UpdateProgress();
+            if ((m_FillRect.right != iFillRight) ||
+                (m_Text[TextLeft].m_strText  != strLeft) ||
+                (m_Text[TextRight].m_strText != strRight)) {
+                Invalidate();
+            }
         }
     }
 
@@ -246,6 +255,7 @@ namespace Windows::GDI {
 
         m_FillRect = m_OutlineRect;
         UpdateProgress();
+        Invalidate();
     }
 
     //--------------------------------------------------------------------------
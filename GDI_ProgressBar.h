@@ -140,7 +140,9 @@ namespace Windows::GDI {
         bool SetFont(_In_z_ LPCTSTR szFamily,
                      _In_ int iHeight);
 
-        constexpr void SetClear(_In_ bool bClear) noexcept { m_bClear = bClear; }
+        constexpr void SetClear(_In_ bool bClear) noexcept {
+            if (m_bClear != bClear) { m_bClear = bClear; Invalidate(); }
+        }
 
     private:
         virtual void OnDraw(float fInterp) noexcept override;
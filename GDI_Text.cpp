@@ -110,6 +110,7 @@ namespace Windows::GDI {
         if (m_eHAlign == eAlign) { return; }
         m_eHAlign = eAlign;
         for (auto& line: m_Lines) { line.SetHAlign(m_eHAlign); }
+        Invalidate();
     }
 
     //--------------------------------------------------------------------------
@@ -126,6 +127,7 @@ namespace Windows::GDI {
         } else {
             m_fLoopGapFactor = m_fLoopGap = 0.f;
         }
+        Invalidate();
     }
 
     //--------------------------------------------------------------------------
@@ -137,6 +139,7 @@ namespace Windows::GDI {
             line.SetHScroll(m_ScrollH.eMode, m_ScrollH.fSpeed, m_ScrollH.fDelay,
                             m_ScrollH.fGapFactor);
         }
+        Invalidate();
     }
 
     //--------------------------------------------------------------------------
@@ -145,6 +148,7 @@ namespace Windows::GDI {
         if (m_bBGClear == bClear) { return; }
         m_bBGClear = bClear;
         for (auto& line: m_Lines) { line.SetClear(m_bBGClear); }
+        Invalidate();
     }
 
     //--------------------------------------------------------------------------
@@ -156,6 +160,8 @@ namespace Windows::GDI {
         m_fTarget           = 0.f;
         m_iScrollLineID     = 0;
         m_eScrollLastStatus = ScrollStatus::None;
+        m_bAnimating        = false;
+        Invalidate();
     }
 
     //--------------------------------------------------------------------------
@@ -167,7 +173,8 @@ namespace Windows::GDI {
         const float fClipTop    = static_cast<float>(Clip().top);
         const float fClipBottom = static_cast<float>(Clip().bottom);
 
-        int iScrollingLineCount = 0;
+        int  iScrollingLineCount = 0;
+        bool bLinesMoved         = false;
         for (auto& line: m_Lines) {
             const auto iLineHeight = GetLineHeight(line);
 
@@ -200,6 +207,11 @@ namespace Windows::GDI {
 
             const auto eScrollStatus = line.Update(bVisible && bShouldScroll);
             if (bVisible) {
+                // Lines are drawn as of their last update, so any
+                // update that scrolled one changes the next frame
+                bLinesMoved = bLinesMoved ||
+                              ((eScrollStatus != ScrollStatus::None) &&
+                               (eScrollStatus != ScrollStatus::Paused));
                 if (eScrollStatus == ScrollStatus::Finished) {
                     if (m_Scroller.IsScrolling() && m_bScrollStaggered) {
                         line.PauseScroll();
@@ -221,6 +233,10 @@ namespace Windows::GDI {
                 m_Scroller.Pause();
             }
         }
+
+        // Vertical scrolling is interpolated between updates
+        m_bAnimating = bLinesMoved ||
+                       (bScrolling && (m_Scroller.GetOffset(0.f) != m_Scroller.GetOffset(1.f)));
     }
 
     //--------------------------------------------------------------------------
@@ -353,6 +369,7 @@ namespace Windows::GDI {
 
     void CText::Update(int iWidth, int iHeight) {
         SetSize(iWidth, iHeight);
+        Invalidate();
 
         m_eScrollLastStatus = ScrollStatus::None;
 
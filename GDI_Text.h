@@ -59,7 +59,9 @@ namespace Windows::GDI {
         void SetFont(_In_ const LOGFONT& logFont,
                      _In_ bool bAllowOverlap = false);
 
-        void SetVAlign(_In_ Text::Align::Vertical eAlign) noexcept { m_eVAlign = eAlign; }
+        void SetVAlign(_In_ Text::Align::Vertical eAlign) noexcept {
+            if (m_eVAlign != eAlign) { m_eVAlign = eAlign; Invalidate(); }
+        }
         void SetVScroll(_In_ const ScrollParams& params) noexcept;
         void SetVScroll(_In_ ScrollMode eMode,
                         _In_ float fSpeed,
@@ -89,6 +91,7 @@ namespace Windows::GDI {
         virtual void OnChanged(_In_ GDIChange eWhat,
                                _In_ LPARAM lparam,
                                _In_ WPARAM wparam) noexcept override;
+        virtual bool IsAnimating() const noexcept override { return m_bAnimating; }
 
     private:
         void Update(int iWidth, int iHeight);
@@ -132,6 +135,8 @@ namespace Windows::GDI {
 
         int m_iScrollLineID{ 0 };
         ScrollStatus m_eScrollLastStatus{ ScrollStatus::None };
+
+        bool m_bAnimating{ false }; //< Scrolling as of the last `Update`
     };
 } // namespace Windows::GDI
 
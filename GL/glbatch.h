@@ -0,0 +1,379 @@
+#pragma once
+#ifndef GUID_638B16B3_9155_49D5_9D1A_E27B116F093E
+#define GUID_638B16B3_9155_49D5_9D1A_E27B116F093E
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glbuffer.h"
+#include "GL/glscopedutil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <vector>
+//--------------------------------------
+
+namespace OpenGL {
+    //**************************************************************************
+    // glVertexBatch
+    //**************************************************************************
+    //
+    // Records immediate mode style drawing (`begin`,
+    // `color`, `vertex`, `end`) into a vertex/colour array
+    // and submits it from one persistent buffer object on
+    // `flush`.
+    //
+    // Consecutive runs of independent primitives (points,
+    // lines, triangles, quads) with the same mode become a
+    // single `glDrawArrays`; consecutive strips/loops with
+    // the same mode become a single `glMultiDrawArrays`.
+    //
+    // Without buffer objects (e.g. the OpenGL 1.1 software
+    // renderer) the arrays are drawn from client memory,
+    // and without `glMultiDrawArrays` each strip/loop is
+    // its own `glDrawArrays`. Support is checked on the
+    // first `flush` after `destroy`.
+    //
+    // NOTE:
+    //  - Drawing is deferred, so anything which changes
+    //    how the batch would be rasterised (line width,
+    //    point size, blending, ...) or draws directly must
+    //    `flush` first (see `glScopedBatchFlush`).
+    //  - As with `glColor`, colour is sticky; it starts as
+    //    the OpenGL current colour and the last colour is
+    //    made current again by `flush`.
+    class glVertexBatch final {
+    private:
+        using this_class = glVertexBatch;
+
+    public:
+        using size_type   = std::size_t;
+        using coord_type  = ::GLfloat;
+        using color_type  = std::array<::GLfloat, 4>;
+        using buffer_type = ::OpenGL::glArrayBuffer;
+
+        struct vertex_type final {
+            coord_type x    { 0 };
+            coord_type y    { 0 };
+            color_type color{ };
+        };
+
+        struct statistics final {
+            size_type m_nFlushes  { 0 }; //< Flushes which drew something
+            size_type m_nDrawCalls{ 0 };
+            size_type m_nVertices { 0 };
+        };
+
+        inline static constexpr const size_type InitialCapacity{ 4096 }; //< Vertices
+
+    private:
+        struct run_type final {
+            ::GLenum  mode { 0 };
+            ::GLint   first{ 0 };
+            ::GLsizei count{ 0 };
+        };
+
+        enum class multi_draw {
+            unknown = 0,
+            none,
+            core,       //< OpenGL 1.4
+            extension,  //< `EXT_multi_draw_arrays`
+        };
+
+        // Vertices per primitive for independent primitives
+        // (zero for connected ones) and the fewest vertices
+        // which draw anything
+        struct primitive_desc final {
+            size_type nStep   { 0 };
+            size_type nMinimum{ 0 };
+        };
+
+        static constexpr primitive_desc Describe(::GLenum mode) noexcept {
+            switch (mode) {
+                case GL_POINTS:         return { 1, 1 };
+                case GL_LINES:          return { 2, 2 };
+                case GL_TRIANGLES:      return { 3, 3 };
+                case GL_QUADS:          return { 4, 4 };
+                case GL_LINE_STRIP:     [[fallthrough]];
+                case GL_LINE_LOOP:      return { 0, 2 };
+                case GL_QUAD_STRIP:     return { 0, 4 };
+                case GL_TRIANGLE_STRIP: [[fallthrough]];
+                case GL_TRIANGLE_FAN:   [[fallthrough]];
+                case GL_POLYGON:        [[fallthrough]];
+                default:                return { 0, 3 };
+            }
+        }
+
+    public:
+        // There is a single OpenGL context (see `Canvas`),
+        // so a single batch serves every visualisation
+        static this_class& instance() noexcept {
+            static this_class s_Batch{};
+            return s_Batch;
+        }
+
+    public:
+        glVertexBatch() {
+            m_Vertices.reserve(InitialCapacity);
+        }
+
+        glVertexBatch(const this_class& ) = delete; // No Copy
+        glVertexBatch(      this_class&&) = delete; // No Move
+        this_class& operator=(const this_class& ) = delete; // No Copy
+        this_class& operator=(      this_class&&) = delete; // No Move
+
+        ~glVertexBatch() noexcept = default;
+
+    public:
+        void begin(::GLenum mode) noexcept {
+            assert(!m_bInBegin);
+            if (!m_bColorKnown) {
+                ::glGetFloatv(GL_CURRENT_COLOR, m_Color.data());
+                m_bColorKnown = true;
+            }
+            m_Mode      = mode;
+            m_nRunFirst = m_Vertices.size();
+            m_bInBegin  = true;
+        }
+
+        void end() noexcept {
+            assert(m_bInBegin);
+            m_bInBegin = false;
+
+            // Incomplete primitives are dropped, as `glEnd` would
+            const auto desc{ Describe(m_Mode) };
+            auto nCount{ m_Vertices.size() - m_nRunFirst };
+            if (desc.nStep) { nCount -= nCount % desc.nStep; }
+            if (nCount < desc.nMinimum) { nCount = 0; }
+            m_Vertices.resize(m_nRunFirst + nCount);
+            if (!nCount) { return; }
+
+            if (desc.nStep && !m_Runs.empty() && m_Runs.back().mode == m_Mode) {
+                m_Runs.back().count += static_cast<::GLsizei>(nCount);
+            } else {
+                m_Runs.push_back({ m_Mode,
+                                   static_cast<::GLint>(m_nRunFirst),
+                                   static_cast<::GLsizei>(nCount) });
+            }
+        }
+
+        void color(::GLfloat r, ::GLfloat g, ::GLfloat b, ::GLfloat a = 1.f) noexcept {
+            m_Color       = { r, g, b, a };
+            m_bColorKnown = true;
+        }
+
+        template <typename CoordT>
+        void vertex(CoordT x, CoordT y) noexcept {
+            assert(m_bInBegin);
+            m_Vertices.push_back({ static_cast<coord_type>(x),
+                                   static_cast<coord_type>(y),
+                                   m_Color });
+        }
+
+        void flush() noexcept {
+            assert(!m_bInBegin);
+            if (!m_Runs.empty()) {
+                Submit();
+                ++m_Statistics.m_nFlushes;
+                m_Statistics.m_nVertices += m_Vertices.size();
+                m_Vertices.clear();
+                m_Runs.clear();
+            }
+
+            // Drawing from a colour array leaves the current
+            // colour undefined; restore what immediate mode
+            // would have left, then pick up any later changes
+            // made directly at the next `begin`
+            if (m_bColorKnown) {
+                ::glColor4fv(m_Color.data());
+                m_bColorKnown = false;
+            }
+        }
+
+        // Requires the context the buffer was created with
+        void destroy() noexcept {
+            m_Vertices.clear();
+            m_Runs.clear();
+            m_Buffer.destroy();
+            m_nCapacity   = 0;
+            m_nOffset     = 0;
+            m_bColorKnown = false;
+            // The next context may differ (hardware/software)
+            m_eMultiDraw  = multi_draw::unknown;
+        }
+
+        const auto& get_statistics() const noexcept { return m_Statistics; }
+        void reset_statistics() noexcept { m_Statistics = {}; }
+
+    private:
+        void Submit() noexcept {
+            if (m_eMultiDraw == multi_draw::unknown) {
+                m_bUseBuffer = buffer_type::is_supported();
+                m_eMultiDraw = GLEW_VERSION_1_4           ? multi_draw::core      :
+                               GLEW_EXT_multi_draw_arrays ? multi_draw::extension :
+                                                            multi_draw::none;
+            }
+
+            if (!m_bUseBuffer) {
+                Draw(reinterpret_cast<std::uintptr_t>(m_Vertices.data()));
+                return;
+            }
+
+            if (!m_Buffer) { m_Buffer.create(); }
+            const auto bind_{ m_Buffer.scoped_bind() };
+
+            // Each flush is written after the last so it never
+            // overwrites data a pending draw may still read; when
+            // full, the old storage is orphaned rather than waited on
+            const auto nBytes{ static_cast<::GLsizeiptrARB>(m_Vertices.size() * sizeof(vertex_type)) };
+            if (m_nOffset + nBytes > m_nCapacity) {
+                m_nCapacity = std::max(m_nCapacity, static_cast<::GLsizeiptrARB>(InitialCapacity * sizeof(vertex_type)));
+                while (nBytes > m_nCapacity) { m_nCapacity *= 2; }
+                buffer_type::data<void>(m_nCapacity, nullptr, GL_STREAM_DRAW_ARB);
+                m_nOffset = 0;
+            }
+            buffer_type::sub_data(m_nOffset, nBytes, m_Vertices.data());
+            const auto nBase{ static_cast<std::uintptr_t>(m_nOffset) };
+            m_nOffset += nBytes;
+            Draw(nBase);
+        }
+
+        // `nBase` is the address of the vertices in client
+        // memory, or their offset in the bound buffer
+        void Draw(std::uintptr_t nBase) noexcept {
+            const ::OpenGL::glScopedPushClientAttrib _clientAttrib{ GL_CLIENT_VERTEX_ARRAY_BIT };
+            ::glEnableClientState(GL_VERTEX_ARRAY);
+            ::glEnableClientState(GL_COLOR_ARRAY);
+            ::glVertexPointer(2, GL_FLOAT, sizeof(vertex_type),
+                              reinterpret_cast<const ::GLvoid*>(nBase + offsetof(vertex_type, x)));
+            ::glColorPointer (4, GL_FLOAT, sizeof(vertex_type),
+                              reinterpret_cast<const ::GLvoid*>(nBase + offsetof(vertex_type, color)));
+
+            for (size_type run = 0; run < m_Runs.size();) {
+                const auto mode{ m_Runs[run].mode };
+                auto next{ run + 1 };
+                while (next < m_Runs.size() && m_Runs[next].mode == mode) { ++next; }
+
+                if (next - run == 1 || m_eMultiDraw == multi_draw::none) {
+                    for (auto r = run; r < next; ++r) {
+                        ::glDrawArrays(mode, m_Runs[r].first, m_Runs[r].count);
+                        ++m_Statistics.m_nDrawCalls;
+                    }
+                } else {
+                    m_Firsts.clear();
+                    m_Counts.clear();
+                    for (auto r = run; r < next; ++r) {
+                        m_Firsts.push_back(m_Runs[r].first);
+                        m_Counts.push_back(m_Runs[r].count);
+                    }
+                    const auto nRuns{ static_cast<::GLsizei>(m_Firsts.size()) };
+                    if (m_eMultiDraw == multi_draw::core) {
+                        ::glMultiDrawArrays(mode, m_Firsts.data(), m_Counts.data(), nRuns);
+                    } else {
+                        ::glMultiDrawArraysEXT(mode, m_Firsts.data(), m_Counts.data(), nRuns);
+                    }
+                    ++m_Statistics.m_nDrawCalls;
+                }
+                OpenGLAssertNoError();
+                run = next;
+            }
+        }
+
+    private:
+        std::vector<vertex_type> m_Vertices   {};
+        std::vector<run_type>    m_Runs       {};
+        std::vector<::GLint>     m_Firsts     {}; //< `glMultiDrawArrays` scratch
+        std::vector<::GLsizei>   m_Counts     {}; //< `glMultiDrawArrays` scratch
+        buffer_type              m_Buffer     {};
+        ::GLsizeiptrARB          m_nCapacity  { 0 }; //< Bytes
+        ::GLsizeiptrARB          m_nOffset    { 0 }; //< Bytes, next write
+        multi_draw               m_eMultiDraw { multi_draw::unknown };
+        bool                     m_bUseBuffer { false };
+
+        color_type m_Color      { 1.f, 1.f, 1.f, 1.f };
+        bool       m_bColorKnown{ false };
+        bool       m_bInBegin   { false };
+        ::GLenum   m_Mode       { GL_POINTS };
+        size_type  m_nRunFirst  { 0 };
+
+        statistics m_Statistics{};
+    }; // class glVertexBatch final
+
+    //**************************************************************************
+    // glScopedBatchBegin
+    //**************************************************************************
+    struct glScopedBatchBegin final {
+    public:
+        glScopedBatchBegin(glVertexBatch& batch,
+                           ::GLenum mode) noexcept :
+            m_Batch{ batch } {
+            m_Batch.begin(mode);
+        }
+
+        ~glScopedBatchBegin() noexcept {
+            m_Batch.end();
+        }
+
+        glScopedBatchBegin(const glScopedBatchBegin& ) = delete; // No Copy
+        glScopedBatchBegin(      glScopedBatchBegin&&) = delete; // No Move
+        glScopedBatchBegin& operator=(const glScopedBatchBegin& ) = delete; // No Copy
+        glScopedBatchBegin& operator=(      glScopedBatchBegin&&) = delete; // No Move
+
+    private:
+        glVertexBatch& m_Batch;
+    }; // struct glScopedBatchBegin final
+
+    //**************************************************************************
+    // glScopedBatchFlush
+    //**************************************************************************
+    // Declare after any scoped state (e.g. `glScopedSetLineWidth`)
+    // so the batch is drawn before that state is restored.
+    // Anything batched before the state was set is drawn with
+    // it too, so flush first unless the batch is known to be
+    // empty (as at the start of a visualisation's `Draw`).
+    struct glScopedBatchFlush final {
+    public:
+        glScopedBatchFlush(glVertexBatch& batch) noexcept :
+            m_Batch{ batch } {}
+
+        ~glScopedBatchFlush() noexcept {
+            m_Batch.flush();
+        }
+
+        glScopedBatchFlush(const glScopedBatchFlush& ) = delete; // No Copy
+        glScopedBatchFlush(      glScopedBatchFlush&&) = delete; // No Move
+        glScopedBatchFlush& operator=(const glScopedBatchFlush& ) = delete; // No Copy
+        glScopedBatchFlush& operator=(      glScopedBatchFlush&&) = delete; // No Move
+
+    private:
+        glVertexBatch& m_Batch;
+    }; // struct glScopedBatchFlush final
+} // namespace OpenGL
+
+#endif // GUID_638B16B3_9155_49D5_9D1A_E27B116F093E
@@ -0,0 +1,216 @@
+#pragma once
+#ifndef GUID_3E0C6C3B_62B1_4C7E_9D53_6F0F1A2B8C41
+#define GUID_3E0C6C3B_62B1_4C7E_9D53_6F0F1A2B8C41
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glframebuffer.h"
+#include "GL/glscopedutil.h"
+#include "GL/glshader.h"
+#include "GL/gltexture.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Util/BitPlane.h"
+#include "Util/Dither.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <array>
+//--------------------------------------
+
+namespace OpenGL {
+    //**************************************************************************
+    // glBitPlanePacker
+    //**************************************************************************
+    //
+    // Packs a rendered scene (an RGBA texture) into a
+    // `util::bit_plane` on the GPU, so only the bit plane is
+    // read back. Each texel of a (stride / 4) x height RGBA8
+    // target is 32 pixels of a row, one byte per channel,
+    // the first pixel in the most significant bit of R:
+    // rows of texels are exactly the rows of the bit plane.
+    //
+    // A pixel is set by the same rule as on the CPU: the
+    // top bit of any channel (as `bit_plane::pack`), or the
+    // rounded luma against the thresholds of
+    // `util::dither::bayer`. Error diffusion is serial, so
+    // has no pass here.
+    class glBitPlanePacker final {
+    private:
+        using this_class = glBitPlanePacker;
+
+    public:
+        using texture_type     = ::OpenGL::glTexture;
+        using framebuffer_type = ::OpenGL::glFramebuffer;
+        using program_type     = ::OpenGL::glProgram;
+
+    private:
+        // A quad covering the target, in clip space
+        inline static constexpr const char VertexShader[]{
+            "#version 110\n"
+            "void main() {\n"
+            "    gl_Position = gl_Vertex;\n"
+            "}\n"
+        };
+
+        inline static constexpr const char FragmentShader[]{
+            "#version 110\n"
+            "uniform sampler2D u_Scene;\n"
+            "uniform vec2      u_SceneSize;\n"
+            "uniform bool      u_bDither;\n"
+            "uniform float     u_Thresholds[64];\n"
+            "bool IsSet(float x, float y) {\n"
+            "    vec4 color = texture2D(u_Scene, (vec2(x, y) + .5) / u_SceneSize);\n"
+            "    if (u_bDither) {\n"
+            "        float luma = min(floor(dot(color.rgb, vec3(.299, .587, .114)) * 255. + .5), 255.);\n"
+            "        return luma > u_Thresholds[int(mod(y, 8.)) * 8 + int(mod(x, 8.))];\n"
+            "    }\n"
+            "    return any(greaterThan(color.rgb, vec3(127.5 / 255.)));\n"
+            "}\n"
+            "float PackByte(float x, float y) {\n"
+            "    float bits = 0.;\n"
+            "    for (int bit = 0; bit < 8; ++bit) {\n"
+            "        float px = x + float(bit);\n"
+            "        if (px < u_SceneSize.x && IsSet(px, y)) { bits += exp2(float(7 - bit)); }\n"
+            "    }\n"
+            "    return bits / 255.;\n"
+            "}\n"
+            "void main() {\n"
+            "    float x = floor(gl_FragCoord.x) * 32.;\n"
+            "    float y = floor(gl_FragCoord.y);\n"
+            "    gl_FragColor = vec4(PackByte(x      , y), PackByte(x + 8. , y),\n"
+            "                        PackByte(x + 16., y), PackByte(x + 24., y));\n"
+            "}\n"
+        };
+
+    public:
+        static bool is_supported() noexcept {
+            return program_type::is_supported() &&
+                   framebuffer_type::is_supported();
+        }
+
+    public:
+        glBitPlanePacker() = default;
+
+        glBitPlanePacker(const this_class& ) = delete; // No Copy
+        glBitPlanePacker(      this_class&&) = delete; // No Move
+        this_class& operator=(const this_class& ) = delete; // No Copy
+        this_class& operator=(      this_class&&) = delete; // No Move
+
+        ~glBitPlanePacker() noexcept = default;
+
+    public:
+        // For a `width` x `height` scene; false (and nothing
+        // created) if the target or program can't be
+        bool create(::GLsizei width,
+                    ::GLsizei height) {
+            destroy();
+            const auto packWidth{ static_cast<::GLsizei>(::util::bit_plane::stride(static_cast<::util::bit_plane::size_type>(width)) / 4) };
+            m_Texture.create(GL_TEXTURE_2D, GL_RGBA8, packWidth, height, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            if (!m_Texture) { destroy(); return false; }
+            {
+                // Read back texel for texel, never filtered
+                const auto bind_{ m_Texture.scoped_bind(GL_TEXTURE_2D) };
+                texture_type::parameter(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                texture_type::parameter(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            }
+            if (!m_Framebuffer.create(m_Texture) ||
+                !m_Program.create(VertexShader, FragmentShader)) {
+                destroy();
+                return false;
+            }
+
+            std::array<::GLfloat, 64> thresholds{};
+            for (std::size_t i = 0; i < thresholds.size(); ++i) {
+                thresholds[i] = ::util::dither::detail::bayer_table[i / 8][i % 8];
+            }
+
+            const auto use_{ m_Program.scoped_use() };
+            ::glUniform1i (m_Program.uniform_location("u_Scene"), 0);
+            ::glUniform2f (m_Program.uniform_location("u_SceneSize"),
+                           static_cast<::GLfloat>(width), static_cast<::GLfloat>(height));
+            ::glUniform1fv(m_Program.uniform_location("u_Thresholds"),
+                           static_cast<::GLsizei>(thresholds.size()), thresholds.data());
+            m_iDitherUniform = m_Program.uniform_location("u_bDither");
+            m_nWidth  = width;
+            m_nHeight = height;
+            OpenGLAssertNoError();
+            return true;
+        }
+
+        // Packs `scene` (of the size given to `create`) into
+        // `pDst`, `util::bit_plane::byte_size` bytes, rows
+        // bottom up as OpenGL's; the framebuffer binding and
+        // viewport are left as they were
+        void pack(const texture_type& scene,
+                  bool bDither,
+                  void* pDst) const noexcept {
+            const auto packWidth{ static_cast<::GLsizei>(::util::bit_plane::stride(static_cast<::util::bit_plane::size_type>(m_nWidth)) / 4) };
+
+            const ::OpenGL::glScopedPushAttrib _attrib{ GL_ENABLE_BIT | GL_VIEWPORT_BIT | GL_TEXTURE_BIT };
+            const auto bind_{ m_Framebuffer.scoped_bind() };
+            const auto use_ { m_Program.scoped_use() };
+            const auto tex_ { scene.scoped_bind(GL_TEXTURE_2D) };
+
+            ::glDisable(GL_BLEND);
+            ::glDisable(GL_POLYGON_SMOOTH);
+            ::glUniform1i(m_iDitherUniform, bDither ? GL_TRUE : GL_FALSE);
+            ::glViewport(0, 0, packWidth, m_nHeight);
+            ::glRecti(-1, -1, 1, 1); //< Clip space: the vertex shader doesn't transform
+
+            ::glReadPixels(0, 0,
+                           packWidth, m_nHeight,
+                           GL_RGBA, GL_UNSIGNED_BYTE,
+                           pDst);
+            OpenGLAssertNoError();
+        }
+
+        // Requires the context the objects were created with
+        void destroy() noexcept {
+            m_iDitherUniform = -1;
+            m_Program.destroy();
+            m_Framebuffer.destroy();
+            m_Texture.destroy();
+            m_nWidth  = 0;
+            m_nHeight = 0;
+        }
+
+    public:
+        explicit operator bool() const noexcept { return static_cast<bool>(m_Program); }
+
+    private:
+        texture_type     m_Texture       {}; //< Bit plane, 32 pixels per texel
+        framebuffer_type m_Framebuffer   {};
+        program_type     m_Program       {};
+        ::GLint          m_iDitherUniform{ -1 };
+        ::GLsizei        m_nWidth        { 0 };
+        ::GLsizei        m_nHeight       { 0 };
+    }; // class glBitPlanePacker final
+} // namespace OpenGL
+
+#endif // GUID_3E0C6C3B_62B1_4C7E_9D53_6F0F1A2B8C41
@@ -118,6 +118,11 @@ namespace OpenGL::detail {
         using scoped_map_type  = glScopedMapBufferARBT<TargetT>;
 
     public:
+        // The `ARB` entry points used throughout
+        static bool is_supported() noexcept {
+            return GLEW_ARB_vertex_buffer_object;
+        }
+
         static void create(GLsizei n, GLuint* buffers) noexcept {
             ::glGenBuffersARB(n, buffers);
             OpenGLAssertNoError();
@@ -155,6 +160,15 @@ namespace OpenGL::detail {
             OpenGLAssertNoError();
         }
 
+        template <typename TypeT>
+        static void sub_data(GLintptrARB offset,
+                             GLsizeiptrARB size,
+                             const TypeT* data) noexcept {
+            ::glBufferSubDataARB(target, offset,
+                                 size, data);
+            OpenGLAssertNoError();
+        }
+
         static void* map(GLenum access) noexcept {
             auto* data = ::glMapBufferARB(target, access);
             OpenGLAssertNoError();
@@ -239,6 +253,11 @@ namespace OpenGL::detail {
 //------------------------------------------------------------------------------
 
 namespace OpenGL {
+    using glArrayBuffer =
+        ::OpenGL::detail::glBufferObjectT<GL_ARRAY_BUFFER_ARB>;
+
+    //----------------------------------
+
     using glPixelPackBuffer =
         ::OpenGL::detail::glBufferObjectT<GL_PIXEL_PACK_BUFFER_ARB>;
 
@@ -59,7 +59,7 @@ namespace OpenGL {
     //**************************************************************************
     // glGetErrorString
     //**************************************************************************
-    inline [[nodiscard]]
+    [[nodiscard]] inline
     const char* const glGetErrorStringA(GLenum error = ::glGetError()) noexcept {
         switch (error) {
         case GL_NO_ERROR:			return "GL_NO_ERROR";
@@ -74,7 +74,7 @@ namespace OpenGL {
     }
 
 #ifdef _WIN32
-    inline [[nodiscard]]
+    [[nodiscard]] inline
     const wchar_t* const glGetErrorStringW(GLenum error = ::glGetError()) noexcept {
         switch (error) {
         case GL_NO_ERROR:			return L"GL_NO_ERROR";
@@ -0,0 +1,173 @@
+#pragma once
+#ifndef GUID_AB50F151_D974_4CD5_A75A_A9240AB739E5
+#define GUID_AB50F151_D974_4CD5_A75A_A9240AB739E5
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/gltexture.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <utility>
+//--------------------------------------
+
+namespace OpenGL {
+    //**************************************************************************
+    // glScopedBindFramebuffer
+    //**************************************************************************
+    // Restores the previous binding (rather than the default
+    // framebuffer) as a framebuffer is usually left bound.
+    class glScopedBindFramebuffer final {
+    public:
+        glScopedBindFramebuffer(::GLuint name) noexcept {
+            ::glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_Previous);
+            ::glBindFramebuffer(GL_FRAMEBUFFER, name);
+            OpenGLAssertNoError();
+        }
+
+        ~glScopedBindFramebuffer() noexcept {
+            ::glBindFramebuffer(GL_FRAMEBUFFER, static_cast<::GLuint>(m_Previous));
+            OpenGLAssertNoError();
+        }
+
+        glScopedBindFramebuffer(const glScopedBindFramebuffer& ) = delete; // No Copy
+        glScopedBindFramebuffer(      glScopedBindFramebuffer&&) = delete; // No Move
+        glScopedBindFramebuffer& operator=(const glScopedBindFramebuffer& ) = delete; // No Copy
+        glScopedBindFramebuffer& operator=(      glScopedBindFramebuffer&&) = delete; // No Move
+
+    private:
+        ::GLint m_Previous{ 0 };
+    }; // class glScopedBindFramebuffer final
+
+    //**************************************************************************
+    // glFramebuffer
+    //**************************************************************************
+    // Framebuffer object (OpenGL 3.0 or ARB_framebuffer_object)
+    // rendering to a single colour texture.
+    class glFramebuffer final {
+    public:
+        static bool is_supported() noexcept {
+            return GLEW_VERSION_3_0 || GLEW_ARB_framebuffer_object;
+        }
+
+        static void create(::GLsizei n,
+                           ::GLuint* names) noexcept {
+            ::glGenFramebuffers(n, names);
+            OpenGLAssertNoError();
+        }
+
+        static void create(::GLuint& name) noexcept {
+            glFramebuffer::create(1, &name);
+        }
+
+        static void destroy(::GLsizei n,
+                            const ::GLuint* names) noexcept {
+            ::glDeleteFramebuffers(n, names);
+            OpenGLAssertNoError();
+        }
+
+        static void destroy(::GLuint name) noexcept {
+            glFramebuffer::destroy(1, &name);
+        }
+
+        static void bind(::GLuint name) noexcept {
+            ::glBindFramebuffer(GL_FRAMEBUFFER, name);
+            OpenGLAssertNoError();
+        }
+
+        static void unbind() noexcept {
+            glFramebuffer::bind(0);
+        }
+
+    private:
+        glFramebuffer(const glFramebuffer&)            = delete; // No Copy
+        glFramebuffer& operator=(const glFramebuffer&) = delete; // No Copy
+
+    public:
+        glFramebuffer() = default;
+
+        glFramebuffer(glFramebuffer&& other) noexcept :
+            m_Framebuffer{ std::exchange(other.m_Framebuffer, 0) } {}
+
+        glFramebuffer& operator=(glFramebuffer&& other) noexcept {
+            destroy();
+            using std::swap;
+            swap(m_Framebuffer, other.m_Framebuffer);
+            return *this;
+        }
+
+        ~glFramebuffer() noexcept { destroy(); }
+
+    public:
+        void bind() const noexcept {
+            glFramebuffer::bind(m_Framebuffer);
+        }
+
+        [[nodiscard]]
+        auto scoped_bind() const noexcept {
+            return glScopedBindFramebuffer{ m_Framebuffer };
+        }
+
+        // Attaches a 2D texture as the only colour buffer;
+        // false (and no framebuffer) if the result can't be
+        // rendered to.
+        bool create(const ::OpenGL::glTexture& texture) noexcept {
+            destroy();
+            glFramebuffer::create(1, &m_Framebuffer);
+            OpenGLAssert(m_Framebuffer);
+            if (!m_Framebuffer) { return false; }
+
+            const auto bind_{ scoped_bind() };
+            ::glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                                     GL_TEXTURE_2D, texture.name(), 0);
+            OpenGLAssertNoError();
+            if (::glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+                glFramebuffer::destroy(std::exchange(m_Framebuffer, 0));
+                return false;
+            }
+            return true;
+        }
+
+        void destroy() noexcept {
+            if (m_Framebuffer) {
+                glFramebuffer::destroy(std::exchange(m_Framebuffer, 0));
+            }
+        }
+
+        constexpr auto name() const noexcept {
+            return m_Framebuffer;
+        }
+
+    public:
+        constexpr operator const GLuint () const noexcept { return m_Framebuffer; }
+
+        explicit constexpr operator bool() const noexcept { return m_Framebuffer != 0; }
+
+    private:
+        ::GLuint m_Framebuffer{ 0 };
+    }; // class glFramebuffer final
+} // namespace OpenGL
+
+#endif // GUID_AB50F151_D974_4CD5_A75A_A9240AB739E5
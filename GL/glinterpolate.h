@@ -0,0 +1,270 @@
+#pragma once
+#ifndef GUID_A7135239_5289_4A41_A6AB_85357700A057
+#define GUID_A7135239_5289_4A41_A6AB_85357700A057
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glbuffer.h"
+#include "GL/glscopedutil.h"
+#include "GL/glshader.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cassert>
+#include <cstddef>
+#include <array>
+#include <vector>
+//--------------------------------------
+
+namespace OpenGL {
+    //**************************************************************************
+    // glInterpolatedVertices
+    //**************************************************************************
+    //
+    // Vertices whose height is blended between two frames
+    // of data by the vertex shader, so frames are uploaded
+    // once when they arrive and each redraw in between only
+    // sets the interpolation factor.
+    //
+    // Each vertex is at (x, base + weight * round(value *
+    // scale + bias)), where `value` is `prev` blended with
+    // `next` (as `util::lerp`) and scale and bias (0 to .5)
+    // are given to `draw`; a zero weight gives a fixed
+    // vertex.
+    //
+    // Only `value * scale` is rounded to float, the bias
+    // moving the rounding threshold (half up), as the CPU
+    // drawn spectrum bars are rounded (see
+    // `SpectrumAnalyser::Util::Pixels`); whole pixel
+    // offsets belong in `base`.
+    //
+    // Vertices are recorded with `begin`, `vertex` and `end`
+    // then submitted with `upload`.
+    class glInterpolatedVertices final {
+    private:
+        using this_class = glInterpolatedVertices;
+
+    public:
+        using size_type    = std::size_t;
+        using coord_type   = ::GLfloat;
+        using color_type   = std::array<::GLfloat, 4>;
+        using buffer_type  = ::OpenGL::glArrayBuffer;
+        using program_type = ::OpenGL::glProgram;
+
+        struct vertex_type final {
+            coord_type x     { 0 };
+            coord_type base  { 0 };
+            coord_type weight{ 0 };
+            coord_type prev  { 0 };
+            coord_type next  { 0 };
+        };
+
+        // Fixed vertices always use `color0`; others:
+        enum class color_mode : ::GLint {
+            Current  = 0, //< OpenGL current colour (everything)
+            Step     = 1, //< `color1`
+            Gradient = 2, //< `color0` to `color1` by value
+        };
+
+    private:
+        struct run_type final {
+            ::GLenum  mode { 0 };
+            ::GLint   first{ 0 };
+            ::GLsizei count{ 0 };
+        };
+
+        // The blended value goes through texture coordinates
+        // (weight, prev, next) so no attribute locations need
+        // binding
+        inline static constexpr const char VertexShader[]{
+            "#version 110\n"
+            "uniform float u_Interp;\n"
+            "uniform vec2  u_ScaleBias;\n"
+            "uniform int   u_ColorMode;\n"
+            "uniform vec4  u_Color0;\n"
+            "uniform vec4  u_Color1;\n"
+            "void main() {\n"
+            "    float weight = gl_MultiTexCoord0.x;\n"
+            "    float prev   = gl_MultiTexCoord0.y;\n"
+            "    float value  = prev + (gl_MultiTexCoord0.z - prev) * u_Interp;\n"
+            "    float pixel  = value * u_ScaleBias.x;\n"
+            "    float whole  = floor(pixel);\n"
+            "    whole       += step(whole + (.5 - u_ScaleBias.y), pixel);\n"
+            "    float y      = gl_Vertex.y + weight * whole;\n"
+            "    gl_Position  = gl_ModelViewProjectionMatrix * vec4(gl_Vertex.x, y, 0., 1.);\n"
+            "    if (u_ColorMode == 0) {\n"
+            "        gl_FrontColor = gl_Color;\n"
+            "    } else if (weight == 0.) {\n"
+            "        gl_FrontColor = u_Color0;\n"
+            "    } else if (u_ColorMode == 1) {\n"
+            "        gl_FrontColor = u_Color1;\n"
+            "    } else {\n"
+            "        gl_FrontColor = mix(u_Color0, u_Color1, clamp(value, 0., 1.));\n"
+            "    }\n"
+            "}\n"
+        };
+
+        inline static constexpr const char FragmentShader[]{
+            "#version 110\n"
+            "void main() {\n"
+            "    gl_FragColor = gl_Color;\n"
+            "}\n"
+        };
+
+    public:
+        static bool is_supported() noexcept {
+            return program_type::is_supported();
+        }
+
+    public:
+        glInterpolatedVertices() = default;
+
+        glInterpolatedVertices(const this_class& ) = delete; // No Copy
+        glInterpolatedVertices(      this_class&&) = delete; // No Move
+        this_class& operator=(const this_class& ) = delete; // No Copy
+        this_class& operator=(      this_class&&) = delete; // No Move
+
+        ~glInterpolatedVertices() noexcept = default;
+
+    public:
+        void clear() noexcept {
+            assert(!m_bInBegin);
+            m_Vertices.clear();
+            m_Runs.clear();
+        }
+
+        void begin(::GLenum mode) noexcept {
+            assert(!m_bInBegin);
+            m_Runs.push_back({ mode, static_cast<::GLint>(m_Vertices.size()), 0 });
+            m_bInBegin = true;
+        }
+
+        void end() noexcept {
+            assert(m_bInBegin);
+            m_bInBegin = false;
+            auto& run{ m_Runs.back() };
+            run.count = static_cast<::GLsizei>(m_Vertices.size()) - run.first;
+            if (!run.count) { m_Runs.pop_back(); }
+        }
+
+        template <typename CoordT, typename ValueT>
+        void vertex(CoordT x, CoordT base, CoordT weight,
+                    ValueT prev, ValueT next) noexcept {
+            assert(m_bInBegin);
+            m_Vertices.push_back({ static_cast<coord_type>(x),
+                                   static_cast<coord_type>(base),
+                                   static_cast<coord_type>(weight),
+                                   static_cast<coord_type>(prev),
+                                   static_cast<coord_type>(next) });
+        }
+
+        // Builds the program on first use; false if it can't
+        // be, in which case nothing will be drawn
+        bool upload() {
+            assert(!m_bInBegin);
+            if (!m_Program && !m_bProgramFailed) {
+                m_bProgramFailed = !m_Program.create(VertexShader, FragmentShader);
+                if (m_Program) {
+                    m_iInterpUniform    = m_Program.uniform_location("u_Interp");
+                    m_iScaleBiasUniform = m_Program.uniform_location("u_ScaleBias");
+                    m_iColorModeUniform = m_Program.uniform_location("u_ColorMode");
+                    m_iColor0Uniform    = m_Program.uniform_location("u_Color0");
+                    m_iColor1Uniform    = m_Program.uniform_location("u_Color1");
+                }
+            }
+            if (!m_Program) { return false; }
+
+            if (!m_Buffer) { m_Buffer.create(); }
+            const auto bind_{ m_Buffer.scoped_bind() };
+            const auto nBytes{ static_cast<::GLsizeiptrARB>(m_Vertices.size() * sizeof(vertex_type)) };
+            if (nBytes > m_nCapacity) {
+                m_nCapacity = nBytes;
+                buffer_type::data<void>(m_nCapacity, nullptr, GL_DYNAMIC_DRAW_ARB);
+            }
+            if (nBytes > 0) {
+                buffer_type::sub_data(0, nBytes, m_Vertices.data());
+            }
+            m_UploadedRuns = m_Runs;
+            return true;
+        }
+
+        // Draws what was last uploaded
+        void draw(::GLfloat fInterp,
+                  ::GLfloat fScale,
+                  ::GLfloat fBias,
+                  color_mode eColorMode = color_mode::Current,
+                  const color_type& color0 = {},
+                  const color_type& color1 = {}) const noexcept {
+            if (!m_Program || !m_Buffer || m_UploadedRuns.empty()) { return; }
+
+            const ::OpenGL::glScopedUseProgram use_{ m_Program.name() };
+            ::glUniform1f(m_iInterpUniform, fInterp);
+            ::glUniform2f(m_iScaleBiasUniform, fScale, fBias);
+            ::glUniform1i(m_iColorModeUniform, static_cast<::GLint>(eColorMode));
+            ::glUniform4fv(m_iColor0Uniform, 1, color0.data());
+            ::glUniform4fv(m_iColor1Uniform, 1, color1.data());
+
+            const auto bind_{ m_Buffer.scoped_bind() };
+            const ::OpenGL::glScopedPushClientAttrib _clientAttrib{ GL_CLIENT_VERTEX_ARRAY_BIT };
+            ::glEnableClientState(GL_VERTEX_ARRAY);
+            ::glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+            ::glVertexPointer  (2, GL_FLOAT, sizeof(vertex_type),
+                                reinterpret_cast<const ::GLvoid*>(offsetof(vertex_type, x)));
+            ::glTexCoordPointer(3, GL_FLOAT, sizeof(vertex_type),
+                                reinterpret_cast<const ::GLvoid*>(offsetof(vertex_type, weight)));
+            for (const auto& run : m_UploadedRuns) {
+                ::glDrawArrays(run.mode, run.first, run.count);
+            }
+            OpenGLAssertNoError();
+        }
+
+        // Requires the context the objects were created with
+        void destroy() noexcept {
+            clear();
+            m_UploadedRuns.clear();
+            m_Buffer.destroy();
+            m_Program.destroy();
+            m_nCapacity      = 0;
+            m_bProgramFailed = false;
+        }
+
+    private:
+        std::vector<vertex_type> m_Vertices         {};
+        std::vector<run_type>    m_Runs             {};
+        std::vector<run_type>    m_UploadedRuns     {};
+        buffer_type              m_Buffer           {};
+        ::GLsizeiptrARB          m_nCapacity        { 0 }; //< Bytes
+        program_type             m_Program          {};
+        ::GLint                  m_iInterpUniform   { -1 };
+        ::GLint                  m_iScaleBiasUniform{ -1 };
+        ::GLint                  m_iColorModeUniform{ -1 };
+        ::GLint                  m_iColor0Uniform   { -1 };
+        ::GLint                  m_iColor1Uniform   { -1 };
+        bool                     m_bProgramFailed   { false };
+        bool                     m_bInBegin         { false };
+    }; // class glInterpolatedVertices final
+} // namespace OpenGL
+
+#endif // GUID_A7135239_5289_4A41_A6AB_85357700A057
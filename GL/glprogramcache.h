@@ -0,0 +1,228 @@
+#pragma once
+#ifndef GUID_2E108EE3_276F_4982_83B7_0626071C21DA
+#define GUID_2E108EE3_276F_4982_83B7_0626071C21DA
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glshader.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <system_error>
+//--------------------------------------
+
+namespace OpenGL {
+    //**************************************************************************
+    // glProgramCache
+    //**************************************************************************
+    //
+    // GLSL programs built from fragment shader files, kept
+    // for the life of the context so a visualisation which
+    // is deactivated and reactivated doesn't recompile.
+    //
+    // Files are polled for changes (at most every
+    // `PollInterval`). A changed file (write time or size)
+    // is only rebuilt once it has stayed the same for a
+    // whole poll, so a save in progress isn't read, nor a
+    // second save missed for landing within the same write
+    // time as the first. A rebuild is begun on one frame and
+    // finished on a later one, once the driver says it is
+    // done (see `glProgramBuilder`), then replaces the
+    // current program only if it compiled and linked; so
+    // editing a shader neither stalls drawing nor leaves
+    // nothing to draw (a broken file just logs the error
+    // and keeps the last good program).
+    //
+    // NOTE:
+    //  - The first build of a file has nothing to fall back
+    //    on, so is finished on the frame it is begun.
+    //  - Programs belong to the context; `destroy` must be
+    //    called before it goes away (see `Canvas`).
+    class glProgramCache final {
+    private:
+        using this_class = glProgramCache;
+
+    public:
+        using size_type    = std::size_t;
+        using path_type    = std::filesystem::path;
+        using program_type = ::OpenGL::glProgram;
+        using builder_type = ::OpenGL::glProgramBuilder;
+        using clock_type   = std::chrono::steady_clock;
+
+        struct statistics final {
+            size_type m_nBuilds  { 0 }; //< Successful compile and link
+            size_type m_nFailures{ 0 }; //< Unreadable file or failed compile/link
+            size_type m_nPolls   { 0 }; //< Write time checks
+            size_type m_nDeferred{ 0 }; //< Changes left until stable
+        };
+
+        inline static constexpr const auto PollInterval{ std::chrono::milliseconds{ 500 } };
+
+    private:
+        using file_time_type = std::filesystem::file_time_type;
+
+        struct file_stamp final {
+            file_time_type writeTime{};
+            std::uintmax_t size     { 0 };
+
+            bool operator==(const file_stamp& other) const noexcept {
+                return writeTime == other.writeTime && size == other.size;
+            }
+        };
+
+        struct entry_type final {
+            program_type           program   {};
+            builder_type           pending   {}; //< Rebuild in progress
+            file_stamp             built     {}; //< Of the last build attempt
+            file_stamp             seen      {}; //< At the last poll
+            clock_type::time_point nextPoll  {};
+            bool                   bAttempted{ false };
+        };
+
+    public:
+        // There is a single OpenGL context (see `Canvas`)
+        static this_class& instance() noexcept {
+            static this_class s_Cache{};
+            return s_Cache;
+        }
+
+    public:
+        glProgramCache() = default;
+
+        glProgramCache(const this_class& ) = delete; // No Copy
+        glProgramCache(      this_class&&) = delete; // No Move
+        this_class& operator=(const this_class& ) = delete; // No Copy
+        this_class& operator=(      this_class&&) = delete; // No Move
+
+        ~glProgramCache() noexcept = default;
+
+    public:
+        // Program for the fragment shader `file` (with
+        // `szVertexSource` as its vertex shader), rebuilding it
+        // first if the file has changed. `nullptr` until the
+        // file has been built successfully once.
+        //
+        // NOTE: Programs are cached by file only; every caller
+        //       for a file must use the same vertex shader.
+        const program_type* get(const path_type& file,
+                                const char* szVertexSource) {
+            auto& entry{ m_Entries[file] };
+            if (entry.pending.pending() && entry.pending.ready()) {
+                Finish(file, entry);
+            }
+            const auto now{ clock_type::now() };
+            if (!entry.bAttempted || now >= entry.nextPoll) {
+                entry.nextPoll = now + PollInterval;
+                Poll(file, szVertexSource, entry);
+            }
+            return entry.program ? &entry.program : nullptr;
+        }
+
+        // Requires the context the programs were created with
+        void destroy() noexcept {
+            m_Entries.clear();
+        }
+
+        const auto& get_statistics() const noexcept { return m_Statistics; }
+        void reset_statistics() noexcept { m_Statistics = {}; }
+
+    private:
+        void Poll(const path_type& file,
+                  const char* szVertexSource,
+                  entry_type& entry) {
+            ++m_Statistics.m_nPolls;
+
+            // Missing (or mid save) files keep whatever was
+            // built last and are tried again next poll
+            std::error_code error{};
+            const file_stamp stamp{ std::filesystem::last_write_time(file, error),
+                                    error ? std::uintmax_t{ 0 } : std::filesystem::file_size(file, error) };
+            if (error) {
+                if (!entry.bAttempted) {
+                    SPDLOG_ERROR("Unable to open shader \"{}\": \"{}\"",
+                                 file.u8string(), error.message());
+                    ++m_Statistics.m_nFailures;
+                    entry.bAttempted = true;
+                }
+                return;
+            }
+
+            // A change waits until it is seen again unchanged
+            const auto bStable{ stamp == entry.seen };
+            entry.seen = stamp;
+            if (entry.bAttempted) {
+                if (stamp == entry.built) { return; }
+                if (!bStable) {
+                    ++m_Statistics.m_nDeferred;
+                    return;
+                }
+            }
+
+            entry.built      = stamp;
+            entry.bAttempted = true;
+
+            std::ifstream stream{ file, std::ios::in | std::ios::binary };
+            const std::string source{ std::istreambuf_iterator<char>{ stream },
+                                      std::istreambuf_iterator<char>{} };
+            if (stream.bad() || source.empty() ||
+                !entry.pending.begin(szVertexSource, source.c_str())) {
+                SPDLOG_ERROR("Unable to build shader \"{}\"{}",
+                             file.u8string(),
+                             entry.program ? ", keeping previous version" : "");
+                ++m_Statistics.m_nFailures;
+                return;
+            }
+            if (!entry.program) { Finish(file, entry); }
+        }
+
+        void Finish(const path_type& file,
+                    entry_type& entry) {
+            auto program{ entry.pending.finish() };
+            if (program) {
+                entry.program = std::move(program);
+                ++m_Statistics.m_nBuilds;
+            } else {
+                SPDLOG_ERROR("Unable to build shader \"{}\"{}",
+                             file.u8string(),
+                             entry.program ? ", keeping previous version" : "");
+                ++m_Statistics.m_nFailures;
+            }
+        }
+
+    private:
+        std::map<path_type, entry_type> m_Entries   {};
+        statistics                      m_Statistics{};
+    }; // class glProgramCache final
+} // namespace OpenGL
+
+#endif // GUID_2E108EE3_276F_4982_83B7_0626071C21DA
@@ -151,6 +151,27 @@ namespace OpenGL {
         glScopedPushAttrib& operator=(const glScopedPushAttrib& ) = delete; // No Copy
         glScopedPushAttrib& operator=(      glScopedPushAttrib&&) = delete; // No Move
     }; // struct glScopedPushAttrib final
+
+    //**************************************************************************
+    // glScopedPushClientAttrib
+    //**************************************************************************
+    struct glScopedPushClientAttrib final {
+    public:
+        glScopedPushClientAttrib(::GLbitfield mask = GL_CLIENT_ALL_ATTRIB_BITS) noexcept {
+            ::glPushClientAttrib(mask);
+            OpenGLAssertNoError();
+        }
+
+        ~glScopedPushClientAttrib() noexcept {
+            ::glPopClientAttrib();
+            OpenGLAssertNoError();
+        }
+
+        glScopedPushClientAttrib(const glScopedPushClientAttrib& ) = delete; // No Copy
+        glScopedPushClientAttrib(      glScopedPushClientAttrib&&) = delete; // No Move
+        glScopedPushClientAttrib& operator=(const glScopedPushClientAttrib& ) = delete; // No Copy
+        glScopedPushClientAttrib& operator=(      glScopedPushClientAttrib&&) = delete; // No Move
+    }; // struct glScopedPushClientAttrib final
 } // namespace OpenGL
 
 #endif // GUID_0E26C781_C56E_41AF_A47F_DD14D907BFCC
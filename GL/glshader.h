@@ -0,0 +1,300 @@
+#pragma once
+#ifndef GUID_97B5E1B1_4D65_40FD_BC73_B6F68765E601
+#define GUID_97B5E1B1_4D65_40FD_BC73_B6F68765E601
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <string>
+#include <utility>
+//--------------------------------------
+
+namespace OpenGL {
+    //**************************************************************************
+    // glScopedUseProgram
+    //**************************************************************************
+    class glScopedUseProgram final {
+    public:
+        glScopedUseProgram(::GLuint program) noexcept {
+            ::glUseProgram(program);
+            OpenGLAssertNoError();
+        }
+
+        ~glScopedUseProgram() noexcept {
+            ::glUseProgram(0);
+            OpenGLAssertNoError();
+        }
+
+        glScopedUseProgram(const glScopedUseProgram& ) = delete; // No Copy
+        glScopedUseProgram(      glScopedUseProgram&&) = delete; // No Move
+        glScopedUseProgram& operator=(const glScopedUseProgram& ) = delete; // No Copy
+        glScopedUseProgram& operator=(      glScopedUseProgram&&) = delete; // No Move
+    }; // class glScopedUseProgram final
+
+    class glProgram;
+
+    //**************************************************************************
+    // glProgramBuilder
+    //**************************************************************************
+    // Builds a `glProgram` in two steps, so compiling and
+    // linking can run while other frames are drawn: `begin`
+    // submits both shaders and the link without asking for
+    // the results (asking is what makes the driver wait),
+    // `finish` checks them. With parallel shader compile
+    // (`GL_ARB/KHR_parallel_shader_compile`) `ready` says
+    // whether the driver is done, so `finish` won't block;
+    // otherwise it can't tell and always says it is.
+    // Compile and link errors are logged by `finish`.
+    class glProgramBuilder final {
+    public:
+        static bool is_parallel() noexcept {
+#if defined(GL_KHR_parallel_shader_compile)
+            if (GLEW_KHR_parallel_shader_compile) { return true; }
+#endif
+#if defined(GL_ARB_parallel_shader_compile)
+            if (GLEW_ARB_parallel_shader_compile) { return true; }
+#endif
+            return false;
+        }
+
+    private:
+        // Same value for the ARB and KHR extensions
+        inline static constexpr const ::GLenum CompletionStatus{ 0x91B1 };
+
+        static std::string shader_log(::GLuint shader) {
+            ::GLint length{ 0 };
+            ::glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+            std::string log(static_cast<std::size_t>(length > 0 ? length : 1), '\0');
+            ::glGetShaderInfoLog(shader, static_cast<::GLsizei>(log.size()), nullptr, log.data());
+            return log;
+        }
+
+        static std::string program_log(::GLuint program) {
+            ::GLint length{ 0 };
+            ::glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+            std::string log(static_cast<std::size_t>(length > 0 ? length : 1), '\0');
+            ::glGetProgramInfoLog(program, static_cast<::GLsizei>(log.size()), nullptr, log.data());
+            return log;
+        }
+
+        static bool compiled(::GLuint shader,
+                             const char* szType) {
+            ::GLint status{ GL_FALSE };
+            ::glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+            if (status != GL_TRUE) {
+                SPDLOG_ERROR("Failed to compile {} shader: \"{}\"",
+                             szType, shader_log(shader).c_str());
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        glProgramBuilder(const glProgramBuilder&)            = delete; // No Copy
+        glProgramBuilder& operator=(const glProgramBuilder&) = delete; // No Copy
+
+    public:
+        glProgramBuilder() = default;
+
+        glProgramBuilder(glProgramBuilder&& other) noexcept :
+            m_Program { std::exchange(other.m_Program,  0) },
+            m_Vertex  { std::exchange(other.m_Vertex,   0) },
+            m_Fragment{ std::exchange(other.m_Fragment, 0) } {}
+
+        glProgramBuilder& operator=(glProgramBuilder&& other) noexcept {
+            cancel();
+            using std::swap;
+            swap(m_Program,  other.m_Program);
+            swap(m_Vertex,   other.m_Vertex);
+            swap(m_Fragment, other.m_Fragment);
+            return *this;
+        }
+
+        ~glProgramBuilder() noexcept { cancel(); }
+
+    public:
+        // Replaces any build in progress
+        bool begin(const char* szVertexSource,
+                   const char* szFragmentSource) {
+            cancel();
+            m_Vertex   = ::glCreateShader(GL_VERTEX_SHADER);
+            m_Fragment = ::glCreateShader(GL_FRAGMENT_SHADER);
+            m_Program  = ::glCreateProgram();
+            if (!m_Vertex || !m_Fragment || !m_Program) {
+                cancel();
+                return false;
+            }
+            ::glShaderSource(m_Vertex,   1, &szVertexSource,   nullptr);
+            ::glShaderSource(m_Fragment, 1, &szFragmentSource, nullptr);
+            ::glCompileShader(m_Vertex);
+            ::glCompileShader(m_Fragment);
+            ::glAttachShader(m_Program, m_Vertex);
+            ::glAttachShader(m_Program, m_Fragment);
+            ::glLinkProgram(m_Program);
+            OpenGLAssertNoError();
+            return true;
+        }
+
+        [[nodiscard]]
+        bool pending() const noexcept { return m_Program != 0; }
+
+        [[nodiscard]]
+        bool ready() const noexcept {
+            if (!pending() || !is_parallel()) { return true; }
+            ::GLint status{ GL_TRUE };
+            ::glGetProgramiv(m_Program, CompletionStatus, &status);
+            return status != GL_FALSE;
+        }
+
+        // The built program, or none (if it failed or
+        // nothing was begun)
+        glProgram finish();
+
+        void cancel() noexcept {
+            if (m_Program)  { ::glDeleteProgram(std::exchange(m_Program,  0)); }
+            if (m_Vertex)   { ::glDeleteShader (std::exchange(m_Vertex,   0)); }
+            if (m_Fragment) { ::glDeleteShader (std::exchange(m_Fragment, 0)); }
+        }
+
+    private:
+        ::GLuint m_Program { 0 };
+        ::GLuint m_Vertex  { 0 };
+        ::GLuint m_Fragment{ 0 };
+    }; // class glProgramBuilder final
+
+    //**************************************************************************
+    // glProgram
+    //**************************************************************************
+    // GLSL program (OpenGL 2.0) from vertex and fragment
+    // shader source. Compile and link errors are logged and
+    // leave no program. `create` waits for the driver; see
+    // `glProgramBuilder` to build without waiting.
+    class glProgram final {
+    private:
+        friend class glProgramBuilder;
+
+    public:
+        static bool is_supported() noexcept {
+            return GLEW_VERSION_2_0;
+        }
+
+    private:
+        glProgram(const glProgram&)            = delete; // No Copy
+        glProgram& operator=(const glProgram&) = delete; // No Copy
+
+        explicit glProgram(::GLuint program) noexcept :
+            m_Program{ program } {}
+
+    public:
+        glProgram() = default;
+
+        glProgram(glProgram&& other) noexcept :
+            m_Program{ std::exchange(other.m_Program, 0) } {}
+
+        glProgram& operator=(glProgram&& other) noexcept {
+            destroy();
+            using std::swap;
+            swap(m_Program, other.m_Program);
+            return *this;
+        }
+
+        ~glProgram() noexcept { destroy(); }
+
+    public:
+        bool create(const char* szVertexSource,
+                    const char* szFragmentSource) {
+            destroy();
+            glProgramBuilder builder{};
+            if (builder.begin(szVertexSource, szFragmentSource)) {
+                *this = builder.finish();
+            }
+            return m_Program != 0;
+        }
+
+        void destroy() noexcept {
+            if (m_Program) {
+                ::glDeleteProgram(std::exchange(m_Program, 0));
+                OpenGLAssertNoError();
+            }
+        }
+
+        void use() const noexcept {
+            ::glUseProgram(m_Program);
+            OpenGLAssertNoError();
+        }
+
+        [[nodiscard]]
+        auto scoped_use() const noexcept {
+            return glScopedUseProgram{ m_Program };
+        }
+
+        // -1 for a uniform which doesn't exist (or was
+        // optimised away), which `glUniform*` ignores
+        ::GLint uniform_location(const char* szName) const noexcept {
+            return m_Program ? ::glGetUniformLocation(m_Program, szName) : -1;
+        }
+
+        constexpr auto name() const noexcept {
+            return m_Program;
+        }
+
+    public:
+        constexpr operator const GLuint () const noexcept { return m_Program; }
+
+        explicit constexpr operator bool() const noexcept { return m_Program != 0; }
+
+    private:
+        ::GLuint m_Program{ 0 };
+    }; // class glProgram final
+
+    //**************************************************************************
+    // glProgramBuilder [[Implementation]]
+    //**************************************************************************
+    inline glProgram glProgramBuilder::finish() {
+        if (!pending()) { return glProgram{}; }
+        const auto bCompiled{ compiled(m_Vertex,   "vertex") &&
+                              compiled(m_Fragment, "fragment") };
+        ::GLint status{ GL_FALSE };
+        if (bCompiled) {
+            ::glGetProgramiv(m_Program, GL_LINK_STATUS, &status);
+            if (status != GL_TRUE) {
+                SPDLOG_ERROR("Failed to link shader program: \"{}\"",
+                             program_log(m_Program).c_str());
+            }
+        }
+        // Shaders are only flagged for deletion while attached
+        ::glDeleteShader(std::exchange(m_Vertex,   0));
+        ::glDeleteShader(std::exchange(m_Fragment, 0));
+        const auto program{ std::exchange(m_Program, 0) };
+        OpenGLAssertNoError();
+        if (bCompiled && status == GL_TRUE) { return glProgram{ program }; }
+        ::glDeleteProgram(program);
+        return glProgram{};
+    }
+} // namespace OpenGL
+
+#endif // GUID_97B5E1B1_4D65_40FD_BC73_B6F68765E601
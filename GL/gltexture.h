@@ -142,6 +142,34 @@ namespace OpenGL {
             OpenGLAssertNoError();
         }
 
+        static void sub_image(::GLenum  target,
+                              ::GLint   level,
+                              ::GLint   xoffset,
+                              ::GLsizei width,
+                              ::GLint   dataFormat,
+                              ::GLenum  dataType,
+                              const ::GLvoid* pixels) noexcept {
+            ::glTexSubImage1D(target, level,
+                              xoffset, width,
+                              dataFormat, dataType, pixels);
+            OpenGLAssertNoError();
+        }
+
+        static void sub_image(::GLenum  target,
+                              ::GLint   level,
+                              ::GLint   xoffset,
+                              ::GLint   yoffset,
+                              ::GLsizei width,
+                              ::GLsizei height,
+                              ::GLint   dataFormat,
+                              ::GLenum  dataType,
+                              const ::GLvoid* pixels) noexcept {
+            ::glTexSubImage2D(target, level,
+                              xoffset, yoffset, width, height,
+                              dataFormat, dataType, pixels);
+            OpenGLAssertNoError();
+        }
+
         static void parameter(::GLenum target,
                               ::GLenum pname,
                               ::GLfloat value) noexcept {
@@ -0,0 +1,159 @@
+#pragma once
+#ifndef GUID_990AB905_8087_49B8_A0FE_5A0A22F4C0BC
+#define GUID_990AB905_8087_49B8_A0FE_5A0A22F4C0BC
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "LCD/LCD.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+namespace LCD {
+    //**************************************************************************
+    // HeadlessLCD:
+    // ------------
+    //
+    // A display with no device behind it, for running (and checking)
+    // rendering and presenting without one. Frames are kept in buffers
+    // of its own: a colour display offers them to be written in place
+    // (see `ILCD::GetFrameBuffer`), anything else given it is copied
+    // into the first, and counted (see `ILCD::GetCopyCount`).
+    //
+    // Not locked: while presenting, only the presenter thread uses it.
+    //**************************************************************************
+    class HeadlessLCD final : public ::LCD::ILCD {
+    private:
+        using thisClass = HeadlessLCD;
+        using baseClass = ::LCD::ILCD;
+
+    public:
+        using byte_type = std::uint8_t;
+        using size_type = std::size_t;
+
+    public:
+        template <typename... ArgPackT>
+        static void initialise(ArgPackT&& ...args) {
+            baseClass::initialise<thisClass>(std::forward<ArgPackT>(args)...);
+        }
+
+    public:
+        HeadlessLCD(singleton_constructor_tag /*tag*/,
+                    const DeviceDesc& device) :
+            m_Device{ device } {
+            // Allocated once, as frame buffers must last as long
+            // as the display does
+            const auto nStride{ ((device.iWidth * device.iBitsPerPixel + 31) / 32) * 4 };
+            const auto nSize  { static_cast<size_type>(nStride) * static_cast<size_type>(device.iHeight) };
+            for (auto& buffer : m_Buffers) {
+                buffer.assign(nSize, 0);
+            }
+        }
+
+    public:
+        // What the display shows: the frame buffer it last sent
+        const byte_type* GetShownFrame() const noexcept { return m_pShown; }
+
+    public: // ::LCD::ILCD
+        UpdateStatus Update(void* pData,
+                            const dirty_rect_type& dirty) override {
+            if (!pData || !Connected()) {
+                m_bStale = true;
+                return UpdateStatus::Skipped;
+            }
+
+            const auto width { GetWidth() };
+            const auto height{ GetHeight() };
+            const auto rect  { dirty.clipped(width, height) };
+
+            // As `LogitechLCD`: a frame written in place is whole,
+            // one copied must be while stale
+            const bool bInPlace{ (pData == GetFrameBuffer(0)) || (pData == GetFrameBuffer(1)) };
+            if (m_bStale && !bInPlace && !rect.covers(width, height)) {
+                return UpdateStatus::Skipped;
+            }
+            const bool bForce{ std::exchange(m_bStale, false) };
+
+            auto* pShown{ static_cast<byte_type*>(pData) };
+            if (!bInPlace) {
+                pShown = m_Buffers.front().data();
+                if (rect) {
+                    ++m_nCopies;
+                    const auto nStride{ static_cast<size_type>(GetDisplayStride()) };
+                    const auto nOffset{ static_cast<size_type>(rect.top) * nStride };
+                    std::memcpy(pShown + nOffset,
+                                static_cast<const byte_type*>(pData) + nOffset,
+                                static_cast<size_type>(rect.height()) * nStride);
+                }
+            }
+
+            if (!bForce && !rect && (pShown == m_pShown)) {
+                return UpdateStatus::Unchanged;
+            }
+            m_pShown = pShown;
+            return UpdateStatus::Success;
+        }
+
+        bool NeedsFullUpdate() const noexcept override { return m_bStale; }
+
+        // Colour only, as for `LogitechLCD`
+        void* GetFrameBuffer(std::size_t index) noexcept override {
+            if (!Connected() || (GetDeviceType() != DeviceType::Color) || (index >= m_Buffers.size())) {
+                return nullptr;
+            }
+            return m_Buffers[index].data();
+        }
+
+    protected: // ::LCD::ILCD
+        bool OnConnect(DeviceDesc& desc,
+                       DeviceType prefered,
+                       void* /*data*/) override {
+            if ((prefered != DeviceType::Unknown) && (prefered != m_Device.eType)) {
+                return false;
+            }
+            desc     = m_Device;
+            m_bStale = true;
+            return true;
+        }
+
+        bool OnDisconnect(void* /*data*/) noexcept override {
+            m_bStale = true;
+            return true;
+        }
+
+    private:
+        DeviceDesc       m_Device{};
+        std::array<std::vector<byte_type>, FrameBufferCount> m_Buffers{};
+        const byte_type* m_pShown{ nullptr };
+        bool             m_bStale{ true };
+    }; // class HeadlessLCD final
+} // namespace LCD
+
+#endif // GUID_990AB905_8087_49B8_A0FE_5A0A22F4C0BC
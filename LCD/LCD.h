@@ -24,6 +24,7 @@
 
 //--------------------------------------
 //
+#include "Util/DirtyRect.h"
 #include "Util/FlagEnum.h"
 #include "Util/Singleton.h"
 //--------------------------------------
@@ -31,6 +32,7 @@
 //--------------------------------------
 //
 #include <cassert>
+#include <cstddef>
 #include <memory>
 #include <functional>
 //--------------------------------------
@@ -144,11 +146,13 @@ namespace LCD {
         using Notification         = ::LCD::Device::Notification;
         using NotificationCode     = typename Notification::What;
         using NotificationCallback = typename Notification::callback_type;
+        using dirty_rect_type      = ::util::dirty_rect;
 
         enum class UpdateStatus {
             Success = 0,
             Skipped,
             Failure,
+            Unchanged, //< Nothing new to show, so nothing was sent
         };
 
         FLAG_ENUM_NO_OPS(Flags,
@@ -209,7 +213,23 @@ namespace LCD {
         virtual bool OnDisconnect(void* pData) noexcept = 0;
 
     public:
-        virtual UpdateStatus Update(void* pData) = 0;
+        // Only `dirty` differs from the last update, so only
+        // it need be valid in `pData`
+        virtual UpdateStatus Update(void* pData,
+                                    const dirty_rect_type& dirty) = 0;
+
+        // The next update must cover the whole display (e.g.
+        // earlier ones were never copied)
+        virtual bool NeedsFullUpdate() const noexcept { return false; }
+
+        // Storage the display sends from, if frames can be
+        // written straight into it: `FrameBufferCount` of them
+        // to alternate between, so one can be written while
+        // another is sent. Each keeps what was written to it
+        // for as long as the display lasts; an update given
+        // one copies nothing
+        static constexpr std::size_t FrameBufferCount{ 2 };
+        virtual void* GetFrameBuffer(std::size_t /*index*/) noexcept { return nullptr; }
 
         // Get current state of all buttons
         virtual ButtonState GetButtons() const noexcept {
@@ -262,13 +282,23 @@ namespace LCD {
         constexpr auto GetButtonCount () const noexcept { return m_Desc.iButtonCount; }
         constexpr auto GetDeviceType  () const noexcept { return m_Desc.eType; }
 
+        // Rows are padded to 32 bits (a no-op for anything
+        // but packed monochrome of an odd width)
+        constexpr auto GetDisplayStride() const noexcept {
+            return ((GetWidth() * GetBitsPerPixel() + 31) / 32) * 4;
+        }
+
         constexpr auto GetDisplayByteSize() const noexcept {
-            return GetWidth() * GetHeight() * (GetBitsPerPixel() / 8);
+            return GetDisplayStride() * GetHeight();
         }
 
         constexpr auto GetDisplayPriority() const noexcept { return m_Priority; }
         constexpr auto GetFlags          () const noexcept { return m_Flags; }
 
+        // Updates that copied frame data into the display's
+        // own storage
+        constexpr auto GetCopyCount() const noexcept { return m_nCopies; }
+
         constexpr bool Connected() const noexcept {
             return static_cast<bool>(m_Desc);
         }
@@ -295,6 +325,9 @@ namespace LCD {
             }
         }
 
+    protected:
+        std::size_t          m_nCopies             { 0 };
+
     private: //Data
         DeviceDesc           m_Desc                { };
         Priority             m_Priority            { Priority::Foreground };
@@ -0,0 +1,265 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "LCD/LCD_Presenter.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cstring>
+#include <utility>
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Util/InterpolateUtil.h"
+//--------------------------------------
+
+namespace LCD {
+    //**************************************************************************
+    // Presenter
+    //**************************************************************************
+    bool Presenter::StartThread(display_pointer pDisplay) {
+        assert(pDisplay); if (!pDisplay) { return false; }
+        assert(!m_Thread.joinable()); if (m_Thread.joinable()) { return false; }
+
+        {
+            const std::lock_guard<std::mutex> lock{ m_Mutex };
+            m_pDisplay   = pDisplay;
+            m_nStride    = static_cast<size_type>(pDisplay->GetDisplayStride());
+            m_iWidth     = static_cast<int>(pDisplay->GetWidth());
+            m_iHeight    = static_cast<int>(pDisplay->GetHeight());
+            m_nFrameSize = m_nStride * static_cast<size_type>(std::max(m_iHeight, 0));
+
+            std::array<void*, display::FrameBufferCount> buffers{};
+            m_bInPlace = true;
+            for (size_type i = 0; i < buffers.size(); ++i) {
+                buffers[i] = pDisplay->GetFrameBuffer(i);
+                m_bInPlace = m_bInPlace && buffers[i];
+            }
+            for (size_type i = 0; i < buffers.size(); ++i) {
+                if (m_bInPlace) {
+                    m_Buffers[i].clear();
+                } else {
+                    m_Buffers[i].resize(m_nFrameSize);
+                    buffers[i] = m_Buffers[i].data();
+                }
+                // Zeroed, which no finished colour frame matches (it
+                // is opaque), so the first still changes all of it
+                if (m_nFrameSize) { std::memset(buffers[i], 0, m_nFrameSize); }
+            }
+            m_pMailbox   = m_nFrameSize ? buffers[0] : nullptr;
+            m_pFront     = m_nFrameSize ? buffers[1] : nullptr;
+            m_Pending    = {};
+            m_Stale      = {};
+            m_bWhole     = false;
+            m_bWake      = false;
+            m_bStop      = false;
+            m_Statistics = {};
+        }
+        if (!m_pMailbox) { return false; }
+
+        m_Thread = std::thread{
+            [this]() noexcept {
+                try {
+                    Run();
+                } catch (...) {
+                    SafeLogCritical("Unhandled exception in LCD presenter thread.");
+                    assert(false);
+                }
+            }
+        };
+        return m_Thread.joinable();
+    }
+
+    //------------------------------------------------------
+
+    void Presenter::StopThread() noexcept {
+        if (!m_Thread.joinable()) { return; }
+
+        {
+            const std::lock_guard<std::mutex> lock{ m_Mutex };
+            m_bStop = true;
+        }
+        m_Wake.notify_one();
+
+        try {
+            m_Thread.join();
+        } catch (...) {
+            assert(false);
+        }
+        m_pDisplay.reset();
+        {
+            const std::lock_guard<std::mutex> lock{ m_Mutex };
+            m_pMailbox = nullptr;
+            m_pFront   = nullptr;
+        }
+
+        [[maybe_unused]] const auto stats{ GetStatistics() }; //< Unused if debug logging is compiled out
+        SafeLogDebug("LCD presenter: {} frames posted, {} replaced, {} submitted, {} unchanged, {} dropped",
+                     stats.m_nPosted,
+                     stats.m_nReplaced,
+                     stats.m_nSubmitted,
+                     stats.m_nUnchanged,
+                     stats.m_nDropped);
+    }
+
+    //------------------------------------------------------
+
+    void Presenter::Post(const void* pFrame,
+                         const dirty_rect_type& dirty) {
+        if (!pFrame) { return; }
+        Post([&](void* pMailbox, const dirty_rect_type& stale) {
+            const auto rect{ dirty.clipped(m_iWidth, m_iHeight) };
+            auto       rows{ stale };
+            if (rows.merge(rect)) {
+                const auto nOffset{ static_cast<size_type>(rows.top) * m_nStride };
+                std::memcpy(static_cast<byte_type*>(pMailbox) + nOffset,
+                            static_cast<const byte_type*>(pFrame) + nOffset,
+                            static_cast<size_type>(rows.height()) * m_nStride);
+            }
+            return rect;
+        });
+    }
+
+    //------------------------------------------------------
+
+    void Presenter::Refresh() {
+        {
+            const std::lock_guard<std::mutex> lock{ m_Mutex };
+            m_bWake = true;
+        }
+        m_Wake.notify_one();
+    }
+
+    //------------------------------------------------------
+
+    bool Presenter::NeedsWholeFrame() const {
+        const std::lock_guard<std::mutex> lock{ m_Mutex };
+        return !m_bWhole;
+    }
+
+    //------------------------------------------------------
+
+    Presenter::statistics Presenter::GetStatistics() const {
+        const std::lock_guard<std::mutex> lock{ m_Mutex };
+        return m_Statistics;
+    }
+
+    //------------------------------------------------------
+
+    // Called with `m_Mutex` held
+    void Presenter::OnPosted(dirty_rect_type dirty) noexcept {
+        // Stale rows can't be compared with the last frame by the
+        // writer, so any it changed count; the display was given
+        // that frame though (else the mailbox wouldn't be stale),
+        // so the edge rows can be checked against it here
+        const auto stale{ std::exchange(m_Stale, dirty_rect_type{}) };
+        const auto sameRow = [&](int row) noexcept {
+            if ((row < stale.top) || (row >= stale.bottom)) { return false; }
+            const auto nOffset{ static_cast<size_type>(row) * m_nStride };
+            return std::memcmp(static_cast<const byte_type*>(m_pMailbox) + nOffset,
+                               static_cast<const byte_type*>(m_pFront) + nOffset,
+                               m_nStride) == 0;
+        };
+        while (dirty && sameRow(dirty.top))        { ++dirty.top; }
+        while (dirty && sameRow(dirty.bottom - 1)) { --dirty.bottom; }
+
+        m_bWake = true;
+        if (!dirty) { return; }
+
+        ++m_Statistics.m_nPosted;
+        if (m_Pending) { ++m_Statistics.m_nReplaced; }
+        m_PostTime = clock_type::now();
+        m_Pending.merge(dirty);
+        if (dirty.covers(m_iWidth, m_iHeight)) { m_bWhole = true; }
+    }
+
+    //------------------------------------------------------
+
+    void Presenter::Run() {
+        const auto all{ dirty_rect_type::all(m_iWidth, m_iHeight) };
+        for (;;) {
+            dirty_rect_type dirty    {};
+            bool            bNewFrame{ false };
+            duration_type   fWaitMS  { 0 }; //< Newest frame's time in the mailbox
+            {
+                std::unique_lock<std::mutex> lock{ m_Mutex };
+                m_Wake.wait(lock, [this]() noexcept { return m_bWake || m_bStop; });
+                if (m_bStop) { break; }
+                m_bWake = false;
+
+                // Nothing to show until a whole frame arrives, and
+                // nothing safe to show if the device changed under it
+                if (!m_bWhole || (static_cast<size_type>(m_pDisplay->GetDisplayByteSize()) != m_nFrameSize)) {
+                    continue;
+                }
+
+                // A new frame is taken by swapping it for the last the
+                // display was given, which is then the display's alone
+                // while it updates; the mailbox is left what changed
+                // between the two behind
+                dirty     = std::exchange(m_Pending, dirty_rect_type{});
+                bNewFrame = static_cast<bool>(dirty);
+                if (bNewFrame) {
+                    fWaitMS = ElapsedMilliseconds(m_PostTime);
+                    std::swap(m_pMailbox, m_pFront);
+                    m_Stale = dirty;
+                }
+                if (m_pDisplay->NeedsFullUpdate()) { dirty = all; }
+            }
+
+            //Send the update to the LCD, if using VSync this may take a long time to return
+            // (an unchanged frame is only sent if the display needs it, e.g. for priority)
+            [[maybe_unused]] const auto nCopies{ m_pDisplay->GetCopyCount() };
+            const auto updateStart{ clock_type::now() };
+            const auto status{ m_pDisplay->Update(m_pFront, dirty) };
+            const auto fUpdateMS{ ElapsedMilliseconds(updateStart) };
+            // Nothing else copies frames, so in place none are
+            assert(!m_bInPlace || (m_pDisplay->GetCopyCount() == nCopies));
+
+            constexpr const duration_type fWeight{ .1f };
+            const std::lock_guard<std::mutex> lock{ m_Mutex };
+            switch (status) {
+                case update_status::Success:
+                    ++m_Statistics.m_nSubmitted;
+                    if (bNewFrame) {
+                        m_Statistics.m_fLatencyMS     = fWaitMS + fUpdateMS;
+                        m_Statistics.m_fMeanLatencyMS = ::util::lerp(m_Statistics.m_fMeanLatencyMS,
+                                                                     m_Statistics.m_fLatencyMS,
+                                                                     fWeight);
+                    }
+                    break;
+                case update_status::Unchanged: ++m_Statistics.m_nUnchanged; break;
+                case update_status::Skipped:
+                    [[fallthrough]];
+                case update_status::Failure:
+                    if (bNewFrame) { ++m_Statistics.m_nDropped; }
+                    break;
+                HintNoDefault();
+            }
+        }
+    }
+} // namespace LCD
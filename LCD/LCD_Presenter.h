@@ -0,0 +1,187 @@
+#pragma once
+#ifndef GUID_A49F5E36_379E_4902_9FE0_33DCE1C8E765
+#define GUID_A49F5E36_379E_4902_9FE0_33DCE1C8E765
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "LCD/LCD.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+namespace LCD {
+    //**************************************************************************
+    // Presenter:
+    // ----------
+    //
+    // Sends frames to an `ILCD` from a dedicated thread, so an update that
+    // blocks (e.g. waiting for VSync) holds up neither rendering nor the
+    // rest of the render thread's work.
+    //
+    // Frames are handed over through a single "mailbox" buffer: posting
+    // writes what changed into it and returns without waiting for the
+    // display. A frame not yet taken when the next is posted is replaced
+    // by it (latest wins), so the display is always sent the newest
+    // complete frame. Dirty rects of replaced frames merge, so nothing
+    // they changed is lost.
+    //
+    // The mailbox always holds a whole frame once one has been posted, so
+    // the display can be sent all of it whenever it needs (e.g. after
+    // missed updates) without anything being redrawn.
+    //
+    // Nothing is copied between the mailbox and the display: the two
+    // alternate (a pointer swap when the display takes a frame), which
+    // leaves the mailbox holding an older frame. Where that differs
+    // from the newest is passed to the next post to rewrite. Frames
+    // are written straight into the display's own buffers where it
+    // has them (see `ILCD::GetFrameBuffer`).
+    //
+    //**************************************************************************
+    class Presenter final {
+    private:
+        using this_class = Presenter;
+
+    public:
+        using display         = ::LCD::ILCD;
+        using display_pointer = typename display::pointer_type;
+        using dirty_rect_type = typename display::dirty_rect_type;
+        using update_status   = typename display::UpdateStatus;
+        using byte_type       = std::uint8_t;
+        using size_type       = std::size_t;
+        using duration_type   = float;
+
+    private:
+        // Only standard threading and timing, so the presenter
+        // builds (and is tested) without Windows
+        using clock_type = std::chrono::steady_clock;
+        using time_point = typename clock_type::time_point;
+
+    public:
+        struct statistics final {
+            size_type     m_nPosted       { 0 }; //< Frames that changed something
+            size_type     m_nReplaced     { 0 }; //< Posted frames replaced before being taken
+            size_type     m_nSubmitted    { 0 }; //< Updates the display took
+            size_type     m_nUnchanged    { 0 }; //< Updates avoided as the frame matched the last
+            size_type     m_nDropped      { 0 }; //< Frames taken that the display skipped or failed
+            duration_type m_fLatencyMS    { 0 }; //< Post to the display taking it (most recent)
+            duration_type m_fMeanLatencyMS{ 0 }; //< Moving average
+        };
+
+    public:
+        Presenter() noexcept = default;
+
+        ~Presenter() noexcept {
+            StopThread();
+        }
+
+        Presenter(const this_class& )             = delete; // No Copy
+        Presenter(      this_class&&)             = delete; // No Move
+        this_class& operator=(const this_class& ) = delete; // No Copy
+        this_class& operator=(      this_class&&) = delete; // No Move
+
+    public:
+        // Frames are laid out as the display's (see
+        // `ILCD::GetDisplayStride`) when this is called
+        bool StartThread(display_pointer pDisplay);
+        void StopThread () noexcept;
+
+        // `fnWrite(void* pMailbox, const dirty_rect_type& stale)`
+        // writes a frame into the mailbox and returns what it
+        // changed from the last posted. The mailbox holds that
+        // frame but for `stale`, which must be rewritten even
+        // where nothing changed. Called with the mailbox
+        // locked, so should be quick.
+        template <typename FuncT>
+        void Post(FuncT&& fnWrite) {
+            {
+                const std::lock_guard<std::mutex> lock{ m_Mutex };
+                if (!m_pMailbox) { return; }
+                const dirty_rect_type dirty{ fnWrite(m_pMailbox, std::as_const(m_Stale)) };
+                OnPosted(dirty.clipped(m_iWidth, m_iHeight));
+            }
+            m_Wake.notify_one();
+        }
+
+        // Copies the `dirty` (and stale) rows of `pFrame`
+        // into the mailbox
+        void Post(const void* pFrame,
+                  const dirty_rect_type& dirty);
+
+        // Has the display updated without a new frame, so it
+        // can still resend (e.g. for a priority change)
+        void Refresh();
+
+        // Until a frame covering the whole display is posted
+        [[nodiscard]]
+        bool NeedsWholeFrame() const;
+
+        [[nodiscard]]
+        statistics GetStatistics() const;
+
+    private:
+        void OnPosted(dirty_rect_type dirty) noexcept;
+        void Run();
+
+        static duration_type ElapsedMilliseconds(time_point start) noexcept {
+            return std::chrono::duration<duration_type, std::milli>(clock_type::now() - start).count();
+        }
+
+    private:
+        display_pointer         m_pDisplay   {};
+        std::thread             m_Thread     {};
+        mutable std::mutex      m_Mutex      {};
+        std::condition_variable m_Wake       {};
+
+        // Frames, unless the display has buffers of its own
+        std::array<std::vector<byte_type>,
+                   display::FrameBufferCount> m_Buffers{};
+        bool                    m_bInPlace   { false }; //< Using the display's buffers
+
+        // Guarded by `m_Mutex`
+        void*                   m_pMailbox   { nullptr };
+        void*                   m_pFront     { nullptr }; //< Last given to the display (swapped by the presenter thread)
+        dirty_rect_type         m_Pending    {}; //< Changed since the display was last given a frame
+        dirty_rect_type         m_Stale      {}; //< Where the mailbox is older than the last posted frame
+        time_point              m_PostTime   {}; //< Of the newest frame
+        size_type               m_nStride    { 0 };
+        size_type               m_nFrameSize { 0 };
+        int                     m_iWidth     { 0 };
+        int                     m_iHeight    { 0 };
+        bool                    m_bWhole     { false };
+        bool                    m_bWake      { false };
+        bool                    m_bStop      { false };
+        statistics              m_Statistics {};
+    }; // class Presenter final
+} // namespace LCD
+
+#endif // GUID_A49F5E36_379E_4902_9FE0_33DCE1C8E765
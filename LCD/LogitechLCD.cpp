@@ -25,6 +25,11 @@
 #include "LogitechLCD.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include "Util/BitPlane.h"
+//--------------------------------------
+
 namespace LCD::Logitech {
     //**************************************************************************
     // LogitechLCD
@@ -114,9 +119,11 @@ namespace LCD::Logitech {
             return false;
         }
 
+        lgDevice device{};
+        auto     format{ m_LGLcdBitmaps.front().hdr.Format };
         switch (type) {
             case DeviceType::Color: {
-                m_Device = m_Connection.OpenDevice(LGLCD_DEVICE_QVGA);
+                device = m_Connection.OpenDevice(LGLCD_DEVICE_QVGA);
 
                 desc.eType         = DeviceType::Color;
                 desc.iWidth        = LGLCD_QVGA_BMP_WIDTH;
@@ -124,39 +131,62 @@ namespace LCD::Logitech {
                 desc.iBitsPerPixel = LGLCD_QVGA_BMP_BPP * 8;
                 desc.iButtonCount  = 8;
 
-                m_LGLcdBitmap.hdr.Format = LGLCD_BMP_FORMAT_QVGAx32;
+                format = LGLCD_BMP_FORMAT_QVGAx32;
                 break;
             }
 
             case DeviceType::Monochrome: {
-                m_Device = m_Connection.OpenDevice(LGLCD_DEVICE_BW);
+                device = m_Connection.OpenDevice(LGLCD_DEVICE_BW);
 
                 desc.eType         = DeviceType::Monochrome;
                 desc.iWidth        = LGLCD_BW_BMP_WIDTH;
                 desc.iHeight       = LGLCD_BW_BMP_HEIGHT;
-                desc.iBitsPerPixel = 8;
+                desc.iBitsPerPixel = 1; //< Packed, expanded in `Update`
                 desc.iButtonCount  = 4;
 
-                m_LGLcdBitmap.hdr.Format = LGLCD_BMP_FORMAT_160x43x1;
+                format = LGLCD_BMP_FORMAT_160x43x1;
                 break;
             }
 
             DEFAULT_UNREACHABLE;
         }
 
+        // Opened unlocked, in case the SDK notifies (so locks)
+        // before returning
+        const auto submit{ m_SubmitLock.ScopedLock() };
+        const auto lock  { m_Lock.ScopedLock() };
+        m_Device = std::move(device);
+        m_bStale = true;
+        m_bShown = false;
+        for (auto& bitmap : m_LGLcdBitmaps) {
+            bitmap.hdr.Format = format;
+        }
+
         return DeviceOpened();
     }
 
     //--------------------------------------------------------------------------
 
     bool LogitechLCD::OnDisconnect(void* /*data*/) noexcept {
+        const auto submit{ m_SubmitLock.ScopedLock() };
+        const auto lock  { m_Lock.ScopedLock() };
         return (!m_Device || m_Device.Close());
     }
 
     //--------------------------------------------------------------------------
 
-    LogitechLCD::UpdateStatus LogitechLCD::Update(void* data) {
+    bool LogitechLCD::HasDevice() const noexcept {
+        const auto lock{ m_Lock.ScopedLock() };
+        return DeviceOpened();
+    }
+
+    //--------------------------------------------------------------------------
+
+    LogitechLCD::UpdateStatus LogitechLCD::Update(void* data,
+                                                  const dirty_rect_type& dirty) {
         assert(data);
+        const auto submit{ m_SubmitLock.ScopedLock() };
+        auto       lock  { m_Lock.ScopedLock() };
         if (!data) {
             SafeLogError("Invalid parameter: update data is null.");
             return UpdateStatus::Skipped;
@@ -164,25 +194,87 @@ namespace LCD::Logitech {
 
         if (!m_Device) {
             SafeLogTrace("Skipping LCD Update: No device currently initialised.");
+            m_bStale = true;
             return UpdateStatus::Skipped;
         }
 
         if (!m_bAppletEnabled) {
             SafeLogInfo("Skipping LCD Update: Applet is currently disabled.");
+            m_bStale = true;
             return UpdateStatus::Skipped;
         }
 
-        if (m_LGLcdBitmap.hdr.Format == LGLCD_BMP_FORMAT_160x43x1) {
-            std::memcpy(m_LGLcdBitmap.bmp_mono.pixels,
-                        data, GetDisplayByteSize());
-        } else {
-            std::memcpy(m_LGLcdBitmap.bmp_qvga32.pixels,
-                        data, GetDisplayByteSize());
+        const auto width { GetWidth() };
+        const auto height{ GetHeight() };
+        const auto rect  { dirty.clipped(width, height) };
+
+        // A frame written in place is whole (the writer was asked
+        // for everything while stale) even if few rows changed,
+        // and is sent from where it was written
+        std::size_t nBitmap{ 0 };
+        while ((nBitmap < FrameBufferCount) && (data != GetFrameBuffer(nBitmap))) {
+            ++nBitmap;
+        }
+        const bool bInPlace{ nBitmap < FrameBufferCount };
+        auto&      bitmap  { m_LGLcdBitmaps[bInPlace ? nBitmap : 0] };
+        if (m_bStale && !bInPlace && !rect.covers(width, height)) {
+            SafeLogTrace("Skipping LCD Update: Bitmap is stale and update is partial.");
+            return UpdateStatus::Skipped;
+        }
+        const bool bForce{ std::exchange(m_bStale, false) };
+
+        // Dirty rows are only copied where they differ from the
+        // last update: drawing something identical (e.g. a paused
+        // scope, or stopped playback) sends nothing.
+        bool bChanged{ false };
+        if (bInPlace) {
+            // Written in place, by a writer that found what changed
+            bChanged = bForce || static_cast<bool>(rect);
+        } else if (rect) {
+            ++m_nCopies;
+            const auto* pData{ static_cast<const std::uint8_t*>(data) };
+            if (bitmap.hdr.Format == LGLCD_BMP_FORMAT_160x43x1) {
+                // Whole rows, as they are packed
+                const auto stride{ ::util::bit_plane::stride(width) };
+                assert(stride * height <= m_MonoPixels.size());
+                const auto* pSrc { pData + rect.top * stride };
+                auto*       pLast{ m_MonoPixels.data() + rect.top * stride };
+                auto*       pDst { bitmap.bmp_mono.pixels + rect.top * width };
+                for (auto row = rect.top; row < rect.bottom; ++row) {
+                    if (bForce || std::memcmp(pLast, pSrc, stride) != 0) {
+                        std::memcpy(pLast, pSrc, stride);
+                        ::util::bit_plane::expand(pSrc, pDst, width, 1);
+                        bChanged = true;
+                    }
+                    pSrc  += stride;
+                    pLast += stride;
+                    pDst  += width;
+                }
+            } else {
+                constexpr const auto nBytesPerPixel{ LGLCD_QVGA_BMP_BPP };
+                const auto stride{ GetDisplayStride() };
+                const auto nRowBytes{ rect.width() * nBytesPerPixel };
+                const auto nOffset  { rect.top * stride + rect.left * nBytesPerPixel };
+                const auto* pSrc{ pData + nOffset };
+                auto*       pDst{ bitmap.bmp_qvga32.pixels + nOffset };
+                for (auto row = rect.top; row < rect.bottom; ++row) {
+                    if (bForce || std::memcmp(pDst, pSrc, nRowBytes) != 0) {
+                        std::memcpy(pDst, pSrc, nRowBytes);
+                        bChanged = true;
+                    }
+                    pSrc += stride;
+                    pDst += stride;
+                }
+            }
+        }
+
+        const auto priority = GetDisplayPriority();
+        if (!bChanged && m_bShown && (priority == m_ShownPriority)) {
+            return UpdateStatus::Unchanged;
         }
 
         using LGPriority = typename lgDevice::Priority;
 
-        const auto priority = GetDisplayPriority();
         LGPriority nativePriority{ 0 };
         switch (priority) {
             case Priority::Idle:       nativePriority = LGLCD_PRIORITY_IDLE_NO_SHOW; break;
@@ -193,9 +285,13 @@ namespace LCD::Logitech {
         }
 
         const auto flags{ GetFlags() };
-        const auto status = m_Device.UpdateBitmap(&(m_LGLcdBitmap.hdr),
+        lock.Release(); //< `m_SubmitLock` keeps `m_Device` open
+        const auto status = m_Device.UpdateBitmap(&(bitmap.hdr),
                                                   nativePriority,
                                                   flags & Flags::PreferVSync);
+        const auto relock{ m_Lock.ScopedLock() };
+        m_bShown        = (status == LGLCD_UPDATE_STATUS_SUCCESS);
+        m_ShownPriority = priority;
         switch (status) {
             case LGLCD_UPDATE_STATUS_SUCCESS: {
                 if (priority == Priority::Alert) {
@@ -223,7 +319,35 @@ namespace LCD::Logitech {
 
     //--------------------------------------------------------------------------
 
+    // Colour only: monochrome is sent a byte per pixel, so is
+    // always expanded from the packed frame
+    void* LogitechLCD::GetFrameBuffer(std::size_t index) noexcept {
+        const auto lock{ m_Lock.ScopedLock() };
+        if (!m_Device || (index >= m_LGLcdBitmaps.size()) ||
+            (m_LGLcdBitmaps[index].hdr.Format != LGLCD_BMP_FORMAT_QVGAx32)) {
+            return nullptr;
+        }
+        return m_LGLcdBitmaps[index].bmp_qvga32.pixels;
+    }
+
+    //--------------------------------------------------------------------------
+
+    bool LogitechLCD::NeedsFullUpdate() const noexcept {
+        const auto lock{ m_Lock.ScopedLock() };
+        return m_bStale;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void LogitechLCD::SetFlags(Flags flags) noexcept {
+        const auto lock{ m_Lock.ScopedLock() };
+        ILCD::SetFlags(flags);
+    }
+
+    //--------------------------------------------------------------------------
+
     void LogitechLCD::SetDisplayPriority(Priority priority) noexcept {
+        const auto lock{ m_Lock.ScopedLock() };
         ILCD::SetDisplayPriority(priority);
         if (m_Device && m_bAppletEnabled) {
             m_Device.SetForegroundMode(priority == Priority::Foreground ||
@@ -234,6 +358,7 @@ namespace LCD::Logitech {
     //--------------------------------------------------------------------------
 
     LogitechLCD::ButtonState LogitechLCD::GetButtons() const noexcept {
+        const auto lock{ m_Lock.ScopedLock() };
         if (!m_Device) {
             SafeLogTrace("Failed to get button state: No device currently initialised.");
             return ButtonState::None;
@@ -275,8 +400,9 @@ namespace LCD::Logitech {
     //--------------------------------------------------------------------------
 
     LogitechLCD::lgNotifyStatus LogitechLCD::OnDeviceArrival(_In_ lgNotifyParam deviceType) noexcept {
-        SafeLogInfo(m_Device ? "Device was connected; new device available." : "Device was connected; initiating device.");
-        if (!m_Device) {
+        const bool bOpened{ HasDevice() };
+        SafeLogInfo(bOpened ? "Device was connected; new device available." : "Device was connected; initiating device.");
+        if (!bOpened) {
             SafeOnNotification(::LCD::Device::Notification::DeviceConnected);
             SafeLogInfo("Device was connected; initiating device.");
             switch (deviceType) {
@@ -287,13 +413,13 @@ namespace LCD::Logitech {
                     break;
             }
         }
-        return m_Device ? ERROR_SUCCESS : ERROR_APP_INIT_FAILURE;
+        return HasDevice() ? ERROR_SUCCESS : ERROR_APP_INIT_FAILURE;
     }
 
     //--------------------------------------------------------------------------
 
     LogitechLCD::lgNotifyStatus LogitechLCD::OnDeviceRemoval(_In_ lgNotifyParam deviceType) noexcept {
-        if (m_Device) {
+        if (HasDevice()) {
             switch (deviceType) {
                 case LGLCD_DEVICE_BW: {
                     if (GetDeviceType() == DeviceType::Monochrome) {
@@ -335,6 +461,7 @@ namespace LCD::Logitech {
     LogitechLCD::lgNotifyStatus LogitechLCD::OnAppletDisabled() noexcept {
         SafeLogInfo("Applet was disabled; disabling updates.");
         SafeOnNotification(::LCD::Device::Notification::AppletDisabled);
+        const auto lock{ m_Lock.ScopedLock() };
         m_bAppletEnabled = false;
         return ERROR_SUCCESS;
     }
@@ -342,16 +469,18 @@ namespace LCD::Logitech {
     //--------------------------------------------------------------------------
 
     LogitechLCD::lgNotifyStatus LogitechLCD::OnAppletEnabled() noexcept {
-        SafeLogInfo(m_Device ? "Applet was enabled; enabling updates." : "Applet was enabled; initiating device.");
+        SafeLogInfo(HasDevice() ? "Applet was enabled; enabling updates." : "Applet was enabled; initiating device.");
         SafeOnNotification(::LCD::Device::Notification::AppletEnabled);
+        const auto lock{ m_Lock.ScopedLock() };
         m_bAppletEnabled = true;
+        m_bShown         = false; //< Resend even if nothing changed
         return ERROR_SUCCESS;
     }
 
     //--------------------------------------------------------------------------
 
     LogitechLCD::lgNotifyStatus LogitechLCD::OnTerminateApplet() noexcept {
-        if (m_Device) {
+        if (HasDevice()) {
             SafeLogInfo("Applet was terminated; resetting device.");
             Disconnect();
         }
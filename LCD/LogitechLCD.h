@@ -32,6 +32,21 @@
 #include "LogitechAPI.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include "Windows/Thread/Thread_CriticalSection.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Util/BitPlane.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <array>
+//--------------------------------------
+
 namespace LCD::Logitech {
     //**************************************************************************
     // LogitechLCD
@@ -86,8 +101,12 @@ namespace LCD::Logitech {
                                                 DeviceType prefered,
                                                 void* data)                        override;
         virtual bool         OnDisconnect      (void* data)               noexcept override;
-        virtual UpdateStatus Update            (void* pData)                       override;
+        virtual UpdateStatus Update            (void* pData,
+                                                const dirty_rect_type& dirty)      override;
+        virtual bool         NeedsFullUpdate   ()                   const noexcept override;
+        virtual void*        GetFrameBuffer    (std::size_t index)        noexcept override;
         virtual ButtonState  GetButtons        ()                   const noexcept override;
+        virtual void         SetFlags          (Flags flags)              noexcept override;
         virtual void         SetDisplayPriority(Priority priority)        noexcept override;
 
     protected: // ::LCD::Logitech::NotifyHandler
@@ -101,13 +120,40 @@ namespace LCD::Logitech {
     private: //Methods
         bool ConnectToType(DeviceDesc& desc,
                            DeviceType type) noexcept;
+        // `DeviceOpened`, for the SDK's notification thread
+        bool HasDevice() const noexcept;
 
     private: //Data
-        lgBitmapDesc m_LGLcdBitmap   { 0 };
+        // Updates may come from a thread of their own, so state
+        // is locked; not while the SDK takes a bitmap though,
+        // as that can wait for VSync
+        mutable ::Windows::Thread::CriticalSection m_Lock{};
+        // Held for all of an update, so the device can't be
+        // closed or replaced while the SDK takes a bitmap
+        // from it; always taken before `m_Lock`
+        ::Windows::Thread::CriticalSection         m_SubmitLock{};
+
+        // Colour frames alternate between these, written in
+        // place (see `GetFrameBuffer`); anything copied, and
+        // monochrome, goes to the first
+        std::array<lgBitmapDesc, FrameBufferCount> m_LGLcdBitmaps{};
+
         lgAPI        m_API           { };
         lgConnection m_Connection    { };
         lgDevice     m_Device        { };
         bool         m_bAppletEnabled{ true };
+
+        // `m_LGLcdBitmaps` are kept between updates, so only
+        // what changed is copied; it is stale if updates were
+        // missed, and shown once the device took it
+        bool         m_bStale        { true };
+        bool         m_bShown        { false };
+        Priority     m_ShownPriority { Priority::Idle };
+
+        // Monochrome as last updated (the SDK bitmap is a byte
+        // per pixel), so changed rows can be found packed
+        std::array<std::uint8_t,
+                   ::util::bit_plane::stride(LGLCD_BW_BMP_WIDTH) * LGLCD_BW_BMP_HEIGHT> m_MonoPixels{};
     }; // class LogitechLCD final
 } // namespace LCD::Logitech
 
@@ -0,0 +1,195 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Audio_BeatDetector.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cmath>
+#include <random>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_BeatDetector_Test
+//******************************************************************************
+//
+// Feeds `BeatDetectorT` with magnitude spectra of synthetic
+// click tracks and checks the tempo, onsets and beat phase
+// it reports, then times a single update.
+
+namespace {
+    using detector_type = ::Audio::Beat::BeatDetectorT<float>;
+
+    constexpr const float  SampleRate { 44100.f };
+    constexpr const float  WindowTime { 1024.f / SampleRate }; //< Analysis window
+    constexpr const float  ClickDecay { .01f };                //< Seconds
+    constexpr const size_t ChannelCount{ 2 };
+
+    //**************************************************************************
+    // ClickTrack
+    //**************************************************************************
+    //
+    // Spectra as an FFT of a click track would see them:
+    // each click is a broadband burst with an exponential
+    // envelope; the window energy scales a slightly pink
+    // spectrum over a low noise floor.
+    class ClickTrack final {
+    public:
+        ClickTrack(float fTempo, size_t nBinCount, unsigned seed) :
+            m_fPeriod  { 60.f / fTempo },
+            m_nBinCount{ nBinCount },
+            m_Spectrum (nBinCount * ChannelCount),
+            m_Random   { seed } {}
+
+        [[nodiscard]] float period() const noexcept { return m_fPeriod; }
+
+        // Spectrum of the window ending at `time`
+        const std::vector<float>& spectrum(float time) {
+            // Envelope integrated over the window, for every
+            // click that overlaps it
+            float energy{ 0.f };
+            const auto windowStart{ time - WindowTime };
+            auto k{ std::floor(std::max(windowStart - 10.f * ClickDecay, 0.f) / m_fPeriod) };
+            for (auto click{ k * m_fPeriod }; click <= time; click = (++k) * m_fPeriod) {
+                const auto from{ std::max(click, windowStart) };
+                energy += ClickDecay * (std::exp(-(from - click) / ClickDecay) -
+                                        std::exp(-(time - click) / ClickDecay));
+            }
+            energy /= WindowTime;
+
+            std::uniform_real_distribution<float> noise{ 0.f, .002f };
+            for (size_t b = 0; b < m_nBinCount; ++b) {
+                const auto shape{ 1.f / std::sqrt(1.f + static_cast<float>(b) * .05f) };
+                for (size_t c = 0; c < ChannelCount; ++c) {
+                    m_Spectrum[b * ChannelCount + c] = energy * shape + noise(m_Random);
+                }
+            }
+            return m_Spectrum;
+        }
+
+    private:
+        float              m_fPeriod;
+        size_t             m_nBinCount;
+        std::vector<float> m_Spectrum;
+        std::mt19937       m_Random;
+    }; // class ClickTrack final
+
+    //**************************************************************************
+    // TestClickTrack
+    //**************************************************************************
+    //
+    // Runs `fDuration` seconds of a click track at `fTempo`
+    // with updates at `fUpdateRate` (plus up to 20% timing
+    // jitter, as render frames see).
+    void TestClickTrack(float fTempo, float fUpdateRate, float fDuration) {
+        constexpr const size_t BinCount{ 256 };
+        ClickTrack track{ fTempo, BinCount, 1234u };
+        std::mt19937 random{ 5678u };
+        std::uniform_real_distribution<float> jitter{ .8f, 1.2f };
+
+        detector_type detector{ };
+        const auto settleTime{ fDuration * .5f };
+        size_t nOnsets{ 0 }, nClicks{ 0 };
+        float  fPhaseError{ 0.f };
+        float  fLastClick { -1.f };
+        for (float time{ 0.f }, prev{ 0.f }; time < fDuration; prev = time, time += jitter(random) / fUpdateRate) {
+            const auto& spectrum{ track.spectrum(time) };
+            const auto& state{ detector.update(spectrum.data(), spectrum.size(), ChannelCount, time - prev) };
+            if (time < settleTime) { continue; }
+
+            // Every click should be seen as an onset, shortly
+            // after it happens (the window has to fill first)
+            if (state.bOnset) { ++nOnsets; }
+            const auto fClick{ std::floor(time / track.period()) };
+            if (fClick != fLastClick) {
+                // Beat phase should track the clicks: compare
+                // at the first update after each click
+                fLastClick = fClick;
+                auto error{ state.fPhase - (time / track.period() - fClick) };
+                error -= std::round(error);
+                fPhaseError = std::max(fPhaseError, std::fabs(error));
+                ++nClicks;
+            }
+        }
+
+        const auto& state{ detector.state() };
+        std::printf("tempo %6.1f @ %4.0fHz: detected %6.2f (confidence %.2f), onsets %zu/%zu, max phase error %.3f\n",
+                    static_cast<double>(fTempo), static_cast<double>(fUpdateRate),
+                    static_cast<double>(state.fTempo), static_cast<double>(state.fConfidence),
+                    nOnsets, nClicks, static_cast<double>(fPhaseError));
+
+        TEST_CHECK(std::fabs(state.fTempo - fTempo) <= fTempo * .02f);
+        TEST_CHECK(state.fConfidence > .25f);
+        TEST_CHECK(nOnsets + 1 >= nClicks && nOnsets <= nClicks + 1);
+        TEST_CHECK(nClicks > 0 && fPhaseError < .1f);
+    }
+
+    //**************************************************************************
+    // TestSilence
+    //**************************************************************************
+    void TestSilence() {
+        detector_type detector{ };
+        for (int i = 0; i < 60 * 10; ++i) {
+            const auto& state{ detector.update(nullptr, 0, ChannelCount, 1.f / 60.f) };
+            TEST_CHECK(!state.bOnset);
+        }
+        TEST_CHECK(detector.state().fTempo == 0.f);
+        TEST_CHECK(detector.state().nBeatCount == 0);
+    }
+
+    //**************************************************************************
+    // BenchmarkUpdate
+    //**************************************************************************
+    void BenchmarkUpdate() {
+        for (const size_t nBinCount : { size_t{ 256 }, size_t{ 1024 } }) {
+            ClickTrack track{ 120.f, nBinCount, 1u };
+            // Pre-generate a few seconds of spectra so only
+            // the detector is timed
+            std::vector<std::vector<float>> spectra;
+            for (int i = 0; i < 240; ++i) { spectra.push_back(track.spectrum(static_cast<float>(i) / 60.f)); }
+
+            detector_type detector{ };
+            size_t nFrame{ 0 };
+            char szName[64];
+            std::snprintf(szName, sizeof(szName), "BeatDetectorT::update (%zu bins x %zu)", nBinCount, ChannelCount);
+            ::Tests::Benchmark(szName, 20000, [&]() {
+                const auto& spectrum{ spectra[nFrame++ % spectra.size()] };
+                ::Tests::DoNotOptimise(detector.update(spectrum.data(), spectrum.size(), ChannelCount, 1.f / 60.f));
+            });
+        }
+    }
+} // namespace <anonymous>
+
+int main() {
+    for (const auto fUpdateRate : { 30.f, 60.f }) {
+        for (const auto fTempo : { 80.f, 96.f, 120.f, 128.f, 140.f, 174.f }) {
+            TestClickTrack(fTempo, fUpdateRate, 20.f);
+        }
+    }
+    TestSilence();
+    BenchmarkUpdate();
+    return ::Tests::Result();
+}
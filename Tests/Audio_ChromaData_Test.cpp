@@ -0,0 +1,224 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Tests/TestSignal.h"
+#include "Audio_ChromaData.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_ChromaData_Test
+//******************************************************************************
+//
+// Feeds `ChromaAnalyserT` with spectra of synthetic chords
+// and checks the pitch classes and keys it reports, then
+// times a single update.
+
+namespace {
+    using analyser_type = ::Audio::Chroma::ChromaAnalyserT<float>;
+    using state_type    = analyser_type::state_type;
+
+    constexpr const float  SampleRate  { 44100.f };
+    constexpr const size_t FFTBinCount { 4096 }; //< `ChromaSpectrumSize`
+    constexpr const size_t ChannelCount{ 2 };
+    constexpr const float  Settle      { 1000.f }; //< Elapsed time that replaces all history
+
+    constexpr const char* const PitchClassNames[]{
+        "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+    };
+
+    // MIDI notes of a root position triad
+    std::array<int, 3> Triad(int root, bool bMinor) noexcept {
+        return { root, root + (bMinor ? 3 : 4), root + 7 };
+    }
+
+    std::vector<float> ChordSpectrum(const std::array<int, 3>& notes,
+                                     size_t harmonics) {
+        std::vector<double> samples(FFTBinCount * 2, 0.);
+        for (const auto note : notes) {
+            ::Tests::AddTone(samples, SampleRate, ::Tests::NoteFrequency(note), .25, harmonics);
+        }
+        return ::Tests::MagnitudeSpectrum<float>(samples, ChannelCount);
+    }
+
+    // Pitch classes ordered loudest first
+    std::array<size_t, ::Audio::Chroma::PitchClassCount> Ranked(const state_type& state) {
+        std::array<size_t, ::Audio::Chroma::PitchClassCount> order{ };
+        std::iota(order.begin(), order.end(), size_t{ 0 });
+        std::stable_sort(order.begin(), order.end(), [&state](size_t a, size_t b) {
+            return state.chroma[a] > state.chroma[b];
+        });
+        return order;
+    }
+
+    bool TopThreeAre(const state_type& state, const std::array<int, 3>& notes) {
+        const auto order{ Ranked(state) };
+        for (size_t i = 0; i < 3; ++i) {
+            const auto pc{ order[i] };
+            if (std::none_of(notes.begin(), notes.end(), [pc](int note) { return static_cast<size_t>(note % 12) == pc; })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //**************************************************************************
+    // TestChords
+    //**************************************************************************
+    //
+    // Every major and minor triad, in two registers and with
+    // overtones, gives its own three pitch classes as the
+    // loudest.
+    void TestChords() {
+        size_t nTested{ 0 }, nCorrect{ 0 };
+        for (const auto nOctaveBase : { 48, 60 }) {
+            for (int root = 0; root < 12; ++root) {
+                for (const auto bMinor : { false, true }) {
+                    const auto notes{ Triad(nOctaveBase + root, bMinor) };
+                    const auto spectrum{ ChordSpectrum(notes, 4) };
+                    analyser_type analyser{ };
+                    const auto state{ analyser.update(spectrum.data(), spectrum.size(), ChannelCount, SampleRate, Settle) };
+                    ++nTested;
+                    if (TopThreeAre(state, notes)) {
+                        ++nCorrect;
+                    } else {
+                        const auto order{ Ranked(state) };
+                        std::printf("%s%s (octave %d): loudest %s %s %s\n",
+                                    PitchClassNames[root], bMinor ? "m" : "", nOctaveBase / 12 - 1,
+                                    PitchClassNames[order[0]], PitchClassNames[order[1]], PitchClassNames[order[2]]);
+                    }
+                }
+            }
+        }
+        std::printf("chords: %zu/%zu give their own pitch classes\n", nCorrect, nTested);
+        TEST_CHECK(nCorrect == nTested);
+    }
+
+    //**************************************************************************
+    // TestOctaveBalance
+    //**************************************************************************
+    //
+    // A semitone spans ~2 FFT bins at A4 but ~23 at C8, so
+    // without normalising per semitone a broadband sound
+    // high up outweighs the same level low down. Fill the
+    // semitones of a C major triad around middle C and an
+    // F#7 with one level: all four must count the same.
+    void TestOctaveBalance() {
+        const auto fBinHz{ SampleRate / static_cast<float>(2 * FFTBinCount) };
+        std::vector<float> spectrum(FFTBinCount * ChannelCount, 0.f);
+        const auto fill = [&spectrum, fBinHz](int note) {
+            const auto lo{ ::Tests::NoteFrequency(note - .5) }, hi{ ::Tests::NoteFrequency(note + .5) };
+            for (size_t b = 0; b < FFTBinCount; ++b) {
+                const auto f{ static_cast<double>(b) * static_cast<double>(fBinHz) };
+                if (f >= lo && f < hi) {
+                    for (size_t c = 0; c < ChannelCount; ++c) { spectrum[b * ChannelCount + c] = .1f; }
+                }
+            }
+        };
+        for (const auto note : Triad(60, false)) { fill(note); }
+        fill(102); //< F#7
+
+        analyser_type analyser{ };
+        const auto state{ analyser.update(spectrum.data(), spectrum.size(), ChannelCount, SampleRate, Settle) };
+        std::printf("octave balance: C %.2f E %.2f G %.2f F# %.2f\n",
+                    static_cast<double>(state.chroma[0]), static_cast<double>(state.chroma[4]),
+                    static_cast<double>(state.chroma[7]), static_cast<double>(state.chroma[6]));
+        for (const auto pc : { 0, 4, 6, 7 }) {
+            TEST_CHECK(state.chroma[pc] > .9f);
+        }
+    }
+
+    //**************************************************************************
+    // TestKey
+    //**************************************************************************
+    //
+    // Cadences played for `KeyTime` at 30 updates a second
+    // settle on their key.
+    void TestKey(const char* szName,
+                 const std::array<std::array<int, 3>, 4>& progression,
+                 state_type::key_type nExpected) {
+        std::array<std::vector<float>, 4> spectra;
+        for (size_t i = 0; i < progression.size(); ++i) { spectra[i] = ChordSpectrum(progression[i], 3); }
+
+        analyser_type analyser{ };
+        state_type state{ };
+        constexpr const float fElapsed{ 1.f / 30.f };
+        const auto nUpdates{ static_cast<size_t>(analyser_type::KeyTime * 2.f / fElapsed) };
+        for (size_t i = 0; i < nUpdates; ++i) {
+            const auto& spectrum{ spectra[(i / 15) % spectra.size()] }; //< Half a second per chord
+            state = analyser.update(spectrum.data(), spectrum.size(), ChannelCount, SampleRate, fElapsed);
+        }
+        std::printf("key of %-14s: %s%s (confidence %.2f)\n", szName,
+                    (state.nKey >= 0) ? PitchClassNames[analyser_type::tonic(state.nKey)] : "?",
+                    analyser_type::is_minor(state.nKey) ? " minor" : " major",
+                    static_cast<double>(state.fKeyConfidence));
+        TEST_CHECK(state.nKey == nExpected);
+        TEST_CHECK(state.fKeyConfidence > .5f);
+    }
+
+    //**************************************************************************
+    // TestSilence
+    //**************************************************************************
+    void TestSilence() {
+        analyser_type analyser{ };
+        const std::vector<float> silence(FFTBinCount * ChannelCount, 0.f);
+        const auto state{ analyser.update(silence.data(), silence.size(), ChannelCount, SampleRate, Settle) };
+        TEST_CHECK(state.nKey == -1);
+        TEST_CHECK(std::all_of(state.chroma.begin(), state.chroma.end(), [](float c) { return c == 0.f; }));
+        TEST_CHECK(analyser.mapped_bin_count() > 0);
+    }
+
+    //**************************************************************************
+    // BenchmarkUpdate
+    //**************************************************************************
+    void BenchmarkUpdate() {
+        const auto spectrum{ ChordSpectrum(Triad(60, false), 4) };
+        analyser_type analyser{ };
+        ::Tests::Benchmark("ChromaAnalyserT::update (4096 x 2)", 20000, [&]() {
+            ::Tests::DoNotOptimise(analyser.update(spectrum.data(), spectrum.size(), ChannelCount, SampleRate, 1.f / 60.f));
+        });
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestChords();
+    TestOctaveBalance();
+    // I IV V I
+    TestKey("C major", { Triad(60, false), Triad(65, false), Triad(67, false), Triad(60, false) }, 0);
+    TestKey("G major", { Triad(55, false), Triad(60, false), Triad(62, false), Triad(55, false) }, 7);
+    // i iv V i
+    TestKey("A minor", { Triad(57, true), Triad(62, true), Triad(64, false), Triad(57, true) }, 12 + 9);
+    TestKey("E minor", { Triad(52, true), Triad(57, true), Triad(59, false), Triad(52, true) }, 12 + 4);
+    TestSilence();
+    BenchmarkUpdate();
+    return ::Tests::Result();
+}
@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Tests/TestSignal.h"
+#include "Audio_ConstantQ.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cmath>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_ConstantQ_Test
+//******************************************************************************
+//
+// Checks `SpectralKernelT` bins are centred where they
+// claim to be, both from the kernel weights and from the
+// response to pure tones, then times `apply` per frame.
+
+namespace {
+    using kernel_type = ::Audio::ConstantQ::SpectralKernelT<float>;
+
+    constexpr const float  SampleRate  { 44100.f };
+    constexpr const size_t FFTBinCount { 2048 };
+    constexpr const size_t ChannelCount{ 2 };
+
+    //**************************************************************************
+    // ToneSpectrum
+    //**************************************************************************
+    std::vector<float> ToneSpectrum(double fFrequency) {
+        std::vector<double> samples(FFTBinCount * 2, 0.);
+        ::Tests::AddTone(samples, SampleRate, fFrequency, 1.);
+        return ::Tests::MagnitudeSpectrum<float>(samples, ChannelCount);
+    }
+
+    size_t PeakBin(const std::vector<float>& output) {
+        size_t peak{ 0 };
+        for (size_t k = 0; k < output.size() / ChannelCount; ++k) {
+            if (output[k * ChannelCount] > output[peak * ChannelCount]) { peak = k; }
+        }
+        return peak;
+    }
+
+    //**************************************************************************
+    // TestKernel
+    //**************************************************************************
+    //
+    // Weights sum to one (so a flat spectrum is unchanged)
+    // and their centroid is the bin's centre frequency,
+    // except where the window is clipped at DC.
+    void TestKernel(size_t nBinsPerOctave) {
+        kernel_type kernel{ };
+        const auto count{ kernel.configure(FFTBinCount, SampleRate, nBinsPerOctave) };
+        TEST_CHECK(count > 0);
+        // C1 to C10 fits below `MaxFraction` at 44.1kHz
+        TEST_CHECK(count == nBinsPerOctave * kernel_type::OctaveCount + 1);
+
+        const std::vector<float> flat(FFTBinCount * ChannelCount, .5f);
+        const auto& output{ kernel.apply(flat.data(), flat.size(), ChannelCount) };
+        TEST_CHECK(output.size() == count * ChannelCount);
+        float fFlatError{ 0.f };
+        for (const auto v : output) { fFlatError = std::max(fFlatError, std::fabs(v - .5f)); }
+        TEST_CHECK(fFlatError < 1e-4f);
+
+        // Centroid from the response to unit impulses
+        const auto fBinHz{ SampleRate / static_cast<float>(2 * FFTBinCount) };
+        float fCentreError{ 0.f };
+        std::vector<double> sum(count), moment(count);
+        std::vector<float> impulse(FFTBinCount * ChannelCount, 0.f);
+        for (size_t i = 0; i < FFTBinCount; ++i) {
+            impulse[i * ChannelCount] = 1.f;
+            const auto& response{ kernel.apply(impulse.data(), impulse.size(), ChannelCount) };
+            for (size_t k = 0; k < count; ++k) {
+                const auto w{ static_cast<double>(response[k * ChannelCount]) };
+                sum[k]    += w * w;
+                moment[k] += w * w * static_cast<double>(i);
+            }
+            impulse[i * ChannelCount] = 0.f;
+        }
+        const auto fSpacing{ std::exp2(1.f / static_cast<float>(nBinsPerOctave)) - 1.f };
+        for (size_t k = 0; k < count; ++k) {
+            const auto fCentre{ kernel.centre_frequency(k) / fBinHz };
+            if (fCentre < std::max(fCentre * fSpacing, kernel_type::MinHalfWidth)) { continue; } //< Clipped at DC
+            const auto fCentroid{ static_cast<float>(moment[k] / sum[k]) };
+            fCentreError = std::max(fCentreError, std::fabs(fCentroid - fCentre));
+        }
+        std::printf("%2zu bins/octave: %zu bins, %zu weights, flat error %.2e, max centroid error %.4f FFT bins\n",
+                    nBinsPerOctave, count, kernel.weight_count(),
+                    static_cast<double>(fFlatError), static_cast<double>(fCentreError));
+        TEST_CHECK(fCentreError < .05f);
+    }
+
+    //**************************************************************************
+    // TestTones
+    //**************************************************************************
+    //
+    // A tone at a bin's centre peaks in that bin, wherever
+    // the bins are at least an FFT bin apart (below that
+    // the FFT can't separate them).
+    void TestTones(size_t nBinsPerOctave) {
+        kernel_type kernel{ };
+        const auto count{ kernel.configure(FFTBinCount, SampleRate, nBinsPerOctave) };
+        const auto fBinHz{ SampleRate / static_cast<float>(2 * FFTBinCount) };
+        const auto fSpacing{ std::exp2(1.f / static_cast<float>(nBinsPerOctave)) - 1.f };
+
+        size_t nTested{ 0 }, nCorrect{ 0 };
+        for (size_t k = 0; k < count; k += 3) {
+            const auto fCentre{ kernel.centre_frequency(k) };
+            if (fCentre * fSpacing < fBinHz) { continue; }
+            const auto spectrum{ ToneSpectrum(static_cast<double>(fCentre)) };
+            const auto& output{ kernel.apply(spectrum.data(), spectrum.size(), ChannelCount) };
+            ++nTested;
+            if (PeakBin(output) == k) {
+                ++nCorrect;
+            } else {
+                std::printf("%.1fHz peaked in bin %zu, expected %zu\n",
+                            static_cast<double>(fCentre), PeakBin(output), k);
+            }
+        }
+        std::printf("%2zu bins/octave: %zu/%zu tones peak in their own bin\n",
+                    nBinsPerOctave, nCorrect, nTested);
+        TEST_CHECK(nTested > 0 && nCorrect == nTested);
+
+        // A4 should land exactly on its note
+        if (nBinsPerOctave % 12 == 0) {
+            const auto spectrum{ ToneSpectrum(440.) };
+            const auto& output{ kernel.apply(spectrum.data(), spectrum.size(), ChannelCount) };
+            TEST_CHECK(PeakBin(output) == (12 * 3 + 9) * (nBinsPerOctave / 12));
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkApply
+    //**************************************************************************
+    void BenchmarkApply() {
+        const auto spectrum{ ToneSpectrum(440.) };
+        for (const size_t nBinsPerOctave : { size_t{ 12 }, size_t{ 24 }, size_t{ 48 } }) {
+            kernel_type kernel{ };
+            kernel.configure(FFTBinCount, SampleRate, nBinsPerOctave);
+            char szName[64];
+            std::snprintf(szName, sizeof(szName), "SpectralKernelT::apply (%zu/oct, %zu x %zu)",
+                          nBinsPerOctave, FFTBinCount, ChannelCount);
+            ::Tests::Benchmark(szName, 20000, [&]() {
+                ::Tests::DoNotOptimise(kernel.apply(spectrum.data(), spectrum.size(), ChannelCount).front());
+            });
+        }
+
+        kernel_type kernel{ };
+        size_t nConfig{ 0 };
+        ::Tests::Benchmark("SpectralKernelT::configure (24/oct)", 200, [&]() {
+            // Alternate sizes so the kernel is rebuilt each time
+            ::Tests::DoNotOptimise(kernel.configure(FFTBinCount >> (nConfig++ & 1), SampleRate, 24));
+        });
+    }
+} // namespace <anonymous>
+
+int main() {
+    for (const size_t nBinsPerOctave : { size_t{ 12 }, size_t{ 24 }, size_t{ 36 }, size_t{ 48 } }) {
+        TestKernel(nBinsPerOctave);
+        TestTones(nBinsPerOctave);
+    }
+    BenchmarkApply();
+    return ::Tests::Result();
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Audio_CorrelationData.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cmath>
+#include <cstdint>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_CorrelationData_Test
+//******************************************************************************
+//
+// Checks the meter reads +1, -1 and 0 for identical,
+// inverted and quadrature channels; that the same audio
+// split between updates differently (as update timing
+// varies) reads the same, including how quickly it follows
+// a change, since the time constant is in seconds of
+// audio; and that `decay` falls towards silence. Then
+// times an update of one update's new frames against one
+// of a whole 500ms window.
+
+namespace {
+    using sample_type      = float;
+    using size_type        = std::size_t;
+    using buffer_type      = std::vector<sample_type>;
+    using correlation_type = ::Audio::Correlation::CorrelationDataT<sample_type>;
+
+    constexpr const double    Pi        { 3.14159265358979323846 };
+    constexpr const size_type SampleRate{ 48000 };
+
+    // Stereo 440Hz with the right channel at `fPhase`
+    // radians; changes to `fPhaseAfter` at `changeFrame`
+    buffer_type Stereo(size_type frames,
+                       double fPhase,
+                       double fPhaseAfter = 0,
+                       size_type changeFrame = ~size_type{ 0 }) {
+        buffer_type result(frames * 2);
+        for (size_type f = 0; f < frames; ++f) {
+            const auto p{ 2. * Pi * 440. * static_cast<double>(f) / static_cast<double>(SampleRate) };
+            result[f * 2 + 0] = static_cast<sample_type>(std::sin(p));
+            result[f * 2 + 1] = static_cast<sample_type>(std::sin(p + ((f < changeFrame) ? fPhase : fPhaseAfter)));
+        }
+        return result;
+    }
+
+    // Feeds `source` in blocks of `blockFrames`, or of
+    // 1 to `blockFrames` frames if `bRandom`
+    correlation_type Feed(const buffer_type& source,
+                          size_type blockFrames,
+                          bool bRandom) {
+        correlation_type meter{};
+        std::uint32_t seed{ 777 };
+        const auto frames{ source.size() / 2 };
+        for (size_type f = 0; f < frames;) {
+            auto count{ blockFrames };
+            if (bRandom) {
+                seed  = seed * 1664525u + 1013904223u;
+                count = 1 + (seed >> 8) % blockFrames;
+            }
+            count = std::min(count, frames - f);
+            meter.update(source.data() + f * 2, count * 2, 2, SampleRate);
+            f += count;
+        }
+        return meter;
+    }
+
+    //**************************************************************************
+    // TestValues
+    //**************************************************************************
+    void TestValues() {
+        const auto read = [](const buffer_type& source) {
+            return Feed(source, 800, false).correlation_curr(1);
+        };
+        TEST_CHECK(std::abs(read(Stereo(SampleRate, 0))      - 1) < 1e-3f);
+        TEST_CHECK(std::abs(read(Stereo(SampleRate, Pi))     + 1) < 1e-3f);
+        TEST_CHECK(std::abs(read(Stereo(SampleRate, Pi / 2)))     < 1e-2f);
+        TEST_CHECK(read(buffer_type(SampleRate * 2, 0)) == 0);
+
+        // A single channel is correlated with itself
+        const auto stereo{ Stereo(SampleRate, Pi) };
+        buffer_type mono(SampleRate);
+        for (size_type f = 0; f < mono.size(); ++f) { mono[f] = stereo[f * 2]; }
+        correlation_type meter{};
+        meter.update(mono.data(), mono.size(), 1, SampleRate);
+        TEST_CHECK(std::abs(meter.correlation_curr(1) - 1) < 1e-3f);
+
+        // Nothing new holds the value
+        const auto before{ meter.correlation_curr(1) };
+        meter.update(mono.data(), 0, 1, SampleRate);
+        TEST_CHECK(meter.correlation_curr(0) == before && meter.correlation_curr(1) == before);
+
+        // Without audio, energy (and so the value) decays to silence
+        for (int i = 0; i < 600; ++i) { meter.decay(1.f / 60.f); }
+        TEST_CHECK(meter.correlation_curr(1) == 0);
+    }
+
+    //**************************************************************************
+    // TestChunking
+    //**************************************************************************
+    void TestChunking() {
+        // Identical channels become inverted after 1s; read
+        // at 1s plus one time constant of audio, whatever
+        // the split between updates
+        const auto change{ SampleRate };
+        const auto frames{ change + static_cast<size_type>(correlation_type::IntegrationTime * SampleRate) };
+        const auto source{ Stereo(frames, 0, Pi, change) };
+        const auto reference{ Feed(source, 1, false).correlation_curr(1) };
+        for (const size_type blockFrames : { size_type{ 64 }, size_type{ 800 }, size_type{ 2400 } }) {
+            for (const bool bRandom : { false, true }) {
+                const auto value{ Feed(source, blockFrames, bRandom).correlation_curr(1) };
+                TEST_CHECK(std::abs(value - reference) < .02f);
+            }
+        }
+        // Part way from +1 to -1
+        TEST_CHECK(reference > -.9f && reference < .5f);
+    }
+
+    //**************************************************************************
+    // BenchmarkUpdate
+    //**************************************************************************
+    void BenchmarkUpdate() {
+        const auto source{ Stereo(SampleRate / 2, Pi / 3) };
+        correlation_type meter{};
+        // New audio at 60 updates a second
+        ::Tests::Benchmark("update, 800 new frames", 10000, [&]() {
+            meter.update(source.data(), 800 * 2, 2, SampleRate);
+            ::Tests::DoNotOptimise(meter.correlation_curr(1));
+        });
+        // The whole (maximum) window, as when every update
+        // re-read it
+        ::Tests::Benchmark("update, 24000 frame window", 1000, [&]() {
+            meter.update(source.data(), source.size(), 2, SampleRate);
+            ::Tests::DoNotOptimise(meter.correlation_curr(1));
+        });
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestValues();
+    TestChunking();
+    BenchmarkUpdate();
+    return ::Tests::Result();
+}
@@ -0,0 +1,222 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Audio_Latency.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_Latency_Test
+//******************************************************************************
+//
+// Checks `OffsetEstimatorT::update` (the measurement, its
+// limits and smoothing), then plays an impulse train (one
+// every 500ms) through a simulation of the plugin:
+// analysis fetching at a jittered 15Hz, rendering at 60Hz
+// interpolated between the two latest analyses, and a
+// 10-25ms LCD/vsync delay before each frame is seen. Each
+// impulse should appear when it's heard: with the fetch
+// offset from the estimator the mean error must be within
+// 3ms (fetching one update period ahead, as before, shows
+// them about 17ms late). Then times an update.
+
+namespace {
+    using duration_type  = double;
+    using estimator_type = ::Audio::Latency::OffsetEstimatorT<duration_type>;
+
+    //**************************************************************************
+    // TestUpdate
+    //**************************************************************************
+    template <typename DurationT>
+    void TestUpdate() {
+        using type = ::Audio::Latency::OffsetEstimatorT<DurationT>;
+        const auto near = [](DurationT a, DurationT b) {
+            return std::abs(a - b) < static_cast<DurationT>(1e-6);
+        };
+        constexpr const auto Period{ static_cast<DurationT>(1. / 15.) };
+
+        type estimator{};
+        TEST_CHECK(!estimator.valid());
+
+        // The first measurement is taken as is
+        TEST_CHECK(near(estimator.update(static_cast<DurationT>(.02), static_cast<DurationT>(.25), Period),
+                        static_cast<DurationT>(.02) + static_cast<DurationT>(.75) * Period));
+        TEST_CHECK(estimator.valid());
+        TEST_CHECK(near(estimator.measured(), estimator.offset()));
+
+        // Then smoothed, converging on a steady measurement
+        const auto fFirst{ estimator.offset() };
+        const auto fSecond{ estimator.update(static_cast<DurationT>(.1), 1, Period) };
+        TEST_CHECK(near(estimator.measured(), static_cast<DurationT>(.1)));
+        TEST_CHECK(near(fSecond, fFirst + (static_cast<DurationT>(.1) - fFirst) * type::Smoothing));
+        for (int i = 0; i < 1000; ++i) { estimator.update(static_cast<DurationT>(.1), 1, Period); }
+        TEST_CHECK(near(estimator.offset(), static_cast<DurationT>(.1)));
+
+        // Interpolation outside [0,1] and negative periods
+        // are limited, as is the result
+        estimator.reset();
+        TEST_CHECK(!estimator.valid());
+        TEST_CHECK(near(estimator.update(0, -1, Period), Period));
+        estimator.reset();
+        TEST_CHECK(near(estimator.update(static_cast<DurationT>(.01), 2, Period), static_cast<DurationT>(.01)));
+        estimator.reset();
+        TEST_CHECK(near(estimator.update(static_cast<DurationT>(.01), 0, -Period), static_cast<DurationT>(.01)));
+        estimator.reset();
+        TEST_CHECK(near(estimator.update(-1, 1, Period), 0));
+        estimator.reset();
+        TEST_CHECK(near(estimator.update(5, 0, Period), type::MaxOffset));
+    }
+
+    //**************************************************************************
+    // Simulate
+    //**************************************************************************
+    // Playback position is real time. Returns each impulse's
+    // on screen time less its heard time (seconds), the
+    // screen time interpolated between presented frames so
+    // the 60Hz frame steps don't hide the offset
+    struct Analysis final {
+        duration_type fFetch  { 0 }; //< When fetched
+        duration_type fCovers { 0 }; //< Playback position the audio reaches
+    };
+
+    std::vector<duration_type> Simulate(unsigned seed,
+                                        bool bCompensate,
+                                        duration_type fDuration) {
+        constexpr const duration_type Period     { 1. / 15. };
+        constexpr const duration_type RenderRate { 60. };
+        constexpr const duration_type ImpulseGap { .5 };
+
+        std::mt19937 random{ seed };
+        std::uniform_real_distribution<duration_type> fetchJitter{ 0., .004 };
+        std::uniform_real_distribution<duration_type> renderJitter{ 0., .002 };
+        std::uniform_real_distribution<duration_type> displayDelay{ .010, .025 };
+
+        estimator_type estimator{};
+        std::vector<Analysis> analyses{};
+        duration_type fNextFetch{ 0 };
+
+        std::vector<duration_type> errors{};
+        duration_type fNextImpulse{ ImpulseGap };
+        duration_type fLastShown{ -1 }, fLastPresent{ 0 };
+
+        const auto nFrames{ static_cast<int>(fDuration * RenderRate) };
+        for (int nFrame = 0; nFrame < nFrames; ++nFrame) {
+            const auto fRender{ static_cast<duration_type>(nFrame) / RenderRate + renderJitter(random) };
+
+            // Analysis fetched since the last frame, ahead of
+            // playback by the current offset
+            while (fNextFetch <= fRender) {
+                const auto fFetch{ fNextFetch + fetchJitter(random) };
+                const auto fOffset{ (bCompensate && estimator.valid()) ? estimator.offset() : Period };
+                analyses.push_back({ fFetch, fFetch + fOffset });
+                fNextFetch += Period;
+            }
+            if (analyses.size() < 2) { continue; }
+
+            // Interpolated from the previous analysis to the latest
+            const auto& prev{ analyses[analyses.size() - 2] };
+            const auto& next{ analyses.back() };
+            const auto fInterp{ std::clamp((fRender - next.fFetch) / Period, 0., 1.) };
+            const auto fShown{ ::util::lerp(prev.fCovers, next.fCovers, fInterp) };
+            const auto fPresent{ fRender + displayDelay(random) };
+            estimator.update(fPresent - next.fFetch, fInterp, Period);
+
+            // Impulses reached between this frame and the last
+            while (fLastShown >= 0 && fShown >= fNextImpulse) {
+                if (fLastShown < fNextImpulse && fShown > fLastShown) {
+                    const auto fAt{ (fNextImpulse - fLastShown) / (fShown - fLastShown) };
+                    const auto fSeen{ fLastPresent + (fPresent - fLastPresent) * fAt };
+                    // Once the estimator has settled
+                    if (fNextImpulse > 2.) { errors.push_back(fSeen - fNextImpulse); }
+                }
+                fNextImpulse += ImpulseGap;
+            }
+            fLastShown   = fShown;
+            fLastPresent = fPresent;
+        }
+        return errors;
+    }
+
+    //**************************************************************************
+    // TestImpulseTrain
+    //**************************************************************************
+    void TestImpulseTrain() {
+        for (const auto seed : { 1u, 2u, 3u }) {
+            for (const auto bCompensate : { false, true }) {
+                const auto errors{ Simulate(seed, bCompensate, 60.) };
+                if (!TEST_CHECK(errors.size() > 100)) { continue; }
+
+                duration_type fSum{ 0 }, fSumSquares{ 0 };
+                for (const auto fError : errors) {
+                    fSum += fError;
+                    fSumSquares += fError * fError;
+                }
+                const auto fCount{ static_cast<duration_type>(errors.size()) };
+                const auto fMean{ fSum / fCount };
+                const auto fDeviation{ std::sqrt(std::max(fSumSquares / fCount - fMean * fMean, 0.)) };
+                std::printf("seed %u, %-11s: impulses seen %+6.1fms from heard (sd %.1fms, %zu impulses)\n",
+                            seed, bCompensate ? "compensated" : "fixed", fMean * 1000., fDeviation * 1000., errors.size());
+                if (bCompensate) {
+                    TEST_CHECK(std::abs(fMean) < .003);
+                } else {
+                    TEST_CHECK(std::abs(fMean) > .010);
+                }
+                TEST_CHECK(fDeviation < .010);
+            }
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkUpdate
+    //**************************************************************************
+    void BenchmarkUpdate() {
+        estimator_type estimator{};
+        duration_type fInterp{ 0 };
+        ::Tests::Benchmark("OffsetEstimatorT::update", 1000000, [&]() {
+            fInterp = (fInterp >= 1.) ? 0. : fInterp + .25;
+            ::Tests::DoNotOptimise(estimator.update(.02, fInterp, 1. / 15.));
+        });
+        ::Tests::Benchmark("simulated minute (3600 frames)", 20, [&]() {
+            ::Tests::DoNotOptimise(Simulate(1u, true, 60.).size());
+        });
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestUpdate<float >();
+    TestUpdate<double>();
+    TestImpulseTrain();
+    BenchmarkUpdate();
+    return ::Tests::Result();
+}
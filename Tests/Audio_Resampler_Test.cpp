@@ -0,0 +1,186 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Audio_Resampler.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cmath>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_Resampler_Test
+//******************************************************************************
+//
+// Checks every quality lands exactly on the first and
+// last source samples, keeps DC, reads interleaved
+// channels independently and applies the transform; then
+// measures error against the underlying sine (which must
+// fall with each step up in quality once the sine is far
+// enough from DC for interpolation error to dominate the
+// sinc kernel's ripple), and times each quality for the
+// typical 100 to 320 sample case.
+
+namespace {
+    using sample_type    = float;
+    using size_type      = std::size_t;
+    using buffer_type    = std::vector<sample_type>;
+    using resampler_type = ::Audio::Samples::ResamplerT<sample_type>;
+    using quality        = ::Audio::Samples::ResampleQuality;
+    using span_type      = resampler_type::sample_span_type;
+
+    constexpr const quality Qualities[]{ quality::Linear, quality::CubicHermite, quality::WindowedSinc };
+    constexpr const char* const QualityNames[]{ "linear", "cubic", "sinc" };
+
+    constexpr const double Pi{ 3.14159265358979323846 };
+
+    buffer_type Resample(quality eQuality,
+                         const buffer_type& source,
+                         size_type stride,
+                         size_type targetCount,
+                         size_type offset = 0) {
+        buffer_type target(targetCount);
+        span_type span{ target };
+        std::nullptr_t transform{};
+        // As `update_sample_data`: later channels start one
+        // sample further on, but the size is that of the block
+        resampler_type::resample(eQuality, span, source.data() + offset, source.size(), stride, transform);
+        return target;
+    }
+
+    // Cycles per source sample
+    buffer_type Sine(size_type count, double frequency) {
+        buffer_type source(count);
+        for (size_type i = 0; i < count; ++i) {
+            source[i] = static_cast<sample_type>(std::sin(2. * Pi * frequency * static_cast<double>(i)));
+        }
+        return source;
+    }
+
+    //**************************************************************************
+    // TestProperties
+    //**************************************************************************
+    void TestProperties() {
+        constexpr const size_type SourceCount{ 100 }, TargetCount{ 320 };
+        const auto source{ Sine(SourceCount, .031) };
+        const buffer_type dc(SourceCount, .75f);
+
+        buffer_type interleaved(SourceCount * 2);
+        for (size_type i = 0; i < SourceCount; ++i) {
+            interleaved[i * 2 + 0] = source[i];
+            interleaved[i * 2 + 1] = -.5f * source[i];
+        }
+
+        for (const auto eQuality : Qualities) {
+            const auto target{ Resample(eQuality, source, 1, TargetCount) };
+            TEST_CHECK(target.front() == source.front());
+            TEST_CHECK(target.back()  == source.back());
+
+            // Unity gain at DC for every phase, even where taps are clamped
+            const auto flat{ Resample(eQuality, dc, 1, TargetCount) };
+            float fWorstDC{ 0 };
+            for (const auto v : flat) { fWorstDC = std::max(fWorstDC, std::abs(v - .75f)); }
+            TEST_CHECK(fWorstDC <= 1e-6f);
+
+            // Each interleaved channel as if on its own
+            const auto left { Resample(eQuality, interleaved, 2, TargetCount, 0) };
+            const auto right{ Resample(eQuality, interleaved, 2, TargetCount, 1) };
+            const auto scaled{ [&]() { buffer_type s(source); for (auto& v : s) { v *= -.5f; } return s; }() };
+            TEST_CHECK(left == target);
+            TEST_CHECK(right == Resample(eQuality, scaled, 1, TargetCount));
+
+            // Transform applied to every output sample
+            buffer_type transformed(TargetCount);
+            span_type span{ transformed };
+            auto fnDouble{ [](sample_type v) noexcept { return v * 2.f; } };
+            resampler_type::resample(eQuality, span, source.data(), source.size(), 1, fnDouble);
+            bool bTransformed{ true };
+            for (size_type i = 0; i < TargetCount; ++i) { bTransformed = bTransformed && transformed[i] == target[i] * 2.f; }
+            TEST_CHECK(bTransformed);
+        }
+
+        // Same size is a straight copy
+        for (const auto eQuality : Qualities) {
+            TEST_CHECK(Resample(eQuality, source, 1, SourceCount) == source);
+        }
+    }
+
+    //**************************************************************************
+    // TestAccuracy
+    //**************************************************************************
+    //
+    // Worst error against the sine itself, away from the
+    // edges (where taps are clamped)
+    void TestAccuracy() {
+        constexpr const size_type SourceCount{ 100 }, TargetCount{ 397 };
+        for (const double frequency : { .02, .1, .25 }) {
+            const auto source{ Sine(SourceCount, frequency) };
+            double fPrevious{ 1e9 };
+            for (size_type q = 0; q < std::size(Qualities); ++q) {
+                const auto target{ Resample(Qualities[q], source, 1, TargetCount) };
+                double fWorst{ 0 };
+                for (size_type d = TargetCount / 10; d < TargetCount - TargetCount / 10; ++d) {
+                    const auto position{ static_cast<double>(d) * static_cast<double>(SourceCount - 1) /
+                                         static_cast<double>(TargetCount - 1) };
+                    const auto expected{ std::sin(2. * Pi * frequency * position) };
+                    fWorst = std::max(fWorst, std::abs(static_cast<double>(target[d]) - expected));
+                }
+                std::printf("%.2f cycles/sample, %-6s worst error %.5f\n", frequency, QualityNames[q], fWorst);
+                if (frequency >= .1 || q < 2) { TEST_CHECK(fWorst < fPrevious); }
+                TEST_CHECK(fWorst < ((q == 0) ? .25 : (frequency < .2) ? .005 : .1));
+                fPrevious = fWorst;
+            }
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkQualities
+    //**************************************************************************
+    void BenchmarkQualities() {
+        constexpr const size_type SourceCount{ 100 }, TargetCount{ 320 };
+        const auto source{ Sine(SourceCount * 2, .031) };
+        buffer_type target(TargetCount);
+        for (size_type q = 0; q < std::size(Qualities); ++q) {
+            char szName[64];
+            std::snprintf(szName, sizeof(szName), "resample %zu -> %zu (%s, stereo)", SourceCount, TargetCount, QualityNames[q]);
+            const auto fMicroseconds{ ::Tests::Benchmark(szName, 100000, [&]() {
+                span_type span{ target };
+                std::nullptr_t transform{};
+                resampler_type::resample(Qualities[q], span, source.data(), source.size(), 2, transform);
+                ::Tests::DoNotOptimise(target.front());
+            }) };
+            std::printf("    %.2f ns/output sample\n", fMicroseconds * 1000. / static_cast<double>(TargetCount));
+        }
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestProperties();
+    TestAccuracy();
+    BenchmarkQualities();
+    return ::Tests::Result();
+}
@@ -0,0 +1,416 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Audio_SampleData_Util.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_SampleData_Test
+//******************************************************************************
+//
+// Runs 6 channel (5.1) interleaved audio through
+// `SampleDataT` and checks every channel lands in its own
+// aligned row, the combined row is their average, peaks
+// and previous/next data follow updates, and narrower
+// sources leave the remaining rows silent. Then times
+// updates and the peak pass against per-channel vectors
+// (the layout the structure-of-arrays block replaced).
+//
+// `update_combined` must give exactly the combined row
+// `update` does, so the two are compared bit for bit for
+// mono, stereo, 3 channel and 5.1 input, every way of fitting the source
+// to the values and with and without a (non-linear)
+// transform, then timed against each other.
+//
+// Min/max envelopes are checked against a brute force
+// reduction of each column, through both the single pass
+// (channel count divides the lane count) and per-channel
+// reductions, and timed against averaging.
+
+namespace {
+    using sample_type      = float;
+    using size_type        = std::size_t;
+    using buffer_type      = std::vector<sample_type>;
+    using sample_data_type = ::Audio::Samples::SampleDataT<sample_type, 8>;
+    using transform_type   = std::function<sample_type(size_type, sample_type)>; //< As `WaveformParams`
+
+    constexpr const size_type ChannelCount{ 6 };
+
+    // Channel `ch` of frame `f`; every channel distinct
+    sample_type Sample(size_type ch, size_type f) noexcept {
+        return static_cast<sample_type>(0.1 * static_cast<double>(ch + 1)) *
+               static_cast<sample_type>(std::sin(0.05 * static_cast<double>(f) + static_cast<double>(ch)));
+    }
+
+    buffer_type Interleaved(size_type channels, size_type frames, size_type start = 0) {
+        buffer_type source(channels * frames);
+        for (size_type f = 0; f < frames; ++f) {
+            for (size_type ch = 0; ch < channels; ++ch) { source[f * channels + ch] = Sample(ch, start + f); }
+        }
+        return source;
+    }
+
+    //**************************************************************************
+    // TestSixChannels
+    //**************************************************************************
+    void TestSixChannels() {
+        constexpr const size_type Count{ 100 };
+        using row_alignment = std::integral_constant<size_type, sample_data_type::channels_type::RowAlignment>;
+
+        sample_data_type data{};
+        data.layout(ChannelCount, Count);
+        data.peak_decay_rate(.25f, 0.f);
+        TEST_CHECK(data.channel_count() == ChannelCount);
+        TEST_CHECK(data.value_count() == Count);
+        TEST_CHECK(data.have_peaks());
+
+        // Rows (including the combined row) are padded to a cache line
+        const auto& channels{ data.channel_data() };
+        TEST_CHECK(channels.channel_count() == ChannelCount + 1);
+        TEST_CHECK((channels.stride() % row_alignment::value) == 0);
+        TEST_CHECK(channels.block().size() == 4 * (ChannelCount + 1) * channels.stride());
+
+        // Same frame count as values: a straight (de-interleaving) copy
+        const auto first{ Interleaved(ChannelCount, Count) };
+        const auto nUpdated{
+            ::Audio::Samples::update_sample_data(data, first.data(), first.size(), ChannelCount,
+                                                 transform_type{}, true /*bCombine*/)
+        };
+        TEST_CHECK(nUpdated == ChannelCount);
+
+        bool bRows{ true }, bCombined{ true }, bPeaks{ true };
+        for (size_type s = 0; s < Count; ++s) {
+            sample_type average{ 0 };
+            for (size_type ch = 0; ch < ChannelCount; ++ch) {
+                const auto v{ Sample(ch, s) };
+                bRows  = bRows  && data.channel_samples_next(ch)[s] == v;
+                bRows  = bRows  && data.channel_samples_prev(ch)[s] == 0;
+                // Peaks start from zero, so only positive samples raise them
+                bPeaks = bPeaks && data.channel_peaks_next(ch)[s] == ((v > 0) ? v : 0.f);
+                average += v * (1.f / static_cast<sample_type>(ChannelCount));
+            }
+            bCombined = bCombined && data.combined_samples_next()[s] == average;
+        }
+        TEST_CHECK(bRows);
+        TEST_CHECK(bCombined);
+        TEST_CHECK(bPeaks);
+
+        // The next update moves "next" to "previous" and
+        // interpolates between them
+        const auto second{ Interleaved(ChannelCount, Count, 1000) };
+        ::Audio::Samples::update_sample_data(data, second.data(), second.size(), ChannelCount,
+                                             transform_type{}, false /*bCombine*/);
+        bool bPrev{ true }, bCurr{ true }, bDecay{ true };
+        for (size_type ch = 0; ch < ChannelCount; ++ch) {
+            const auto curr{ data.channel_samples_curr(ch, .5f) };
+            const auto peaks{ data.channel_peaks_next(ch) };
+            for (size_type s = 0; s < Count; ++s) {
+                const auto a{ Sample(ch, s) }, b{ Sample(ch, 1000 + s) };
+                bPrev = bPrev && data.channel_samples_prev(ch)[s] == a;
+                bCurr = bCurr && std::abs(curr[s] - (a + b) * .5f) <= 1e-6f;
+                const auto peak{ (a > 0) ? a : 0.f };
+                const auto decayed{ (peak > 0.f) ? peak - .25f : 0.f };
+                bDecay = bDecay && peaks[s] == ((b > peak) ? b : decayed);
+            }
+        }
+        TEST_CHECK(bPrev);
+        TEST_CHECK(bCurr);
+        TEST_CHECK(bDecay);
+        // Not requested, so silent
+        bool bSilent{ true };
+        for (const auto v : data.combined_samples_next()) { bSilent = bSilent && v == 0; }
+        TEST_CHECK(bSilent);
+
+        // A stereo source fills the first two rows only; the
+        // combined row averages just those
+        const auto stereo{ Interleaved(2, Count) };
+        TEST_CHECK(::Audio::Samples::update_sample_data(data, stereo.data(), stereo.size(), 2,
+                                                        transform_type{}, true) == 2);
+        bool bStereo{ true };
+        for (size_type s = 0; s < Count; ++s) {
+            bStereo = bStereo && data.channel_samples_next(0)[s] == Sample(0, s);
+            bStereo = bStereo && data.channel_samples_next(1)[s] == Sample(1, s);
+            for (size_type ch = 2; ch < ChannelCount; ++ch) { bStereo = bStereo && data.channel_samples_next(ch)[s] == 0; }
+            bStereo = bStereo && data.combined_samples_next()[s] == Sample(0, s) * .5f + Sample(1, s) * .5f;
+        }
+        TEST_CHECK(bStereo);
+
+        // Changing the layout zeroes everything
+        data.layout(ChannelCount, Count / 2);
+        bool bZero{ true };
+        for (const auto v : data.channel_data().block()) { bZero = bZero && v == 0; }
+        TEST_CHECK(bZero);
+        TEST_CHECK(data.value_count() == Count / 2);
+    }
+
+    //**************************************************************************
+    // TestCombinedMatches
+    //**************************************************************************
+    void TestCombinedMatches() {
+        struct test_case final {
+            const char* m_szName;
+            size_type   m_nFrames;
+            size_type   m_nCount;
+            bool        m_bEnvelope;
+            ::Audio::Samples::ResampleQuality m_eQuality;
+        };
+        using quality = ::Audio::Samples::ResampleQuality;
+        constexpr const test_case Cases[]{
+            { "bin (whole)",       4800, 320, false, quality::CubicHermite },
+            { "bin (fractional)",  1001, 320, false, quality::CubicHermite },
+            { "copy",               320, 320, false, quality::CubicHermite },
+            { "expand (linear)",    100, 320, false, quality::Linear       },
+            { "expand (cubic)",     100, 320, false, quality::CubicHermite },
+            { "expand (sinc)",      100, 320, false, quality::WindowedSinc },
+            { "envelope (bin)",    4800, 640, true,  quality::CubicHermite },
+            { "envelope (expand)",  100, 640, true,  quality::CubicHermite },
+        };
+        const transform_type Transforms[]{
+            transform_type{},
+            [](size_type ch, sample_type v) noexcept {
+                return std::sqrt(std::abs(v)) * static_cast<sample_type>(ch + 1);
+            },
+        };
+
+        buffer_type scratch{};
+        for (const size_type channels : { size_type{ 1 }, size_type{ 2 }, size_type{ 3 }, ChannelCount }) {
+            for (const auto& c : Cases) {
+                for (const auto& transform : Transforms) {
+                    const auto source{ Interleaved(channels, c.m_nFrames) };
+                    sample_data_type both{}, combined{};
+                    both.layout(channels, c.m_nCount);
+                    combined.layout(channels, c.m_nCount);
+                    ::Audio::Samples::update_sample_data(both, source.data(), source.size(), channels,
+                                                         transform, true, c.m_bEnvelope, c.m_eQuality);
+                    const auto nCombined{
+                        ::Audio::Samples::update_combined_sample_data(combined, source.data(), source.size(), channels,
+                                                                      transform, scratch, c.m_bEnvelope, c.m_eQuality)
+                    };
+
+                    size_type nDiffer{ 0 }, nNonZero{ 0 };
+                    for (size_type s = 0; s < c.m_nCount; ++s) {
+                        nDiffer += (both.combined_samples_next()[s] != combined.combined_samples_next()[s]) ? 1 : 0;
+                        for (size_type ch = 0; ch < channels; ++ch) {
+                            nNonZero += (combined.channel_samples_next(ch)[s] != 0) ? 1 : 0;
+                        }
+                    }
+                    if (nDiffer > 0) {
+                        std::printf("%zu channels, %s%s: %zu of %zu combined values differ\n",
+                                    channels, c.m_szName, transform ? " (transformed)" : "",
+                                    nDiffer, c.m_nCount);
+                    }
+                    TEST_CHECK(nDiffer == 0);
+                    TEST_CHECK(nNonZero == 0);
+                    TEST_CHECK(nCombined == channels);
+                }
+            }
+        }
+    }
+
+    //**************************************************************************
+    // TestEnvelope
+    //**************************************************************************
+    void TestEnvelope() {
+        constexpr const size_type Pairs{ 160 };
+        // Not monotonic, so every pair must be re-ordered
+        const transform_type fnNegate{ [](size_type, sample_type v) noexcept { return -v; } };
+
+        // 2 and 4 channels are reduced in one pass, 3 and 6 a channel at a time
+        for (const size_type channels : { size_type{ 2 }, size_type{ 3 }, size_type{ 4 }, ChannelCount }) {
+            for (const size_type frames : { size_type{ 100 }, size_type{ 1001 }, size_type{ 65536 } }) {
+                for (const auto& transform : { transform_type{}, fnNegate }) {
+                    auto source{ Interleaved(channels, frames) };
+                    // A one sample spike in every channel, which averaging would flatten
+                    for (size_type ch = 0; ch < channels; ++ch) { source[(frames / 3) * channels + ch] = 2.f; }
+
+                    sample_data_type data{};
+                    data.layout(channels, Pairs * 2);
+                    ::Audio::Samples::update_sample_data(data, source.data(), source.size(), channels,
+                                                         transform, false, true /*bEnvelope*/);
+
+                    size_type nWrong{ 0 };
+                    bool bSpike{ false };
+                    for (size_type ch = 0; ch < channels; ++ch) {
+                        const auto pairs{ data.channel_samples_next(ch) };
+                        for (size_type p = 0; p < Pairs; ++p) {
+                            const auto begin{ (p * frames) / Pairs };
+                            const auto end  { std::max(((p + 1) * frames) / Pairs, begin + 1) };
+                            auto lo{ source[begin * channels + ch] }, hi{ lo };
+                            for (size_type f = begin; f < end; ++f) {
+                                lo = std::min(lo, source[f * channels + ch]);
+                                hi = std::max(hi, source[f * channels + ch]);
+                            }
+                            if (transform) { lo = transform(ch, lo); hi = transform(ch, hi); std::swap(lo, hi); }
+                            nWrong += (pairs[p * 2] != lo || pairs[p * 2 + 1] != hi) ? 1 : 0;
+                            bSpike  = bSpike || pairs[p * 2 + 1] == 2.f || pairs[p * 2] == -2.f;
+                        }
+                    }
+                    TEST_CHECK(nWrong == 0);
+                    TEST_CHECK(bSpike);
+                }
+            }
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkUpdate
+    //**************************************************************************
+    //
+    // 100ms at 48kHz into 320 values, as a waveform would be
+    void BenchmarkUpdate() {
+        constexpr const size_type Frames{ 4800 }, Count{ 320 };
+        for (const size_type channels : { size_type{ 2 }, ChannelCount }) {
+            const auto source{ Interleaved(channels, Frames) };
+            sample_data_type data{};
+            data.layout(channels, Count);
+            data.peak_decay_rate(.01f, 0.f);
+            char szName[64];
+            std::snprintf(szName, sizeof(szName), "update %zu channels + combined", channels);
+            ::Tests::Benchmark(szName, 5000, [&]() {
+                ::Audio::Samples::update_sample_data(data, source.data(), source.size(), channels,
+                                                     transform_type{}, true);
+                ::Tests::DoNotOptimise(data.combined_samples_next()[0]);
+            });
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkCombined
+    //**************************************************************************
+    //
+    // Combined only, through `update` and `update_combined`
+    void BenchmarkCombined() {
+        constexpr const size_type Frames{ 4800 }, Count{ 320 };
+        for (const size_type channels : { size_type{ 2 }, ChannelCount }) {
+            const auto source{ Interleaved(channels, Frames) };
+            sample_data_type data{};
+            data.layout(channels, Count);
+            buffer_type scratch{};
+            char szName[64];
+            std::snprintf(szName, sizeof(szName), "combined %zu channels (update)", channels);
+            ::Tests::Benchmark(szName, 5000, [&]() {
+                ::Audio::Samples::update_sample_data(data, source.data(), source.size(), channels,
+                                                     transform_type{}, true);
+                ::Tests::DoNotOptimise(data.combined_samples_next()[0]);
+            });
+            std::snprintf(szName, sizeof(szName), "combined %zu channels (update_combined)", channels);
+            ::Tests::Benchmark(szName, 5000, [&]() {
+                ::Audio::Samples::update_combined_sample_data(data, source.data(), source.size(), channels,
+                                                              transform_type{}, scratch);
+                ::Tests::DoNotOptimise(data.combined_samples_next()[0]);
+            });
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkEnvelope
+    //**************************************************************************
+    //
+    // 65536 frames into 160 columns, averaged or as
+    // [min, max] pairs
+    void BenchmarkEnvelope() {
+        constexpr const size_type Frames{ 65536 }, Columns{ 160 };
+        buffer_type scratch{};
+        for (const size_type channels : { size_type{ 2 }, ChannelCount }) {
+            const auto source{ Interleaved(channels, Frames) };
+            for (const bool bEnvelope : { false, true }) {
+                sample_data_type data{};
+                data.layout(channels, Columns * (bEnvelope ? 2 : 1));
+                char szName[64];
+                std::snprintf(szName, sizeof(szName), "%zu channels, %s", channels, bEnvelope ? "envelope" : "average");
+                ::Tests::Benchmark(szName, 500, [&]() {
+                    ::Audio::Samples::update_sample_data(data, source.data(), source.size(), channels,
+                                                         transform_type{}, false, bEnvelope);
+                    ::Tests::DoNotOptimise(data.channel_samples_next(0)[0]);
+                });
+                std::snprintf(szName, sizeof(szName), "%zu channels, combined %s", channels, bEnvelope ? "envelope" : "average");
+                ::Tests::Benchmark(szName, 500, [&]() {
+                    ::Audio::Samples::update_combined_sample_data(data, source.data(), source.size(), channels,
+                                                                  transform_type{}, scratch, bEnvelope);
+                    ::Tests::DoNotOptimise(data.combined_samples_next()[0]);
+                });
+            }
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkPeaks
+    //**************************************************************************
+    //
+    // Advancing a frame: one pass over the block, against
+    // swapping and decaying separate per-channel vectors
+    void BenchmarkPeaks() {
+        constexpr const size_type Count{ 320 };
+        sample_data_type data{};
+        data.layout(ChannelCount, Count);
+        data.peak_decay_rate(.01f, 0.f);
+        ::Tests::Benchmark("advance 6+1 rows (one block)", 100000, [&]() {
+            data.begin_update();
+            data.end_update();
+            ::Tests::DoNotOptimise(data.combined_peaks_next()[0]);
+        });
+
+        struct channel final {
+            buffer_type m_Prev, m_Next, m_PeaksPrev, m_PeaksNext;
+        };
+        std::vector<channel> rows(ChannelCount + 1);
+        for (auto& row : rows) {
+            row.m_Prev.assign(Count, 0.f); row.m_Next.assign(Count, 0.f);
+            row.m_PeaksPrev.assign(Count, 0.f); row.m_PeaksNext.assign(Count, 0.f);
+        }
+        ::Tests::Benchmark("advance 6+1 rows (per-channel vectors)", 100000, [&]() {
+            for (auto& row : rows) {
+                row.m_Prev.swap(row.m_Next);
+                row.m_PeaksPrev.swap(row.m_PeaksNext);
+                for (size_type i = 0; i < Count; ++i) {
+                    const auto peak{ row.m_PeaksPrev[i] };
+                    const auto decayed{ (peak > 0.f) ? (peak - .01f) : 0.f };
+                    row.m_PeaksNext[i] = (row.m_Next[i] > peak) ? row.m_Next[i] : decayed;
+                }
+            }
+            ::Tests::DoNotOptimise(rows.back().m_PeaksNext[0]);
+        });
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestSixChannels();
+    TestCombinedMatches();
+    TestEnvelope();
+    BenchmarkUpdate();
+    BenchmarkCombined();
+    BenchmarkEnvelope();
+    BenchmarkPeaks();
+    return ::Tests::Result();
+}
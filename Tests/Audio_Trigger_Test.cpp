@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Audio_Trigger.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Audio_Trigger_Test
+//******************************************************************************
+//
+// Plays signals through the trigger the way the data
+// manager does: every update (60 per second, with timing
+// jitter) the latest 100ms of stereo audio is searched and
+// a 50ms window chosen. For a locked trigger the signal's
+// phase at the centre of the window is the same every
+// update, so the change in phase between updates is
+// measured; the signals include tones above what survives
+// decimation, a tone with two rising crossings per period
+// (which the edge trigger can't hold) and a sweep. Then
+// times `find` for short and long blocks.
+
+namespace {
+    using sample_type  = float;
+    using size_type    = std::size_t;
+    using trigger_type = ::Audio::Samples::TriggerT<sample_type>;
+    using mode_type    = ::Audio::Samples::TriggerMode;
+
+    constexpr const double Pi        { 3.14159265358979323846 };
+    constexpr const double SampleRate{ 48000 };
+
+    // Interleaved stereo (right is the left at half level)
+    // and the phase, in radians, at every frame
+    struct signal final {
+        std::vector<sample_type> m_Samples{};
+        std::vector<double>      m_Phase  {};
+    };
+
+    // `fnFrequency` gives Hz at a time in seconds;
+    // `fnShape` a sample at a phase
+    signal MakeSignal(double fSeconds,
+                      const std::function<double(double)>& fnFrequency,
+                      const std::function<double(double)>& fnShape) {
+        const auto frames{ static_cast<size_type>(fSeconds * SampleRate) };
+        signal result{};
+        result.m_Samples.resize(frames * 2);
+        result.m_Phase.resize(frames);
+        double phase{ 0 };
+        for (size_type f = 0; f < frames; ++f) {
+            result.m_Phase[f] = phase;
+            const auto v{ static_cast<sample_type>(fnShape(phase)) };
+            result.m_Samples[f * 2 + 0] = v;
+            result.m_Samples[f * 2 + 1] = v * .5f;
+            phase += 2. * Pi * fnFrequency(static_cast<double>(f) / SampleRate) / SampleRate;
+        }
+        return result;
+    }
+
+    double Wrap(double fRadians) noexcept {
+        return std::remainder(fRadians, 2. * Pi);
+    }
+
+    struct lock_result final {
+        double m_fRMSJitter{ 0 }; //< Radians
+        double m_fLocked   { 0 }; //< Fraction of updates locked
+    };
+
+    // Windows start on whole frames, so a locked trigger can
+    // still move by up to a frame's worth of phase; it is
+    // treated as locked if within this or a frame
+    constexpr const double LockTolerance{ .2 }; //< Radians (about 3% of a period)
+
+    lock_result Run(mode_type eMode, const signal& sig) {
+        constexpr const size_type BlockFrames { 4800 }; //< 100ms
+        constexpr const size_type WindowFrames{ BlockFrames / 2 };
+        const auto totalFrames{ sig.m_Phase.size() };
+
+        trigger_type trigger{};
+        std::uint32_t seed{ 12345 };
+        size_type end{ BlockFrames };
+        double fPrevious{ 0 }, fSumSquares{ 0 };
+        size_type nUpdates{ 0 }, nLocked{ 0 };
+        bool bFirst{ true };
+        while (end <= totalFrames) {
+            const auto blockStart{ end - BlockFrames };
+            const auto start{ trigger.find(eMode, sig.m_Samples.data() + blockStart * 2,
+                                           BlockFrames, 2, WindowFrames) };
+            TEST_CHECK(start <= BlockFrames - WindowFrames);
+            const auto centre{ blockStart + start + WindowFrames / 2 };
+            const auto phase { sig.m_Phase[centre] };
+            if (!bFirst) {
+                const auto delta    { Wrap(phase - fPrevious) };
+                const auto perFrame { sig.m_Phase[centre + 1] - phase };
+                const auto tolerance{ std::max(LockTolerance, perFrame * 1.01) };
+                fSumSquares += delta * delta;
+                nLocked     += (std::abs(delta) <= tolerance) ? 1 : 0;
+                ++nUpdates;
+            }
+            bFirst    = false;
+            fPrevious = phase;
+
+            // 800 frames (1/60s) +/- 25%
+            seed = seed * 1664525u + 1013904223u;
+            end += 600 + (seed >> 8) % 401;
+        }
+        lock_result result{};
+        result.m_fRMSJitter = std::sqrt(fSumSquares / static_cast<double>(nUpdates));
+        result.m_fLocked    = static_cast<double>(nLocked) / static_cast<double>(nUpdates);
+        return result;
+    }
+
+    //**************************************************************************
+    // TestLock
+    //**************************************************************************
+    void TestLock() {
+        const auto sine{ [](double p) { return std::sin(p); } };
+        // Rises through zero three times per period
+        const auto tripleCrossing{ [](double p) { return std::sin(3. * p) + .3 * std::sin(p); } };
+        const auto constant = [](double hz) { return [hz](double) { return hz; }; };
+
+        struct test_case final {
+            const char* m_szName;
+            signal      m_Signal;
+            bool        m_bEdgeLocks; //< Expected to lock with `RisingEdge` too
+        };
+        const test_case cases[]{
+            { "sine 55Hz",             MakeSignal(4., constant(55.),   sine), true },
+            { "sine 440Hz",            MakeSignal(4., constant(440.),  sine), true },
+            { "sine 3kHz",             MakeSignal(4., constant(3000.), sine), true },
+            { "sine 7.5kHz",           MakeSignal(4., constant(7500.), sine), true },
+            { "three crossings 220Hz", MakeSignal(4., constant(220.),  tripleCrossing), false },
+            // Logarithmic, so every octave gets the same time
+            { "sweep 50Hz-5kHz (20s)", MakeSignal(20., [](double t) { return 50. * std::pow(100., t / 20.); }, sine), true },
+        };
+
+        std::printf("%-24s %-22s %-22s %-22s\n", "signal", "off", "rising edge", "period lock");
+        for (const auto& c : cases) {
+            const auto off   { Run(mode_type::None,       c.m_Signal) };
+            const auto edge  { Run(mode_type::RisingEdge, c.m_Signal) };
+            const auto locked{ Run(mode_type::PeriodLock, c.m_Signal) };
+            std::printf("%-24s %.3f rad (%5.1f%%)    %.3f rad (%5.1f%%)    %.3f rad (%5.1f%%)\n",
+                        c.m_szName,
+                        off.m_fRMSJitter,    off.m_fLocked    * 100.,
+                        edge.m_fRMSJitter,   edge.m_fLocked   * 100.,
+                        locked.m_fRMSJitter, locked.m_fLocked * 100.);
+            // Allow for the odd update where the sweep outruns the reference
+            TEST_CHECK(locked.m_fLocked >= .98);
+            TEST_CHECK(c.m_bEdgeLocks || edge.m_fLocked < .9);
+            TEST_CHECK(off.m_fLocked < .5);
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkFind
+    //**************************************************************************
+    void BenchmarkFind() {
+        const auto sig{ MakeSignal(1., [](double) { return 440.; }, [](double p) { return std::sin(p); }) };
+        for (const size_type frames : { size_type{ 2205 }, size_type{ 4800 }, size_type{ 24000 } }) {
+            for (const auto eMode : { mode_type::RisingEdge, mode_type::PeriodLock }) {
+                trigger_type trigger{};
+                size_type offset{ 0 };
+                char szName[64];
+                std::snprintf(szName, sizeof(szName), "%s, %zu frames",
+                              (eMode == mode_type::RisingEdge) ? "rising edge" : "period lock", frames);
+                ::Tests::Benchmark(szName, 2000, [&]() {
+                    // Move on a little each time, as between updates
+                    offset = (offset + 797) % (sig.m_Phase.size() - frames);
+                    const auto start{ trigger.find(eMode, sig.m_Samples.data() + offset * 2, frames, 2, frames / 2) };
+                    ::Tests::DoNotOptimise(start);
+                });
+            }
+        }
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestLock();
+    BenchmarkFind();
+    return ::Tests::Result();
+}
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "ColorBlend.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// ColorBlend_Test
+//******************************************************************************
+//
+// Every entry of a `ColorGradientT` must be exactly what
+// `ColorBlend` gives for that pixel of the bar, for each
+// colour type and the bar lengths the displays use, with
+// out of range pixels clamped; blend values must round to
+// the pixel `SpectrumAnalyser::Util::Draw` draws them at.
+// Then times both for a frame's worth of gradient bars.
+
+namespace {
+    template <typename ColorT>
+    bool Identical(const ColorT& a, const ColorT& b) noexcept {
+        // Bitwise, so -0/+0 or NaN payloads would show up too
+        return std::memcmp(a.data(), b.data(), sizeof(typename ColorT::component_type) * ColorT::Count) == 0;
+    }
+
+    template <typename ColorT, typename RandomT>
+    ColorT RandomColor(RandomT& random) {
+        using component_type = typename ColorT::component_type;
+        ColorT color{};
+        for (auto& c : color) {
+            if constexpr (std::is_floating_point_v<component_type>) {
+                // Palette colours are unpacked from 8 bits, but
+                // check arbitrary values too
+                const auto byte{ static_cast<component_type>(random() & 0xFF) / static_cast<component_type>(255) };
+                c = (random() & 1) ? byte : std::uniform_real_distribution<component_type>{ 0, 1 }(random);
+            } else {
+                c = static_cast<component_type>(random() & 0xFF);
+            }
+        }
+        return color;
+    }
+
+    constexpr const std::size_t Steps[]{ 1, 21, 43, 120, 160, 240, 320 };
+
+    //**************************************************************************
+    // TestTable
+    //**************************************************************************
+    template <typename ColorT>
+    void TestTable(const char* szName) {
+        using gradient_type = ::Color::ColorGradientT<ColorT>;
+        using float_type    = typename gradient_type::float_type;
+
+        std::mt19937 random{ 42u };
+        std::size_t nTested{ 0 }, nDifferent{ 0 };
+        for (int palette = 0; palette < 200; ++palette) {
+            const auto c0{ RandomColor<ColorT>(random) };
+            const auto c1{ RandomColor<ColorT>(random) };
+            for (const auto steps : Steps) {
+                const gradient_type gradient{ c0, c1, steps };
+                TEST_CHECK(gradient.steps() == steps);
+                TEST_CHECK(Identical(gradient.front(), c0));
+                TEST_CHECK(Identical(gradient.back(),  c1));
+
+                const auto last{ static_cast<int>(steps) };
+                for (int i = -2; i <= last + 2; ++i) {
+                    const auto pixel{ std::clamp(i, 0, last) };
+                    const auto expected{ ::Color::ColorBlend(c0, c1, static_cast<float_type>(pixel) /
+                                                                     static_cast<float_type>(steps)) };
+                    ++nTested;
+                    if (!Identical(gradient[i], expected)) { ++nDifferent; }
+                }
+                // Unsigned indices (e.g. `size_t`) too
+                TEST_CHECK(Identical(gradient[steps + 1], gradient[last]));
+            }
+        }
+        std::printf("%-10s %zu/%zu entries identical to ColorBlend\n", szName, nTested - nDifferent, nTested);
+        TEST_CHECK(nDifferent == 0);
+    }
+
+    //**************************************************************************
+    // TestRounding
+    //**************************************************************************
+    template <typename BlendT>
+    void TestRounding() {
+        std::mt19937 random{ 9u };
+        std::uniform_real_distribution<BlendT> inside{ 0, 1 };
+        const ::Color::Color3f c0{ 0.f, .25f, 1.f }, c1{ 1.f, .5f, 0.f };
+        for (const auto steps : Steps) {
+            const ::Color::ColorGradient3f gradient{ c0, c1, steps };
+            const auto fHeight{ static_cast<float>(steps) };
+            const auto check = [&](BlendT blend) {
+                // As `Util::Draw` (float samples, float height)
+                const auto nY{ static_cast<int>(std::round(static_cast<float>(blend) * fHeight)) };
+                TEST_CHECK(&gradient(blend) == &gradient[nY]);
+            };
+            for (int i = 0; i < 1000; ++i) { check(inside(random)); }
+            for (std::size_t i = 0; i <= steps; ++i) {
+                // Exactly on and half way between pixels
+                check(static_cast<BlendT>(i) / static_cast<BlendT>(steps));
+                check((static_cast<BlendT>(i) + static_cast<BlendT>(.5)) / static_cast<BlendT>(steps));
+            }
+            TEST_CHECK(&gradient(static_cast<BlendT>(-1)) == &gradient[0]);
+            TEST_CHECK(&gradient(static_cast<BlendT>(2))  == &gradient[steps]);
+            TEST_CHECK(&gradient(std::numeric_limits<BlendT>::quiet_NaN()) == &gradient[0]);
+        }
+    }
+
+    //**************************************************************************
+    // BenchmarkGradient
+    //**************************************************************************
+    //
+    // One frame of a 160 column gradient spectrum on a
+    // 240 pixel high display: a blend per bar and per peak.
+    void BenchmarkGradient() {
+        constexpr const std::size_t Height{ 240 };
+        std::mt19937 random{ 7u };
+        std::uniform_real_distribution<float> level{ 0.f, 1.f };
+        std::vector<float> levels(320);
+        std::vector<int>   pixels(levels.size());
+        for (std::size_t i = 0; i < levels.size(); ++i) {
+            levels[i] = level(random);
+            pixels[i] = static_cast<int>(std::round(levels[i] * static_cast<float>(Height)));
+        }
+
+        const ::Color::Color3f c0{ .1f, .6f, .2f }, c1{ 1.f, .2f, 0.f };
+        const ::Color::ColorGradient3f gradient{ c0, c1, Height };
+        ::Color::Color3f sum{};
+        ::Tests::Benchmark("ColorBlend (320 per frame)", 20000, [&]() {
+            for (const auto p : pixels) {
+                sum += ::Color::ColorBlend(c0, c1, static_cast<float>(p) / static_cast<float>(Height));
+            }
+            ::Tests::DoNotOptimise(sum);
+        });
+        ::Tests::Benchmark("ColorGradientT[pixel] (320 per frame)", 20000, [&]() {
+            for (const auto p : pixels) { sum += gradient[p]; }
+            ::Tests::DoNotOptimise(sum);
+        });
+        ::Tests::Benchmark("ColorGradientT(blend) (320 per frame)", 20000, [&]() {
+            for (const auto l : levels) { sum += gradient(l); }
+            ::Tests::DoNotOptimise(sum);
+        });
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestTable<::Color::Color3f >("Color3f");
+    TestTable<::Color::Color4f >("Color4f");
+    TestTable<::Color::Color3ub>("Color3ub");
+    TestTable<::Color::Color4ub>("Color4ub");
+    TestRounding<float >();
+    TestRounding<double>();
+    BenchmarkGradient();
+    return ::Tests::Result();
+}
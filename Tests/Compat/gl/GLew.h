@@ -0,0 +1,31 @@
+#pragma once
+#ifndef GUID_0257DC5F_096D_4B5A_A82C_87649409333B
+#define GUID_0257DC5F_096D_4B5A_A82C_87649409333B
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+// "GL/glcore.h" includes GLEW by its name on Windows; where
+// file names are case sensitive it is installed as this
+#include <GL/glew.h>
+//--------------------------------------
+
+#endif // GUID_0257DC5F_096D_4B5A_A82C_87649409333B
@@ -0,0 +1,293 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Tests/TestGL.h"
+#include "GL/glbitplane.h"
+#include "GL/glscopedutil.h"
+#include "Util/BitPlane.h"
+#include "Util/Dither.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// GL_glbitplane_Test
+//******************************************************************************
+//
+// Packs random scenes on the GPU with
+// `OpenGL::glBitPlanePacker`, as an offscreen `Canvas`
+// does, and compares the bit plane with what the CPU
+// paths it replaces make of the same framebuffer:
+//  - Threshold: the channel mapped GL_LUMINANCE read back
+//    (see `Canvas::InitialiseOpenGL`) then
+//    `bit_plane::pack`, and `bit_plane::pack` of the
+//    RGBA pixels themselves.
+//  - Bayer: the luma read back then `util::dither::bayer`.
+// Every width from 1 to 320 (whole bytes or not, one or
+// several texels per row), then the LCD sizes, must match
+// bit for bit, padding included. Then times each path,
+// read back included.
+//
+// Needs an OpenGL driver (llvmpipe will do); skipped
+// without one.
+
+namespace {
+    namespace bit_plane = ::util::bit_plane;
+    namespace dither    = ::util::dither;
+    using byte_type     = bit_plane::byte_type;
+    using size_type     = bit_plane::size_type;
+    using pixel_type    = std::uint32_t; //< RGBA, in memory order
+    using plane_type    = std::vector<byte_type>;
+    using packer_type   = ::OpenGL::glBitPlanePacker;
+
+    //**************************************************************************
+    // Scene
+    //**************************************************************************
+    // A scene texture (and a framebuffer to read it back
+    // through) of random pixels: a third black, a third
+    // with no channel over half, the rest anything, so
+    // both thresholds and luma see every kind of value
+    class Scene final {
+    public:
+        Scene(std::mt19937& rng, ::GLsizei width, ::GLsizei height) :
+            m_nWidth { width },
+            m_nHeight{ height },
+            m_Pixels (static_cast<size_type>(width) * static_cast<size_type>(height)) {
+            std::uniform_int_distribution<pixel_type> any{ };
+            std::uniform_int_distribution<int> kind{ 0, 2 };
+            for (auto& pixel : m_Pixels) {
+                const auto bits{ any(rng) };
+                switch (kind(rng)) {
+                    case 0:  pixel = bits & 0xFF000000; break;
+                    case 1:  pixel = bits & 0xFF7F7F7F; break;
+                    default: pixel = bits;              break;
+                }
+            }
+            m_Texture.create(GL_TEXTURE_2D, GL_RGBA8, width, height, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, m_Pixels.data());
+            {
+                const auto bind_{ m_Texture.scoped_bind(GL_TEXTURE_2D) };
+                ::OpenGL::glTexture::parameter(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                ::OpenGL::glTexture::parameter(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            }
+            m_Framebuffer.create(m_Texture);
+        }
+
+        explicit operator bool() const noexcept { return static_cast<bool>(m_Framebuffer); }
+
+        const auto& texture() const noexcept { return m_Texture; }
+        const auto& pixels () const noexcept { return m_Pixels; }
+
+        // Rows 4 byte aligned, as `Canvas::GetReadbackStride`
+        size_type stride() const noexcept {
+            return (static_cast<size_type>(m_nWidth) + 3) & ~size_type{ 3 };
+        }
+
+        // As `Canvas::EndPass` reads back a packed canvas
+        // packing on the CPU: channel mapped for
+        // thresholding, luma for dithering
+        plane_type luminance(bool bLuma) const {
+            plane_type bytes(stride() * static_cast<size_type>(m_nHeight));
+            const auto bind_{ m_Framebuffer.scoped_bind() };
+            const ::OpenGL::glScopedPushAttrib _attrib{ GL_PIXEL_MODE_BIT };
+            ::glPixelTransferi(GL_MAP_COLOR, bLuma ? GL_FALSE : GL_TRUE);
+            if (bLuma) {
+                ::glPixelTransferf(GL_RED_SCALE  , .299f);
+                ::glPixelTransferf(GL_GREEN_SCALE, .587f);
+                ::glPixelTransferf(GL_BLUE_SCALE , .114f);
+            }
+            ::glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            ::glReadPixels(0, 0, m_nWidth, m_nHeight,
+                           GL_LUMINANCE, GL_UNSIGNED_BYTE, bytes.data());
+            return bytes;
+        }
+
+        std::vector<pixel_type> rgba() const {
+            std::vector<pixel_type> pixels(m_Pixels.size());
+            const auto bind_{ m_Framebuffer.scoped_bind() };
+            ::glReadPixels(0, 0, m_nWidth, m_nHeight,
+                           GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            return pixels;
+        }
+
+    private:
+        ::GLsizei               m_nWidth     { 0 };
+        ::GLsizei               m_nHeight    { 0 };
+        std::vector<pixel_type> m_Pixels     {};
+        ::OpenGL::glTexture     m_Texture    {};
+        ::OpenGL::glFramebuffer m_Framebuffer{};
+    }; // class Scene final
+
+    // The channel maps `Canvas::InitialiseOpenGL` sets for
+    // a packed canvas
+    void SetChannelMaps() {
+        std::array<::GLushort, 256> channelMap{};
+        std::fill(channelMap.begin() + channelMap.size() / 2, channelMap.end(), ::GLushort{ 0xFFFF });
+        ::glPixelMapusv(GL_PIXEL_MAP_R_TO_R, static_cast<::GLsizei>(channelMap.size()), channelMap.data());
+        ::glPixelMapusv(GL_PIXEL_MAP_G_TO_G, static_cast<::GLsizei>(channelMap.size()), channelMap.data());
+        ::glPixelMapusv(GL_PIXEL_MAP_B_TO_B, static_cast<::GLsizei>(channelMap.size()), channelMap.data());
+    }
+
+    bool Matches(const char* szRoute,
+                 const plane_type& expected,
+                 const plane_type& actual,
+                 ::GLsizei width,
+                 ::GLsizei height) {
+        const auto it{ std::mismatch(expected.begin(), expected.end(), actual.begin()) };
+        if (it.first == expected.end()) { return true; }
+        const auto offset{ static_cast<size_type>(it.first - expected.begin()) };
+        const auto stride{ bit_plane::stride(static_cast<size_type>(width)) };
+        std::printf("  %s (%dx%d): row %zu byte %zu is %02X, should be %02X\n",
+                    szRoute, width, height, offset / stride, offset % stride,
+                    *it.second, *it.first);
+        return false;
+    }
+
+    //**************************************************************************
+    // TestMatchesCPU
+    //**************************************************************************
+    void TestMatchesCPU(std::mt19937& rng,
+                        ::GLsizei width,
+                        ::GLsizei height,
+                        size_type& nFailures) {
+        const Scene scene{ rng, width, height };
+        packer_type packer{};
+        if (!scene || !packer.create(width, height)) {
+            std::printf("  %dx%d: failed to create the scene or packer\n", width, height);
+            ++nFailures;
+            return;
+        }
+
+        const auto W{ static_cast<size_type>(width) };
+        const auto H{ static_cast<size_type>(height) };
+        const auto size{ bit_plane::byte_size(W, H) };
+
+        // Threshold
+        plane_type gpu(size, 0xA5);
+        packer.pack(scene.texture(), false, gpu.data());
+
+        plane_type cpu(size, 0x5A);
+        const auto mapped{ scene.luminance(false) };
+        bit_plane::pack(mapped.data(), scene.stride(), cpu.data(), W, H);
+        nFailures += !Matches("threshold, luminance read back", cpu, gpu, width, height);
+
+        std::fill(cpu.begin(), cpu.end(), 0x5A);
+        bit_plane::pack(scene.pixels().data(), cpu.data(), W, H);
+        nFailures += !Matches("threshold, RGBA", cpu, gpu, width, height);
+
+        // Ordered dithering
+        std::fill(gpu.begin(), gpu.end(), 0xA5);
+        packer.pack(scene.texture(), true, gpu.data());
+
+        std::fill(cpu.begin(), cpu.end(), 0x5A);
+        const auto luma{ scene.luminance(true) };
+        dither::bayer(luma.data(), scene.stride(), cpu.data(), W, H);
+        nFailures += !Matches("bayer, luma read back", cpu, gpu, width, height);
+
+        packer.destroy();
+    }
+
+    void TestMatchesCPU() {
+        std::mt19937 rng{ 43 };
+        size_type nFailures{ 0 };
+        for (::GLsizei width = 1; width <= 320; ++width) {
+            TestMatchesCPU(rng, width, 9, nFailures); //< Over one Bayer tile
+        }
+        for (const auto& [W, H] : { std::pair<::GLsizei, ::GLsizei>{ 160, 43 }, std::pair<::GLsizei, ::GLsizei>{ 320, 240 } }) {
+            TestMatchesCPU(rng, W, H, nFailures);
+        }
+        TEST_CHECK(nFailures == 0);
+    }
+
+    //**************************************************************************
+    // BenchmarkPaths
+    //**************************************************************************
+    // Each includes its read back (which waits for the
+    // driver), not the drawing of the scene
+    void BenchmarkPaths(::GLsizei width, ::GLsizei height) {
+        std::mt19937 rng{ 160 };
+        const Scene scene{ rng, width, height };
+        packer_type packer{};
+        if (!scene || !packer.create(width, height)) { return; }
+
+        const auto W{ static_cast<size_type>(width) };
+        const auto H{ static_cast<size_type>(height) };
+        plane_type plane(bit_plane::byte_size(W, H));
+        char szName[64];
+
+        std::snprintf(szName, sizeof(szName), "GPU pack, threshold (%dx%d)", width, height);
+        ::Tests::Benchmark(szName, 200, [&]() {
+            packer.pack(scene.texture(), false, plane.data());
+            ::Tests::DoNotOptimise(plane.front());
+        });
+        std::snprintf(szName, sizeof(szName), "GPU pack, bayer (%dx%d)", width, height);
+        ::Tests::Benchmark(szName, 200, [&]() {
+            packer.pack(scene.texture(), true, plane.data());
+            ::Tests::DoNotOptimise(plane.front());
+        });
+        std::snprintf(szName, sizeof(szName), "mapped luminance + pack (%dx%d)", width, height);
+        ::Tests::Benchmark(szName, 200, [&]() {
+            const auto mapped{ scene.luminance(false) };
+            bit_plane::pack(mapped.data(), scene.stride(), plane.data(), W, H);
+            ::Tests::DoNotOptimise(plane.front());
+        });
+        std::snprintf(szName, sizeof(szName), "luma + bayer (%dx%d)", width, height);
+        ::Tests::Benchmark(szName, 200, [&]() {
+            const auto luma{ scene.luminance(true) };
+            dither::bayer(luma.data(), scene.stride(), plane.data(), W, H);
+            ::Tests::DoNotOptimise(plane.front());
+        });
+        std::snprintf(szName, sizeof(szName), "RGBA + pack (%dx%d)", width, height);
+        ::Tests::Benchmark(szName, 200, [&]() {
+            const auto pixels{ scene.rgba() };
+            bit_plane::pack(pixels.data(), plane.data(), W, H);
+            ::Tests::DoNotOptimise(plane.front());
+        });
+        packer.destroy();
+    }
+} // namespace <anonymous>
+
+int main() {
+    const ::Tests::glOffscreen context{ 1, 1 };
+    if (!context || !packer_type::is_supported()) {
+        std::printf("No OpenGL 2.0 driver: skipped\n");
+        return ::Tests::SkipReturnCode;
+    }
+    std::printf("Renderer: %s\n", context.renderer());
+
+    SetChannelMaps();
+    TestMatchesCPU();
+    BenchmarkPaths(160, 43);
+    BenchmarkPaths(320, 240);
+    return ::Tests::Result();
+}
@@ -0,0 +1,362 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Tests/TestGL.h"
+#include "GL/glinterpolate.h"
+#include "Util/InterpolateUtil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// GL_glinterpolate_Test
+//******************************************************************************
+//
+// Draws spectrum bars (and peaks) both ways the spectrum
+// analysers can: from values interpolated on the CPU and
+// rounded as `SpectrumAnalyser::Util::Draw` rounds them,
+// and from the two frames blended by the vertex shader of
+// `OpenGL::glInterpolatedVertices`, laid out as
+// `SpectrumAnalyser::detail::Basic` lays them out; mono
+// and stereo, at the G15 (160x43, an odd height) and G19
+// (320x240) sizes. Then times a redraw each way.
+//
+// With float samples (32-bit builds) every redraw must be
+// pixel identical, values on the rounding thresholds
+// included. With double samples (64-bit builds) the CPU
+// interpolates in double, the shader in float, so a bar
+// within a rounding error of a threshold may differ;
+// those must stay rare.
+//
+// The spectrum analyser headers need the plugin's config
+// to build, so their arithmetic is repeated here.
+//
+// Needs an OpenGL driver (llvmpipe will do); skipped
+// without one.
+
+namespace {
+    using vertices_type = ::OpenGL::glInterpolatedVertices;
+    using coord_type    = ::GLint;
+    using pixels_type   = ::Tests::glOffscreen::pixels_type;
+
+    template <typename SampleT>
+    struct Frames final {
+        using samples_type = std::vector<SampleT>;
+        samples_type prevL, nextL;
+        samples_type prevR, nextR; //< Stereo only
+    };
+
+    //**************************************************************************
+    // RandomFrames
+    //**************************************************************************
+    // Values in [0,1]; with `bThresholds`, a quarter of them
+    // exactly where the CPU rounds up to the next pixel and
+    // some at the ends
+    template <typename SampleT>
+    std::vector<SampleT> RandomSamples(std::mt19937& random,
+                                       std::size_t nCount,
+                                       bool bStereo,
+                                       ::GLsizei nHeight,
+                                       bool bThresholds) {
+        const auto fScale{ static_cast<double>(bStereo ? nHeight / 2 : nHeight) };
+        const auto fBias { (bStereo && (nHeight % 2) != 0) ? .5 : 0. };
+        std::uniform_real_distribution<SampleT> inside{ 0, 1 };
+        std::vector<SampleT> samples(nCount);
+        for (auto& fSample : samples) {
+            switch (bThresholds ? random() % 4 : 3) {
+            case 0: {
+                fSample = static_cast<SampleT>(random() % 2);
+                break;
+            }
+            case 1: {
+                const auto nPixel{ static_cast<double>(random() % static_cast<unsigned>(fScale + 1)) };
+                fSample = static_cast<SampleT>(std::min((nPixel + .5 - fBias) / fScale, 1.));
+                break;
+            }
+            default: {
+                fSample = inside(random);
+                break;
+            }
+            }
+        }
+        return samples;
+    }
+
+    template <typename SampleT>
+    Frames<SampleT> RandomFrames(std::mt19937& random,
+                                 bool bStereo,
+                                 ::GLsizei nWidth,
+                                 ::GLsizei nHeight,
+                                 bool bThresholds) {
+        const auto nCount{ static_cast<std::size_t>(nWidth) };
+        Frames<SampleT> frames{};
+        frames.prevL = RandomSamples<SampleT>(random, nCount, bStereo, nHeight, bThresholds);
+        frames.nextL = RandomSamples<SampleT>(random, nCount, bStereo, nHeight, bThresholds);
+        if (bStereo) {
+            frames.prevR = RandomSamples<SampleT>(random, nCount, bStereo, nHeight, bThresholds);
+            frames.nextR = RandomSamples<SampleT>(random, nCount, bStereo, nHeight, bThresholds);
+        }
+        return frames;
+    }
+
+    //**************************************************************************
+    // DrawCPU
+    //**************************************************************************
+    // As `SpectrumAnalyser::Util::Pixels`
+    template <typename SampleT>
+    coord_type Pixels(SampleT fSample, SampleT fScale, SampleT fBias) noexcept {
+        constexpr const auto fHalf{ static_cast<SampleT>(.5) };
+        const auto fPixels = fSample * fScale;
+        const auto fWhole = std::floor(fPixels);
+        const auto nWhole = static_cast<coord_type>(fWhole);
+        return (fPixels >= fWhole + (fHalf - fBias)) ? nWhole + 1 : nWhole;
+    }
+
+    // As `SpectrumAnalyser::Mono::Draw`/`Stereo::Draw`: lines
+    // (or points, for peaks) of values interpolated as
+    // `Audio::SampleData` does, placed by `Util::Draw`
+    template <typename SampleT>
+    void DrawCPU(const Frames<SampleT>& frames,
+                 SampleT fInterp,
+                 bool bStereo,
+                 ::GLsizei nHeight,
+                 bool bPoints) {
+        const auto count{ frames.prevL.size() };
+        const auto fHeight{ static_cast<SampleT>(nHeight) };
+        ::glBegin(bPoints ? GL_POINTS : GL_LINES);
+        if (!bStereo) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto fSample{ ::util::lerp(frames.prevL[i], frames.nextL[i], fInterp) };
+                const auto nX{ static_cast<coord_type>(i) };
+                if (!bPoints) { ::glVertex2i(nX, 0); }
+                ::glVertex2i(nX, Pixels<SampleT>(fSample, fHeight, 0));
+            }
+        } else {
+            const auto fHalfHeight{ fHeight * static_cast<SampleT>(.5) };
+            const auto nHalfHeight{ nHeight / 2 };
+            const auto nBaseL     { nHalfHeight };
+            const auto nBaseR     { nHeight - nHalfHeight };
+            const auto fBias      { static_cast<SampleT>((nHeight % 2) != 0 ? .5 : 0.) };
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto nX{ static_cast<coord_type>(i) };
+                const auto fSampleL{ ::util::lerp(frames.prevL[i], frames.nextL[i], fInterp) };
+                if (!bPoints) { ::glVertex2i(nX, nHalfHeight); }
+                ::glVertex2i(nX, nBaseL + Pixels<SampleT>(fSampleL, fHalfHeight, fBias));
+
+                const auto fSampleR{ ::util::lerp(frames.prevR[i], frames.nextR[i], fInterp) };
+                if (!bPoints) { ::glVertex2i(nX, nHalfHeight); }
+                ::glVertex2i(nX, nBaseR - Pixels<SampleT>(fSampleR, fHalfHeight, fBias));
+            }
+        }
+        ::glEnd();
+    }
+
+    //**************************************************************************
+    // Record/DrawGPU
+    //**************************************************************************
+    // As `SpectrumAnalyser::detail::Basic::Record` and
+    // `DrawInterpolated`
+    template <typename SampleT>
+    void Record(vertices_type& vertices,
+                const Frames<SampleT>& frames,
+                bool bStereo,
+                ::GLsizei nHeight,
+                bool bPoints) {
+        vertices.clear();
+        const auto count{ frames.prevL.size() };
+        vertices.begin(bPoints ? GL_POINTS : GL_LINES);
+        if (!bStereo) {
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto nX{ static_cast<coord_type>(i) };
+                if (!bPoints) { vertices.vertex(nX, 0, 0, frames.prevL[i], frames.nextL[i]); }
+                vertices.vertex(nX, 0, 1, frames.prevL[i], frames.nextL[i]);
+            }
+        } else {
+            const auto nHalfHeight{ nHeight / 2 };
+            const auto nBaseL     { nHalfHeight };
+            const auto nBaseR     { nHeight - nHalfHeight };
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto nX{ static_cast<coord_type>(i) };
+                if (!bPoints) { vertices.vertex(nX, nHalfHeight, 0, frames.prevL[i], frames.nextL[i]); }
+                vertices.vertex(nX, nBaseL, 1, frames.prevL[i], frames.nextL[i]);
+                if (!bPoints) { vertices.vertex(nX, nHalfHeight, 0, frames.prevR[i], frames.nextR[i]); }
+                vertices.vertex(nX, nBaseR, -1, frames.prevR[i], frames.nextR[i]);
+            }
+        }
+        vertices.end();
+    }
+
+    void DrawGPU(const vertices_type& vertices,
+                 float fInterp,
+                 bool bStereo,
+                 ::GLsizei nHeight) {
+        const auto fHeight{ static_cast<::GLfloat>(nHeight) };
+        const auto fScale { bStereo ? fHeight * .5f : fHeight };
+        const auto fBias  { (bStereo && (nHeight % 2) != 0) ? .5f : 0.f };
+        vertices.draw(fInterp, fScale, fBias);
+    }
+
+    //**************************************************************************
+    // TestMatchesCPU
+    //**************************************************************************
+    // Returns the columns that differ, out of `nColumns`
+    template <typename SampleT>
+    std::size_t CompareCPU(::GLsizei nWidth, ::GLsizei nHeight,
+                           bool bStereo, bool bPoints, bool bThresholds,
+                           std::size_t& nColumns) {
+        nColumns = 0;
+        ::Tests::glOffscreen context{ nWidth, nHeight };
+        if (!TEST_CHECK(context)) { return 0; }
+
+        vertices_type vertices{};
+        std::mt19937 random{ static_cast<unsigned>(nWidth * nHeight) + (bStereo ? 1u : 0u) };
+        std::uniform_real_distribution<float> inside{ 0.f, 1.f };
+
+        constexpr const int FrameCount{ 50 };
+        constexpr const int RedrawCount{ 8 }; //< Per frame
+        std::size_t nDiffer{ 0 };
+        for (int nFrame = 0; nFrame < FrameCount; ++nFrame) {
+            const auto frames{ RandomFrames<SampleT>(random, bStereo, nWidth, nHeight, bThresholds) };
+            Record(vertices, frames, bStereo, nHeight, bPoints);
+            if (!TEST_CHECK(vertices.upload())) { return 0; }
+
+            for (int nRedraw = 0; nRedraw < RedrawCount; ++nRedraw) {
+                // Both ends, then anywhere between
+                const auto fInterp{ (nRedraw == 0) ? 0.f : (nRedraw == 1) ? 1.f : inside(random) };
+
+                ::glClear(GL_COLOR_BUFFER_BIT);
+                DrawCPU<SampleT>(frames, fInterp, bStereo, nHeight, bPoints);
+                const auto cpu{ context.read() };
+
+                ::glClear(GL_COLOR_BUFFER_BIT);
+                DrawGPU(vertices, fInterp, bStereo, nHeight);
+                const auto gpu{ context.read() };
+
+                for (::GLsizei x = 0; x < nWidth; ++x) {
+                    for (::GLsizei y = 0; y < nHeight; ++y) {
+                        const auto i{ static_cast<std::size_t>(y) * static_cast<std::size_t>(nWidth) +
+                                      static_cast<std::size_t>(x) };
+                        if (cpu[i] != gpu[i]) { ++nDiffer; break; }
+                    }
+                }
+                nColumns += static_cast<std::size_t>(nWidth);
+            }
+        }
+        vertices.destroy();
+        return nDiffer;
+    }
+
+    void TestMatchesCPU(::GLsizei nWidth, ::GLsizei nHeight, bool bStereo, bool bPoints) {
+        const auto szName{ bStereo ? (bPoints ? "stereo peaks" : "stereo bars")
+                                   : (bPoints ? "mono peaks"   : "mono bars") };
+        std::size_t nColumns{ 0 };
+
+        // Float samples: exact, thresholds included
+        const auto nFloat{ CompareCPU<float>(nWidth, nHeight, bStereo, bPoints, true, nColumns) };
+        if (nFloat != 0) {
+            std::printf("%dx%d %s (float): %zu of %zu columns differ\n",
+                        nWidth, nHeight, szName, nFloat, nColumns);
+        }
+        TEST_CHECK(nFloat == 0);
+
+        // Double samples: a column in 10000 at most (each
+        // is within a rounding error about 1 in 100000)
+        const auto nDouble{ CompareCPU<double>(nWidth, nHeight, bStereo, bPoints, false, nColumns) };
+        std::printf("%dx%d %s (double): %zu of %zu columns differ\n",
+                    nWidth, nHeight, szName, nDouble, nColumns);
+        TEST_CHECK(nDouble * 10000 <= nColumns);
+    }
+
+    //**************************************************************************
+    // BenchmarkRedraw
+    //**************************************************************************
+    // A redraw between updates, finished (i.e. drawing time
+    // included): the CPU interpolating, rounding and sending
+    // every vertex, against the GPU path setting a uniform;
+    // then the GPU path's once per update upload
+    void BenchmarkRedraw(::GLsizei nWidth, ::GLsizei nHeight, bool bStereo) {
+        ::Tests::glOffscreen context{ nWidth, nHeight };
+        if (!context) { return; }
+
+        vertices_type vertices{};
+        std::mt19937 random{ 3u };
+        const auto frames{ RandomFrames<float>(random, bStereo, nWidth, nHeight, false) };
+        Record(vertices, frames, bStereo, nHeight, false);
+        if (!vertices.upload()) { return; }
+
+        const auto szMode{ bStereo ? "stereo" : "mono" };
+        char szName[64];
+        float fInterp{ 0.f };
+        std::snprintf(szName, sizeof(szName), "bars %s cpu (%dx%d)", szMode, nWidth, nHeight);
+        ::Tests::Benchmark(szName, 500, [&]() {
+            fInterp = (fInterp >= 1.f) ? 0.f : fInterp + .125f;
+            ::glClear(GL_COLOR_BUFFER_BIT);
+            DrawCPU<float>(frames, fInterp, bStereo, nHeight, false);
+            ::glFinish();
+        });
+        std::snprintf(szName, sizeof(szName), "bars %s gpu (%dx%d)", szMode, nWidth, nHeight);
+        ::Tests::Benchmark(szName, 500, [&]() {
+            fInterp = (fInterp >= 1.f) ? 0.f : fInterp + .125f;
+            ::glClear(GL_COLOR_BUFFER_BIT);
+            DrawGPU(vertices, fInterp, bStereo, nHeight);
+            ::glFinish();
+        });
+        std::snprintf(szName, sizeof(szName), "bars %s gpu upload (%dx%d)", szMode, nWidth, nHeight);
+        ::Tests::Benchmark(szName, 500, [&]() {
+            Record(vertices, frames, bStereo, nHeight, false);
+            vertices.upload();
+            ::glFinish();
+        });
+        vertices.destroy();
+    }
+} // namespace <anonymous>
+
+int main() {
+    {
+        const ::Tests::glOffscreen context{ 1, 1 };
+        if (!context || !::OpenGL::glInterpolatedVertices::is_supported()) {
+            std::printf("No OpenGL 2.0 driver: skipped\n");
+            return ::Tests::SkipReturnCode;
+        }
+        std::printf("Renderer: %s\n", context.renderer());
+    }
+
+    for (const auto& [W, H] : { std::pair<::GLsizei, ::GLsizei>{ 160, 43 }, std::pair<::GLsizei, ::GLsizei>{ 320, 240 } }) {
+        for (const auto bStereo : { false, true }) {
+            TestMatchesCPU(W, H, bStereo, false);
+            TestMatchesCPU(W, H, bStereo, true);
+        }
+    }
+    for (const auto bStereo : { false, true }) {
+        BenchmarkRedraw(320, 240, bStereo);
+    }
+    return ::Tests::Result();
+}
@@ -0,0 +1,250 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "Tests/TestCommon.h"
+#include "LCD/HeadlessLCD.h"
+#include "LCD/LCD_Presenter.h"
+#include "Util/FrameCopy.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// LCD_Presenter_Test
+//******************************************************************************
+//
+// Presents frames to a `LCD::HeadlessLCD` and checks what
+// it shows after each:
+//
+//  - colour frames are finished straight into the display's
+//    own buffers as `Canvas::EndFrame(pTarget, stale)` does
+//    (`util::frame::copy_opaque`), which must copy nothing
+//    else, and alternate between the two;
+//  - a frame changing rows back to what the older buffer
+//    already held must still be sent, and one redrawn the
+//    same must not;
+//  - packed (monochrome) frames are copied, and counted.
+//
+// `copy_opaque` itself is checked by Util_FrameCopy_Test.
+
+namespace {
+    using display_type = ::LCD::HeadlessLCD;
+    using device_desc  = ::LCD::Device::Desc;
+    using device_type  = ::LCD::Device::Type;
+    using presenter    = ::LCD::Presenter;
+    using rect_type    = ::util::dirty_rect;
+    using pixel_type   = ::util::frame::pixel_type;
+    using byte_type    = std::uint8_t;
+    using size_type    = std::size_t;
+
+    constexpr const int Width { 22 }; //< Not a multiple of 4, so SSE2 leaves a remainder
+    constexpr const int Height{ 12 };
+
+    constexpr const pixel_type Opaque{ 0xFF000000u };
+
+    //--------------------------------------------------------------------------
+
+    constexpr bool Same(const rect_type& a,
+                        const rect_type& b) noexcept {
+        return (a.left == b.left) && (a.top == b.top) && (a.right == b.right) && (a.bottom == b.bottom);
+    }
+
+    std::shared_ptr<display_type> CreateDisplay(device_type eType,
+                                                int iWidth,
+                                                int iHeight,
+                                                int iBitsPerPixel) {
+        device_desc desc{};
+        desc.eType         = eType;
+        desc.iWidth        = iWidth;
+        desc.iHeight       = iHeight;
+        desc.iBitsPerPixel = iBitsPerPixel;
+        display_type::initialise(desc);
+        auto pDisplay{ std::static_pointer_cast<display_type>(::LCD::ILCD::instance_peek()) };
+        TEST_CHECK(pDisplay->Connect(eType));
+        return pDisplay;
+    }
+
+    // Until the presenter has dealt with `nUpdates` in all
+    bool WaitForUpdates(const presenter& frames,
+                        size_type nUpdates) {
+        const auto until{ std::chrono::steady_clock::now() + std::chrono::seconds{ 5 } };
+        while (std::chrono::steady_clock::now() < until) {
+            const auto stats{ frames.GetStatistics() };
+            if ((stats.m_nSubmitted + stats.m_nUnchanged + stats.m_nDropped) >= nUpdates) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+        return false;
+    }
+
+    // Alpha left zero, as GDI does
+    void Fill(std::vector<pixel_type>& canvas,
+              const rect_type& rect,
+              pixel_type seed) {
+        for (auto y = rect.top; y < rect.bottom; ++y) {
+            for (auto x = rect.left; x < rect.right; ++x) {
+                canvas[static_cast<size_type>(y * Width + x)] = (seed + static_cast<pixel_type>(x * 7 + y * 131)) & 0x00FFFFFFu;
+            }
+        }
+    }
+
+    bool Shows(const display_type& display,
+               const std::vector<pixel_type>& canvas) {
+        const auto* pShown{ reinterpret_cast<const pixel_type*>(display.GetShownFrame()) };
+        if (!pShown) { return false; }
+        for (size_type i = 0; i < canvas.size(); ++i) {
+            if (pShown[i] != (canvas[i] | Opaque)) { return false; }
+        }
+        return true;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void TestInPlace() {
+        const auto pDisplay{ CreateDisplay(device_type::Color, Width, Height, 32) };
+        const auto* pBuffer0{ static_cast<const byte_type*>(pDisplay->GetFrameBuffer(0)) };
+        const auto* pBuffer1{ static_cast<const byte_type*>(pDisplay->GetFrameBuffer(1)) };
+        TEST_CHECK(pBuffer0 && pBuffer1 && (pBuffer0 != pBuffer1));
+
+        presenter frames{};
+        TEST_CHECK(frames.StartThread(pDisplay));
+        TEST_CHECK(frames.NeedsWholeFrame());
+
+        std::vector<pixel_type> canvas(static_cast<size_type>(Width * Height), 0);
+        size_type        nUpdates{ 0 };
+        const byte_type* pLast   { nullptr };
+        // Draws `rect` (seeded by `seed`) then posts it as
+        // `VisualisationManager` does, returning what the
+        // frame changed
+        const auto present = [&](const rect_type& rect, pixel_type seed) {
+            Fill(canvas, rect, seed);
+            rect_type changed{};
+            frames.Post([&](void* pMailbox, const rect_type& stale) {
+                changed = ::util::frame::copy_opaque(canvas.data(),
+                                                     static_cast<pixel_type*>(pMailbox),
+                                                     Width,
+                                                     rect,
+                                                     stale);
+                return changed;
+            });
+            TEST_CHECK(WaitForUpdates(frames, ++nUpdates));
+            TEST_CHECK(Shows(*pDisplay, canvas));
+            TEST_CHECK(pDisplay->GetCopyCount() == 0);
+            return changed;
+        };
+        // Each new frame is sent from the other buffer
+        const auto alternated = [&]() {
+            const auto* pShown{ pDisplay->GetShownFrame() };
+            const bool  bAlternated{ ((pShown == pBuffer0) || (pShown == pBuffer1)) && (pShown != pLast) };
+            pLast = pShown;
+            return bAlternated;
+        };
+
+        const auto all{ rect_type::all(Width, Height) };
+        TEST_CHECK(Same(present(all, 1), all));
+        TEST_CHECK(!frames.NeedsWholeFrame());
+        TEST_CHECK(alternated());
+
+        TEST_CHECK(Same(present({ 0, 2, Width, 5 }, 2), { 0, 2, Width, 5 }));
+        TEST_CHECK(alternated());
+
+        // Back to the first frame's rows, which the buffer now
+        // being written still holds: the rows must still count
+        TEST_CHECK(Same(present({ 0, 2, Width, 5 }, 1), { 0, 2, Width, 5 }));
+        TEST_CHECK(alternated());
+
+        // Drawn again unchanged: the stale rows count as changed
+        // for the writer, but match the frame the display has,
+        // so there is nothing to send
+        present(all, 1);
+        TEST_CHECK(frames.GetStatistics().m_nUnchanged == 1);
+        TEST_CHECK(pDisplay->GetShownFrame() == pLast);
+
+        TEST_CHECK(Same(present({ 3, 8, 10, 11 }, 3), { 3, 8, 10, 11 }));
+        TEST_CHECK(alternated());
+
+        frames.StopThread();
+        const auto stats{ frames.GetStatistics() };
+        TEST_CHECK(stats.m_nSubmitted == 4);
+        TEST_CHECK(stats.m_nUnchanged == 1);
+        TEST_CHECK(stats.m_nDropped == 0);
+        TEST_CHECK(pDisplay->GetCopyCount() == 0);
+        ::LCD::ILCD::destroy();
+    }
+
+    //--------------------------------------------------------------------------
+
+    void TestCopied() {
+        constexpr const int MonoWidth { 20 };
+        constexpr const int MonoHeight{ 6 };
+        const auto pDisplay{ CreateDisplay(device_type::Monochrome, MonoWidth, MonoHeight, 1) };
+        TEST_CHECK(!pDisplay->GetFrameBuffer(0));
+
+        presenter frames{};
+        TEST_CHECK(frames.StartThread(pDisplay));
+
+        const auto nStride{ static_cast<size_type>(pDisplay->GetDisplayStride()) };
+        TEST_CHECK(nStride == 4);
+        std::vector<byte_type> frame(nStride * MonoHeight, 0);
+        size_type nUpdates{ 0 };
+        const auto present = [&](const rect_type& rect, byte_type value) {
+            for (auto y = rect.top; y < rect.bottom; ++y) {
+                std::memset(frame.data() + static_cast<size_type>(y) * nStride, value + y, nStride);
+            }
+            frames.Post(frame.data(), rect);
+            TEST_CHECK(WaitForUpdates(frames, ++nUpdates));
+            TEST_CHECK(std::memcmp(pDisplay->GetShownFrame(), frame.data(), frame.size()) == 0);
+        };
+
+        present(rect_type::all(MonoWidth, MonoHeight), 0x10);
+        TEST_CHECK(pDisplay->GetCopyCount() == 1);
+        present({ 0, 1, MonoWidth, 3 }, 0x20);
+        TEST_CHECK(pDisplay->GetCopyCount() == 2);
+        // Rows 1 and 2 are stale in the mailbox, so are copied
+        // in again along with these
+        present({ 0, 4, MonoWidth, 5 }, 0x30);
+        TEST_CHECK(pDisplay->GetCopyCount() == 3);
+
+        frames.StopThread();
+        TEST_CHECK(frames.GetStatistics().m_nSubmitted == 3);
+        ::LCD::ILCD::destroy();
+    }
+} // namespace
+
+//******************************************************************************
+
+int main() {
+    TestInPlace();
+    TestCopied();
+    return ::Tests::Result();
+}
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef GUID_9AC84BCC_0E04_4A68_874F_F4284A2AACA7
+#define GUID_9AC84BCC_0E04_4A68_874F_F4284A2AACA7
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+// The plugin gets these from "CommonHeaders.h"
+#ifndef gsl_suppress
+#   define gsl_suppress(...)
+#endif
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+//--------------------------------------
+
+//******************************************************************************
+//******************************************************************************
+// Minimal test support
+//******************************************************************************
+//******************************************************************************
+//
+// The tests only cover the platform independent headers,
+// so they build without the Windows/foobar2000 SDKs.
+// Each test is a standalone executable: checks report
+// and count failures, `main` returns the count so CTest
+// sees a non-zero exit status.
+
+namespace Tests {
+    inline int& FailureCount() noexcept {
+        static int nFailures{ 0 };
+        return nFailures;
+    }
+
+    inline bool Check(bool bCondition,
+                      const char* szExpression,
+                      const char* szFile,
+                      int nLine) noexcept {
+        if (!bCondition) {
+            std::printf("%s(%d): check failed: %s\n", szFile, nLine, szExpression);
+            ++FailureCount();
+        }
+        return bCondition;
+    }
+
+    inline int Result() noexcept {
+        if (FailureCount() == 0) {
+            std::printf("All checks passed\n");
+        } else {
+            std::printf("%d check(s) failed\n", FailureCount());
+        }
+        return FailureCount();
+    }
+
+    //**************************************************************************
+    // Benchmark
+    //**************************************************************************
+    //
+    // Times `nIterations` calls of `fn` (after one warm up
+    // call) and prints the mean time per call. Results
+    // can be kept alive with `DoNotOptimise`.
+    template <typename FuncT>
+    double Benchmark(const char* szName,
+                     std::size_t nIterations,
+                     FuncT&& fn) {
+        using clock_type = std::chrono::steady_clock;
+        fn();
+        const auto start{ clock_type::now() };
+        for (std::size_t i = 0; i < nIterations; ++i) { fn(); }
+        const auto end{ clock_type::now() };
+        const auto fMicroseconds{ std::chrono::duration<double, std::micro>(end - start).count() /
+                                  static_cast<double>(nIterations) };
+        std::printf("benchmark: %-40s %10.3f us/iteration (%zu iterations)\n",
+                    szName, fMicroseconds, nIterations);
+        return fMicroseconds;
+    }
+
+    template <typename TypeT>
+    inline void DoNotOptimise(const TypeT& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        // Publishing only the address lets a pure computation
+        // of `value` be dropped; this makes its value used
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const void* volatile pSink{ nullptr };
+        pSink = &value;
+        (void)pSink;
+#endif
+    }
+} // namespace Tests
+
+#define TEST_CHECK(expr) ::Tests::Check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#endif // GUID_9AC84BCC_0E04_4A68_874F_F4284A2AACA7
@@ -0,0 +1,192 @@
+#pragma once
+#ifndef GUID_9AA08F74_7F36_4F74_8D4C_2CAE7DFD02A4
+#define GUID_9AA08F74_7F36_4F74_8D4C_2CAE7DFD02A4
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+// GLEW must come before any other OpenGL header
+#include "GL/glcommon.h"
+#include "GL/glframebuffer.h"
+#include "GL/gltexture.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cstdint>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+//******************************************************************************
+// OpenGL test support
+//******************************************************************************
+//******************************************************************************
+
+namespace Tests {
+    // CTest reports a test returning this as skipped
+    // (see "CMakeLists.txt")
+    inline constexpr const int SkipReturnCode{ 77 };
+
+    //**************************************************************************
+    // glOffscreen
+    //**************************************************************************
+    //
+    // An OpenGL (compatibility profile) context with no
+    // window, made through EGL, drawing to a `width` x
+    // `height` RGBA8 framebuffer object with the projection
+    // `Canvas` sets up (origin top left, a unit per pixel).
+    // Mesa's surfaceless platform is tried first, so a
+    // software driver (llvmpipe) works without a display.
+    //
+    // Check `operator bool` before use: without a driver
+    // tests should return `SkipReturnCode`.
+    class glOffscreen final {
+    public:
+        using pixel_type  = std::uint32_t; //< RGBA, in memory order
+        using pixels_type = std::vector<pixel_type>;
+
+    public:
+        glOffscreen(::GLsizei width, ::GLsizei height) noexcept :
+            m_nWidth { width },
+            m_nHeight{ height } {
+            if (!create_context()) { destroy(); return; }
+
+            m_Texture.create(GL_TEXTURE_2D, GL_RGBA8, width, height, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            if (!m_Framebuffer.create(m_Texture)) { destroy(); return; }
+            m_Framebuffer.bind();
+
+            ::glViewport(0, 0, width, height);
+            ::glMatrixMode(GL_PROJECTION);
+            ::glLoadIdentity();
+            ::glOrtho(0, width, height, 0, -1, 1);
+            ::glMatrixMode(GL_MODELVIEW);
+            ::glLoadIdentity();
+            ::glDisable(GL_DEPTH_TEST);
+            ::glDisable(GL_BLEND);
+            ::glClearColor(0.f, 0.f, 0.f, 0.f);
+            ::glColor4f(1.f, 1.f, 1.f, 1.f);
+        }
+
+        ~glOffscreen() noexcept { destroy(); }
+
+        glOffscreen(const glOffscreen& ) = delete; // No Copy
+        glOffscreen(      glOffscreen&&) = delete; // No Move
+        glOffscreen& operator=(const glOffscreen& ) = delete; // No Copy
+        glOffscreen& operator=(      glOffscreen&&) = delete; // No Move
+
+    public:
+        explicit operator bool() const noexcept { return m_Context != EGL_NO_CONTEXT; }
+
+        constexpr auto width () const noexcept { return m_nWidth; }
+        constexpr auto height() const noexcept { return m_nHeight; }
+
+        const char* renderer() const noexcept {
+            return ::OpenGL::glGetRendererString();
+        }
+
+        // Waits for drawing to finish; bottom row first
+        pixels_type read() const {
+            pixels_type pixels(static_cast<std::size_t>(m_nWidth) *
+                               static_cast<std::size_t>(m_nHeight));
+            ::glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            ::glReadPixels(0, 0, m_nWidth, m_nHeight,
+                           GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            return pixels;
+        }
+
+    private:
+        bool create_context() noexcept {
+            const auto pfnGetPlatformDisplay{
+                reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                    ::eglGetProcAddress("eglGetPlatformDisplayEXT")) };
+            if (pfnGetPlatformDisplay) {
+                m_Display = pfnGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                                  EGL_DEFAULT_DISPLAY, nullptr);
+            }
+            if (m_Display == EGL_NO_DISPLAY) {
+                m_Display = ::eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            }
+            if (m_Display == EGL_NO_DISPLAY) { return false; }
+
+            ::EGLint nMajor{ 0 }, nMinor{ 0 };
+            if (!::eglInitialize(m_Display, &nMajor, &nMinor)) {
+                m_Display = EGL_NO_DISPLAY;
+                return false;
+            }
+            if (!::eglBindAPI(EGL_OPENGL_API)) { return false; }
+
+            // Drawing only goes to the framebuffer object, so a
+            // display with no configs (surfaceless) is fine
+            // (EGL_KHR_no_config_context)
+            const ::EGLint configAttribs[]{
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_NONE
+            };
+            ::EGLConfig config{ EGL_NO_CONFIG_KHR };
+            ::EGLint nConfigs{ 0 };
+            if (!::eglChooseConfig(m_Display, configAttribs, &config, 1, &nConfigs) ||
+                nConfigs < 1) {
+                config = EGL_NO_CONFIG_KHR;
+            }
+
+            m_Context = ::eglCreateContext(m_Display, config, EGL_NO_CONTEXT, nullptr);
+            if (m_Context == EGL_NO_CONTEXT) { return false; }
+            if (!::eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_Context) ||
+                ::glewContextInit() != GLEW_OK ||
+                !::OpenGL::glFramebuffer::is_supported()) {
+                return false;
+            }
+            return true;
+        }
+
+        void destroy() noexcept {
+            if (m_Context != EGL_NO_CONTEXT) {
+                m_Framebuffer.destroy();
+                m_Texture.destroy();
+                ::eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                ::eglDestroyContext(m_Display, m_Context);
+                m_Context = EGL_NO_CONTEXT;
+            }
+            if (m_Display != EGL_NO_DISPLAY) {
+                ::eglTerminate(m_Display);
+                m_Display = EGL_NO_DISPLAY;
+            }
+        }
+
+    private:
+        ::EGLDisplay             m_Display    { EGL_NO_DISPLAY };
+        ::EGLContext             m_Context    { EGL_NO_CONTEXT };
+        ::OpenGL::glTexture      m_Texture    {};
+        ::OpenGL::glFramebuffer  m_Framebuffer{};
+        ::GLsizei                m_nWidth     { 0 };
+        ::GLsizei                m_nHeight    { 0 };
+    }; // class glOffscreen final
+} // namespace Tests
+
+#endif // GUID_9AA08F74_7F36_4F74_8D4C_2CAE7DFD02A4
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef GUID_9877BA5E_95AB_4AEE_8438_D8D5859B3B61
+#define GUID_9877BA5E_95AB_4AEE_8438_D8D5859B3B61
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+//******************************************************************************
+// Synthetic test signals
+//******************************************************************************
+//******************************************************************************
+
+namespace Tests {
+    inline constexpr const double Pi{ 3.14159265358979323846 };
+
+    //**************************************************************************
+    // MagnitudeSpectrum
+    //**************************************************************************
+    //
+    // Hann windowed FFT of `samples` (a power of two in
+    // length), scaled so a full scale sine peaks at 1, and
+    // written to `channelCount` interleaved channels, as the
+    // analysis thread produces them.
+    template <typename SampleTypeT>
+    std::vector<SampleTypeT> MagnitudeSpectrum(const std::vector<double>& samples,
+                                               std::size_t channelCount) {
+        const auto N{ samples.size() };
+        std::vector<std::complex<double>> x(N);
+        for (std::size_t n = 0; n < N; ++n) {
+            x[n] = samples[n] * (.5 - .5 * std::cos(2. * Pi * static_cast<double>(n) / static_cast<double>(N)));
+        }
+
+        // Iterative radix-2
+        for (std::size_t i = 1, j = 0; i < N; ++i) {
+            auto bit{ N >> 1 };
+            for (; j & bit; bit >>= 1) { j ^= bit; }
+            j ^= bit;
+            if (i < j) { std::swap(x[i], x[j]); }
+        }
+        for (std::size_t len = 2; len <= N; len <<= 1) {
+            const auto w{ std::polar(1., -2. * Pi / static_cast<double>(len)) };
+            for (std::size_t i = 0; i < N; i += len) {
+                std::complex<double> wk{ 1. };
+                for (std::size_t k = 0; k < len / 2; ++k, wk *= w) {
+                    const auto u{ x[i + k] };
+                    const auto v{ x[i + k + len / 2] * wk };
+                    x[i + k]           = u + v;
+                    x[i + k + len / 2] = u - v;
+                }
+            }
+        }
+
+        std::vector<SampleTypeT> spectrum(N / 2 * channelCount);
+        for (std::size_t b = 0; b < N / 2; ++b) {
+            for (std::size_t c = 0; c < channelCount; ++c) {
+                spectrum[b * channelCount + c] = static_cast<SampleTypeT>(std::abs(x[b]) * 4. / static_cast<double>(N));
+            }
+        }
+        return spectrum;
+    }
+
+    //**************************************************************************
+    // AddTone
+    //**************************************************************************
+    //
+    // Adds a sine at `frequency` Hz (plus `harmonics`
+    // overtones, each half the level of the last).
+    inline void AddTone(std::vector<double>& samples,
+                        double sampleRate,
+                        double frequency,
+                        double level,
+                        std::size_t harmonics = 0) {
+        for (std::size_t h = 1; h <= harmonics + 1; ++h) {
+            const auto f{ frequency * static_cast<double>(h) };
+            if (f >= sampleRate * .5) { break; }
+            for (std::size_t n = 0; n < samples.size(); ++n) {
+                samples[n] += level * std::sin(2. * Pi * f * static_cast<double>(n) / sampleRate);
+            }
+            level *= .5;
+        }
+    }
+
+    // Frequency of MIDI note `note` (69 being A4, 440Hz)
+    [[nodiscard]] inline double NoteFrequency(double note) noexcept {
+        return 440. * std::exp2((note - 69.) / 12.);
+    }
+} // namespace Tests
+
+#endif // GUID_9877BA5E_95AB_4AEE_8438_D8D5859B3B61
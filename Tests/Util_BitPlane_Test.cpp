@@ -0,0 +1,269 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Util/BitPlane.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Util_BitPlane_Test
+//******************************************************************************
+//
+// Checks the packed monochrome path is pixel-exact against
+// the one it replaced, then times the two.
+//
+// Before, a monochrome frame went to the LCD SDK as one
+// byte per pixel: 0xFF where a BGRA pixel had the top bit
+// of any colour channel set, otherwise 0x00 (or, drawn
+// without OpenGL, the 8bpp canvas bytes, which the SDK
+// lights from 128). Now a frame is read back as one byte
+// per pixel (GL_LUMINANCE through the channel maps set up
+// by `Canvas`), or taken from the 8bpp canvas, packed to
+// a bit-plane, and expanded for the SDK by `LogitechLCD`.
+// Every route must light exactly the same pixels, for any
+// width (whole bytes or not) and height.
+
+namespace {
+    namespace bit_plane = ::util::bit_plane;
+    using byte_type  = bit_plane::byte_type;
+    using size_type  = bit_plane::size_type;
+    using pixel_type = std::uint32_t;
+
+    constexpr const byte_type Guard{ 0xA5 }; //< Past the end of each destination
+
+    // Mostly black (as a visualisation is) with some pixels
+    // having only one channel's top bit set, some only lower
+    // bits set, and alpha (which must be ignored) random
+    std::vector<pixel_type> RandomFrame(std::mt19937& rng,
+                                        size_type width,
+                                        size_type height) {
+        std::uniform_int_distribution<pixel_type> any{ };
+        std::uniform_int_distribution<int> kind{ 0, 7 };
+        std::vector<pixel_type> frame(width * height);
+        for (auto& pixel : frame) {
+            const auto bits{ any(rng) };
+            switch (kind(rng)) {
+                case 0: pixel = bits & 0xFF000000;                   break; // Black
+                case 1: pixel = bits & 0xFF7F7F7F;                   break; // No top bits
+                case 2: pixel = (bits & 0xFF7F7F7F) | 0x00000080;    break; // Blue only
+                case 3: pixel = (bits & 0xFF7F7F7F) | 0x00008000;    break; // Green only
+                case 4: pixel = (bits & 0xFF7F7F7F) | 0x00800000;    break; // Red only
+                default: pixel = bits;                               break;
+            }
+        }
+        return frame;
+    }
+
+    //**************************************************************************
+    // Old path: what the SDK used to be given
+    //**************************************************************************
+    void Threshold(const pixel_type* src, byte_type* dst, size_type count) noexcept {
+        for (size_type i = 0; i < count; ++i) {
+            dst[i] = (src[i] & 0x00808080) ? 0xFF : 0x00;
+        }
+    }
+
+    //**************************************************************************
+    // Readback: GL_LUMINANCE with each channel mapped to 0 or
+    // 1 by its top bit; luminance is their (clamped) sum
+    //**************************************************************************
+    std::vector<byte_type> Luminance(const std::vector<pixel_type>& frame,
+                                     size_type width,
+                                     size_type height,
+                                     size_type stride) {
+        std::vector<byte_type> bytes(stride * height, Guard); // Padding must be ignored
+        for (size_type y = 0; y < height; ++y) {
+            for (size_type x = 0; x < width; ++x) {
+                const auto pixel{ frame[y * width + x] };
+                unsigned sum{ 0 };
+                for (const auto shift : { 0u, 8u, 16u }) {
+                    sum += (((pixel >> shift) & 0xFF) >= 128) ? 255u : 0u;
+                }
+                bytes[y * stride + x] = static_cast<byte_type>(std::min(sum, 255u));
+            }
+        }
+        return bytes;
+    }
+
+    // Expanded for the SDK, with the plane's row padding
+    // checked on the way
+    std::vector<byte_type> Expand(const std::vector<byte_type>& plane,
+                                  size_type width,
+                                  size_type height,
+                                  bool& bPaddingClear) {
+        const auto stride{ bit_plane::stride(width) };
+        bPaddingClear = true;
+        for (size_type y = 0; y < height; ++y) {
+            const auto* pRow{ plane.data() + y * stride };
+            if (width % 8 && (pRow[width / 8] & (0xFFu >> (width % 8)))) { bPaddingClear = false; }
+            for (size_type i = (width + 7) / 8; i < stride; ++i) {
+                if (pRow[i]) { bPaddingClear = false; }
+            }
+        }
+        std::vector<byte_type> bytes(width * height + 8, Guard);
+        bit_plane::expand(plane.data(), bytes.data(), width, height);
+        return bytes;
+    }
+
+    bool Matches(const char* szRoute,
+                 const std::vector<byte_type>& expected,
+                 const std::vector<byte_type>& actual,
+                 size_type width,
+                 size_type height) {
+        const auto count{ width * height };
+        for (size_type i = 0; i < count; ++i) {
+            if (actual[i] != expected[i]) {
+                std::printf("  %s (%zux%zu): pixel (%zu, %zu) is %02X, was %02X\n",
+                            szRoute, width, height, i % width, i / width,
+                            actual[i], expected[i]);
+                return false;
+            }
+        }
+        for (size_type i = count; i < actual.size(); ++i) {
+            if (actual[i] != Guard) {
+                std::printf("  %s (%zux%zu): expand wrote past the frame\n", szRoute, width, height);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //**************************************************************************
+    // TestPixelExact
+    //**************************************************************************
+    void TestPixelExact() {
+        std::mt19937 rng{ 39 };
+        size_type nFailures{ 0 };
+        for (size_type width = 1; width <= 320; ++width) {
+            for (const size_type height : { size_type{ 1 }, size_type{ 43 } }) {
+                const auto frame{ RandomFrame(rng, width, height) };
+                std::vector<byte_type> old(width * height);
+                Threshold(frame.data(), old.data(), old.size());
+
+                bool bPaddingClear{ false };
+                std::vector<byte_type> plane(bit_plane::byte_size(width, height), Guard);
+
+                // 32-bit pixels
+                bit_plane::pack(frame.data(), plane.data(), width, height);
+                nFailures += !Matches("pack (32-bit)", old, Expand(plane, width, height, bPaddingClear), width, height);
+                nFailures += !bPaddingClear;
+
+                // Luminance read back (rows 4 byte aligned)
+                std::fill(plane.begin(), plane.end(), Guard);
+                const auto stride{ (width + 3) & ~size_type{ 3 } };
+                const auto luminance{ Luminance(frame, width, height, stride) };
+                bit_plane::pack(luminance.data(), stride, plane.data(), width, height);
+                nFailures += !Matches("pack (luminance)", old, Expand(plane, width, height, bPaddingClear), width, height);
+                nFailures += !bPaddingClear;
+            }
+        }
+        TEST_CHECK(nFailures == 0);
+    }
+
+    //**************************************************************************
+    // TestCanvasBytes
+    //**************************************************************************
+    // The 8bpp canvas (no OpenGL) went to the SDK as is; a
+    // byte of 128 or more lights the pixel there
+    void TestCanvasBytes() {
+        std::mt19937 rng{ 8 };
+        std::uniform_int_distribution<int> any{ 0, 255 };
+        size_type nFailures{ 0 };
+        for (size_type width = 1; width <= 320; ++width) {
+            constexpr const size_type height{ 43 };
+            const auto stride{ (width + 3) & ~size_type{ 3 } }; // DIB rows are DWORD aligned
+            std::vector<byte_type> canvas(stride * height);
+            for (auto& byte : canvas) { byte = static_cast<byte_type>(any(rng)); }
+
+            std::vector<byte_type> lit(width * height);
+            for (size_type y = 0; y < height; ++y) {
+                for (size_type x = 0; x < width; ++x) {
+                    lit[y * width + x] = (canvas[y * stride + x] >= 128) ? 0xFF : 0x00;
+                }
+            }
+
+            bool bPaddingClear{ false };
+            std::vector<byte_type> plane(bit_plane::byte_size(width, height), Guard);
+            bit_plane::pack(canvas.data(), stride, plane.data(), width, height);
+            nFailures += !Matches("pack (8bpp canvas)", lit, Expand(plane, width, height, bPaddingClear), width, height);
+            nFailures += !bPaddingClear;
+        }
+        TEST_CHECK(nFailures == 0);
+    }
+
+    //**************************************************************************
+    // BenchmarkPaths
+    //**************************************************************************
+    void BenchmarkPaths() {
+        std::mt19937 rng{ 160 };
+        // G15/G510 (160x43) and a larger panel
+        for (const auto& [W, H] : { std::pair<size_type, size_type>{ 160, 43 }, std::pair<size_type, size_type>{ 320, 240 } }) {
+            const auto frame{ RandomFrame(rng, W, H) };
+            const auto luminance{ Luminance(frame, W, H, W) };
+            std::vector<byte_type> plane(bit_plane::byte_size(W, H));
+            std::vector<byte_type> sdk(W * H);
+            char szName[64];
+
+            std::snprintf(szName, sizeof(szName), "old: threshold 32-bit (%zux%zu)", W, H);
+            ::Tests::Benchmark(szName, 20000, [&]() {
+                Threshold(frame.data(), sdk.data(), sdk.size());
+                ::Tests::DoNotOptimise(sdk.front());
+            });
+            std::snprintf(szName, sizeof(szName), "new: pack 32-bit (%zux%zu)", W, H);
+            ::Tests::Benchmark(szName, 20000, [&]() {
+                bit_plane::pack(frame.data(), plane.data(), W, H);
+                ::Tests::DoNotOptimise(plane.front());
+            });
+            std::snprintf(szName, sizeof(szName), "new: pack luminance (%zux%zu)", W, H);
+            ::Tests::Benchmark(szName, 20000, [&]() {
+                bit_plane::pack(luminance.data(), W, plane.data(), W, H);
+                ::Tests::DoNotOptimise(plane.front());
+            });
+            std::snprintf(szName, sizeof(szName), "new: expand (%zux%zu)", W, H);
+            ::Tests::Benchmark(szName, 20000, [&]() {
+                bit_plane::expand(plane.data(), sdk.data(), W, H);
+                ::Tests::DoNotOptimise(sdk.front());
+            });
+            std::printf("  bytes handed on per frame: %zu (32-bit), %zu (luminance), %zu (packed)\n",
+                        frame.size() * sizeof(pixel_type), luminance.size(), plane.size());
+        }
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestPixelExact();
+    TestCanvasBytes();
+    BenchmarkPaths();
+    return ::Tests::Result();
+}
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Util/BitPlane.h"
+#include "Util/DirtyRect.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Util_DirtyRect_Test
+//******************************************************************************
+//
+// Checks `util::dirty_rect`, then that handing on only
+// the dirty part of a frame leaves the LCD with the same
+// pixels as handing on all of it, then times each at LCD
+// sizes.
+//
+// A frame goes from the read back pixels to the canvas
+// bitmap (`Canvas::EndFrame`: alpha fix up and copy, or
+// pack for monochrome) and then to the LCD's retained
+// bitmap (`LogitechLCD::Update`: copy, or expand). Those
+// need Windows and the LCD SDK to build, so their loops
+// are repeated here.
+
+namespace {
+    using rect_type  = ::util::dirty_rect;
+    using coord_type = rect_type::coord_type;
+    using pixel_type = std::uint32_t;
+    using byte_type  = ::util::bit_plane::byte_type;
+    using size_type  = ::util::bit_plane::size_type;
+
+    bool operator==(const rect_type& a, const rect_type& b) noexcept {
+        return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    //**************************************************************************
+    // TestRect
+    //**************************************************************************
+    void TestRect() {
+        constexpr const rect_type none{};
+        TEST_CHECK(none.empty() && !none);
+        TEST_CHECK(none.width() == 0 && none.height() == 0);
+        TEST_CHECK((rect_type{ 5, 5, 5, 9 }).empty());  //< No width
+        TEST_CHECK((rect_type{ 5, 9, 7, 2 }).empty());  //< Inverted
+        TEST_CHECK((rect_type{ 5, 9, 7, 2 }).height() == 0);
+
+        constexpr const auto all{ rect_type::all(160, 43) };
+        TEST_CHECK(all && all.width() == 160 && all.height() == 43);
+        TEST_CHECK(all.covers(160, 43));
+        TEST_CHECK(!all.covers(161, 43));
+        TEST_CHECK(!(rect_type{ 1, 0, 160, 43 }).covers(160, 43));
+
+        // Merging is the bounding rect; empty rects are ignored
+        rect_type merged{};
+        merged.merge(none);
+        TEST_CHECK(merged.empty());
+        merged.merge({ 10, 20, 30, 25 });
+        TEST_CHECK(merged == (rect_type{ 10, 20, 30, 25 }));
+        merged.merge({ 100, 100, 100, 200 });
+        TEST_CHECK(merged == (rect_type{ 10, 20, 30, 25 }));
+        merged.merge({ 0, 30, 12, 31 });
+        TEST_CHECK(merged == (rect_type{ 0, 20, 30, 31 }));
+
+        // Clipping
+        TEST_CHECK((rect_type{ -5, -5, 500, 500 }).clipped(320, 240) == rect_type::all(320, 240));
+        TEST_CHECK((rect_type{ 10, 10, 20, 20 }).clipped(320, 240) == (rect_type{ 10, 10, 20, 20 }));
+        TEST_CHECK((rect_type{ 300, 10, 400, 20 }).clipped(320, 240) == (rect_type{ 300, 10, 320, 20 }));
+        TEST_CHECK((rect_type{ 400, 10, 500, 20 }).clipped(320, 240) == none);
+        TEST_CHECK((rect_type{ -20, 10, -10, 20 }).clipped(320, 240) == none);
+    }
+
+    //**************************************************************************
+    // Colour: canvas, then LCD
+    //**************************************************************************
+    // Alpha fix up of what OpenGL drew, then the copy to the
+    // canvas bitmap and on to the LCD's
+    void HandOnColor(std::vector<pixel_type>& readback,
+                     std::vector<pixel_type>& canvas,
+                     std::vector<pixel_type>& lcd,
+                     coord_type width,
+                     const rect_type& rect) noexcept {
+        const auto count{ static_cast<size_type>(rect.width()) };
+        for (auto row = rect.top; row < rect.bottom; ++row) {
+            const auto offset{ static_cast<size_type>(row) * static_cast<size_type>(width) + static_cast<size_type>(rect.left) };
+            auto* pSrc{ readback.data() + offset };
+            for (size_type i = 0; i < count; ++i) { pSrc[i] |= 0xFF000000; }
+            std::memcpy(canvas.data() + offset, pSrc, count * sizeof(pixel_type));
+            std::memcpy(lcd.data() + offset, canvas.data() + offset, count * sizeof(pixel_type));
+        }
+    }
+
+    //**************************************************************************
+    // Monochrome: canvas (packed), then LCD (a byte a pixel)
+    //**************************************************************************
+    // Whole rows, as packed rows can't be split
+    void HandOnMono(const std::vector<byte_type>& readback,
+                    std::vector<byte_type>& canvas,
+                    std::vector<byte_type>& lcd,
+                    coord_type width,
+                    const rect_type& rect) noexcept {
+        const auto W{ static_cast<size_type>(width) };
+        const auto stride{ ::util::bit_plane::stride(W) };
+        const auto top{ static_cast<size_type>(rect.top) };
+        const auto rows{ static_cast<size_type>(rect.height()) };
+        ::util::bit_plane::pack(readback.data() + top * W, W, canvas.data() + top * stride, W, rows);
+        ::util::bit_plane::expand(canvas.data() + top * stride, lcd.data() + top * W, W, rows);
+    }
+
+    //**************************************************************************
+    // TestPartialMatchesFull
+    //**************************************************************************
+    // Each frame changes only inside a random rect; handed
+    // on with that rect, the LCD must end up as if every
+    // frame had been handed on in full
+    void TestPartialMatchesFull() {
+        std::mt19937 rng{ 47 };
+        std::uniform_int_distribution<pixel_type> any{ };
+        size_type nFailures{ 0 };
+        for (const auto& [W, H] : { std::pair<coord_type, coord_type>{ 320, 240 }, std::pair<coord_type, coord_type>{ 160, 43 } }) {
+            const auto count{ static_cast<size_type>(W) * static_cast<size_type>(H) };
+            std::uniform_int_distribution<coord_type> x{ -8, W + 8 };
+            std::uniform_int_distribution<coord_type> y{ -8, H + 8 };
+
+            std::vector<pixel_type> frame(count, 0);
+            std::vector<pixel_type> readback(count), canvas(count), lcd(count, 0xDEADBEEF);
+            std::vector<pixel_type> fullReadback(count), fullCanvas(count), fullLCD(count);
+
+            std::vector<byte_type> monoFrame(count, 0), monoLCD(count, 0xA5), fullMonoLCD(count);
+            std::vector<byte_type> packed(::util::bit_plane::byte_size(static_cast<size_type>(W), static_cast<size_type>(H)));
+            std::vector<byte_type> fullPacked(packed.size());
+
+            for (int nFrame = 0; nFrame < 200; ++nFrame) {
+                // The first frame is always in full (see `Canvas::Invalidate`)
+                auto rect{ (nFrame == 0) ? rect_type::all(W, H) : rect_type{ x(rng), y(rng), x(rng), y(rng) } };
+                rect = rect.clipped(W, H);
+                for (auto row = rect.top; row < rect.bottom; ++row) {
+                    for (auto col = rect.left; col < rect.right; ++col) {
+                        const auto i{ static_cast<size_type>(row) * static_cast<size_type>(W) + static_cast<size_type>(col) };
+                        frame[i] = any(rng) & 0x00FFFFFF; //< No alpha: OpenGL clears it
+                        monoFrame[i] = static_cast<byte_type>(frame[i]);
+                    }
+                }
+                // Only the dirty rows are read back (the rest
+                // is left as it was)
+                const auto rowOffset{ static_cast<size_type>(rect.top) * static_cast<size_type>(W) };
+                std::memcpy(readback.data() + rowOffset, frame.data() + rowOffset,
+                            static_cast<size_type>(rect.height()) * static_cast<size_type>(W) * sizeof(pixel_type));
+                HandOnColor(readback, canvas, lcd, W, rect);
+                HandOnMono(monoFrame, packed, monoLCD, W, rect_type{ 0, rect.top, W, rect.bottom });
+
+                fullReadback = frame;
+                HandOnColor(fullReadback, fullCanvas, fullLCD, W, rect_type::all(W, H));
+                HandOnMono(monoFrame, fullPacked, fullMonoLCD, W, rect_type::all(W, H));
+
+                nFailures += (lcd != fullLCD);
+                nFailures += (monoLCD != fullMonoLCD);
+                nFailures += (packed != fullPacked);
+            }
+        }
+        TEST_CHECK(nFailures == 0);
+    }
+
+    //**************************************************************************
+    // BenchmarkHandOn
+    //**************************************************************************
+    void BenchmarkHandOn() {
+        std::mt19937 rng{ 320 };
+        std::uniform_int_distribution<pixel_type> any{ };
+
+        {   // G19 (320x240, colour)
+            constexpr const coord_type W{ 320 }, H{ 240 };
+            const auto count{ static_cast<size_type>(W) * static_cast<size_type>(H) };
+            std::vector<pixel_type> readback(count), canvas(count), lcd(count);
+            for (auto& pixel : readback) { pixel = any(rng); }
+
+            const std::pair<const char*, rect_type> cases[]{
+                { "full frame",               rect_type::all(W, H) },
+                { "progress bar (24 rows)",   rect_type{ 0, 200, W, 224 } },
+                { "time text (60x16)",        rect_type{ 250, 220, 310, 236 } },
+                { "unchanged",                rect_type{} },
+            };
+            for (const auto& [szCase, rect] : cases) {
+                char szName[64];
+                std::snprintf(szName, sizeof(szName), "320x240 %s", szCase);
+                ::Tests::Benchmark(szName, 5000, [&, &rect = rect]() {
+                    if (rect) { HandOnColor(readback, canvas, lcd, W, rect); }
+                    ::Tests::DoNotOptimise(lcd.front());
+                });
+            }
+        }
+
+        {   // G15/G510 (160x43, monochrome)
+            constexpr const coord_type W{ 160 }, H{ 43 };
+            const auto count{ static_cast<size_type>(W) * static_cast<size_type>(H) };
+            std::vector<byte_type> readback(count), lcd(count);
+            std::vector<byte_type> canvas(::util::bit_plane::byte_size(static_cast<size_type>(W), static_cast<size_type>(H)));
+            for (auto& byte : readback) { byte = static_cast<byte_type>(any(rng)); }
+
+            const std::pair<const char*, rect_type> cases[]{
+                { "full frame",               rect_type::all(W, H) },
+                { "progress bar (5 rows)",    rect_type{ 0, 36, W, 41 } },
+                { "unchanged",                rect_type{} },
+            };
+            for (const auto& [szCase, rect] : cases) {
+                char szName[64];
+                std::snprintf(szName, sizeof(szName), "160x43 %s", szCase);
+                ::Tests::Benchmark(szName, 20000, [&, &rect = rect]() {
+                    if (rect) { HandOnMono(readback, canvas, lcd, W, rect); }
+                    ::Tests::DoNotOptimise(lcd.front());
+                });
+            }
+        }
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestRect();
+    TestPartialMatchesFull();
+    BenchmarkHandOn();
+    return ::Tests::Result();
+}
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Util/Dither.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Util_Dither_Test
+//******************************************************************************
+//
+// Compares every `util::dither::method` against fixed
+// bit-planes, checks a few properties that must hold for
+// any input, then times each method at LCD sizes.
+//
+// The golden bit-planes come from straightforward full
+// frame implementations (the classic 8x8 Bayer matrix;
+// error kept for the whole frame and dropped at the
+// edges), not from `Dither.h`.
+
+namespace {
+    namespace dither = ::util::dither;
+    using byte_type  = dither::byte_type;
+    using size_type  = dither::size_type;
+    using plane_type = std::vector<byte_type>;
+
+    constexpr const size_type Width    { 20 }; //< Not a multiple of 8, so the last byte is partial
+    constexpr const size_type Height   { 10 };
+    constexpr const size_type SrcStride{ 24 }; //< Padding must be ignored
+    constexpr const size_type DstStride{ 4 };  //< Rows are DWORD aligned
+
+    // Diagonal ramps wrapping at 256, then a black and a
+    // white row (which error diffusion must not disturb)
+    std::vector<byte_type> TestImage() {
+        std::vector<byte_type> image(SrcStride * Height, 0xA5);
+        for (size_type y = 0; y < Height; ++y) {
+            for (size_type x = 0; x < Width; ++x) {
+                image[y * SrcStride + x] = (y == 8) ? 0 :
+                                           (y == 9) ? 255 :
+                                           static_cast<byte_type>((x * 13 + y * 29) % 256);
+            }
+        }
+        return image;
+    }
+
+    using golden_type = std::array<byte_type, DstStride * Height>;
+
+    constexpr const golden_type GoldenThreshold{
+        0x00, 0x3F, 0xF0, 0x00,
+        0x00, 0xFF, 0xC0, 0x00,
+        0x03, 0xFF, 0x00, 0x00,
+        0x0F, 0xF8, 0x00, 0x00,
+        0x7F, 0xE0, 0x00, 0x00,
+        0xFF, 0x80, 0x10, 0x00,
+        0xFE, 0x00, 0x70, 0x00,
+        0xF8, 0x03, 0xF0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xFF, 0xF0, 0x00,
+    };
+
+    constexpr const golden_type GoldenBayer{
+        0x0A, 0xAF, 0xF0, 0x00,
+        0x05, 0x55, 0xC0, 0x00,
+        0xAA, 0xBF, 0x20, 0x00,
+        0x15, 0x70, 0x00, 0x00,
+        0xAF, 0xEA, 0xA0, 0x00,
+        0x55, 0x80, 0x50, 0x00,
+        0xBE, 0x2A, 0xB0, 0x00,
+        0x78, 0x01, 0x50, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xFF, 0xF0, 0x00,
+    };
+
+    constexpr const golden_type GoldenFloydSteinberg{
+        0x01, 0x57, 0xF0, 0x00,
+        0x15, 0x5D, 0xC0, 0x00,
+        0x4A, 0xFF, 0x00, 0x00,
+        0x2B, 0xB8, 0x10, 0x00,
+        0xBE, 0xE0, 0x40, 0x00,
+        0xD7, 0x81, 0x50, 0x00,
+        0x7E, 0x05, 0x50, 0x00,
+        0xF8, 0x2A, 0xF0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xFF, 0xF0, 0x00,
+    };
+
+    constexpr const golden_type GoldenAtkinson{
+        0x00, 0xB7, 0xF0, 0x00,
+        0x06, 0xDF, 0xC0, 0x00,
+        0x33, 0x7F, 0x00, 0x00,
+        0x2D, 0xF8, 0x00, 0x00,
+        0xDF, 0xE0, 0x30, 0x00,
+        0xDF, 0x80, 0x90, 0x00,
+        0xFE, 0x03, 0x70, 0x00,
+        0xF8, 0x19, 0xF0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xFF, 0xF0, 0x00,
+    };
+
+    bool Matches(const char* szName,
+                 const plane_type& plane,
+                 const golden_type& golden) {
+        bool bMatch{ plane.size() == golden.size() };
+        for (size_type i = 0; bMatch && i < golden.size(); ++i) { bMatch = plane[i] == golden[i]; }
+        if (!bMatch) {
+            std::printf("%s: bit-plane differs from golden\n", szName);
+            for (size_type y = 0; y < Height; ++y) {
+                std::printf("    ");
+                for (size_type i = 0; i < DstStride; ++i) { std::printf("0x%02X ", plane[y * DstStride + i]); }
+                std::printf("   expected ");
+                for (size_type i = 0; i < DstStride; ++i) { std::printf("0x%02X ", golden[y * DstStride + i]); }
+                std::printf("\n");
+            }
+        }
+        return bMatch;
+    }
+
+    //**************************************************************************
+    // TestGolden
+    //**************************************************************************
+    void TestGolden() {
+        TEST_CHECK(::util::bit_plane::stride(Width) == DstStride);
+
+        const auto image{ TestImage() };
+        const std::array<std::pair<dither::method, const golden_type*>, 4> cases{ {
+            { dither::method::threshold,       &GoldenThreshold      },
+            { dither::method::bayer,           &GoldenBayer          },
+            { dither::method::floyd_steinberg, &GoldenFloydSteinberg },
+            { dither::method::atkinson,        &GoldenAtkinson       },
+        } };
+        constexpr const char* const Names[]{ "threshold", "bayer", "floyd_steinberg", "atkinson" };
+
+        dither::ditherer ditherer{ };
+        for (const auto& [eMethod, pGolden] : cases) {
+            const auto szName{ Names[static_cast<int>(eMethod)] };
+            // Destination starts dirty: every byte, including
+            // the unused bits and row padding, must be written
+            plane_type plane(DstStride * Height, 0xFF);
+            ditherer(eMethod, image.data(), SrcStride, plane.data(), Width, Height);
+            TEST_CHECK(Matches(szName, plane, *pGolden));
+
+            // Error rows are reset between calls
+            plane_type again(DstStride * Height, 0x00);
+            ditherer(eMethod, image.data(), SrcStride, again.data(), Width, Height);
+            TEST_CHECK(again == plane);
+        }
+
+        plane_type plane(DstStride * Height, 0xFF);
+        dither::bayer(image.data(), SrcStride, plane.data(), Width, Height);
+        TEST_CHECK(Matches("bayer (free function)", plane, GoldenBayer));
+    }
+
+    //**************************************************************************
+    // TestFlatGrey
+    //**************************************************************************
+    //
+    // Every method should reproduce a flat grey's level in
+    // its density of set pixels: Bayer exactly per 8x8 tile,
+    // Floyd-Steinberg over the frame. (Atkinson drops a
+    // quarter of the error so is only checked at the ends.)
+    void TestFlatGrey() {
+        constexpr const size_type W{ 64 }, H{ 64 };
+        const auto stride{ ::util::bit_plane::stride(W) };
+        dither::ditherer ditherer{ };
+        int nWorstBayer{ 0 }, nWorstFS{ 0 };
+        for (int grey = 0; grey < 256; ++grey) {
+            const std::vector<byte_type> image(W * H, static_cast<byte_type>(grey));
+            plane_type plane(stride * H);
+            const auto count = [&plane]() {
+                int n{ 0 };
+                for (const auto b : plane) { for (int bit = 0; bit < 8; ++bit) { n += (b >> bit) & 1; } }
+                return n;
+            };
+            const auto expected{ (grey * static_cast<int>(W * H) + 127) / 255 };
+
+            ditherer(dither::method::bayer, image.data(), W, plane.data(), W, H);
+            const auto nBayerError{ std::abs(count() / 64 - (grey * 64 + 127) / 255) };
+            nWorstBayer = std::max(nWorstBayer, nBayerError);
+
+            ditherer(dither::method::floyd_steinberg, image.data(), W, plane.data(), W, H);
+            nWorstFS = std::max(nWorstFS, std::abs(count() - expected));
+
+            if (grey == 0 || grey == 255) {
+                ditherer(dither::method::atkinson, image.data(), W, plane.data(), W, H);
+                TEST_CHECK(count() == expected);
+            }
+        }
+        std::printf("flat grey: worst bayer error %d pixels/tile, worst floyd_steinberg error %d pixels/frame\n",
+                    nWorstBayer, nWorstFS);
+        TEST_CHECK(nWorstBayer <= 1);
+        TEST_CHECK(nWorstFS <= static_cast<int>(W + H));
+    }
+
+    //**************************************************************************
+    // BenchmarkMethods
+    //**************************************************************************
+    void BenchmarkMethods() {
+        constexpr const char* const Names[]{ "threshold", "bayer", "floyd_steinberg", "atkinson" };
+        // G15/G510 (160x43) and a larger panel
+        for (const auto& [W, H] : { std::pair<size_type, size_type>{ 160, 43 }, std::pair<size_type, size_type>{ 320, 240 } }) {
+            std::vector<byte_type> image(W * H);
+            for (size_type i = 0; i < image.size(); ++i) { image[i] = static_cast<byte_type>((i * 7 + i / W * 3) & 0xFF); }
+            plane_type plane(::util::bit_plane::stride(W) * H);
+            dither::ditherer ditherer{ };
+            for (const auto eMethod : { dither::method::threshold, dither::method::bayer,
+                                        dither::method::floyd_steinberg, dither::method::atkinson }) {
+                char szName[64];
+                std::snprintf(szName, sizeof(szName), "dither %s (%zux%zu)", Names[static_cast<int>(eMethod)], W, H);
+                ::Tests::Benchmark(szName, 2000, [&]() {
+                    ditherer(eMethod, image.data(), W, plane.data(), W, H);
+                    ::Tests::DoNotOptimise(plane.front());
+                });
+            }
+        }
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestGolden();
+    TestFlatGrey();
+    BenchmarkMethods();
+    return ::Tests::Result();
+}
@@ -0,0 +1,311 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "Tests/TestCommon.h"
+#include "LCD/HeadlessLCD.h"
+#include "Util/FrameCopy.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Util_FrameCopy_Test
+//******************************************************************************
+//
+// Checks `util::frame::copy_opaque` against a scalar
+// reference, then finishes frames into a `LCD::HeadlessLCD`
+// as `Canvas::EndFrame(pTarget, stale)` does (the canvas
+// itself needs GDI and OpenGL):
+//
+//  - colour frames written into the display's own buffer
+//    must be shown, and copied by nothing else;
+//  - a frame redrawn the same must not be sent;
+//  - packed (monochrome) frames are copied, and counted.
+//
+// Then times the fused copy against what it replaced (alpha
+// fixed up in place, then compared and copied by the LCD)
+// for a whole QVGA frame.
+
+namespace {
+    using display_type = ::LCD::HeadlessLCD;
+    using device_desc  = ::LCD::Device::Desc;
+    using device_type  = ::LCD::Device::Type;
+    using status_type  = ::LCD::ILCD::UpdateStatus;
+    using rect_type    = ::util::dirty_rect;
+    using pixel_type   = ::util::frame::pixel_type;
+    using size_type    = ::util::frame::size_type;
+    using byte_type    = display_type::byte_type;
+
+    constexpr const int Width { 22 }; //< Not a multiple of 4, so SSE2 leaves a remainder
+    constexpr const int Height{ 12 };
+
+    constexpr const pixel_type Opaque{ 0xFF000000u };
+
+    //--------------------------------------------------------------------------
+
+    constexpr bool Same(const rect_type& a,
+                        const rect_type& b) noexcept {
+        return (a.left == b.left) && (a.top == b.top) && (a.right == b.right) && (a.bottom == b.bottom);
+    }
+
+    // What `copy_opaque` must do, a pixel at a time
+    bool CopyOpaqueReference(const pixel_type* src,
+                             pixel_type* dst,
+                             size_type count) noexcept {
+        bool bChanged{ false };
+        for (size_type i = 0; i < count; ++i) {
+            const auto pixel{ src[i] | Opaque };
+            bChanged |= (dst[i] != pixel);
+            dst[i] = pixel;
+        }
+        return bChanged;
+    }
+
+    std::shared_ptr<display_type> CreateDisplay(device_type eType,
+                                                int iWidth,
+                                                int iHeight,
+                                                int iBitsPerPixel) {
+        device_desc desc{};
+        desc.eType         = eType;
+        desc.iWidth        = iWidth;
+        desc.iHeight       = iHeight;
+        desc.iBitsPerPixel = iBitsPerPixel;
+        display_type::initialise(desc);
+        auto pDisplay{ std::static_pointer_cast<display_type>(::LCD::ILCD::instance_peek()) };
+        TEST_CHECK(pDisplay->Connect(eType));
+        return pDisplay;
+    }
+
+    // Alpha left zero, as GDI does
+    void Fill(std::vector<pixel_type>& canvas,
+              const rect_type& rect,
+              pixel_type seed) {
+        for (auto y = rect.top; y < rect.bottom; ++y) {
+            for (auto x = rect.left; x < rect.right; ++x) {
+                canvas[static_cast<size_type>(y * Width + x)] = (seed + static_cast<pixel_type>(x * 7 + y * 131)) & 0x00FFFFFFu;
+            }
+        }
+    }
+
+    bool Shows(const display_type& display,
+               const std::vector<pixel_type>& canvas) {
+        const auto* pShown{ reinterpret_cast<const pixel_type*>(display.GetShownFrame()) };
+        for (size_type i = 0; i < canvas.size(); ++i) {
+            if (pShown[i] != (canvas[i] | Opaque)) { return false; }
+        }
+        return true;
+    }
+
+    //**************************************************************************
+    // TestCopyOpaque
+    //**************************************************************************
+    void TestCopyOpaque() {
+        std::mt19937 rng{ 49 };
+        std::uniform_int_distribution<pixel_type> any{ };
+        std::uniform_int_distribution<int> kind{ 0, 3 };
+        size_type nFailures{ 0 };
+        for (size_type count = 0; count < 40; ++count) {
+            for (int nCase = 0; nCase < 50; ++nCase) {
+                std::vector<pixel_type> src(count), dst(count);
+                for (size_type i = 0; i < count; ++i) {
+                    src[i] = any(rng);
+                    // Mostly already there, so a single changed
+                    // pixel (in or out of the SSE2 part) is seen
+                    dst[i] = (kind(rng) != 0) ? (src[i] | Opaque) : any(rng);
+                }
+                auto expected{ dst };
+                const bool bExpected{ CopyOpaqueReference(src.data(), expected.data(), count) };
+                nFailures += (::util::frame::copy_opaque(src.data(), dst.data(), count) != bExpected);
+                nFailures += (dst != expected);
+            }
+        }
+        TEST_CHECK(nFailures == 0);
+
+        std::vector<pixel_type> src(static_cast<size_type>(Width * Height), 0);
+        Fill(src, rect_type::all(Width, Height), 5);
+        std::vector<pixel_type> dst(src.size(), 0);
+        for (size_type i = 0; i < src.size(); ++i) { dst[i] = src[i] | Opaque; }
+
+        const auto at = [](int x, int y) { return static_cast<size_type>(y * Width + x); };
+
+        // Nothing to do, or nothing different
+        TEST_CHECK(!::util::frame::copy_opaque(src.data(), dst.data(), Width, {}, {}));
+        TEST_CHECK(!::util::frame::copy_opaque(src.data(), dst.data(), Width, rect_type::all(Width, Height), {}));
+
+        // Only rows that came out different are reported, and
+        // nothing outside the rect is written
+        src[at(4, 6)] ^= 0x00010101u;
+        src[at(8, 4)] ^= 0x00010101u;
+        dst[at(0, 6)]  = 0x12345678u;
+        TEST_CHECK(Same(::util::frame::copy_opaque(src.data(), dst.data(), Width, { 2, 3, 9, 9 }, {}),
+                        { 2, 4, 9, 7 }));
+        TEST_CHECK(dst[at(4, 6)] == (src[at(4, 6)] | Opaque));
+        TEST_CHECK(dst[at(8, 4)] == (src[at(8, 4)] | Opaque));
+        TEST_CHECK(dst[at(0, 6)] == 0x12345678u);
+
+        // Stale rows are rewritten, but only reported where
+        // dirty, where they always are (the same as the stale
+        // buffer says nothing of the frame before)
+        dst[at(1, 0)] = 0;
+        dst[at(1, 1)] = 0;
+        TEST_CHECK(Same(::util::frame::copy_opaque(src.data(), dst.data(), Width, { 0, 1, Width, 3 }, { 0, 0, Width, 2 }),
+                        { 0, 1, Width, 2 }));
+        TEST_CHECK(dst[at(1, 0)] == (src[at(1, 0)] | Opaque));
+        TEST_CHECK(dst[at(1, 1)] == (src[at(1, 1)] | Opaque));
+        TEST_CHECK(!::util::frame::copy_opaque(src.data(), dst.data(), Width, {}, { 0, 0, Width, Height }));
+    }
+
+    //**************************************************************************
+    // TestInPlace
+    //**************************************************************************
+    void TestInPlace() {
+        const auto pDisplay{ CreateDisplay(device_type::Color, Width, Height, 32) };
+        auto* pBuffer{ static_cast<pixel_type*>(pDisplay->GetFrameBuffer(0)) };
+        TEST_CHECK(pBuffer && pDisplay->NeedsFullUpdate());
+
+        std::vector<pixel_type> canvas(static_cast<size_type>(Width * Height), 0);
+        // Draws `rect` (seeded by `seed`) and finishes it into
+        // the display's buffer, then updates the display with
+        // what changed, as `VisualisationManager` does
+        const auto present = [&](const rect_type& rect, pixel_type seed) {
+            Fill(canvas, rect, seed);
+            const auto changed{ ::util::frame::copy_opaque(canvas.data(), pBuffer, Width, rect, {}) };
+            const auto status{ pDisplay->Update(pBuffer, changed) };
+            TEST_CHECK(Shows(*pDisplay, canvas));
+            TEST_CHECK(pDisplay->GetCopyCount() == 0);
+            return status;
+        };
+
+        const auto all{ rect_type::all(Width, Height) };
+        TEST_CHECK(present(all, 1) == status_type::Success);
+        TEST_CHECK(!pDisplay->NeedsFullUpdate());
+        TEST_CHECK(present({ 0, 2, Width, 5 }, 2) == status_type::Success);
+        TEST_CHECK(present({ 3, 8, 10, 11 }, 3) == status_type::Success);
+
+        // Drawn again unchanged: nothing to send
+        TEST_CHECK(present(all, 1) == status_type::Success);
+        TEST_CHECK(present(all, 1) == status_type::Unchanged);
+
+        // Reconnected, the frame is sent even if the same
+        pDisplay->Disconnect();
+        TEST_CHECK(pDisplay->Connect(device_type::Color));
+        TEST_CHECK(present(all, 1) == status_type::Success);
+
+        TEST_CHECK(pDisplay->GetCopyCount() == 0);
+        ::LCD::ILCD::destroy();
+    }
+
+    //**************************************************************************
+    // TestCopied
+    //**************************************************************************
+    void TestCopied() {
+        constexpr const int MonoWidth { 20 };
+        constexpr const int MonoHeight{ 6 };
+        const auto pDisplay{ CreateDisplay(device_type::Monochrome, MonoWidth, MonoHeight, 1) };
+        TEST_CHECK(!pDisplay->GetFrameBuffer(0));
+
+        const auto nStride{ static_cast<size_type>(pDisplay->GetDisplayStride()) };
+        TEST_CHECK(nStride == 4);
+        std::vector<byte_type> frame(nStride * MonoHeight, 0);
+        const auto present = [&](const rect_type& rect, byte_type value) {
+            for (auto y = rect.top; y < rect.bottom; ++y) {
+                std::memset(frame.data() + static_cast<size_type>(y) * nStride, value + y, nStride);
+            }
+            const auto status{ pDisplay->Update(frame.data(), rect) };
+            TEST_CHECK(std::memcmp(pDisplay->GetShownFrame(), frame.data(), frame.size()) == 0);
+            return status;
+        };
+
+        // Partial while stale: skipped
+        TEST_CHECK(pDisplay->Update(frame.data(), { 0, 1, MonoWidth, 3 }) == status_type::Skipped);
+        TEST_CHECK(pDisplay->GetCopyCount() == 0);
+
+        TEST_CHECK(present(rect_type::all(MonoWidth, MonoHeight), 0x10) == status_type::Success);
+        TEST_CHECK(pDisplay->GetCopyCount() == 1);
+        TEST_CHECK(present({ 0, 1, MonoWidth, 3 }, 0x20) == status_type::Success);
+        TEST_CHECK(pDisplay->GetCopyCount() == 2);
+        TEST_CHECK(present({}, 0) == status_type::Unchanged);
+        TEST_CHECK(pDisplay->GetCopyCount() == 2);
+        ::LCD::ILCD::destroy();
+    }
+
+    //**************************************************************************
+    // BenchmarkFinish
+    //**************************************************************************
+    void BenchmarkFinish() {
+        constexpr const int QVGAWidth { 320 };
+        constexpr const int QVGAHeight{ 240 };
+        const auto all  { rect_type::all(QVGAWidth, QVGAHeight) };
+        const auto count{ static_cast<size_type>(QVGAWidth * QVGAHeight) };
+        std::vector<pixel_type> canvas(count, 0x00204080u), lcd(count, 0);
+
+        // Before: alpha fixed up in the canvas, then compared
+        // against and copied into the LCD's bitmap
+        const auto old = [&]() {
+            for (auto& pixel : canvas) { pixel |= Opaque; }
+            const bool bChanged{ std::memcmp(lcd.data(), canvas.data(), count * sizeof(pixel_type)) != 0 };
+            if (bChanged) { std::memcpy(lcd.data(), canvas.data(), count * sizeof(pixel_type)); }
+            return bChanged;
+        };
+
+        pixel_type seed{ 0 };
+        // A frame as drawn: alpha zero, changing in the first
+        // and last pixel (so every row is compared)
+        const auto draw = [&](bool bChange) {
+            for (auto& pixel : canvas) { pixel &= ~Opaque; }
+            if (bChange) {
+                canvas.front() = ++seed & 0x00FFFFFFu;
+                canvas.back()  = seed & 0x00FFFFFFu;
+            }
+        };
+
+        for (const bool bChange : { false, true }) {
+            ::Tests::Benchmark(bChange ? "old alpha + compare + copy 320x240 (changed)"
+                                       : "old alpha + compare + copy 320x240 (unchanged)", 2000, [&]() {
+                draw(bChange);
+                ::Tests::DoNotOptimise(old());
+            });
+            ::Tests::Benchmark(bChange ? "copy_opaque 320x240 (changed)"
+                                       : "copy_opaque 320x240 (unchanged)", 2000, [&]() {
+                draw(bChange);
+                ::Tests::DoNotOptimise(::util::frame::copy_opaque(canvas.data(), lcd.data(), QVGAWidth, all, {}));
+            });
+        }
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestCopyOpaque();
+    TestInPlace();
+    TestCopied();
+    BenchmarkFinish();
+    return ::Tests::Result();
+}
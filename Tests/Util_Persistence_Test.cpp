@@ -0,0 +1,274 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Util/Persistence.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+//--------------------------------------
+
+//******************************************************************************
+// Util_Persistence_Test
+//******************************************************************************
+//
+// The kernels (four pixels at a time with SSE2, where the
+// build has it) must give exactly what the one pixel at a
+// time functions in `detail` give: for random BGRA, each
+// `mode`, decays of 0, 128 and 256, and counts which leave
+// a remainder. The SWAR helpers those use are checked
+// against a channel at a time. Then each kernel is timed
+// on a 320x240 frame, against a plain copy: for a drawn
+// frame (opaque or clear pixels, in runs) and for random
+// alpha (the worst case).
+
+namespace {
+    namespace persistence = ::util::persistence;
+    using pixel_type  = persistence::pixel_type;
+    using size_type   = persistence::size_type;
+    using decay_type  = persistence::decay_type;
+    using pixels_type = std::vector<pixel_type>;
+
+    constexpr const persistence::mode Modes[]{
+        persistence::mode::blend, persistence::mode::max, persistence::mode::add
+    };
+    constexpr const char* const ModeNames[]{ "blend", "max", "add" };
+
+    constexpr const decay_type Decays[]{ 0, 128, persistence::DecayOne };
+
+    // Not multiples of four, bar 320x240
+    constexpr const size_type Counts[]{ 1, 2, 3, 5, 7, 13, 63, 1021, 320 * 240, 320 * 240 + 3 };
+
+    //**************************************************************************
+    // RandomPixels
+    //**************************************************************************
+    // Alpha mostly opaque or clear, as OpenGL frames are, in
+    // runs long enough to take the kernels' shortcuts; the
+    // rest random, and some pixels wholly empty
+    pixels_type RandomPixels(std::mt19937& random, size_type count) {
+        pixels_type pixels(count);
+        pixel_type alpha{ 0 };
+        for (size_type i = 0; i < count; ++i) {
+            if ((i % 8) == 0) {
+                switch (random() % 4) {
+                    case 0:  alpha = 0x00u; break;
+                    case 1:  alpha = 0xFFu; break;
+                    default: alpha = 0x100u; break; //< Random per pixel
+                }
+            }
+            const auto a{ (alpha == 0x100u) ? (random() & 0xFFu) : alpha };
+            pixels[i] = (random() % 16 == 0) ? 0u : ((a << 24) | (random() & 0x00FFFFFFu));
+        }
+        return pixels;
+    }
+
+    //**************************************************************************
+    // Scalar references
+    //**************************************************************************
+    void BlendScalar(const pixels_type& src, pixels_type& dst) {
+        for (size_type i = 0; i < dst.size(); ++i) {
+            dst[i] = persistence::detail::blend(src[i], dst[i]);
+        }
+    }
+
+    void AccumulateScalar(persistence::mode eMode,
+                          const pixels_type& src,
+                          pixels_type& history,
+                          decay_type decay) {
+        for (size_type i = 0; i < history.size(); ++i) {
+            history[i] = persistence::detail::accumulate(eMode, src[i], history[i], decay);
+        }
+    }
+
+    void CompositeScalar(const pixels_type& history, pixels_type& dst) {
+        for (size_type i = 0; i < dst.size(); ++i) {
+            dst[i] = persistence::detail::composite(history[i], dst[i]);
+        }
+    }
+
+    //**************************************************************************
+    // TestKernels
+    //**************************************************************************
+    void TestKernels() {
+        std::mt19937 random{ 46u };
+        size_type nChecked{ 0 };
+        for (const auto count : Counts) {
+            const auto src{ RandomPixels(random, count) };
+            const auto dst{ RandomPixels(random, count) };
+
+            {
+                auto expected{ dst }, actual{ dst };
+                BlendScalar(src, expected);
+                persistence::blend(src.data(), actual.data(), count);
+                TEST_CHECK(actual == expected);
+            }
+
+            for (size_type m = 0; m < std::size(Modes); ++m) {
+                for (const auto decay : Decays) {
+                    auto expected{ dst }, actual{ dst };
+                    AccumulateScalar(Modes[m], src, expected, decay);
+                    persistence::accumulate(Modes[m], src.data(), actual.data(), count, decay);
+                    if (!TEST_CHECK(actual == expected)) {
+                        std::printf("    accumulate %s, decay %u, %zu pixels\n",
+                                    ModeNames[m], static_cast<unsigned>(decay), count);
+                    }
+
+                    // The history as accumulate leaves it (so
+                    // premultiplied) over the frame
+                    auto composited{ dst }, compositedScalar{ dst };
+                    CompositeScalar(actual, compositedScalar);
+                    persistence::composite(actual.data(), composited.data(), count);
+                    TEST_CHECK(composited == compositedScalar);
+                }
+            }
+
+            {
+                // Random (not premultiplied) history too
+                auto expected{ dst }, actual{ dst };
+                CompositeScalar(src, expected);
+                persistence::composite(src.data(), actual.data(), count);
+                TEST_CHECK(actual == expected);
+            }
+            nChecked += count;
+        }
+#ifdef foo_logitech_lcd_PERSISTENCE_SSE2
+        std::printf("SSE2 kernels match scalar over %zu pixels per case\n", nChecked);
+#else
+        std::printf("No SSE2 in this build: scalar only (%zu pixels per case)\n", nChecked);
+#endif
+    }
+
+    //**************************************************************************
+    // TestSWAR
+    //**************************************************************************
+    // Every pair of channel values, in each channel
+    void TestSWAR() {
+        namespace detail = persistence::detail;
+        size_type nDifferent{ 0 };
+        for (pixel_type a = 0; a < 256; ++a) {
+            for (pixel_type b = 0; b < 256; ++b) {
+                // The other channels hold values which would
+                // carry into (or borrow from) their neighbours
+                const pixel_type pa{ (a << 24) | (a << 16) | ((255 - a) << 8) | b };
+                const pixel_type pb{ (b << 24) | (b << 16) | ((255 - b) << 8) | a };
+                pixel_type adds{ 0 }, max{ 0 };
+                for (const auto shift : detail::Shifts) {
+                    const auto ca{ detail::channel(pa, shift) }, cb{ detail::channel(pb, shift) };
+                    adds |= std::min(ca + cb, 255u) << shift;
+                    max  |= std::max(ca, cb) << shift;
+                }
+                if (detail::adds(pa, pb) != adds) { ++nDifferent; }
+                if (detail::max (pa, pb) != max)  { ++nDifferent; }
+            }
+        }
+        TEST_CHECK(nDifferent == 0);
+
+        for (std::uint32_t x = 0; x <= 255u * 255u; ++x) {
+            if (detail::div255(x) != (x + 127u) / 255u) { ++nDifferent; }
+        }
+        TEST_CHECK(nDifferent == 0);
+    }
+
+    //**************************************************************************
+    // BenchmarkKernels
+    //**************************************************************************
+    // A drawn frame: clear, with opaque bars over the lower
+    // part of each column (as a spectrum analyser draws)
+    pixels_type DrawnPixels(size_type width, size_type height) {
+        pixels_type pixels(width * height, 0u);
+        for (size_type x = 0; x < width; ++x) {
+            const auto top{ height - (x * 7919u) % height };
+            for (size_type y = top; y < height; ++y) {
+                pixels[y * width + x] = 0xFF000000u | static_cast<pixel_type>(x * 0x010203u);
+            }
+        }
+        return pixels;
+    }
+
+    void BenchmarkKernels(const char* szInput,
+                          const pixels_type& src,
+                          const pixels_type& background) {
+        // Per frame decay of 0.9
+        const auto decay{ persistence::to_decay(.9f) };
+        auto dst{ background };
+        auto history{ src };
+        const auto count{ dst.size() };
+
+        char szName[64];
+        std::snprintf(szName, sizeof(szName), "memcpy (%s)", szInput);
+        ::Tests::Benchmark(szName, 2000, [&]() {
+            std::memcpy(dst.data(), src.data(), count * sizeof(pixel_type));
+            ::Tests::DoNotOptimise(dst.front());
+        });
+        std::snprintf(szName, sizeof(szName), "blend (%s)", szInput);
+        ::Tests::Benchmark(szName, 2000, [&]() {
+            persistence::blend(src.data(), dst.data(), count);
+            ::Tests::DoNotOptimise(dst.front());
+        });
+        std::snprintf(szName, sizeof(szName), "blend, scalar (%s)", szInput);
+        ::Tests::Benchmark(szName, 2000, [&]() {
+            BlendScalar(src, dst);
+            ::Tests::DoNotOptimise(dst.front());
+        });
+        for (size_type m = 0; m < std::size(Modes); ++m) {
+            std::snprintf(szName, sizeof(szName), "accumulate %s (%s)", ModeNames[m], szInput);
+            ::Tests::Benchmark(szName, 2000, [&]() {
+                persistence::accumulate(Modes[m], src.data(), history.data(), count, decay);
+                ::Tests::DoNotOptimise(history.front());
+            });
+        }
+        std::snprintf(szName, sizeof(szName), "composite (%s)", szInput);
+        ::Tests::Benchmark(szName, 2000, [&]() {
+            persistence::composite(history.data(), dst.data(), count);
+            ::Tests::DoNotOptimise(dst.front());
+        });
+        std::snprintf(szName, sizeof(szName), "composite, scalar (%s)", szInput);
+        ::Tests::Benchmark(szName, 2000, [&]() {
+            CompositeScalar(history, dst);
+            ::Tests::DoNotOptimise(dst.front());
+        });
+    }
+
+    void BenchmarkKernels() {
+        constexpr const size_type Width{ 320 }, Height{ 240 };
+        std::mt19937 random{ 7u };
+        const auto background{ RandomPixels(random, Width * Height) };
+        BenchmarkKernels("320x240 drawn", DrawnPixels(Width, Height), background);
+        BenchmarkKernels("320x240 random", RandomPixels(random, Width * Height), background);
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestSWAR();
+    TestKernels();
+    BenchmarkKernels();
+    return ::Tests::Result();
+}
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Tests/TestCommon.h"
+#include "Util/SPSCQueue.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+//--------------------------------------
+
+//******************************************************************************
+// Util_SPSCQueue_Test
+//******************************************************************************
+//
+// Checks the capacity limits on one thread, then streams
+// a numbered sequence from a producer thread to a consumer
+// thread through small queues (so both sides keep finding
+// it full or empty) and checks nothing is lost, repeated
+// or reordered. Finally times a round trip between two
+// threads, which is the hand-off the analysis worker adds
+// between fetching audio and the render thread seeing it.
+
+namespace {
+    using size_type = std::size_t;
+
+    //**************************************************************************
+    // TestCapacity
+    //**************************************************************************
+    void TestCapacity() {
+        ::util::spsc_queue<int, 4> queue{};
+        TEST_CHECK(queue.empty());
+        TEST_CHECK(queue.capacity() == 4);
+
+        // Every slot is usable
+        for (int i = 0; i < 4; ++i) { TEST_CHECK(queue.try_push(i)); }
+        TEST_CHECK(!queue.try_push(4));
+        TEST_CHECK(queue.size() == 4);
+
+        // Indices keep running past the capacity
+        int value{ -1 };
+        for (int round = 0; round < 10; ++round) {
+            TEST_CHECK(queue.try_pop(value) && value == round);
+            TEST_CHECK(queue.try_push(round + 4));
+            TEST_CHECK(!queue.try_push(-1));
+        }
+        for (int i = 10; i < 14; ++i) { TEST_CHECK(queue.try_pop(value) && value == i); }
+        TEST_CHECK(!queue.try_pop(value));
+        TEST_CHECK(queue.empty() && queue.size() == 0);
+    }
+
+    //**************************************************************************
+    // TestStress
+    //**************************************************************************
+    template <size_type CapacityT>
+    void TestStress(std::uint64_t nCount) {
+        ::util::spsc_queue<std::uint64_t, CapacityT> queue{};
+        std::atomic<bool> bStart{ false };
+
+        std::thread producer{ [&]() {
+            while (!bStart.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+            for (std::uint64_t i = 0; i < nCount; ++i) {
+                while (!queue.try_push(i)) { std::this_thread::yield(); }
+            }
+        } };
+
+        std::uint64_t nExpected{ 0 }, nOutOfOrder{ 0 }, nEmpty{ 0 };
+        bStart.store(true, std::memory_order_release);
+        while (nExpected < nCount) {
+            std::uint64_t value{ 0 };
+            if (!queue.try_pop(value)) { ++nEmpty; std::this_thread::yield(); continue; }
+            if (value != nExpected) { ++nOutOfOrder; }
+            nExpected = value + 1;
+            TEST_CHECK(queue.size() <= CapacityT);
+        }
+        producer.join();
+
+        std::printf("stress (capacity %zu): %llu values, %llu out of order, consumer found empty %llu times\n",
+                    CapacityT,
+                    static_cast<unsigned long long>(nCount),
+                    static_cast<unsigned long long>(nOutOfOrder),
+                    static_cast<unsigned long long>(nEmpty));
+        TEST_CHECK(nOutOfOrder == 0);
+        TEST_CHECK(queue.empty());
+    }
+
+    //**************************************************************************
+    // TestFrameRecycling
+    //**************************************************************************
+    //
+    // The analysis worker's scheme: frames go out on one
+    // queue and come back on another, so each frame must be
+    // owned by exactly one side at a time. The writer stamps
+    // each frame it fills; the reader checks the stamp is
+    // intact, which fails if a frame is handed out twice.
+    void TestFrameRecycling() {
+        struct frame final {
+            std::uint64_t m_nStamp{ 0 };
+            std::array<std::uint64_t, 64> m_Data{};
+        };
+        constexpr const size_type FrameCount{ 4 };
+        constexpr const std::uint64_t PublishCount{ 200000 };
+
+        std::array<frame, FrameCount> frames{};
+        ::util::spsc_queue<frame*, FrameCount> ready{}, free{};
+        for (auto& f : frames) { TEST_CHECK(free.try_push(&f)); }
+
+        std::thread writer{ [&]() {
+            for (std::uint64_t i = 1; i <= PublishCount; ++i) {
+                frame* pFrame{ nullptr };
+                while (!free.try_pop(pFrame)) { std::this_thread::yield(); }
+                pFrame->m_nStamp = i;
+                pFrame->m_Data.fill(i);
+                while (!ready.try_push(pFrame)) { std::this_thread::yield(); }
+            }
+        } };
+
+        std::uint64_t nLast{ 0 }, nTorn{ 0 };
+        while (nLast < PublishCount) {
+            frame* pFrame{ nullptr };
+            if (!ready.try_pop(pFrame)) { std::this_thread::yield(); continue; }
+            for (const auto v : pFrame->m_Data) { if (v != pFrame->m_nStamp) { ++nTorn; break; } }
+            if (pFrame->m_nStamp != nLast + 1) { ++nTorn; }
+            nLast = pFrame->m_nStamp;
+            TEST_CHECK(free.try_push(pFrame));
+        }
+        writer.join();
+        TEST_CHECK(nTorn == 0);
+    }
+
+    //**************************************************************************
+    // BenchmarkRoundTrip
+    //**************************************************************************
+    //
+    // One value out and back between two spinning threads,
+    // so both hand-offs are counted.
+    void BenchmarkRoundTrip() {
+        ::util::spsc_queue<std::uint64_t, 4> ping{}, pong{};
+        std::atomic<bool> bStop{ false };
+
+        std::thread echo{ [&]() {
+            std::uint64_t value{ 0 };
+            while (!bStop.load(std::memory_order_relaxed)) {
+                if (ping.try_pop(value)) {
+                    while (!pong.try_push(value)) {}
+                }
+            }
+        } };
+
+        std::uint64_t nSent{ 0 };
+        ::Tests::Benchmark("spsc_queue round trip", 100000, [&]() {
+            while (!ping.try_push(++nSent)) {}
+            std::uint64_t value{ 0 };
+            while (!pong.try_pop(value)) {}
+            ::Tests::DoNotOptimise(value);
+        });
+
+        bStop.store(true, std::memory_order_relaxed);
+        echo.join();
+    }
+
+    //**************************************************************************
+    // BenchmarkPushPop
+    //**************************************************************************
+    void BenchmarkPushPop() {
+        ::util::spsc_queue<std::uint64_t, 8> queue{};
+        std::uint64_t value{ 0 };
+        ::Tests::Benchmark("spsc_queue push+pop (one thread)", 10000000, [&]() {
+            (void)queue.try_push(value);
+            (void)queue.try_pop(value);
+            ::Tests::DoNotOptimise(value);
+        });
+    }
+} // namespace <anonymous>
+
+int main() {
+    TestCapacity();
+    TestStress<2>(1000000);
+    TestStress<64>(5000000);
+    TestFrameRecycling();
+    // A round trip needs two cores to mean anything
+    if (std::thread::hardware_concurrency() > 1) {
+        BenchmarkRoundTrip();
+    }
+    BenchmarkPushPop();
+    return ::Tests::Result();
+}
@@ -0,0 +1,179 @@
+#pragma once
+#ifndef GUID_11432B36_7F37_432D_AC70_A5E3A547EBC7
+#define GUID_11432B36_7F37_432D_AC70_A5E3A547EBC7
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include <array>
+#include <cstdint>
+#include <cstring> // memcpy
+//--------------------------------------
+
+namespace util::bit_plane {
+    //**************************************************************************
+    // bit_plane
+    //**************************************************************************
+    //
+    // One bit per pixel, rows top to bottom, the leftmost
+    // pixel in the most significant bit of each byte, and
+    // each row padded to 32 bits: the layout of a 1bpp DIB,
+    // so GDI can draw straight into one.
+    using byte_type = std::uint8_t;
+    using size_type = std::size_t;
+
+    //--------------------------------------------------------------------------
+
+    [[nodiscard]]
+    constexpr size_type stride(size_type width) noexcept {
+        return ((width + 31) / 32) * 4;
+    }
+
+    [[nodiscard]]
+    constexpr size_type byte_size(size_type width,
+                                  size_type height) noexcept {
+        return stride(width) * height;
+    }
+
+    //--------------------------------------------------------------------------
+
+    namespace detail {
+        // Top bit of each of 8 bytes (first byte in memory
+        // first) gathered into one byte, first pixel in the
+        // most significant bit
+        [[nodiscard]]
+        inline byte_type gather8(const byte_type* src) noexcept {
+            std::uint64_t bits{ 0 };
+            std::memcpy(&bits, src, sizeof(bits));
+            bits = (bits >> 7) & 0x0101010101010101ull;
+            return static_cast<byte_type>((bits * 0x8040201008040201ull) >> 56);
+        }
+
+        // Each bit of a byte as 0x00 or 0xFF, most significant
+        // bit first in memory
+        [[nodiscard]]
+        constexpr auto make_expand_table() noexcept {
+            std::array<std::array<byte_type, 8>, 256> table{};
+            for (size_type value = 0; value < table.size(); ++value) {
+                for (size_type bit = 0; bit < 8; ++bit) {
+                    table[value][bit] = (value & (0x80u >> bit)) ? 0xFF : 0x00;
+                }
+            }
+            return table;
+        }
+
+        // Whether any colour channel of each of `count` (up
+        // to 8) 32-bit pixels has its top bit set, gathered
+        // as `gather8` does
+        [[nodiscard]]
+        inline byte_type gather(const std::uint32_t* src,
+                                size_type count) noexcept {
+            unsigned bits{ 0 };
+            for (size_type bit = 0; bit < count; ++bit) {
+                bits |= static_cast<unsigned>((src[bit] & 0x00808080) != 0) << (7 - bit);
+            }
+            return static_cast<byte_type>(bits);
+        }
+
+        [[nodiscard]]
+        inline byte_type gather8(const std::uint32_t* src) noexcept {
+            return gather(src, 8);
+        }
+
+        inline static constexpr const auto expand_table{ make_expand_table() };
+    } // namespace detail
+
+    //--------------------------------------------------------------------------
+    // Pack one byte per pixel (`srcStride` bytes per row),
+    // setting each pixel whose top bit is set. Little-endian
+    // only (as is every target of this component).
+    inline void pack(const byte_type* src,
+                     size_type srcStride,
+                     byte_type* dst,
+                     size_type width,
+                     size_type height) noexcept {
+        const auto dstStride{ stride(width) };
+        const auto wholeBytes{ width / 8 };
+        for (size_type y = 0; y < height; ++y) {
+            const auto* pSrc{ src + y * srcStride };
+            auto*       pDst{ dst + y * dstStride };
+            for (size_type i = 0; i < wholeBytes; ++i, pSrc += 8) {
+                *pDst++ = detail::gather8(pSrc);
+            }
+            if (const auto remainder{ width % 8 }) {
+                byte_type bits{ 0 };
+                for (size_type bit = 0; bit < remainder; ++bit) {
+                    bits |= static_cast<byte_type>((pSrc[bit] & 0x80u) >> bit);
+                }
+                *pDst++ = bits;
+            }
+            std::memset(pDst, 0, dstStride - (wholeBytes + (width % 8 ? 1 : 0)));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Pack 32-bit pixels, setting each pixel with the top bit
+    // of any colour channel set (alpha is ignored).
+    inline void pack(const std::uint32_t* src,
+                     byte_type* dst,
+                     size_type width,
+                     size_type height) noexcept {
+        const auto dstStride{ stride(width) };
+        const auto wholeBytes{ width / 8 };
+        for (size_type y = 0; y < height; ++y) {
+            auto* pDst{ dst + y * dstStride };
+            std::memset(pDst, 0, dstStride);
+            // Without branches: a frame is as likely to be
+            // noise as not, which defeats prediction
+            for (size_type i = 0; i < wholeBytes; ++i, src += 8) {
+                *pDst++ = detail::gather8(src);
+            }
+            if (const auto remainder{ width % 8 }) {
+                *pDst = detail::gather(src, remainder);
+                src += remainder;
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // Expand to one byte per pixel (0x00 or 0xFF), rows
+    // `width` bytes apart.
+    inline void expand(const byte_type* src,
+                       byte_type* dst,
+                       size_type width,
+                       size_type height) noexcept {
+        const auto srcStride{ stride(width) };
+        const auto wholeBytes{ width / 8 };
+        for (size_type y = 0; y < height; ++y) {
+            const auto* pSrc{ src + y * srcStride };
+            for (size_type i = 0; i < wholeBytes; ++i, dst += 8) {
+                std::memcpy(dst, detail::expand_table[*pSrc++].data(), 8);
+            }
+            if (const auto remainder{ width % 8 }) {
+                std::memcpy(dst, detail::expand_table[*pSrc].data(), remainder);
+                dst += remainder;
+            }
+        }
+    }
+} // namespace util::bit_plane
+
+#endif // GUID_11432B36_7F37_432D_AC70_A5E3A547EBC7
@@ -0,0 +1,102 @@
+#pragma once
+#ifndef GUID_0713E510_1CE9_4CCD_8B0E_A75C876CA2A4
+#define GUID_0713E510_1CE9_4CCD_8B0E_A75C876CA2A4
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include <algorithm>
+//--------------------------------------
+
+namespace util {
+    //**************************************************************************
+    // dirty_rect
+    //**************************************************************************
+    //
+    // Part of a frame that changed from the one before: the
+    // half open [left, right) x [top, bottom), in pixels from
+    // the top left. Dirty areas merge into their bounding
+    // rect, so one small change at each edge of a frame
+    // covers all of it; tracking more than one rect is not
+    // worth its cost at LCD sizes.
+    struct dirty_rect final {
+        using coord_type = int;
+
+        coord_type left  { 0 };
+        coord_type top   { 0 };
+        coord_type right { 0 };
+        coord_type bottom{ 0 };
+
+        //----------------------------------------------------------------------
+
+        [[nodiscard]]
+        static constexpr dirty_rect all(coord_type cx,
+                                        coord_type cy) noexcept {
+            return { 0, 0, cx, cy };
+        }
+
+        //----------------------------------------------------------------------
+
+        [[nodiscard]]
+        constexpr bool empty() const noexcept {
+            return (right <= left) || (bottom <= top);
+        }
+
+        explicit constexpr operator bool() const noexcept { return !empty(); }
+
+        [[nodiscard]]
+        constexpr coord_type width () const noexcept { return empty() ? 0 : right - left; }
+        [[nodiscard]]
+        constexpr coord_type height() const noexcept { return empty() ? 0 : bottom - top; }
+
+        [[nodiscard]]
+        constexpr bool covers(coord_type cx,
+                              coord_type cy) const noexcept {
+            return (left <= 0) && (top <= 0) && (right >= cx) && (bottom >= cy);
+        }
+
+        //----------------------------------------------------------------------
+
+        constexpr dirty_rect& merge(const dirty_rect& other) noexcept {
+            if (other.empty()) { return *this; }
+            if (empty()) { return *this = other; }
+            left   = std::min(left,   other.left);
+            top    = std::min(top,    other.top);
+            right  = std::max(right,  other.right);
+            bottom = std::max(bottom, other.bottom);
+            return *this;
+        }
+
+        // Limited to a `cx` by `cy` frame
+        [[nodiscard]]
+        constexpr dirty_rect clipped(coord_type cx,
+                                     coord_type cy) const noexcept {
+            const dirty_rect clip{
+                std::max(left, 0),   std::max(top, 0),
+                std::min(right, cx), std::min(bottom, cy)
+            };
+            return clip.empty() ? dirty_rect{} : clip;
+        }
+    }; // struct dirty_rect final
+} // namespace util
+
+#endif // GUID_0713E510_1CE9_4CCD_8B0E_A75C876CA2A4
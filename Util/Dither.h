@@ -0,0 +1,211 @@
+#pragma once
+#ifndef GUID_71D593CA_5125_4E7E_8345_56D643CF0B46
+#define GUID_71D593CA_5125_4E7E_8345_56D643CF0B46
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Util/BitPlane.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+//--------------------------------------
+
+namespace util::dither {
+    //**************************************************************************
+    // dither
+    //**************************************************************************
+    //
+    // Reduce 8-bit grey (one byte per pixel) to a packed
+    // `bit_plane`.
+    //
+    //  - threshold: set when the top bit is set (as
+    //    `bit_plane::pack`).
+    //  - bayer: 8x8 ordered dither, a compare against a
+    //    fixed table; stable from frame to frame, so
+    //    nothing crawls on an animated display.
+    //  - floyd_steinberg / atkinson: error diffusion,
+    //    integer only, with rolling error rows rather than
+    //    a full frame of error. Atkinson diffuses 3/4 of
+    //    the error, keeping more contrast in highlights
+    //    and shadows at the cost of some tonal range.
+    enum class method {
+        threshold = 0,
+        bayer,
+        floyd_steinberg,
+        atkinson,
+    }; // enum class method
+
+    using byte_type = bit_plane::byte_type;
+    using size_type = bit_plane::size_type;
+
+    //--------------------------------------------------------------------------
+
+    namespace detail {
+        // Thresholds for the recursive 8x8 Bayer index `M`,
+        // spread evenly over (0, 255): a flat grey `g` sets
+        // close to `g * 64 / 255` pixels of every 8x8 tile.
+        [[nodiscard]]
+        constexpr auto make_bayer_table() noexcept {
+            std::array<std::array<byte_type, 8>, 8> table{};
+            for (size_type y = 0; y < 8; ++y) {
+                for (size_type x = 0; x < 8; ++x) {
+                    size_type index{ 0 };
+                    for (size_type bit = 0; bit < 3; ++bit) {
+                        const auto xb{ (x >> bit) & 1 };
+                        const auto yb{ (y >> bit) & 1 };
+                        index |= ((xb ^ yb) << (5 - 2 * bit)) | (yb << (4 - 2 * bit));
+                    }
+                    table[y][x] = static_cast<byte_type>(((2 * index + 1) * 255) / 128);
+                }
+            }
+            return table;
+        }
+
+        inline static constexpr const auto bayer_table{ make_bayer_table() };
+    } // namespace detail
+
+    //--------------------------------------------------------------------------
+
+    inline void bayer(const byte_type* src,
+                      size_type srcStride,
+                      byte_type* dst,
+                      size_type width,
+                      size_type height) noexcept {
+        const auto dstStride{ bit_plane::stride(width) };
+        for (size_type y = 0; y < height; ++y) {
+            const auto& thresholds{ detail::bayer_table[y % 8] };
+            const auto* pSrc{ src + y * srcStride };
+            auto*       pDst{ dst + y * dstStride };
+            std::memset(pDst, 0, dstStride);
+            for (size_type x = 0; x < width; x += 8, ++pDst) {
+                const auto count{ (width - x < 8) ? (width - x) : size_type{ 8 } };
+                byte_type bits{ 0 };
+                for (size_type i = 0; i < count; ++i) {
+                    bits |= static_cast<byte_type>((pSrc[x + i] > thresholds[i]) ? (0x80u >> i) : 0u);
+                }
+                *pDst = bits;
+            }
+        }
+    }
+
+    //**************************************************************************
+    // ditherer
+    //**************************************************************************
+    // Holds the error rows so error diffusion doesn't
+    // allocate once the size has settled.
+    class ditherer final {
+    public:
+        void operator()(method eMethod,
+                        const byte_type* src,
+                        size_type srcStride,
+                        byte_type* dst,
+                        size_type width,
+                        size_type height) {
+            switch (eMethod) {
+                case method::bayer:           bayer(src, srcStride, dst, width, height);                     break;
+                case method::floyd_steinberg: diffuse<floyd_steinberg>(src, srcStride, dst, width, height); break;
+                case method::atkinson:        diffuse<atkinson>(src, srcStride, dst, width, height);        break;
+                case method::threshold:       [[fallthrough]];
+                default:                      bit_plane::pack(src, srcStride, dst, width, height);           break;
+            }
+        }
+
+    private:
+        using error_type = std::int32_t;
+
+        inline static constexpr const size_type Margin{ 2 }; //< Either side, so kernels needn't test the edges
+
+        // Kernels: `Rows` error rows (including the current
+        // one); `spread` distributes the error `e` from
+        // column `x` of `rows[0]` (the current row).
+        struct floyd_steinberg final {
+            inline static constexpr const size_type Rows{ 2 };
+
+            static void spread(error_type* const* rows, size_type x, error_type e) noexcept {
+                rows[0][x + 1] += (e * 7) / 16;
+                rows[1][x - 1] += (e * 3) / 16;
+                rows[1][x    ] += (e * 5) / 16;
+                rows[1][x + 1] += (e    ) / 16;
+            }
+        };
+
+        struct atkinson final {
+            inline static constexpr const size_type Rows{ 3 };
+
+            static void spread(error_type* const* rows, size_type x, error_type e) noexcept {
+                const auto e8{ e / 8 };
+                rows[0][x + 1] += e8;
+                rows[0][x + 2] += e8;
+                rows[1][x - 1] += e8;
+                rows[1][x    ] += e8;
+                rows[1][x + 1] += e8;
+                rows[2][x    ] += e8;
+            }
+        };
+
+        template <typename KernelT>
+        void diffuse(const byte_type* src,
+                     size_type srcStride,
+                     byte_type* dst,
+                     size_type width,
+                     size_type height) {
+            constexpr const auto Rows{ KernelT::Rows };
+            const auto rowSize{ width + 2 * Margin };
+            m_Error.assign(rowSize * Rows, 0);
+
+            std::array<error_type*, Rows> rows{};
+            for (size_type r = 0; r < Rows; ++r) {
+                rows[r] = m_Error.data() + r * rowSize + Margin;
+            }
+
+            const auto dstStride{ bit_plane::stride(width) };
+            for (size_type y = 0; y < height; ++y) {
+                const auto* pSrc{ src + y * srcStride };
+                auto*       pDst{ dst + y * dstStride };
+                std::memset(pDst, 0, dstStride);
+                for (size_type x = 0; x < width; ++x) {
+                    const auto value{ static_cast<error_type>(pSrc[x]) + rows[0][x] };
+                    const bool bSet{ value >= 128 };
+                    if (bSet) { pDst[x / 8] |= static_cast<byte_type>(0x80u >> (x % 8)); }
+                    KernelT::spread(rows.data(), x, value - (bSet ? 255 : 0));
+                }
+
+                // Current row becomes the furthest ahead
+                auto* const pDone{ rows[0] };
+                for (size_type r = 1; r < Rows; ++r) { rows[r - 1] = rows[r]; }
+                rows[Rows - 1] = pDone;
+                std::fill(pDone - Margin, pDone - Margin + rowSize, error_type{ 0 });
+            }
+        }
+
+    private:
+        std::vector<error_type> m_Error{};
+    }; // class ditherer final
+} // namespace util::dither
+
+#endif // GUID_71D593CA_5125_4E7E_8345_56D643CF0B46
@@ -0,0 +1,126 @@
+#pragma once
+#ifndef GUID_DDE972E9_D71F_4721_8BD1_096575E97148
+#define GUID_DDE972E9_D71F_4721_8BD1_096575E97148
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Util/DirtyRect.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+//--------------------------------------
+
+//--------------------------------------
+//
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#   define foo_logitech_lcd_FRAMECOPY_SSE2
+#   include <emmintrin.h>
+#endif
+//--------------------------------------
+
+namespace util::frame {
+    //**************************************************************************
+    // frame
+    //**************************************************************************
+    //
+    // Finishing a colour frame (packed 32-bit BGRA, alpha in
+    // the top byte) on its way to where it is sent from. GDI
+    // leaves alpha zero, so it is set opaque as pixels are
+    // copied.
+    using pixel_type = std::uint32_t;
+    using size_type  = std::size_t;
+    using rect_type  = ::util::dirty_rect;
+
+    //--------------------------------------------------------------------------
+    // `dst = src` with alpha set opaque; true if that changed
+    // anything. Four pixels at a time where SSE2 is (as for
+    // `util::persistence`).
+    inline bool copy_opaque(const pixel_type* src,
+                            pixel_type* dst,
+                            size_type count) noexcept {
+        size_type  i   { 0 };
+        pixel_type diff{ 0 };
+#ifdef foo_logitech_lcd_FRAMECOPY_SSE2
+        const auto alpha{ _mm_set1_epi32(static_cast<int>(0xFF000000u)) };
+        auto       diff4{ _mm_setzero_si128() };
+        for (const auto n4{ count & ~size_type{ 3 } }; i < n4; i += 4) {
+            const auto pixels{ _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), alpha) };
+            diff4 = _mm_or_si128(diff4, _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)), pixels));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), pixels);
+        }
+        diff = (_mm_movemask_epi8(_mm_cmpeq_epi32(diff4, _mm_setzero_si128())) != 0xFFFF) ? 1u : 0u;
+#endif
+        for (; i < count; ++i) {
+            const auto pixel{ src[i] | 0xFF000000u };
+            diff |= dst[i] ^ pixel;
+            dst[i] = pixel;
+        }
+        return diff != 0;
+    }
+
+    //--------------------------------------------------------------------------
+    // `copy_opaque` of a frame `width` pixels wide into `dst`,
+    // which holds the frame before `src` but for `stale`
+    // (older, as where frames alternate between buffers).
+    // `dirty` is what `src` changed from the frame before;
+    // it and `stale` are copied. Returns `dirty` less rows
+    // that came out the same as they were, which is only
+    // known where `dst` wasn't stale (see `LCD::Presenter`).
+    inline rect_type copy_opaque(const pixel_type* src,
+                                 pixel_type* dst,
+                                 int width,
+                                 const rect_type& dirty,
+                                 const rect_type& stale) noexcept {
+        auto copy{ stale };
+        copy.merge(dirty);
+        if (!copy) { return {}; }
+
+        const auto nOffset{ static_cast<size_type>(copy.top) * static_cast<size_type>(width) +
+                            static_cast<size_type>(copy.left) };
+        const auto nCount { static_cast<size_type>(copy.width()) };
+        src += nOffset;
+        dst += nOffset;
+
+        auto changedTop   { dirty.bottom };
+        auto changedBottom{ dirty.top };
+        for (auto row = copy.top; row < copy.bottom; ++row) {
+            const bool bDirty{ (row >= dirty.top) && (row < dirty.bottom) };
+            const bool bStale{ (row >= stale.top) && (row < stale.bottom) };
+            if (copy_opaque(src, dst, nCount) ? bDirty : (bDirty && bStale)) {
+                changedTop    = std::min(changedTop, row);
+                changedBottom = row + 1;
+            }
+            src += width;
+            dst += width;
+        }
+
+        const rect_type changed{ dirty.left, changedTop, dirty.right, changedBottom };
+        return changed ? changed : rect_type{};
+    }
+} // namespace util::frame
+
+#endif // GUID_DDE972E9_D71F_4721_8BD1_096575E97148
@@ -43,7 +43,7 @@ namespace util {
         typename TypeT,
         typename InterpT = TypeT
     >
-    inline [[nodiscard]]
+    [[nodiscard]] inline
     constexpr auto lerp(TypeT prev, TypeT next, InterpT interp) noexcept {
         return prev + (next - prev) * interp;
     }
@@ -79,7 +79,7 @@ namespace util {
         class AllocatorT = std::allocator<TypeT>,
         typename InterpT = typename std::vector<TypeT, AllocatorT>::value_type
     >
-    inline [[nodiscard]]
+    [[nodiscard]] inline
     auto lerp(const std::vector<TypeT, AllocatorT>& prev,
               const std::vector<TypeT, AllocatorT>& next,
               InterpT interp) {
@@ -27,6 +27,7 @@
 #include <stdexcept>
 #include <cassert>
 #include <cstring> // memset/memcpy
+#include <utility> // std::exchange
 //--------------------------------------
 
 namespace util {
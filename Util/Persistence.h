@@ -0,0 +1,312 @@
+#pragma once
+#ifndef GUID_AB7E47DD_C284_44B6_989D_5E33F94C5474
+#define GUID_AB7E47DD_C284_44B6_989D_5E33F94C5474
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+//--------------------------------------
+
+//--------------------------------------
+//
+#if defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+#   define foo_logitech_lcd_PERSISTENCE_SSE2
+#   include <emmintrin.h>
+#endif
+//--------------------------------------
+
+namespace util::persistence {
+    //**************************************************************************
+    // persistence
+    //**************************************************************************
+    //
+    // Trails on packed 32-bit BGRA pixels (alpha in the top
+    // byte), in 8-bit fixed point throughout:
+    //
+    //  - blend: `src` over `dst` by `src` alpha (straight,
+    //    rounded to nearest).
+    //  - accumulate: `history` decays by a constant factor
+    //    (`decay_type`, so exponentially over frames) and the
+    //    new frame is combined into it by `mode`.
+    //  - composite: `history` (premultiplied, as accumulate
+    //    leaves it given frames cleared to transparent black)
+    //    over `dst`.
+    //
+    // Four pixels at a time with SSE2 (any x64 build, or x86
+    // built for it), otherwise (and for the remainder of each
+    // call) one at a time; both give identical results.
+    enum class mode {
+        blend = 0, //< Over (by frame alpha)
+        max,       //< Brightest of trail and frame, per channel
+        add,       //< Trail plus frame, saturating
+    }; // enum class mode
+
+    using pixel_type = std::uint32_t;
+    using size_type  = std::size_t;
+    using decay_type = std::uint16_t; //< [0, 256] as [0, 1]
+
+    inline static constexpr const decay_type DecayOne{ 256 };
+
+    //--------------------------------------------------------------------------
+
+    [[nodiscard]]
+    constexpr decay_type to_decay(float fDecay) noexcept {
+        // Written so NaN gives no trail at all
+        if (!(fDecay > 0.f)) { return 0; }
+        if (fDecay >= 1.f)   { return DecayOne; }
+        return static_cast<decay_type>(fDecay * DecayOne + .5f);
+    }
+
+    //--------------------------------------------------------------------------
+
+    namespace detail {
+        inline static constexpr const size_type Shifts[]{ 0, 8, 16, 24 };
+
+        [[nodiscard]]
+        constexpr std::uint32_t channel(pixel_type pixel, size_type shift) noexcept {
+            return (pixel >> shift) & 0xFFu;
+        }
+
+        // `x / 255` rounded to nearest, for `x` in [0, 255 * 255]
+        [[nodiscard]]
+        constexpr std::uint32_t div255(std::uint32_t x) noexcept {
+            x += 128;
+            return (x + (x >> 8)) >> 8;
+        }
+
+        // Per channel (byte) saturating add and maximum, four
+        // channels at once without carries between them
+        [[nodiscard]]
+        constexpr pixel_type adds(pixel_type a, pixel_type b) noexcept {
+            const pixel_type sum  { (a & 0x7F7F7F7Fu) + (b & 0x7F7F7F7Fu) };
+            const pixel_type carry{ ((a & b) | ((a ^ b) & sum)) & 0x80808080u };
+            return (sum ^ ((a ^ b) & 0x80808080u)) | ((carry >> 7) * 0xFFu);
+        }
+
+        [[nodiscard]]
+        constexpr pixel_type max(pixel_type a, pixel_type b) noexcept {
+            // Top bit of each channel set where `a >= b`
+            const pixel_type diff{ (a | 0x80808080u) - (b & 0x7F7F7F7Fu) };
+            const pixel_type ge  { ((a & ~b) | (~(a ^ b) & diff)) & 0x80808080u };
+            const pixel_type mask{ (ge >> 7) * 0xFFu };
+            return (a & mask) | (b & ~mask);
+        }
+
+        [[nodiscard]]
+        constexpr pixel_type blend(pixel_type src, pixel_type dst) noexcept {
+            const auto a{ src >> 24 };
+            if (a == 255) { return src; }
+            if (a == 0)   { return dst; }
+
+            pixel_type out{ 0 };
+            for (const auto shift : Shifts) {
+                out |= div255(channel(src, shift) * a + channel(dst, shift) * (255 - a)) << shift;
+            }
+            return out;
+        }
+
+        [[nodiscard]]
+        constexpr pixel_type accumulate(mode eMode,
+                                        pixel_type src,
+                                        pixel_type history,
+                                        decay_type decay) noexcept {
+            // Two channels per multiply (`decay` is at most 256,
+            // so neither product spills into the next channel)
+            const pixel_type decayed{ ((((history & 0x00FF00FFu) * decay) >> 8) & 0x00FF00FFu) |
+                                      ((((history >> 8) & 0x00FF00FFu) * decay) & 0xFF00FF00u) };
+            switch (eMode) {
+                case mode::max: return max(src, decayed);
+                case mode::add: return adds(src, decayed);
+                case mode::blend:
+                default:        return blend(src, decayed);
+            }
+        }
+
+        [[nodiscard]]
+        constexpr pixel_type composite(pixel_type history, pixel_type dst) noexcept {
+            if (history == 0)           { return dst; }
+            if ((history >> 24) == 255) { return history; }
+
+            const auto ia{ 255 - (history >> 24) };
+            pixel_type out{ 0 };
+            for (const auto shift : Shifts) {
+                const auto c{ channel(history, shift) + div255(channel(dst, shift) * ia) };
+                out |= std::min(c, 255u) << shift;
+            }
+            return out;
+        }
+
+#ifdef foo_logitech_lcd_PERSISTENCE_SSE2
+        //----------------------------------------------------------------------
+        // SSE2: each 4 pixels as two halves of 8 16-bit channels
+
+        // Each pixel's alpha in all four of its channels
+        inline __m128i alpha16(__m128i c16) noexcept {
+            c16 = _mm_shufflelo_epi16(c16, _MM_SHUFFLE(3, 3, 3, 3));
+            return _mm_shufflehi_epi16(c16, _MM_SHUFFLE(3, 3, 3, 3));
+        }
+
+        inline __m128i div255(__m128i x16) noexcept {
+            x16 = _mm_add_epi16(x16, _mm_set1_epi16(128));
+            return _mm_srli_epi16(_mm_add_epi16(x16, _mm_srli_epi16(x16, 8)), 8);
+        }
+
+        // Sums of products are at most 255 * 255, so fit 16 bits unsigned
+        inline __m128i blend16(__m128i s16, __m128i d16) noexcept {
+            const auto a16 { alpha16(s16) };
+            const auto ia16{ _mm_sub_epi16(_mm_set1_epi16(255), a16) };
+            return div255(_mm_add_epi16(_mm_mullo_epi16(s16, a16),
+                                        _mm_mullo_epi16(d16, ia16)));
+        }
+
+        inline __m128i blend4(__m128i src, __m128i dst) noexcept {
+            const auto zero{ _mm_setzero_si128() };
+
+            // OpenGL frames are nearly all opaque or clear pixels,
+            // which select without any arithmetic
+            const auto alpha { _mm_srai_epi32(src, 24) }; //< -1 when opaque
+            const auto opaque{ _mm_cmpeq_epi32(alpha, _mm_set1_epi32(-1)) };
+            const auto clear { _mm_cmpeq_epi32(alpha, zero) };
+            if (_mm_movemask_epi8(_mm_or_si128(opaque, clear)) == 0xFFFF) {
+                return _mm_or_si128(_mm_and_si128(opaque, src),
+                                    _mm_andnot_si128(opaque, dst));
+            }
+
+            return _mm_packus_epi16(blend16(_mm_unpacklo_epi8(src, zero), _mm_unpacklo_epi8(dst, zero)),
+                                    blend16(_mm_unpackhi_epi8(src, zero), _mm_unpackhi_epi8(dst, zero)));
+        }
+
+        inline __m128i decay4(__m128i history, __m128i decay16) noexcept {
+            const auto zero{ _mm_setzero_si128() };
+            const auto lo{ _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(history, zero), decay16), 8) };
+            const auto hi{ _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(history, zero), decay16), 8) };
+            return _mm_packus_epi16(lo, hi);
+        }
+
+        inline __m128i composite4(__m128i history, __m128i dst) noexcept {
+            const auto zero { _mm_setzero_si128() };
+
+            // Trails fade to nothing, so most of the history is
+            // empty (or, under fresh drawing, opaque)
+            const auto opaque{ _mm_cmpeq_epi32(_mm_srai_epi32(history, 24), _mm_set1_epi32(-1)) };
+            const auto empty { _mm_cmpeq_epi32(history, zero) };
+            if (_mm_movemask_epi8(_mm_or_si128(opaque, empty)) == 0xFFFF) {
+                return _mm_or_si128(_mm_and_si128(opaque, history),
+                                    _mm_andnot_si128(opaque, dst));
+            }
+
+            const auto max16{ _mm_set1_epi16(255) };
+            const auto h_lo { _mm_unpacklo_epi8(history, zero) };
+            const auto h_hi { _mm_unpackhi_epi8(history, zero) };
+            const auto lo{ div255(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero),
+                                                  _mm_sub_epi16(max16, alpha16(h_lo)))) };
+            const auto hi{ div255(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero),
+                                                  _mm_sub_epi16(max16, alpha16(h_hi)))) };
+            return _mm_adds_epu8(history, _mm_packus_epi16(lo, hi));
+        }
+
+        inline __m128i load4(const pixel_type* src) noexcept {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        }
+
+        inline void store4(pixel_type* dst, __m128i pixels) noexcept {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), pixels);
+        }
+#endif // #ifdef foo_logitech_lcd_PERSISTENCE_SSE2
+    } // namespace detail
+
+    //--------------------------------------------------------------------------
+    // `dst = src over dst`
+    inline void blend(const pixel_type* src,
+                      pixel_type* dst,
+                      size_type count) noexcept {
+        size_type i{ 0 };
+#ifdef foo_logitech_lcd_PERSISTENCE_SSE2
+        for (; i + 4 <= count; i += 4) {
+            detail::store4(dst + i, detail::blend4(detail::load4(src + i),
+                                                   detail::load4(dst + i)));
+        }
+#endif
+        for (; i < count; ++i) {
+            dst[i] = detail::blend(src[i], dst[i]);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // `history = decay * history` combined with `src` by `eMode`
+    inline void accumulate(mode eMode,
+                           const pixel_type* src,
+                           pixel_type* history,
+                           size_type count,
+                           decay_type decay) noexcept {
+        decay = std::min(decay, DecayOne);
+        size_type i{ 0 };
+#ifdef foo_logitech_lcd_PERSISTENCE_SSE2
+        const auto decay16{ _mm_set1_epi16(static_cast<short>(decay)) };
+        switch (eMode) {
+            case mode::blend:
+                for (; i + 4 <= count; i += 4) {
+                    const auto decayed{ detail::decay4(detail::load4(history + i), decay16) };
+                    detail::store4(history + i, detail::blend4(detail::load4(src + i), decayed));
+                }
+                break;
+            case mode::max:
+                for (; i + 4 <= count; i += 4) {
+                    const auto decayed{ detail::decay4(detail::load4(history + i), decay16) };
+                    detail::store4(history + i, _mm_max_epu8(detail::load4(src + i), decayed));
+                }
+                break;
+            case mode::add:
+                for (; i + 4 <= count; i += 4) {
+                    const auto decayed{ detail::decay4(detail::load4(history + i), decay16) };
+                    detail::store4(history + i, _mm_adds_epu8(detail::load4(src + i), decayed));
+                }
+                break;
+        }
+#endif
+        for (; i < count; ++i) {
+            history[i] = detail::accumulate(eMode, src[i], history[i], decay);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // `dst = history over dst`
+    inline void composite(const pixel_type* history,
+                          pixel_type* dst,
+                          size_type count) noexcept {
+        size_type i{ 0 };
+#ifdef foo_logitech_lcd_PERSISTENCE_SSE2
+        for (; i + 4 <= count; i += 4) {
+            detail::store4(dst + i, detail::composite4(detail::load4(history + i),
+                                                       detail::load4(dst + i)));
+        }
+#endif
+        for (; i < count; ++i) {
+            dst[i] = detail::composite(history[i], dst[i]);
+        }
+    }
+} // namespace util::persistence
+
+#endif // GUID_AB7E47DD_C284_44B6_989D_5E33F94C5474
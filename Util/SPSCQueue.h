@@ -0,0 +1,129 @@
+#pragma once
+#ifndef GUID_0B2F5791_7949_462E_A1F6_DF32D9586626
+#define GUID_0B2F5791_7949_462E_A1F6_DF32D9586626
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include <atomic>
+#include <array>
+#include <utility>
+#include <type_traits>
+#include <cassert>
+//--------------------------------------
+
+namespace util {
+    //**************************************************************************
+    // spsc_queue:
+    // -----------
+    //
+    // Fixed capacity, lock-free, single-producer/single-consumer queue.
+    //
+    // Exactly one thread may push and exactly one (other) thread may pop;
+    // no locks are taken and neither side will ever block. Capacity must be
+    // a power of two.
+    //
+    // NOTE:
+    //  - Indices are free running and masked on access, so the full
+    //    capacity is usable (no "wasted" slot to distinguish full/empty).
+    //  - Head and tail live on separate cache lines to avoid the producer
+    //    and consumer invalidating each other on every operation.
+    //**************************************************************************
+    template <
+        typename TypeT,
+        std::size_t CapacityT
+    >
+    class spsc_queue final {
+    private:
+        using this_type = spsc_queue<TypeT, CapacityT>;
+
+        static_assert(CapacityT >= 2 && (CapacityT & (CapacityT - 1)) == 0,
+                      "spsc_queue capacity must be a power of two");
+        static_assert(std::is_nothrow_move_assignable_v<TypeT>,
+                      "spsc_queue requires a no-throw move assignable type");
+
+        inline static constexpr std::size_t CacheLineSize{ 64 };
+
+    public:
+        using value_type = TypeT;
+        using size_type  = std::size_t;
+
+        inline static constexpr const size_type Capacity{ CapacityT };
+
+    private:
+        inline static constexpr const size_type IndexMask{ CapacityT - 1 };
+
+    public:
+        spsc_queue() noexcept = default;
+
+        spsc_queue(const this_type& )           = delete; // No Copy
+        spsc_queue(      this_type&&)           = delete; // No Move
+        this_type& operator=(const this_type& ) = delete; // No Copy
+        this_type& operator=(      this_type&&) = delete; // No Move
+
+    public: // Producer
+        [[nodiscard]]
+        bool try_push(value_type value) noexcept {
+            const auto tail{ m_Tail.load(std::memory_order_relaxed) };
+            const auto head{ m_Head.load(std::memory_order_acquire) };
+            if ((tail - head) >= Capacity) { return false; }
+            m_Buffer[tail & IndexMask] = std::move(value);
+            m_Tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+    public: // Consumer
+        [[nodiscard]]
+        bool try_pop(value_type& value) noexcept {
+            const auto head{ m_Head.load(std::memory_order_relaxed) };
+            const auto tail{ m_Tail.load(std::memory_order_acquire) };
+            if (head == tail) { return false; }
+            value = std::move(m_Buffer[head & IndexMask]);
+            m_Head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+    public: // Either (result is only a snapshot)
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return m_Head.load(std::memory_order_acquire) ==
+                   m_Tail.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]]
+        size_type size() const noexcept {
+            const auto head{ m_Head.load(std::memory_order_acquire) };
+            const auto tail{ m_Tail.load(std::memory_order_acquire) };
+            return tail - head;
+        }
+
+        [[nodiscard]]
+        static constexpr size_type capacity() noexcept { return Capacity; }
+
+    private:
+        alignas(CacheLineSize) std::atomic<size_type> m_Head{ 0 }; //< Written by consumer
+        alignas(CacheLineSize) std::atomic<size_type> m_Tail{ 0 }; //< Written by producer
+        alignas(CacheLineSize) std::array<value_type, CapacityT> m_Buffer{};
+    }; // template <...> class spsc_queue final
+} // namespace util
+
+#endif // GUID_0B2F5791_7949_462E_A1F6_DF32D9586626
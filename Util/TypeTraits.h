@@ -24,6 +24,7 @@
 
 //--------------------------------------
 //
+#include <cstdint>
 #include <type_traits>
 //--------------------------------------
 
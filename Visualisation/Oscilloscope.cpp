@@ -29,6 +29,7 @@
 //
 #include "Visualisation/Oscilloscope_Basic.h"
 #include "Visualisation/Oscilloscope_Radial.h"
+#include "Visualisation/Oscilloscope_Goniometer.h"
 //--------------------------------------
 
 //--------------------------------------
@@ -58,6 +59,8 @@ namespace Visualisation::Oscilloscope {
                     return std::make_shared<Radial::CircleMono>(config, dim);
                 case OscilloscopeType::StarBurstMono:
                     return std::make_shared<Radial::StarBurstMono>(config, dim);
+                case OscilloscopeType::GoniometerStereo:
+                    return std::make_shared<GoniometerStereo>(config, dim);
             }
         } else {
             switch (eType) {
@@ -73,6 +76,8 @@ namespace Visualisation::Oscilloscope {
                     return std::make_shared<Radial::CircleMonoGradient>(config, dim);
                 case OscilloscopeType::StarBurstMono:
                     return std::make_shared<Radial::StarBurstMonoGradient>(config, dim);
+                case OscilloscopeType::GoniometerStereo:
+                    return std::make_shared<GoniometerStereoGradient>(config, dim);
             }
         }
         return pointer_type{};
@@ -75,6 +75,16 @@ namespace Visualisation::Oscilloscope {
     protected:
         constexpr auto& Config() const noexcept { return m_Config; }
 
+        constexpr auto Trigger() const noexcept {
+            using trigger_mode = typename WaveformParams::trigger_mode;
+            switch (Config().m_eTrigger) {
+                case OscilloscopeTrigger::RisingEdge: return trigger_mode::RisingEdge;
+                case OscilloscopeTrigger::PeriodLock: return trigger_mode::PeriodLock;
+                case OscilloscopeTrigger::Off:
+                default:                              return trigger_mode::None;
+            }
+        }
+
     private:
         config_type m_Config{};
     }; // IOscilloscope
@@ -41,6 +41,7 @@
 //
 #include "GL/glcommon.h"
 #include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
 //--------------------------------------
 
 namespace Visualisation::Oscilloscope::detail {
@@ -51,6 +52,8 @@ namespace Visualisation::Oscilloscope::detail {
                                const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::CombinedWaveform;
         params.Waveform.nSampleCountHint = GetDimensions().cx;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -66,17 +69,20 @@ namespace Visualisation::Oscilloscope::detail {
         if (ePass != RenderPass::OpenGL) { return; }
         assert(mode == GL_POINTS || mode == GL_LINE_STRIP);
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
         ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
         ::OpenGL::glScopedSetPointSize _pointSize{ Config().m_fPointSize };
+        const ::OpenGL::glScopedBatchFlush _flush{ batch };
         {
             const auto samples = AudioDataManager.GetWaveform(fInterp);
-            const ::OpenGL::glScopedBegin _begin{ mode };
             Util::Draw(
+                mode, Config().m_bEnvelope,
                 samples, canvasSize, Config().m_fScale,
-                [](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                    ::glVertex2i(nX, nY);
+                [&batch](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                    batch.vertex(nX, nY);
                     return nX + 1;
                 }
             );
@@ -90,6 +96,8 @@ namespace Visualisation::Oscilloscope::detail {
                                        const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::CombinedWaveform;
         params.Waveform.nSampleCountHint = GetDimensions().cx;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
 
         using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
 
@@ -108,6 +116,8 @@ namespace Visualisation::Oscilloscope::detail {
         if (ePass != RenderPass::OpenGL) { return; }
         assert(mode == GL_POINTS || mode == GL_LINE_STRIP);
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
         using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
@@ -116,17 +126,18 @@ namespace Visualisation::Oscilloscope::detail {
 
         ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
         ::OpenGL::glScopedSetPointSize _pointSize{ Config().m_fPointSize };
+        const ::OpenGL::glScopedBatchFlush _flush{ batch };
         {
             const auto samples = AudioDataManager.GetWaveform(fInterp);
-            const ::OpenGL::glScopedBegin _begin{ mode };
             Util::Draw(
+                mode, Config().m_bEnvelope,
                 samples, canvasSize, Config().m_fScale,
                 [
-                    color0, color1
+                    &batch, color0, color1
                 ] (auto fSample, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
                     const auto colorBlend = ::Color::ColorBlend(color0, color1, fSample);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nX, nY);
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nX, nY);
                     return nX + 1;
                 }
             );
@@ -140,6 +151,8 @@ namespace Visualisation::Oscilloscope::detail {
                                  const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::Waveform;
         params.Waveform.nSampleCountHint = GetDimensions().cx / 2;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -155,18 +168,21 @@ namespace Visualisation::Oscilloscope::detail {
         if (ePass != RenderPass::OpenGL) { return; }
         assert(mode == GL_POINTS || mode == GL_LINE_STRIP);
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         const auto nWidth = canvasSize.cx;
 
         ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
         ::OpenGL::glScopedSetPointSize _pointSize{ Config().m_fPointSize };
+        const ::OpenGL::glScopedBatchFlush _flush{ batch };
         {
             const auto samplesL = AudioDataManager.GetWaveform(Audio::Channel::Left, fInterp);
-            const ::OpenGL::glScopedBegin _begin{ mode };
             Util::Draw(
+                mode, Config().m_bEnvelope,
                 samplesL, canvasSize, Config().m_fScale,
-                [](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                    ::glVertex2i(nX, nY);
+                [&batch](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                    batch.vertex(nX, nY);
                     return nX + 1;
                 }
             );
@@ -174,13 +190,13 @@ namespace Visualisation::Oscilloscope::detail {
 
         {
             const auto samplesR = AudioDataManager.GetWaveform(Audio::Channel::Right, fInterp);
-            const ::OpenGL::glScopedBegin _begin{ mode };
             Util::Draw(
+                mode, Config().m_bEnvelope,
                 samplesR, canvasSize, Config().m_fScale,
                 [
-                    nWidth
+                    &batch, nWidth
                 ] (auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                    ::glVertex2i(nWidth - nX, nY);
+                    batch.vertex(nWidth - nX, nY);
                     return nX + 1;
                 }
             );
@@ -194,6 +210,8 @@ namespace Visualisation::Oscilloscope::detail {
                                          const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::Waveform;
         params.Waveform.nSampleCountHint = GetDimensions().cx / 2;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -209,6 +227,8 @@ namespace Visualisation::Oscilloscope::detail {
         if (ePass != RenderPass::OpenGL) { return; }
         assert(mode == GL_POINTS || mode == GL_LINE_STRIP);
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         const auto nWidth = canvasSize.cx;
 
@@ -218,17 +238,18 @@ namespace Visualisation::Oscilloscope::detail {
 
         ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
         ::OpenGL::glScopedSetPointSize _pointSize{ Config().m_fPointSize };
+        const ::OpenGL::glScopedBatchFlush _flush{ batch };
         {
             const auto samplesL = AudioDataManager.GetWaveform(Audio::Channel::Left, fInterp);
-            const ::OpenGL::glScopedBegin _begin{ mode };
             Util::Draw(
+                mode, Config().m_bEnvelope,
                 samplesL, canvasSize, Config().m_fScale,
                 [
-                    color0, color1
+                    &batch, color0, color1
                 ] (auto fSample, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
                     const auto colorBlend = ::Color::ColorBlend(color0, color1, fSample);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nX, nY);
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nX, nY);
                     return nX + 1;
                 }
             );
@@ -236,15 +257,15 @@ namespace Visualisation::Oscilloscope::detail {
 
         {
             const auto samplesR = AudioDataManager.GetWaveform(Audio::Channel::Right, fInterp);
-            const ::OpenGL::glScopedBegin _begin{ mode };
             Util::Draw(
+                mode, Config().m_bEnvelope,
                 samplesR, canvasSize, Config().m_fScale,
                 [
-                    nWidth, color0, color1
+                    &batch, nWidth, color0, color1
                 ] (auto fSample, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
                     const auto colorBlend = ::Color::ColorBlend(color0, color1, fSample);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nWidth - nX, nY);
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nWidth - nX, nY);
                     return nX + 1;
                 }
             );
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "Visualisation/Oscilloscope_Goniometer.h"
+#include "Visualisation/Oscilloscope_Util.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Audio_DataManager.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "ColorPacker.h"
+#include "ColorBlend.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
+//--------------------------------------
+
+namespace Visualisation::Oscilloscope::detail {
+    //**************************************************************************
+    // Goniometer
+    //**************************************************************************
+    void Goniometer::Activate(request_param_type& params,
+                              const audio_data_manager_type& /*AudioDataManager*/) noexcept {
+        params.Want = request_param_type::want_type::Waveform |
+                      request_param_type::want_type::Correlation;
+        params.Waveform.nSampleCountHint = PointCount;
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
+                                               params.PrimaryColor);
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
+                                               params.ClearColor);
+
+        for (auto& trail : m_Trail) {
+            trail.clear();
+            trail.reserve(PointCount);
+        }
+        m_nTrailNext = 0;
+        m_nLastFrame = 0;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Goniometer::UpdateTrail(const audio_data_manager_type& AudioDataManager,
+                                 const dimensions_type& plotSize,
+                                 float /*fInterp*/) {
+        // One trail per analysis update, however often drawn:
+        // render may run faster than analysis, and rebuilding
+        // the oldest slot with unchanged data would lose it
+        const auto nFrame{ static_cast<std::int64_t>(AudioDataManager.GetFrameTimestamp()) };
+        if (nFrame == m_nLastFrame) { return; }
+        m_nLastFrame = nFrame;
+
+        // Blending two blocks of audio doesn't give a
+        // meaningful stereo field, so always use the newest
+        constexpr const float fNewest{ 1.f };
+        const auto samplesL = AudioDataManager.GetWaveform(Audio::Channel::Left,  fNewest);
+        const auto samplesR = AudioDataManager.GetWaveform(Audio::Channel::Right, fNewest);
+
+        // Plot sits above the meter
+        const auto nHalfWidth  = plotSize.cx / 2;
+        const auto nHalfHeight = MeterHeight() + plotSize.cy / 2;
+
+        auto& trail{ m_Trail[m_nTrailNext] };
+        trail.clear();
+        Util::DrawLissajous(
+            samplesL, samplesR, plotSize, Config().m_fScale,
+            [
+                &trail, nHalfWidth, nHalfHeight
+            ] (auto fX, auto fY) noexcept -> void {
+                trail.push_back({ nHalfWidth  + static_cast<coord_type>(fX),
+                                  nHalfHeight + static_cast<coord_type>(fY) });
+            }
+        );
+        m_nTrailNext = (m_nTrailNext + 1) % TrailCount;
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Goniometer::DrawMeter(const audio_data_manager_type& AudioDataManager,
+                               float fInterp,
+                               const color_type& negativeColor) const {
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
+        const auto canvasSize  = GetDimensions();
+        const auto nMeterTop   = MeterHeight();
+        const auto nMeterBot   = 0;
+        const auto nHalfWidth  = canvasSize.cx / 2;
+        const auto fCorrelation{ AudioDataManager.GetCorrelation(fInterp) };
+        const auto nX = nHalfWidth + static_cast<coord_type>(std::round(fCorrelation * static_cast<float>(nHalfWidth - 1)));
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        const auto primary{ ColorUnpacker::Unpack<color_type>(Config().m_Color.m_Palette.Primary) };
+        const auto bar{ ::Color::ColorBlend(negativeColor, primary, fCorrelation * .5f + .5f) };
+
+        // Bar from the centre (0) towards -1 (left) or +1 (right)
+        {
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
+            batch.color(bar.r(), bar.g(), bar.b());
+            batch.vertex(std::min(nHalfWidth, nX)    , nMeterTop - 1);
+            batch.vertex(std::max(nHalfWidth, nX) + 1, nMeterTop - 1);
+            batch.vertex(std::max(nHalfWidth, nX) + 1, nMeterBot);
+            batch.vertex(std::min(nHalfWidth, nX)    , nMeterBot);
+        }
+
+        // Scale: baseline plus -1, 0 and +1 ticks
+        {
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
+            batch.color(primary.r(), primary.g(), primary.b());
+            batch.vertex(0             , nMeterTop);
+            batch.vertex(canvasSize.cx , nMeterTop);
+            for (const auto nTick : { 0, nHalfWidth, canvasSize.cx - 1 }) {
+                batch.vertex(nTick, nMeterTop);
+                batch.vertex(nTick, nMeterBot);
+            }
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Goniometer::Draw(render_pass_type ePass,
+                          const audio_data_manager_type& AudioDataManager,
+                          float fInterp,
+                          const color_type& trailColor,
+                          const color_type& negativeColor) {
+        if (ePass != RenderPass::OpenGL) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
+        const auto canvasSize = GetDimensions();
+        const dimensions_type plotSize{ canvasSize.cx, canvasSize.cy - MeterHeight() };
+
+        UpdateTrail(AudioDataManager, plotSize, fInterp);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        const auto primary{ ColorUnpacker::Unpack<color_type>(Config().m_Color.m_Palette.Primary) };
+
+        // Oldest first so newer points overdraw
+        {
+            const ::OpenGL::glScopedSetPointSize _pointSize{ Config().m_fPointSize };
+            const ::OpenGL::glScopedBatchFlush _flush{ batch };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_POINTS };
+            for (size_type age = TrailCount; age > 0; --age) {
+                const auto& trail{ m_Trail[(m_nTrailNext + TrailCount - age) % TrailCount] };
+                if (trail.empty()) { continue; }
+                const auto fBlend{ static_cast<float>(TrailCount - age + 1) / static_cast<float>(TrailCount) };
+                const auto color{ ::Color::ColorBlend(trailColor, primary, fBlend) };
+                batch.color(color.r(), color.g(), color.b());
+                for (const auto& point : trail) { batch.vertex(point.x, point.y); }
+            }
+        }
+
+        DrawMeter(AudioDataManager, fInterp, negativeColor);
+    }
+} // namespace Visualisation::Oscilloscope::detail
+
+//==============================================================================
+
+namespace Visualisation::Oscilloscope {
+    //**************************************************************************
+    // GoniometerStereo
+    //**************************************************************************
+    void GoniometerStereo::Draw(render_pass_type ePass,
+                                const audio_data_manager_type& AudioDataManager,
+                                float fInterp) {
+        // Trails fade into the background
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        const auto background{ ColorUnpacker::Unpack<color_type>(Config().m_Color.m_Palette.Background) };
+        const auto primary   { ColorUnpacker::Unpack<color_type>(Config().m_Color.m_Palette.Primary) };
+        base_class::Draw(ePass, AudioDataManager, fInterp,
+                         background, primary);
+    }
+
+    //**************************************************************************
+    // GoniometerStereoGradient
+    //**************************************************************************
+    void GoniometerStereoGradient::Draw(render_pass_type ePass,
+                                        const audio_data_manager_type& AudioDataManager,
+                                        float fInterp) {
+        // Trails (and negative correlation) in the secondary colour
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        const auto secondary{ ColorUnpacker::Unpack<color_type>(Config().m_Color.m_Palette.Secondary) };
+        base_class::Draw(ePass, AudioDataManager, fInterp,
+                         secondary, secondary);
+    }
+} // namespace Visualisation::Oscilloscope
@@ -0,0 +1,160 @@
+#pragma once
+#ifndef GUID_61A4E337_16F4_40D4_AF2D_B8B35E6F7339
+#define GUID_61A4E337_16F4_40D4_AF2D_B8B35E6F7339
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Visualisation/Oscilloscope.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Color.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+//--------------------------------------
+
+namespace Visualisation::Oscilloscope::detail {
+    //**************************************************************************
+    // Goniometer
+    //**************************************************************************
+    //
+    // Stereo field (mid vertical, side horizontal) as a
+    // point cloud, above a phase correlation meter.
+    //
+    // Persistence comes from a ring of the last
+    // `TrailCount` point sets, redrawn oldest first in
+    // colours stepping towards the primary colour; only
+    // the points are redrawn, so there is no full frame
+    // blend or read back.
+    class Goniometer : public IOscilloscope {
+    private:
+        using base_class = IOscilloscope;
+        using this_class = Goniometer;
+
+    public:
+        using color_type = ::Color::Color3f;
+
+        inline static constexpr const size_type TrailCount{ 4 };
+        inline static constexpr const size_type PointCount{ 512 };
+
+    public:
+        using base_class::base_class;
+
+        virtual void Activate(request_param_type& params,
+                              const audio_data_manager_type& AudioDataManager) noexcept override;
+
+    protected:
+        // Trails fade from `trailColor` (oldest) to the
+        // primary colour; the meter bar blends from
+        // `negativeColor` at -1 to the primary colour at +1.
+        void Draw(render_pass_type ePass,
+                  const audio_data_manager_type& AudioDataManager,
+                  float fInterp,
+                  const color_type& trailColor,
+                  const color_type& negativeColor);
+
+    private:
+        struct point_type final {
+            coord_type x{ 0 };
+            coord_type y{ 0 };
+        };
+        using point_buffer_type = std::vector<point_type>;
+
+        void UpdateTrail(const audio_data_manager_type& AudioDataManager,
+                         const dimensions_type& plotSize,
+                         float fInterp);
+
+        void DrawMeter(const audio_data_manager_type& AudioDataManager,
+                       float fInterp,
+                       const color_type& negativeColor) const;
+
+        [[nodiscard]]
+        auto MeterHeight() const noexcept {
+            return std::max<coord_type>(GetDimensions().cy / 12, 4);
+        }
+
+    private:
+        std::array<point_buffer_type, TrailCount> m_Trail     {};
+        size_type                                 m_nTrailNext{ 0 }; //< Slot to overwrite (oldest)
+        std::int64_t                              m_nLastFrame{ 0 }; //< `GetFrameTimestamp` of newest trail
+    }; // class Goniometer
+} // namespace Visualisation::Oscilloscope::detail
+
+//==============================================================================
+
+namespace Visualisation::Oscilloscope {
+    //**************************************************************************
+    // GoniometerStereo
+    //**************************************************************************
+    class GoniometerStereo final : public detail::Goniometer {
+    private:
+        using base_class = detail::Goniometer;
+        using this_class = GoniometerStereo;
+
+    public:
+        static constexpr auto Type() noexcept {
+            return visualisation_type::GoniometerStereo;
+        }
+
+    public:
+        GoniometerStereo(const config_type& config,
+                         const dimensions_type& dim) noexcept :
+            base_class{ Type(), config, dim } {};
+
+        virtual void Draw(render_pass_type ePass,
+                          const audio_data_manager_type& AudioDataManager,
+                          float fInterp) override;
+    }; // class GoniometerStereo final
+
+    //**************************************************************************
+    // GoniometerStereoGradient
+    //**************************************************************************
+    class GoniometerStereoGradient final : public detail::Goniometer {
+    private:
+        using base_class = detail::Goniometer;
+        using this_class = GoniometerStereoGradient;
+
+    public:
+        static constexpr auto Type() noexcept {
+            return visualisation_type::GoniometerStereo;
+        }
+
+    public:
+        GoniometerStereoGradient(const config_type& config,
+                                 const dimensions_type& dim) noexcept :
+            base_class{ Type(), config, dim } {};
+
+        virtual void Draw(render_pass_type ePass,
+                          const audio_data_manager_type& AudioDataManager,
+                          float fInterp) override;
+    }; // class GoniometerStereoGradient final
+} // namespace Visualisation::Oscilloscope
+
+#endif // GUID_61A4E337_16F4_40D4_AF2D_B8B35E6F7339
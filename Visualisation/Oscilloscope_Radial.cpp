@@ -41,6 +41,7 @@
 //
 #include "GL/glcommon.h"
 #include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
 //--------------------------------------
 
 namespace Visualisation::Oscilloscope::Radial {
@@ -51,6 +52,8 @@ namespace Visualisation::Oscilloscope::Radial {
                               const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::CombinedWaveform;
         params.Waveform.nSampleCountHint = Util::RadialSampleCount;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -64,6 +67,8 @@ namespace Visualisation::Oscilloscope::Radial {
                           float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         const auto nHalfWidth = canvasSize.cx / 2;
         const auto nHalfHeight = canvasSize.cy / 2;
@@ -84,15 +89,16 @@ namespace Visualisation::Oscilloscope::Radial {
         {
             const auto samples = AudioDataManager.GetWaveform(fInterp);
             const ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
-            const ::OpenGL::glScopedBegin _begin{ GL_LINE_LOOP };
+            const ::OpenGL::glScopedBatchFlush _flush{ batch };
             Util::DrawRadial(
+                GL_LINE_LOOP, Config().m_bEnvelope,
                 samples, canvasSize, Config().m_fScale,
                 [
-                    nHalfWidth, nHalfHeight, fRadiusOffset, fRadiusFactor
+                    &batch, nHalfWidth, nHalfHeight, fRadiusOffset, fRadiusFactor
                 ] (auto fSample, auto fX, auto fY) constexpr noexcept -> void {
                     const auto nX = nHalfWidth + static_cast<coord_type>(fX * fRadiusOffset + fX * fRadiusFactor * fSample);
                     const auto nY = nHalfHeight + static_cast<coord_type>(fY * fRadiusOffset + fY * fRadiusFactor * fSample);
-                    ::glVertex2i(nX, nY);
+                    batch.vertex(nX, nY);
                 }
             );
         }
@@ -105,6 +111,8 @@ namespace Visualisation::Oscilloscope::Radial {
                                       const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::CombinedWaveform;
         params.Waveform.nSampleCountHint = Util::RadialSampleCount;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -118,6 +126,8 @@ namespace Visualisation::Oscilloscope::Radial {
                                   float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         const auto nHalfWidth = canvasSize.cx / 2;
         const auto nHalfHeight = canvasSize.cy / 2;
@@ -142,17 +152,18 @@ namespace Visualisation::Oscilloscope::Radial {
         {
             const auto samples = AudioDataManager.GetWaveform(fInterp);
             const ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
-            const ::OpenGL::glScopedBegin _begin{ GL_LINE_LOOP };
+            const ::OpenGL::glScopedBatchFlush _flush{ batch };
             Util::DrawRadial(
+                GL_LINE_LOOP, Config().m_bEnvelope,
                 samples, canvasSize, Config().m_fScale,
                 [
-                    nHalfWidth, nHalfHeight, fRadiusOffset, fRadiusFactor, color0, color1
+                    &batch, nHalfWidth, nHalfHeight, fRadiusOffset, fRadiusFactor, color0, color1
                 ] (auto fSample, auto fX, auto fY) constexpr noexcept -> void {
                     const auto nX = nHalfWidth + static_cast<coord_type>(fX * fRadiusOffset + fX * fRadiusFactor * fSample);
                     const auto nY = nHalfHeight + static_cast<coord_type>(fY * fRadiusOffset + fY * fRadiusFactor * fSample);
                     const auto colorBlend = ::Color::ColorBlend(color0, color1, (fSample * 4.0f) * 0.5f + 0.5f);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nX, nY);
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nX, nY);
                 }
             );
         }
@@ -165,6 +176,8 @@ namespace Visualisation::Oscilloscope::Radial {
                                  const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::CombinedWaveform;
         params.Waveform.nSampleCountHint = Util::RadialSampleCount;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -178,24 +191,30 @@ namespace Visualisation::Oscilloscope::Radial {
                              float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         const auto nHalfWidth = canvasSize.cx / 2;
         const auto nHalfHeight = canvasSize.cy / 2;
 
         {
-            const auto samples = AudioDataManager.GetWaveform(fInterp);
+            // Envelope data: burst to the larger extreme
+            const auto samples = Config().m_bEnvelope
+                               ? Util::EnvelopePeaks(AudioDataManager.GetWaveform(fInterp))
+                               : AudioDataManager.GetWaveform(fInterp);
             {
                 const ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchFlush _flush{ batch };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::DrawRadial(
                     samples, canvasSize, 2.f * Config().m_fScale,
                     [
-                        nHalfWidth, nHalfHeight
+                        &batch, nHalfWidth, nHalfHeight
                     ] (auto fSample, auto fX, auto fY) constexpr noexcept -> void {
                         const auto nX = nHalfWidth + static_cast<coord_type>(fX * fSample);
                         const auto nY = nHalfHeight + static_cast<coord_type>(fY * fSample);
-                        ::glVertex2i(nHalfWidth, nHalfHeight);
-                        ::glVertex2i(nX, nY);
+                        batch.vertex(nHalfWidth, nHalfHeight);
+                        batch.vertex(nX, nY);
                     }
                 );
             }
@@ -209,6 +228,8 @@ namespace Visualisation::Oscilloscope::Radial {
                                          const audio_data_manager_type& /*AudioDataManager*/) noexcept {
         params.Want = request_param_type::want_type::CombinedWaveform;
         params.Waveform.nSampleCountHint = Util::RadialSampleCount;
+        params.Waveform.bEnvelope = Config().m_bEnvelope;
+        params.Waveform.eTrigger  = Trigger();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -222,6 +243,8 @@ namespace Visualisation::Oscilloscope::Radial {
                                      float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         const auto nHalfWidth = canvasSize.cx / 2;
         const auto nHalfHeight = canvasSize.cy / 2;
@@ -231,38 +254,43 @@ namespace Visualisation::Oscilloscope::Radial {
         const auto color1{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
 
         {
-            const auto samples = AudioDataManager.GetWaveform(fInterp);
+            // Envelope data: burst to the larger extreme
+            const auto samples = Config().m_bEnvelope
+                               ? Util::EnvelopePeaks(AudioDataManager.GetWaveform(fInterp))
+                               : AudioDataManager.GetWaveform(fInterp);
             if (Config().m_Color.m_bAltGradientMode) {
                 const ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchFlush _flush{ batch };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::DrawRadial(
                     samples, canvasSize, Config().m_fScale,
                     [
-                        nHalfWidth, nHalfHeight, color0, color1
+                        &batch, nHalfWidth, nHalfHeight, color0, color1
                     ] (auto fSample, auto fX, auto fY) constexpr noexcept -> void {
                         const auto nX = nHalfWidth + static_cast<coord_type>(fX * fSample);
                         const auto nY = nHalfHeight + static_cast<coord_type>(fY * fSample);
-                        ::glColor3f(color0.r(), color0.g(), color0.b());
-                        ::glVertex2i(nHalfWidth, nHalfHeight);
-                        ::glColor3f(color1.r(), color1.g(), color1.b());
-                        ::glVertex2i(nX, nY);
+                        batch.color(color0.r(), color0.g(), color0.b());
+                        batch.vertex(nHalfWidth, nHalfHeight);
+                        batch.color(color1.r(), color1.g(), color1.b());
+                        batch.vertex(nX, nY);
                     }
                 );
             } else {
                 const ::OpenGL::glScopedSetLineWidth _lineWidth{ Config().m_fLineWidth };
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchFlush _flush{ batch };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::DrawRadial(
                     samples, canvasSize, Config().m_fScale,
                     [
-                        nHalfWidth, nHalfHeight, color0, color1
+                        &batch, nHalfWidth, nHalfHeight, color0, color1
                     ] (auto fSample, auto fX, auto fY) constexpr noexcept -> void {
                         const auto nX = nHalfWidth + static_cast<coord_type>(fX * fSample);
                         const auto nY = nHalfHeight + static_cast<coord_type>(fY * fSample);
                         const auto colorBlend = ::Color::ColorBlend(color0, color1, std::fabs(fSample) * 4.0f);
-                        ::glColor3f(color0.r(), color0.g(), color0.b());
-                        ::glVertex2i(nHalfWidth, nHalfHeight);
-                        ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                        ::glVertex2i(nX, nY);
+                        batch.color(color0.r(), color0.g(), color0.b());
+                        batch.vertex(nHalfWidth, nHalfHeight);
+                        batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                        batch.vertex(nX, nY);
                     }
                 );
             }
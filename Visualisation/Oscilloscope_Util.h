@@ -27,6 +27,11 @@
 #include "Visualisation/Oscilloscope.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include "GL/glbatch.h"
+//--------------------------------------
+
 //--------------------------------------
 //
 #include "Util/TrigCache.h"
@@ -36,6 +41,7 @@
 //
 #include <cassert>
 #include <cmath>
+#include <algorithm>
 #include <utility>
 #include <functional>
 //--------------------------------------
@@ -80,12 +86,74 @@ namespace Visualisation::Oscilloscope {
 
         //--------------------------------------------------
 
+        // `samples` holds interleaved [min, max] pairs (see
+        // `WaveformParams::bEnvelope`); each pair is drawn
+        // as a vertical span by passing both ends to `fnDraw`.
+        // With `bJoin` each span is stretched to meet the
+        // previous one so the trace is continuous.
         template <typename SamplesT, typename LambdaT>
-        static void DrawRadial(const SamplesT& samples,
-                               const dimensions_type& canvasSize,
-                               sample_type scaleFactor,
-                               LambdaT fnDraw) noexcept {
-            assert(!samples.empty());
+        static void DrawEnvelope(const SamplesT& samples,
+                                 const dimensions_type& canvasSize,
+                                 sample_type scaleFactor,
+                                 bool bJoin,
+                                 LambdaT fnDraw) noexcept {
+            assert(!samples.empty()); assert((samples.size() % 2) == 0);
+            const auto fHeight = static_cast<float>(canvasSize.cy);
+            const auto toY = [fHeight](auto fSample) noexcept {
+                return static_cast<coord_type>(std::round(fHeight * fSample));
+            };
+
+            coord_type nX = 0;
+            coord_type nPrevMin{ 0 }, nPrevMax{ 0 };
+            for (size_type i = 0; i + 1 < samples.size(); i += 2) {
+                const auto fMin = .5f + samples[i    ] * scaleFactor * .5f;
+                const auto fMax = .5f + samples[i + 1] * scaleFactor * .5f;
+                const auto nCurrMin = toY(fMin);
+                const auto nCurrMax = toY(fMax);
+                auto nMin{ nCurrMin }, nMax{ nCurrMax };
+                if (bJoin && i > 0) {
+                    nMin = std::min(nMin, nPrevMax);
+                    nMax = std::max(nMax, nPrevMin);
+                }
+                nPrevMin = nCurrMin;
+                nPrevMax = nCurrMax;
+                nMax = std::max(nMax, nMin + 1); //< Zero length lines may not rasterise
+                fnDraw(fMin, nX, nMin);
+                nX = fnDraw(fMax, nX, nMax);
+            }
+        }
+
+        //--------------------------------------------------
+
+        // Plain or envelope data: plain data is drawn with
+        // `mode`, envelope data always as `GL_LINES` (joined
+        // when `mode` would join points). Both are recorded
+        // into `OpenGL::glVertexBatch::instance()`.
+        template <typename SamplesT, typename LambdaT>
+        static void Draw(GLenum mode,
+                         bool bEnvelope,
+                         const SamplesT& samples,
+                         const dimensions_type& canvasSize,
+                         sample_type scaleFactor,
+                         LambdaT fnDraw) noexcept {
+            auto& batch{ ::OpenGL::glVertexBatch::instance() };
+            if (bEnvelope) {
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
+                DrawEnvelope(samples, canvasSize, scaleFactor,
+                             mode != GL_POINTS, fnDraw);
+            } else {
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, mode };
+                Draw(samples, canvasSize, scaleFactor, fnDraw);
+            }
+        }
+
+        //--------------------------------------------------
+
+        // Scale from a sample to an offset from the centre of
+        // the canvas for the radial/XY plots.
+        [[nodiscard]]
+        static std::pair<sample_type, sample_type> RadialScale(const dimensions_type& canvasSize,
+                                                               sample_type scaleFactor) noexcept {
             const auto fHalfWidth = static_cast<float>(canvasSize.cx) * 0.5f;
             const auto fHalfHeight = static_cast<float>(canvasSize.cy) * 0.5f;
 
@@ -94,8 +162,18 @@ namespace Visualisation::Oscilloscope {
             const auto fRadiusFactorX = fTargetRadius / static_cast<float>(canvasSize.cx);
             const auto fRadiusFactorY = fTargetRadius / static_cast<float>(canvasSize.cy);
 
-            const auto fScaleX = scaleFactor * fHalfWidth * fRadiusFactorX;
-            const auto fScaleY = scaleFactor * fHalfHeight * fRadiusFactorY;
+            return { scaleFactor * fHalfWidth * fRadiusFactorX,
+                     scaleFactor * fHalfHeight * fRadiusFactorY };
+        }
+        //--------------------------------------------------
+
+        template <typename SamplesT, typename LambdaT>
+        static void DrawRadial(const SamplesT& samples,
+                               const dimensions_type& canvasSize,
+                               sample_type scaleFactor,
+                               LambdaT fnDraw) noexcept {
+            assert(!samples.empty());
+            const auto [fScaleX, fScaleY] = RadialScale(canvasSize, scaleFactor);
 
             // Parametric Circle Equation:
             //      x = radius * cos(theta)
@@ -108,6 +186,91 @@ namespace Visualisation::Oscilloscope {
                 fnDraw(fSample, fX, fY);
             }
         }
+
+        //--------------------------------------------------
+
+        // Radial equivalent of `DrawEnvelope`: both ends of
+        // each pair are passed to `fnDraw` at the same angle.
+        template <typename SamplesT, typename LambdaT>
+        static void DrawRadialEnvelope(const SamplesT& samples,
+                                       const dimensions_type& canvasSize,
+                                       sample_type scaleFactor,
+                                       LambdaT fnDraw) noexcept {
+            assert(!samples.empty()); assert((samples.size() % 2) == 0);
+            const auto pairCount{ samples.size() / 2 };
+            const auto [fScaleX, fScaleY] = RadialScale(canvasSize, scaleFactor);
+
+            for (size_type i = 0; i < pairCount; ++i) {
+                const auto sincos = s_TrigCache.sincos(i, pairCount);
+                const auto fX = sincos.cosine * fScaleX;
+                const auto fY = sincos.sine * fScaleY;
+                fnDraw(samples[i * 2    ], fX, fY);
+                fnDraw(samples[i * 2 + 1], fX, fY);
+            }
+        }
+
+        //--------------------------------------------------
+
+        // Plain or envelope data: plain data is drawn with
+        // `mode`, envelope data always as `GL_LINES`. Both are
+        // recorded into `OpenGL::glVertexBatch::instance()`.
+        template <typename SamplesT, typename LambdaT>
+        static void DrawRadial(GLenum mode,
+                               bool bEnvelope,
+                               const SamplesT& samples,
+                               const dimensions_type& canvasSize,
+                               sample_type scaleFactor,
+                               LambdaT fnDraw) noexcept {
+            auto& batch{ ::OpenGL::glVertexBatch::instance() };
+            if (bEnvelope) {
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
+                DrawRadialEnvelope(samples, canvasSize, scaleFactor, fnDraw);
+            } else {
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, mode };
+                DrawRadial(samples, canvasSize, scaleFactor, fnDraw);
+            }
+        }
+
+        //--------------------------------------------------
+
+        // Stereo field (goniometer) plot: mid (L+R) along +Y
+        // (up, as with the spectrum analyser bars), side (R-L)
+        // along +X, i.e. the L/R plane rotated by 45 degrees.
+        // `fnDraw` receives the offset from the centre of the
+        // canvas.
+        template <typename SamplesT, typename LambdaT>
+        static void DrawLissajous(const SamplesT& samplesL,
+                                  const SamplesT& samplesR,
+                                  const dimensions_type& canvasSize,
+                                  sample_type scaleFactor,
+                                  LambdaT fnDraw) noexcept {
+            assert(samplesL.size() == samplesR.size());
+            constexpr const sample_type fRootHalf{ static_cast<sample_type>(0.70710678118654752440) };
+            const auto [fScaleX, fScaleY] = RadialScale(canvasSize, scaleFactor * fRootHalf);
+            const auto count{ std::min(samplesL.size(), samplesR.size()) };
+            for (size_type i = 0; i < count; ++i) {
+                const auto fL = samplesL[i];
+                const auto fR = samplesR[i];
+                fnDraw((fR - fL) * fScaleX, (fL + fR) * fScaleY);
+            }
+        }
+        //--------------------------------------------------
+
+        // Reduces envelope pairs to the extreme of largest
+        // magnitude, for visualisations which draw a single
+        // value per point.
+        template <typename SamplesT>
+        static SamplesT EnvelopePeaks(SamplesT samples) noexcept {
+            assert((samples.size() % 2) == 0);
+            const auto pairCount{ samples.size() / 2 };
+            for (size_type i = 0; i < pairCount; ++i) {
+                const auto fMin = samples[i * 2    ];
+                const auto fMax = samples[i * 2 + 1];
+                samples[i] = (std::fabs(fMin) > std::fabs(fMax)) ? fMin : fMax;
+            }
+            samples.resize(pairCount);
+            return samples;
+        }
         //==================================================
 
     private:
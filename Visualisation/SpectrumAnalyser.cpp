@@ -29,6 +29,9 @@
 //
 #include "Visualisation/SpectrumAnalyser_Basic.h"
 #include "Visualisation/SpectrumAnalyser_Block.h"
+#include "Visualisation/SpectrumAnalyser_Spectrogram.h"
+#include "Visualisation/SpectrumAnalyser_Chromagram.h"
+#include "Visualisation/SpectrumAnalyser_Shader.h"
 //--------------------------------------
 
 //--------------------------------------
@@ -54,6 +57,12 @@ namespace Visualisation::SpectrumAnalyser {
                     return std::make_shared<Block::Mono>(config, dim);
                 case SpectrumAnalyserType::StereoBlock:
                     return std::make_shared<Block::Stereo>(config, dim);
+                case SpectrumAnalyserType::Spectrogram:
+                    return std::make_shared<Spectrogram::Mono>(config, dim);
+                case SpectrumAnalyserType::Chromagram:
+                    return std::make_shared<Chromagram::Mono>(config, dim);
+                case SpectrumAnalyserType::Shader:
+                    return std::make_shared<Shader::Mono>(config, dim);
             }
         } else {
             switch (eType) {
@@ -65,6 +74,12 @@ namespace Visualisation::SpectrumAnalyser {
                     return std::make_shared<Block::MonoGradient>(config, dim);
                 case SpectrumAnalyserType::StereoBlock:
                     return std::make_shared<Block::StereoGradient>(config, dim);
+                case SpectrumAnalyserType::Spectrogram:
+                    return std::make_shared<Spectrogram::MonoGradient>(config, dim);
+                case SpectrumAnalyserType::Chromagram:
+                    return std::make_shared<Chromagram::MonoGradient>(config, dim);
+                case SpectrumAnalyserType::Shader:
+                    return std::make_shared<Shader::Mono>(config, dim);
             }
         }
         return pointer_type{};
@@ -73,6 +73,15 @@ namespace Visualisation::SpectrumAnalyser {
     protected:
         constexpr auto& Config() const noexcept { return m_Config; }
 
+        constexpr size_type BinsPerOctave() const noexcept {
+            switch (Config().m_Scale) {
+                case SpectrumAnalyserScale::ConstantQ12: return 12;
+                case SpectrumAnalyserScale::ConstantQ24: return 24;
+                case SpectrumAnalyserScale::Linear:
+                default:                                 return 0;
+            }
+        }
+
     private:
         config_type m_Config{};
     }; // class ISpectrumAnalyser
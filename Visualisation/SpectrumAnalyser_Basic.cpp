@@ -29,6 +29,7 @@
 //--------------------------------------
 //
 #include "Audio_DataManager.h"
+#include "Config/Config_Manager.h"
 //--------------------------------------
 
 //--------------------------------------
@@ -41,9 +42,136 @@
 //
 #include "GL/glcommon.h"
 #include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 //--------------------------------------
 
 namespace Visualisation::SpectrumAnalyser {
+    namespace detail {
+        //**********************************************************************
+        // Basic
+        //**********************************************************************
+        void Basic::ActivateInterpolation() {
+            m_bGPUInterpolation = ::Config::GeneralConfig::get().m_Canvas.m_bGPUInterpolation;
+            m_nLastFrame = -1;
+        }
+
+        //----------------------------------------------------------------------
+
+        void Basic::Deactivate() {
+            m_Interpolated.destroy();
+            m_nLastFrame = -1;
+        }
+
+        //----------------------------------------------------------------------
+
+        bool Basic::DrawInterpolated(const audio_data_manager_type& AudioDataManager,
+                                     float fInterp,
+                                     color_mode eColorMode,
+                                     const ::Color::Color3f& color0,
+                                     const ::Color::Color3f& color1) {
+            if (!m_bGPUInterpolation || !interpolated_type::is_supported()) { return false; }
+
+            const auto nFrame{ static_cast<std::int64_t>(AudioDataManager.GetFrameTimestamp()) };
+            if (nFrame != m_nLastFrame) {
+                Record(AudioDataManager);
+                if (!m_Interpolated.upload()) {
+                    // Program won't build; stay on the CPU path
+                    m_bGPUInterpolation = false;
+                    return false;
+                }
+                m_nLastFrame = nFrame;
+            }
+
+            // Heights as `Util::Draw` (the stereo bases are in the
+            // vertices, see `Record`)
+            const auto nHeight{ GetDimensions().cy };
+            const auto fHeight{ static_cast<::GLfloat>(nHeight) };
+            const auto fScale { m_bStereo ? fHeight * .5f : fHeight };
+            const auto fBias  { (m_bStereo && (nHeight % 2) != 0) ? .5f : 0.f };
+            m_Interpolated.draw(fInterp, fScale, fBias, eColorMode,
+                                { color0.r(), color0.g(), color0.b(), 1.f },
+                                { color1.r(), color1.g(), color1.b(), 1.f });
+            return true;
+        }
+
+        //----------------------------------------------------------------------
+
+        void Basic::Record(const audio_data_manager_type& AudioDataManager) {
+            using Audio::Channel;
+
+            auto& vertices{ m_Interpolated };
+            vertices.clear();
+
+            const auto bPeaks{ Config().m_Peak.m_bEnable };
+            if (!m_bStereo) {
+                const auto samplesPrev{ AudioDataManager.GetSpectrumPrev() };
+                const auto samplesNext{ AudioDataManager.GetSpectrumNext() };
+                vertices.begin(GL_LINES);
+                for (std::size_t i = 0; i < samplesPrev.size(); ++i) {
+                    const auto nX{ static_cast<coord_type>(i) };
+                    vertices.vertex(nX, 0, 0, samplesPrev[i], samplesNext[i]);
+                    vertices.vertex(nX, 0, 1, samplesPrev[i], samplesNext[i]);
+                }
+                vertices.end();
+
+                if (bPeaks) {
+                    const auto peaksPrev{ AudioDataManager.GetSpectrumPeaksPrev() };
+                    const auto peaksNext{ AudioDataManager.GetSpectrumPeaksNext() };
+                    vertices.begin(GL_POINTS);
+                    for (std::size_t i = 0; i < peaksPrev.size(); ++i) {
+                        const auto nX{ static_cast<coord_type>(i) };
+                        vertices.vertex(nX, 0, 1, peaksPrev[i], peaksNext[i]);
+                    }
+                    vertices.end();
+                }
+            } else {
+                // Left grows up from the middle, right down; from
+                // the same rows as `Util::Draw`
+                const auto nHeight    { static_cast<coord_type>(GetDimensions().cy) };
+                const auto nHalfHeight{ nHeight / 2 };
+                const auto nBaseL     { nHalfHeight };
+                const auto nBaseR     { nHeight - nHalfHeight };
+
+                const auto samplesPrevL{ AudioDataManager.GetSpectrumPrev(Channel::Left) };
+                const auto samplesNextL{ AudioDataManager.GetSpectrumNext(Channel::Left) };
+                const auto samplesPrevR{ AudioDataManager.GetSpectrumPrev(Channel::Right) };
+                const auto samplesNextR{ AudioDataManager.GetSpectrumNext(Channel::Right) };
+                const auto count{ std::min(samplesPrevL.size(), samplesPrevR.size()) };
+                vertices.begin(GL_LINES);
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto nX{ static_cast<coord_type>(i) };
+                    vertices.vertex(nX, nHalfHeight, 0, samplesPrevL[i], samplesNextL[i]);
+                    vertices.vertex(nX, nBaseL,      1, samplesPrevL[i], samplesNextL[i]);
+                    vertices.vertex(nX, nHalfHeight, 0, samplesPrevR[i], samplesNextR[i]);
+                    vertices.vertex(nX, nBaseR,     -1, samplesPrevR[i], samplesNextR[i]);
+                }
+                vertices.end();
+
+                if (bPeaks) {
+                    const auto peaksPrevL{ AudioDataManager.GetSpectrumPeaksPrev(Channel::Left) };
+                    const auto peaksNextL{ AudioDataManager.GetSpectrumPeaksNext(Channel::Left) };
+                    const auto peaksPrevR{ AudioDataManager.GetSpectrumPeaksPrev(Channel::Right) };
+                    const auto peaksNextR{ AudioDataManager.GetSpectrumPeaksNext(Channel::Right) };
+                    const auto nPeaks{ std::min(peaksPrevL.size(), peaksPrevR.size()) };
+                    vertices.begin(GL_POINTS);
+                    for (std::size_t i = 0; i < nPeaks; ++i) {
+                        const auto nX{ static_cast<coord_type>(i) };
+                        vertices.vertex(nX, nBaseL,  1, peaksPrevL[i], peaksNextL[i]);
+                        vertices.vertex(nX, nBaseR, -1, peaksPrevR[i], peaksNextR[i]);
+                    }
+                    vertices.end();
+                }
+            }
+        }
+    } // namespace detail
+
     //**************************************************************************
     // Mono
     //**************************************************************************
@@ -59,10 +187,12 @@ namespace Visualisation::SpectrumAnalyser {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+        ActivateInterpolation();
     }
 
     //--------------------------------------------------------------------------
@@ -71,17 +201,20 @@ namespace Visualisation::SpectrumAnalyser {
                     const audio_data_manager_type& AudioDataManager,
                     float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
+        if (DrawInterpolated(AudioDataManager, fInterp)) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
 
         const auto canvasSize = GetDimensions();
         {
             const auto& samples = AudioDataManager.GetSpectrum(fInterp);
             if (samples.empty()) { return; }
-            const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
             Util::Draw(
                 samples, canvasSize,
-                [](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                    ::glVertex2i(nX, 0);
-                    ::glVertex2i(nX, nY);
+                [&batch](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                    batch.vertex(nX, 0);
+                    batch.vertex(nX, nY);
                     return nX + 1;
                 }
             );
@@ -90,11 +223,11 @@ namespace Visualisation::SpectrumAnalyser {
         if (Config().m_Peak.m_bEnable) {
             const auto& peaks = AudioDataManager.GetSpectrumPeaks(fInterp);
             if (peaks.empty()) { return; }
-            const ::OpenGL::glScopedBegin _begin{ GL_POINTS };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_POINTS };
             Util::Draw(
                 peaks, canvasSize,
-                [](auto /*fPeak*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                    ::glVertex2i(nX, nY);
+                [&batch](auto /*fPeak*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                    batch.vertex(nX, nY);
                     return nX + 1;
                 }
             );
@@ -116,10 +249,18 @@ namespace Visualisation::SpectrumAnalyser {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        // A colour per pixel of bar height
+        m_Gradient.set(ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary),
+                       ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary),
+                       GetDimensions().cy);
+        ActivateInterpolation();
     }
 
     //--------------------------------------------------------------------------
@@ -128,27 +269,37 @@ namespace Visualisation::SpectrumAnalyser {
                             const audio_data_manager_type& AudioDataManager,
                             float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
-        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
-        const auto color0{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary) };
-        const auto color1{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
+        const auto& gradient{ m_Gradient };
+        const auto& color0  { gradient.front() };
+        const auto& color1  { gradient.back() };
+
+        if (DrawInterpolated(AudioDataManager, fInterp,
+                             Config().m_Color.m_bAltGradientMode ? color_mode::Step
+                                                                 : color_mode::Gradient,
+                             color0, color1)) {
+            return;
+        }
 
         {
             const auto& samples = AudioDataManager.GetSpectrum(fInterp);
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 if (Config().m_Color.m_bAltGradientMode) {
                     Util::Draw(
                         samples, canvasSize,
                         [
-                            color0, color1
+                            &batch, color0, color1
                         ] (auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX, 0);
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX, 0);
 
-                            ::glColor3f(color1.r(), color1.g(), color1.b());
-                            ::glVertex2i(nX, nY);
+                            batch.color(color1.r(), color1.g(), color1.b());
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
@@ -156,14 +307,14 @@ namespace Visualisation::SpectrumAnalyser {
                     Util::Draw(
                         samples, canvasSize,
                         [
-                            color0, color1
-                        ] (auto fSample, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            const auto colorBlend = ::Color::ColorBlend(color0, color1, fSample);
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX, 0);
+                            &batch, &gradient, color0
+                        ] (auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                            const auto& colorBlend = gradient[nY];
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX, 0);
 
-                            ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                            ::glVertex2i(nX, nY);
+                            batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
@@ -174,13 +325,13 @@ namespace Visualisation::SpectrumAnalyser {
         if (Config().m_Peak.m_bEnable) {
             const auto& peaks = AudioDataManager.GetSpectrumPeaks(fInterp);
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_POINTS };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_POINTS };
                 if (Config().m_Color.m_bAltGradientMode) {
-                    ::glColor3f(color1.r(), color1.g(), color1.b());
+                    batch.color(color1.r(), color1.g(), color1.b());
                     Util::Draw(
                         peaks, canvasSize,
-                        [](auto /*fPeak*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            ::glVertex2i(nX, nY);
+                        [&batch](auto /*fPeak*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
@@ -188,11 +339,11 @@ namespace Visualisation::SpectrumAnalyser {
                     Util::Draw(
                         peaks, canvasSize,
                         [
-                            color0, color1
-                        ] (auto fPeak, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeak);
-                            ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                            ::glVertex2i(nX, nY);
+                            &batch, &gradient
+                        ] (auto /*fPeak*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                            const auto& colorBlend = gradient[nY];
+                            batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
@@ -216,10 +367,12 @@ namespace Visualisation::SpectrumAnalyser {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+        ActivateInterpolation();
     }
 
     //--------------------------------------------------------------------------
@@ -228,20 +381,24 @@ namespace Visualisation::SpectrumAnalyser {
                       const audio_data_manager_type& AudioDataManager,
                       float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
+        if (DrawInterpolated(AudioDataManager, fInterp)) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         {
             const auto samplesL = AudioDataManager.GetSpectrum(Audio::Channel::Left, fInterp);
             const auto samplesR = AudioDataManager.GetSpectrum(Audio::Channel::Right, fInterp);
             const auto nHalfHeight = canvasSize.cy / 2;
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::Draw(
                     samplesL, samplesR, canvasSize,
                     [
-                        nHalfHeight
+                        &batch, nHalfHeight
                     ] (auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                        ::glVertex2i(nX, nHalfHeight);
-                        ::glVertex2i(nX, nY);
+                        batch.vertex(nX, nHalfHeight);
+                        batch.vertex(nX, nY);
                         return nX + 1;
                     }
                 );
@@ -252,11 +409,11 @@ namespace Visualisation::SpectrumAnalyser {
             const auto peaksL = AudioDataManager.GetSpectrumPeaks(Audio::Channel::Left, fInterp);
             const auto peaksR = AudioDataManager.GetSpectrumPeaks(Audio::Channel::Right, fInterp);
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_POINTS };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_POINTS };
                 Util::Draw(
                     peaksL, peaksR, canvasSize,
-                    [](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                        ::glVertex2i(nX, nY);
+                    [&batch](auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                        batch.vertex(nX, nY);
                         return nX + 1;
                     }
                 );
@@ -279,10 +436,18 @@ namespace Visualisation::SpectrumAnalyser {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        // A colour per pixel of bar height (each channel has half)
+        m_Gradient.set(ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary),
+                       ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary),
+                       GetDimensions().cy / 2);
+        ActivateInterpolation();
     }
 
     //--------------------------------------------------------------------------
@@ -291,29 +456,39 @@ namespace Visualisation::SpectrumAnalyser {
                               const audio_data_manager_type& AudioDataManager,
                               float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
-        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
-        const auto color0{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary) };
-        const auto color1{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
+        const auto& gradient{ m_Gradient };
+        const auto& color0  { gradient.front() };
+        const auto& color1  { gradient.back() };
+
+        if (DrawInterpolated(AudioDataManager, fInterp,
+                             Config().m_Color.m_bAltGradientMode ? color_mode::Step
+                                                                 : color_mode::Gradient,
+                             color0, color1)) {
+            return;
+        }
 
         {
             const auto samplesL = AudioDataManager.GetSpectrum(Audio::Channel::Left, fInterp);
             const auto samplesR = AudioDataManager.GetSpectrum(Audio::Channel::Right, fInterp);
             const auto nHalfHeight = canvasSize.cy / 2;
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 if (Config().m_Color.m_bAltGradientMode) {
                     Util::Draw(
                         samplesL, samplesR, canvasSize,
                         [
-                            nHalfHeight, color0, color1
+                            &batch, nHalfHeight, color0, color1
                         ] (auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX, nHalfHeight);
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX, nHalfHeight);
 
-                            ::glColor3f(color1.r(), color1.g(), color1.b());
-                            ::glVertex2i(nX, nY);
+                            batch.color(color1.r(), color1.g(), color1.b());
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
@@ -321,14 +496,14 @@ namespace Visualisation::SpectrumAnalyser {
                     Util::Draw(
                         samplesL, samplesR, canvasSize,
                         [
-                            nHalfHeight, color0, color1
+                            &batch, &gradient, nHalfHeight, color0
                         ] (auto fSample, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            const auto colorBlend = ::Color::ColorBlend(color0, color1, fSample);
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX, nHalfHeight);
+                            const auto& colorBlend = gradient(fSample);
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX, nHalfHeight);
 
-                            ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                            ::glVertex2i(nX, nY);
+                            batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
@@ -340,13 +515,13 @@ namespace Visualisation::SpectrumAnalyser {
             const auto peaksL = AudioDataManager.GetSpectrumPeaks(Audio::Channel::Left, fInterp);
             const auto peaksR = AudioDataManager.GetSpectrumPeaks(Audio::Channel::Right, fInterp);
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_POINTS };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_POINTS };
                 if (Config().m_Color.m_bAltGradientMode) {
-                    ::glColor3f(color1.r(), color1.g(), color1.b());
+                    batch.color(color1.r(), color1.g(), color1.b());
                     Util::Draw(
                         peaksL, peaksR, canvasSize,
-                        [](auto /*fPeak*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            ::glVertex2i(nX, nY);
+                        [&batch](auto /*fPeak*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
@@ -354,11 +529,11 @@ namespace Visualisation::SpectrumAnalyser {
                     Util::Draw(
                         peaksL, peaksR, canvasSize,
                         [
-                            color0, color1
+                            &batch, &gradient
                         ] (auto fPeak, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
-                            const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeak);
-                            ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                            ::glVertex2i(nX, nY);
+                            const auto& colorBlend = gradient(fPeak);
+                            batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                            batch.vertex(nX, nY);
                             return nX + 1;
                         }
                     );
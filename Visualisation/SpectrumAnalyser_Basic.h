@@ -27,13 +27,80 @@
 #include "Visualisation/SpectrumAnalyser.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include "ColorBlend.h"
+#include "GL/glinterpolate.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cstdint>
+//--------------------------------------
+
 namespace Visualisation::SpectrumAnalyser {
+    namespace detail {
+        //**********************************************************************
+        // Basic
+        //**********************************************************************
+        //
+        // Bars (and peaks) drawn either from the interpolated
+        // frame built on the CPU every redraw, or, with "GPU
+        // Interpolation" enabled, from the two frames being
+        // interpolated between: these are uploaded once per
+        // update and blended by the vertex shader (see
+        // `OpenGL::glInterpolatedVertices`), so redraws in
+        // between only set the interpolation factor.
+        class Basic : public ISpectrumAnalyser {
+        private:
+            using base_class = ISpectrumAnalyser;
+            using this_class = Basic;
+
+        protected:
+            using interpolated_type = ::OpenGL::glInterpolatedVertices;
+            using color_mode        = interpolated_type::color_mode;
+
+        protected:
+            Basic(visualisation_type eType,
+                  const config_type& config,
+                  const dimensions_type& dim,
+                  bool bStereo) noexcept :
+                base_class{ eType, config, dim },
+                m_bStereo { bStereo } {}
+
+        public:
+            virtual void Deactivate() override;
+
+        protected:
+            // Call from `Activate`
+            void ActivateInterpolation();
+
+            // Draws using the vertex shader blend (see `color_mode`
+            // for `color0` and `color1`); false if that's disabled
+            // or unsupported, in which case nothing was drawn
+            bool DrawInterpolated(const audio_data_manager_type& AudioDataManager,
+                                  float fInterp,
+                                  color_mode eColorMode = color_mode::Current,
+                                  const ::Color::Color3f& color0 = {},
+                                  const ::Color::Color3f& color1 = {});
+
+        private:
+            void Record(const audio_data_manager_type& AudioDataManager);
+
+        private:
+            interpolated_type m_Interpolated      { };
+            std::int64_t      m_nLastFrame        { -1 }; //< `GetFrameTimestamp` of upload (-1 for none)
+            bool              m_bGPUInterpolation { false };
+            const bool        m_bStereo           { false };
+        }; // class Basic
+    } // namespace detail
+
     //**************************************************************************
     // Mono
     //**************************************************************************
-    class Mono final : public ISpectrumAnalyser {
+    class Mono final : public detail::Basic {
     private:
-        using base_class = ISpectrumAnalyser;
+        using base_class = detail::Basic;
         using this_class = Mono;
 
     public:
@@ -44,7 +111,7 @@ namespace Visualisation::SpectrumAnalyser {
     public:
         Mono(const config_type& config,
              const dimensions_type& dim) noexcept :
-            base_class{ Type(), config, dim } {}
+            base_class{ Type(), config, dim, false } {}
 
         virtual void Activate(request_param_type& params,
                               const audio_data_manager_type& AudioDataManager) override;
@@ -57,9 +124,9 @@ namespace Visualisation::SpectrumAnalyser {
     //**************************************************************************
     // MonoGradient
     //**************************************************************************
-    class MonoGradient final : public ISpectrumAnalyser {
+    class MonoGradient final : public detail::Basic {
     private:
-        using base_class = ISpectrumAnalyser;
+        using base_class = detail::Basic;
         using this_class = MonoGradient;
 
     public:
@@ -70,7 +137,7 @@ namespace Visualisation::SpectrumAnalyser {
     public:
         MonoGradient(const config_type& config,
                      const dimensions_type& dim) noexcept :
-            base_class{ Type(), config, dim } {}
+            base_class{ Type(), config, dim, false } {}
 
         virtual void Activate(request_param_type& params,
                               const audio_data_manager_type& AudioDataManager) override;
@@ -78,14 +145,17 @@ namespace Visualisation::SpectrumAnalyser {
         virtual void Draw(render_pass_type ePass,
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) override;
+
+    private:
+        ::Color::ColorGradient3f m_Gradient{ };
     }; // class MonoGradient final
 
     //**************************************************************************
     // Stereo
     //**************************************************************************
-    class Stereo final : public ISpectrumAnalyser {
+    class Stereo final : public detail::Basic {
     private:
-        using base_class = ISpectrumAnalyser;
+        using base_class = detail::Basic;
         using this_class = Stereo;
 
     public:
@@ -96,7 +166,7 @@ namespace Visualisation::SpectrumAnalyser {
     public:
         Stereo(const config_type& config,
                const dimensions_type& dim) noexcept :
-            base_class{ Type(), config, dim } {}
+            base_class{ Type(), config, dim, true } {}
 
         virtual void Activate(request_param_type& params,
                               const audio_data_manager_type& AudioDataManager) override;
@@ -109,9 +179,9 @@ namespace Visualisation::SpectrumAnalyser {
     //**************************************************************************
     // StereoGradient
     //**************************************************************************
-    class StereoGradient final : public ISpectrumAnalyser {
+    class StereoGradient final : public detail::Basic {
     private:
-        using base_class = ISpectrumAnalyser;
+        using base_class = detail::Basic;
         using this_class = StereoGradient;
 
     public:
@@ -122,7 +192,7 @@ namespace Visualisation::SpectrumAnalyser {
     public:
         StereoGradient(const config_type& config,
                        const dimensions_type& dim) noexcept :
-            base_class{ Type(), config, dim } {}
+            base_class{ Type(), config, dim, true } {}
 
         virtual void Activate(request_param_type& params,
                               const audio_data_manager_type& AudioDataManager) override;
@@ -130,6 +200,9 @@ namespace Visualisation::SpectrumAnalyser {
         virtual void Draw(render_pass_type ePass,
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) override;
+
+    private:
+        ::Color::ColorGradient3f m_Gradient{ };
     }; // class StereoGradient final
 } // namespace Visualisation::SpectrumAnalyser
 
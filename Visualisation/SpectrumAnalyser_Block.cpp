@@ -41,6 +41,7 @@
 //
 #include "GL/glcommon.h"
 #include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
 //--------------------------------------
 
 namespace Visualisation::SpectrumAnalyser::Block {
@@ -59,6 +60,7 @@ namespace Visualisation::SpectrumAnalyser::Block {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -75,6 +77,8 @@ namespace Visualisation::SpectrumAnalyser::Block {
         const auto bGap = Config().m_Block.m_bGap;
         const auto nBlockCount = Config().m_Block.m_uCount;
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
         const auto nTotalBlockWidth = bGap ? (canvasSize.cx - (nBlockCount - 1)) : canvasSize.cx;
@@ -84,18 +88,18 @@ namespace Visualisation::SpectrumAnalyser::Block {
             const auto samples = AudioDataManager.GetSpectrum(fInterp);
             assert(samples.size() == nBlockCount);
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
                 Util::Draw(
                     samples, canvasSize,
                     [
-                        nBlockWidth, bGap
+                        &batch, nBlockWidth, bGap
                     ] (auto /*fSample*/, auto nX0, auto nY1) constexpr noexcept -> decltype(nX0) {
                         const auto nY0 = 0;
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY0);
-                        ::glVertex2i(nX0, nY1);
-                        ::glVertex2i(nX1, nY1);
-                        ::glVertex2i(nX1, nY0);
+                        batch.vertex(nX0, nY0);
+                        batch.vertex(nX0, nY1);
+                        batch.vertex(nX1, nY1);
+                        batch.vertex(nX1, nY0);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
@@ -106,15 +110,15 @@ namespace Visualisation::SpectrumAnalyser::Block {
             const auto peaks = AudioDataManager.GetSpectrumPeaks(fInterp);
             assert(peaks.size() == nBlockCount);
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::Draw(
                     peaks, canvasSize,
                     [
-                        nBlockWidth, bGap
+                        &batch, nBlockWidth, bGap
                     ] (auto /*fPeak*/, auto nX0, auto nY) constexpr noexcept -> decltype(nX0) {
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY);
-                        ::glVertex2i(nX1, nY);
+                        batch.vertex(nX0, nY);
+                        batch.vertex(nX1, nY);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
@@ -137,10 +141,17 @@ namespace Visualisation::SpectrumAnalyser::Block {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        // A colour per pixel of bar height
+        m_Gradient.set(ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary),
+                       ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary),
+                       GetDimensions().cy);
     }
 
     //--------------------------------------------------------------------------
@@ -153,11 +164,13 @@ namespace Visualisation::SpectrumAnalyser::Block {
         const auto bGap = Config().m_Block.m_bGap;
         const auto nBlockCount = Config().m_Block.m_uCount;
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
-        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
-        const auto color0{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary) };
-        const auto color1{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
+        const auto& gradient{ m_Gradient };
+        const auto& color0  { gradient.front() };
+        const auto& color1  { gradient.back() };
 
         const auto nTotalBlockWidth = bGap ? (canvasSize.cx - (nBlockCount - 1)) : canvasSize.cx;
         const auto nBlockWidth = static_cast<coord_type>(nTotalBlockWidth / nBlockCount);
@@ -166,45 +179,45 @@ namespace Visualisation::SpectrumAnalyser::Block {
             const auto samples = AudioDataManager.GetSpectrum(fInterp);
             assert(samples.size() == nBlockCount);
             if (Config().m_Color.m_bAltGradientMode) {
-                const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
                 Util::Draw(
                     samples, canvasSize,
                     [
-                        nBlockWidth, bGap, color0, color1
+                        &batch, nBlockWidth, bGap, color0, color1
                     ] (auto /*fSample*/, auto nX0, auto nY1) constexpr noexcept -> decltype(nX0) {
                         const auto nY0 = 0;
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glColor3f(color0.r(), color0.g(), color0.b());
-                        ::glVertex2i(nX0, nY0);
+                        batch.color(color0.r(), color0.g(), color0.b());
+                        batch.vertex(nX0, nY0);
 
-                        ::glColor3f(color1.r(), color1.g(), color1.b());
-                        ::glVertex2i(nX0, nY1);
-                        ::glVertex2i(nX1, nY1);
+                        batch.color(color1.r(), color1.g(), color1.b());
+                        batch.vertex(nX0, nY1);
+                        batch.vertex(nX1, nY1);
 
-                        ::glColor3f(color0.r(), color0.g(), color0.b());
-                        ::glVertex2i(nX1, nY0);
+                        batch.color(color0.r(), color0.g(), color0.b());
+                        batch.vertex(nX1, nY0);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
             } else {
-                const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
                 Util::Draw(
                     samples, canvasSize,
                     [
-                        nBlockWidth, bGap, color0, color1
-                    ] (auto fSample, auto nX0, auto nY1) constexpr noexcept -> decltype(nX0) {
-                        const auto colorBlend = ::Color::ColorBlend(color0, color1, fSample);
+                        &batch, &gradient, nBlockWidth, bGap, color0
+                    ] (auto /*fSample*/, auto nX0, auto nY1) constexpr noexcept -> decltype(nX0) {
+                        const auto& colorBlend = gradient[nY1];
                         const auto nY0 = 0;
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glColor3f(color0.r(), color0.g(), color0.b());
-                        ::glVertex2i(nX0, nY0);
+                        batch.color(color0.r(), color0.g(), color0.b());
+                        batch.vertex(nX0, nY0);
 
-                        ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                        ::glVertex2i(nX0, nY1);
-                        ::glVertex2i(nX1, nY1);
+                        batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                        batch.vertex(nX0, nY1);
+                        batch.vertex(nX1, nY1);
 
-                        ::glColor3f(color0.r(), color0.g(), color0.b());
-                        ::glVertex2i(nX1, nY0);
+                        batch.color(color0.r(), color0.g(), color0.b());
+                        batch.vertex(nX1, nY0);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
@@ -215,31 +228,31 @@ namespace Visualisation::SpectrumAnalyser::Block {
             const auto peaks = AudioDataManager.GetSpectrumPeaks(fInterp);
             assert(peaks.size() == nBlockCount);
             if (Config().m_Color.m_bAltGradientMode) {
-                ::glColor3f(color1.r(), color1.g(), color1.b());
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                batch.color(color1.r(), color1.g(), color1.b());
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::Draw(
                     peaks, canvasSize,
                     [
-                        nBlockWidth, bGap
+                        &batch, nBlockWidth, bGap
                     ] (auto /*fPeak*/, auto nX0, auto nY) constexpr noexcept -> decltype(nX0) {
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY);
-                        ::glVertex2i(nX1, nY);
+                        batch.vertex(nX0, nY);
+                        batch.vertex(nX1, nY);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
             } else {
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::Draw(
                     peaks, canvasSize,
                     [
-                        nBlockWidth, bGap, color0, color1
-                    ] (auto fPeak, auto nX0, auto nY) constexpr noexcept -> decltype(nX0) {
-                        const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeak);
-                        ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                        &batch, &gradient, nBlockWidth, bGap
+                    ] (auto /*fPeak*/, auto nX0, auto nY) constexpr noexcept -> decltype(nX0) {
+                        const auto& colorBlend = gradient[nY];
+                        batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY);
-                        ::glVertex2i(nX1, nY);
+                        batch.vertex(nX0, nY);
+                        batch.vertex(nX1, nY);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
@@ -262,6 +275,7 @@ namespace Visualisation::SpectrumAnalyser::Block {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
@@ -278,6 +292,8 @@ namespace Visualisation::SpectrumAnalyser::Block {
         const auto bGap = Config().m_Block.m_bGap;
         const auto nBlockCount = Config().m_Block.m_uCount;
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
         const auto nTotalBlockWidth = bGap ? (canvasSize.cx - (nBlockCount - 1)) : canvasSize.cx;
@@ -290,18 +306,18 @@ namespace Visualisation::SpectrumAnalyser::Block {
             assert(samplesR.size() == nBlockCount);
             const auto nHalfHeight = canvasSize.cy / 2;
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
                 Util::Draw(
                     samplesL, samplesR, canvasSize,
                     [
-                        nHalfHeight, nBlockWidth, bGap
+                        &batch, nHalfHeight, nBlockWidth, bGap
                     ] (auto /*fSample*/, auto nX0, auto nY1) constexpr noexcept -> decltype(nX0) {
                         const auto nY0 = nHalfHeight;
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY0);
-                        ::glVertex2i(nX0, nY1);
-                        ::glVertex2i(nX1, nY1);
-                        ::glVertex2i(nX1, nY0);
+                        batch.vertex(nX0, nY0);
+                        batch.vertex(nX0, nY1);
+                        batch.vertex(nX1, nY1);
+                        batch.vertex(nX1, nY0);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
@@ -314,15 +330,15 @@ namespace Visualisation::SpectrumAnalyser::Block {
             const auto peaksR = AudioDataManager.GetSpectrumPeaks(Audio::Channel::Right, fInterp);
             assert(peaksR.size() == nBlockCount);
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 Util::Draw(
                     peaksL, peaksR, canvasSize,
                     [
-                        nBlockWidth, bGap
+                        &batch, nBlockWidth, bGap
                     ] (auto /*fSample*/, auto nX0, auto nY) constexpr noexcept -> decltype(nX0) {
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY);
-                        ::glVertex2i(nX1, nY);
+                        batch.vertex(nX0, nY);
+                        batch.vertex(nX1, nY);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
@@ -345,10 +361,17 @@ namespace Visualisation::SpectrumAnalyser::Block {
             params.Spectrum.fPeakMininum = 0;
         }
         params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        // A colour per pixel of bar height (each channel has half)
+        m_Gradient.set(ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary),
+                       ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary),
+                       GetDimensions().cy / 2);
     }
 
     //--------------------------------------------------------------------------
@@ -361,11 +384,13 @@ namespace Visualisation::SpectrumAnalyser::Block {
         const auto bGap = Config().m_Block.m_bGap;
         const auto nBlockCount = Config().m_Block.m_uCount;
 
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
-        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
-        const auto color0{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary) };
-        const auto color1{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
+        const auto& gradient{ m_Gradient };
+        const auto& color0  { gradient.front() };
+        const auto& color1  { gradient.back() };
 
         const auto nTotalBlockWidth = bGap ? (canvasSize.cx - (nBlockCount - 1)) : canvasSize.cx;
         const auto nBlockWidth = static_cast<coord_type>(nTotalBlockWidth / nBlockCount);
@@ -376,45 +401,45 @@ namespace Visualisation::SpectrumAnalyser::Block {
             const auto nHalfHeight = canvasSize.cy / 2;
             {
                 if (Config().m_Color.m_bAltGradientMode) {
-                    const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+                    const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
                     Util::Draw(
                         samplesL, samplesR, canvasSize,
                         [
-                            nHalfHeight, nBlockWidth, bGap, color0, color1
+                            &batch, nHalfHeight, nBlockWidth, bGap, color0, color1
                         ] (auto /*fSample*/, auto nX0, auto nY1) constexpr noexcept -> decltype(nX0) {
                             const auto nY0 = nHalfHeight;
                             const auto nX1 = nX0 + nBlockWidth;
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX0, nY0);
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX0, nY0);
 
-                            ::glColor3f(color1.r(), color1.g(), color1.b());
-                            ::glVertex2i(nX0, nY1);
-                            ::glVertex2i(nX1, nY1);
+                            batch.color(color1.r(), color1.g(), color1.b());
+                            batch.vertex(nX0, nY1);
+                            batch.vertex(nX1, nY1);
 
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX1, nY0);
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX1, nY0);
                             return bGap ? nX1 + 1 : nX1;
                         }
                     );
                 } else {
-                    const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+                    const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
                     Util::Draw(
                         samplesL, samplesR, canvasSize,
                         [
-                            nHalfHeight, nBlockWidth, bGap, color0, color1
+                            &batch, &gradient, nHalfHeight, nBlockWidth, bGap, color0
                         ] (auto fSample, auto nX0, auto nY1) constexpr noexcept -> decltype(nX0) {
-                            const auto colorBlend = ::Color::ColorBlend(color0, color1, fSample);
+                            const auto& colorBlend = gradient(fSample);
                             const auto nY0 = nHalfHeight;
                             const auto nX1 = nX0 + nBlockWidth;
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX0, nY0);
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX0, nY0);
 
-                            ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                            ::glVertex2i(nX0, nY1);
-                            ::glVertex2i(nX1, nY1);
+                            batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                            batch.vertex(nX0, nY1);
+                            batch.vertex(nX1, nY1);
 
-                            ::glColor3f(color0.r(), color0.g(), color0.b());
-                            ::glVertex2i(nX1, nY0);
+                            batch.color(color0.r(), color0.g(), color0.b());
+                            batch.vertex(nX1, nY0);
                             return bGap ? nX1 + 1 : nX1;
                         }
                     );
@@ -425,17 +450,17 @@ namespace Visualisation::SpectrumAnalyser::Block {
         if (Config().m_Peak.m_bEnable) {
             const auto peaksL = AudioDataManager.GetSpectrumPeaks(Audio::Channel::Left, fInterp);
             const auto peaksR = AudioDataManager.GetSpectrumPeaks(Audio::Channel::Right, fInterp);
-            const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
             if (Config().m_Color.m_bAltGradientMode) {
-                ::glColor3f(color1.r(), color1.g(), color1.b());
+                batch.color(color1.r(), color1.g(), color1.b());
                 Util::Draw(
                     peaksL, peaksR, canvasSize,
                     [
-                        nBlockWidth, bGap
+                        &batch, nBlockWidth, bGap
                     ] (auto /*fPeak*/, auto nX0, auto nY) constexpr noexcept -> decltype(nX0) {
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY);
-                        ::glVertex2i(nX1, nY);
+                        batch.vertex(nX0, nY);
+                        batch.vertex(nX1, nY);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
@@ -443,13 +468,13 @@ namespace Visualisation::SpectrumAnalyser::Block {
                 Util::Draw(
                     peaksL, peaksR, canvasSize,
                     [
-                        nBlockWidth, bGap, color0, color1
+                        &batch, &gradient, nBlockWidth, bGap
                     ] (auto fPeak, auto nX0, auto nY) constexpr noexcept -> decltype(nX0) {
-                        const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeak);
-                        ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                        const auto& colorBlend = gradient(fPeak);
+                        batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
                         const auto nX1 = nX0 + nBlockWidth;
-                        ::glVertex2i(nX0, nY);
-                        ::glVertex2i(nX1, nY);
+                        batch.vertex(nX0, nY);
+                        batch.vertex(nX1, nY);
                         return bGap ? nX1 + 1 : nX1;
                     }
                 );
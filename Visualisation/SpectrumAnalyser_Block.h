@@ -27,6 +27,11 @@
 #include "Visualisation/SpectrumAnalyser.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include "ColorBlend.h"
+//--------------------------------------
+
 namespace Visualisation::SpectrumAnalyser::Block {
     //**************************************************************************
     // Mono
@@ -78,6 +83,9 @@ namespace Visualisation::SpectrumAnalyser::Block {
         virtual void Draw(render_pass_type ePass,
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) override;
+
+    private:
+        ::Color::ColorGradient3f m_Gradient{ };
     }; // class MonoGradient final
 
     //**************************************************************************
@@ -130,6 +138,9 @@ namespace Visualisation::SpectrumAnalyser::Block {
         virtual void Draw(render_pass_type ePass,
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) override;
+
+    private:
+        ::Color::ColorGradient3f m_Gradient{ };
     }; // class StereoGradient final
 } // namespace Visualisation::SpectrumAnalyser::Block
 
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "Visualisation/SpectrumAnalyser_Chromagram.h"
+#include "Visualisation/SpectrumAnalyser_Util.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Audio_DataManager.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "ColorBlend.h"
+#include "ColorPacker.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Windows/GDI/GDI_Font.h"
+//--------------------------------------
+
+namespace {
+    //**************************************************************************
+    // Helpers
+    //**************************************************************************
+    inline constexpr LPCTSTR KeyNames[2][12]{
+        {
+            TEXT("C major"),  TEXT("C# major"), TEXT("D major"),  TEXT("Eb major"),
+            TEXT("E major"),  TEXT("F major"),  TEXT("F# major"), TEXT("G major"),
+            TEXT("Ab major"), TEXT("A major"),  TEXT("Bb major"), TEXT("B major"),
+        },
+        {
+            TEXT("C minor"),  TEXT("C# minor"), TEXT("D minor"),  TEXT("Eb minor"),
+            TEXT("E minor"),  TEXT("F minor"),  TEXT("F# minor"), TEXT("G minor"),
+            TEXT("G# minor"), TEXT("A minor"),  TEXT("Bb minor"), TEXT("B minor"),
+        },
+    };
+} // namespace <anonymous>
+
+//==============================================================================
+
+namespace Visualisation::SpectrumAnalyser::Chromagram::detail {
+    //**************************************************************************
+    // Chromagram
+    //**************************************************************************
+    void Chromagram::Activate(request_param_type& params,
+                              const audio_data_manager_type& /*AudioDataManager*/) {
+        params.Want = request_param_type::want_type::Chroma;
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
+                                               params.PrimaryColor);
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
+                                               params.ClearColor);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        // A colour per pixel of bar height
+        m_Gradient.set(ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary),
+                       ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary),
+                       std::max<coord_type>(BarHeight(), 1));
+
+        if (!m_KeyFont.IsNull()) { m_KeyFont.DeleteObject(); }
+        ::Windows::GDI::CLogFont logFont{};
+        if (::Windows::GDI::GetFontClose(TEXT("Arial"), -KeyHeight(), &logFont) != ::Windows::GDI::FONT_MATCH_NONE) {
+            m_KeyFont.CreateFontIndirect(&logFont);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Chromagram::Deactivate() {
+        if (!m_KeyFont.IsNull()) { m_KeyFont.DeleteObject(); }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Chromagram::DrawBars(const audio_data_manager_type& AudioDataManager,
+                              float fInterp) {
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
+        const auto canvasSize = GetDimensions();
+        const dimensions_type barArea{ canvasSize.cx, BarHeight() };
+        if (barArea.cy <= 0) { return; }
+
+        // Spare pixels split either side; 1 pixel gap when
+        // bars are wide enough to keep one
+        const auto chroma{ AudioDataManager.GetChroma(fInterp) };
+        const auto nCount{ static_cast<coord_type>(chroma.size()) };
+        const auto nPitch{ std::max<coord_type>(canvasSize.cx / nCount, 1) };
+        const auto nWidth{ (nPitch > 2) ? nPitch - 1 : nPitch };
+        const auto nLeft { (canvasSize.cx - nPitch * nCount) / 2 };
+
+        const auto& gradient { m_Gradient };
+        const auto& primary  { gradient.front() };
+        const auto& secondary{ gradient.back() };
+
+        const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
+        batch.color(primary.r(), primary.g(), primary.b());
+        if (m_bGradient) {
+            Util::Draw(
+                chroma, barArea,
+                [
+                    &batch, &gradient, nLeft, nPitch, nWidth, primary
+                ] (auto /*fSample*/, auto nX, auto nY) noexcept -> decltype(nX) {
+                    const auto& colorBlend = gradient[nY];
+                    const auto nX0{ nLeft + nX };
+                    batch.color(primary.r(), primary.g(), primary.b());
+                    batch.vertex(nX0         , 0);
+                    batch.vertex(nX0 + nWidth, 0);
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nX0 + nWidth, nY);
+                    batch.vertex(nX0         , nY);
+                    return nX + nPitch;
+                }
+            );
+        } else {
+            Util::Draw(
+                chroma, barArea,
+                [
+                    &batch, nLeft, nPitch, nWidth
+                ] (auto /*fSample*/, auto nX, auto nY) constexpr noexcept -> decltype(nX) {
+                    const auto nX0{ nLeft + nX };
+                    batch.vertex(nX0         , 0);
+                    batch.vertex(nX0 + nWidth, 0);
+                    batch.vertex(nX0 + nWidth, nY);
+                    batch.vertex(nX0         , nY);
+                    return nX + nPitch;
+                }
+            );
+        }
+
+        // Tonic marked by a cap just above the tallest a bar
+        // can be
+        const auto nKey{ AudioDataManager.GetKey() };
+        if (nKey >= 0 && AudioDataManager.GetKeyConfidence() >= MinKeyConfidence) {
+            const auto nX0{ nLeft + static_cast<coord_type>(nKey % nCount) * nPitch };
+            const auto nY0{ barArea.cy + 1 };
+            const auto& cap{ m_bGradient ? secondary : primary };
+            batch.color(cap.r(), cap.g(), cap.b());
+            batch.vertex(nX0         , nY0);
+            batch.vertex(nX0 + nWidth, nY0);
+            batch.vertex(nX0 + nWidth, nY0 + CapHeight);
+            batch.vertex(nX0         , nY0 + CapHeight);
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Chromagram::DrawKey(const audio_data_manager_type& AudioDataManager) {
+        if (m_KeyFont.IsNull()) { return; }
+
+        const auto hDC{ ::Windows::GDI::GetCurrentDC() };
+        if (!hDC) { return; }
+
+        const auto nKey{ AudioDataManager.GetKey() };
+        const auto bKnown{ nKey >= 0 && AudioDataManager.GetKeyConfidence() >= MinKeyConfidence };
+        const auto szKey{
+            bKnown ? ::KeyNames[(nKey >= 12) ? 1 : 0][nKey % 12]
+                   : TEXT("-")
+        };
+
+        // Colour and background mode are set up by the canvas
+        const ::Windows::GDI::ScopedSelectFont _font{ hDC, m_KeyFont };
+        RECT rect{ 0, 0, GetDimensions().cx, KeyHeight() };
+        ::DrawText(hDC, szKey, -1, &rect,
+                   DT_CENTER | DT_TOP | DT_SINGLELINE | DT_NOPREFIX | DT_NOCLIP);
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Chromagram::Draw(render_pass_type ePass,
+                          const audio_data_manager_type& AudioDataManager,
+                          float fInterp) {
+        switch (ePass) {
+            case RenderPass::OpenGL: DrawBars(AudioDataManager, fInterp); break;
+            case RenderPass::GDI:    DrawKey (AudioDataManager);          break;
+            HintNoDefault();
+        }
+    }
+} // namespace Visualisation::SpectrumAnalyser::Chromagram::detail
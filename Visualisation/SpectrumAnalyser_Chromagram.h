@@ -0,0 +1,145 @@
+#pragma once
+#ifndef GUID_9A74E7D3_3817_415F_B85F_DC84CA2995AF
+#define GUID_9A74E7D3_3817_415F_B85F_DC84CA2995AF
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Visualisation/SpectrumAnalyser.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "ColorBlend.h"
+#include "Windows/GDI/GDI.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+//--------------------------------------
+
+namespace Visualisation::SpectrumAnalyser::Chromagram {
+    namespace detail {
+        //**********************************************************************
+        // Chromagram
+        //**********************************************************************
+        //
+        // Twelve pitch class bars (C to B) with the estimated
+        // key written above them.
+        //
+        // Bars are drawn in the OpenGL pass, the key in the
+        // GDI pass; once the key is known its tonic is marked
+        // with a cap above that bar.
+        class Chromagram : public ISpectrumAnalyser {
+        private:
+            using base_class = ISpectrumAnalyser;
+            using this_class = Chromagram;
+
+        public:
+            inline static constexpr const float MinKeyConfidence{ .5f }; //< Below this the key reads "-"
+            inline static constexpr const coord_type CapHeight{ 2 }; //< Tonic marker, in pixels
+
+        protected:
+            // `bGradient`: bars blend from the primary to the
+            // secondary colour with level (and the cap is in
+            // the secondary colour)
+            Chromagram(visualisation_type eType,
+                       const config_type& config,
+                       const dimensions_type& dim,
+                       bool bGradient) noexcept :
+                base_class  { eType, config, dim },
+                m_bGradient { bGradient } {}
+
+        public:
+            virtual void Activate(request_param_type& params,
+                                  const audio_data_manager_type& AudioDataManager) override;
+
+            virtual void Deactivate() override;
+
+            virtual void Draw(render_pass_type ePass,
+                              const audio_data_manager_type& AudioDataManager,
+                              float fInterp) override;
+
+        private:
+            void DrawBars(const audio_data_manager_type& AudioDataManager,
+                          float fInterp);
+            void DrawKey(const audio_data_manager_type& AudioDataManager);
+
+            [[nodiscard]]
+            auto KeyHeight() const noexcept {
+                return std::clamp<coord_type>(GetDimensions().cy / 4, 8, 24);
+            }
+
+            // Above the key, less the cap and a 1 pixel gap
+            [[nodiscard]]
+            auto BarHeight() const noexcept {
+                return GetDimensions().cy - KeyHeight() - CapHeight - 1;
+            }
+
+        private:
+            ::Windows::GDI::CFont    m_KeyFont  { };
+            ::Color::ColorGradient3f m_Gradient { };
+            const bool               m_bGradient{ false };
+        }; // class Chromagram
+    } // namespace detail
+
+    //**************************************************************************
+    // Mono
+    //**************************************************************************
+    class Mono final : public detail::Chromagram {
+    private:
+        using base_class = detail::Chromagram;
+        using this_class = Mono;
+
+    public:
+        static constexpr auto Type() noexcept {
+            return visualisation_type::Chromagram;
+        }
+
+    public:
+        Mono(const config_type& config,
+             const dimensions_type& dim) noexcept :
+            base_class{ Type(), config, dim, false } {}
+    }; // class Mono final
+
+    //**************************************************************************
+    // MonoGradient
+    //**************************************************************************
+    class MonoGradient final : public detail::Chromagram {
+    private:
+        using base_class = detail::Chromagram;
+        using this_class = MonoGradient;
+
+    public:
+        static constexpr auto Type() noexcept {
+            return visualisation_type::Chromagram;
+        }
+
+    public:
+        MonoGradient(const config_type& config,
+                     const dimensions_type& dim) noexcept :
+            base_class{ Type(), config, dim, true } {}
+    }; // class MonoGradient final
+} // namespace Visualisation::SpectrumAnalyser::Chromagram
+
+#endif // GUID_9A74E7D3_3817_415F_B85F_DC84CA2995AF
@@ -0,0 +1,289 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "Visualisation/SpectrumAnalyser_Shader.h"
+#include "Visualisation/SpectrumAnalyser_Util.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Audio_DataManager.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "ColorPacker.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glscopedutil.h"
+#include "GL/glshader.h"
+#include "GL/glprogramcache.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Windows/Windows_Core.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+#include <string>
+//--------------------------------------
+
+namespace {
+    //**************************************************************************
+    // Helpers
+    //**************************************************************************
+    // The visualisation only supplies the fragment shader;
+    // this passes the canvas position through to it.
+    inline constexpr const char s_szVertexShader[]{
+        "#version 110\n"
+        "varying vec2 v_TexCoord;\n"
+        "void main() {\n"
+        "    v_TexCoord  = gl_MultiTexCoord0.xy;\n"
+        "    gl_Position = ftransform();\n"
+        "}\n"
+    };
+
+    //--------------------------------------------------------------------------
+    // dB range mapped to [0,1] (as the VU meter default)
+    inline constexpr const float MinDecibel{ -40.f };
+    inline constexpr const float MaxDecibel{   0.f };
+
+    //--------------------------------------------------------------------------
+    // "<component>.frag" beside the component DLL
+    inline std::filesystem::path ShaderFile() {
+        std::wstring module(MAX_PATH, L'\0');
+        for (;;) {
+            const auto length{ ::GetModuleFileNameW(::Windows::GetInstanceHandle(),
+                                                    module.data(),
+                                                    static_cast<DWORD>(module.size())) };
+            if (length == 0) { return {}; }
+            if (length < module.size()) {
+                module.resize(length);
+                break;
+            }
+            module.resize(module.size() * 2);
+        }
+        return std::filesystem::path{ module }.replace_extension(L".frag");
+    }
+} // namespace <anonymous>
+
+//==============================================================================
+
+namespace Visualisation::SpectrumAnalyser::Shader {
+    //**************************************************************************
+    // Mono
+    //**************************************************************************
+    void Mono::Activate(request_param_type& params,
+                        const audio_data_manager_type& /*AudioDataManager*/) {
+        params.Want = request_param_type::want_type::CombinedSpectrum |
+                      request_param_type::want_type::CombinedWaveform |
+                      request_param_type::want_type::CombinedDecibel;
+
+        // Peak decay happens AFTER transform, units/range is same as output of
+        // transform.
+        m_bPeaks = Config().m_Peak.m_bEnable;
+        if (m_bPeaks) {
+            params.Spectrum.fPeakDecayRate = Config().m_Peak.m_fDecayRate;
+            params.Spectrum.fPeakMininum = 0;
+            params.Decibel.fPeakDecayRate = Config().m_Peak.m_fDecayRate;
+            params.Decibel.fPeakMininum = 0;
+        }
+        params.Spectrum.nSampleCountHint = GetDimensions().cx;
+        params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
+        params.Waveform.nSampleCountHint = GetDimensions().cx;
+        using dB_type = typename request_param_type::dB_type;
+        params.Decibel.fnTransform = [](size_type /*channel*/, dB_type fVal) noexcept {
+            constexpr const auto fMin{ static_cast<dB_type>(::MinDecibel) };
+            constexpr const auto fMax{ static_cast<dB_type>(::MaxDecibel) };
+            return (fVal - fMin) / (fMax - fMin);
+        };
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
+                                               params.PrimaryColor);
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
+                                               params.ClearColor);
+
+        using ColorPacker = ::Color::PackedColor32ui::ABGR;
+        m_Background = ColorPacker::Unpack<color_type>(Config().m_Color.m_Palette.Background);
+        m_Primary    = ColorPacker::Unpack<color_type>(Config().m_Color.m_Palette.Primary);
+        m_Secondary  = ColorPacker::Unpack<color_type>(Config().m_Color.m_Palette.Secondary);
+
+        m_File = ::ShaderFile();
+        m_Time.Start();
+
+        // Sample counts may have changed, start afresh
+        m_Spectrum.destroy();
+        m_Waveform.destroy();
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Mono::Deactivate() {
+        // The program stays cached for next time
+        m_Spectrum.destroy();
+        m_Waveform.destroy();
+        m_Uniforms = {};
+        m_Texels.clear();
+        m_Texels.shrink_to_fit();
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Mono::Upload(texture_type& texture,
+                      ::GLsizei& nWidth,
+                      ::GLint internalFormat,
+                      ::GLenum dataFormat,
+                      ::GLsizei nComponents) {
+        const auto nTexels{ static_cast<::GLsizei>(m_Texels.size()) / nComponents };
+        if (nTexels <= 0) { return; }
+
+        if (!texture || nTexels != nWidth) {
+            // Non power of two widths need OpenGL 2.0, as
+            // does GLSL
+            nWidth = nTexels;
+            texture.create(/*target*/         GL_TEXTURE_1D,
+                           /*internalFormat*/ internalFormat,
+                           /*width*/          nWidth,
+                           /*border*/         0,
+                           /*format*/         dataFormat,
+                           /*type*/           GL_FLOAT,
+                           /*pixels*/         m_Texels.data());
+            // First and last samples are the ends, not a blend
+            // with the border
+            const ::OpenGL::glScopedBindTexture bind_{ texture.scoped_bind(GL_TEXTURE_1D) };
+            texture_type::parameter(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        } else {
+            const ::OpenGL::glScopedBindTexture bind_{ texture.scoped_bind(GL_TEXTURE_1D) };
+            texture_type::sub_image(GL_TEXTURE_1D, 0,
+                                    0, nWidth,
+                                    dataFormat, GL_FLOAT,
+                                    m_Texels.data());
+        }
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Mono::Draw(render_pass_type ePass,
+                    const audio_data_manager_type& AudioDataManager,
+                    float fInterp) {
+        if (ePass != RenderPass::OpenGL) { return; }
+        if (!::OpenGL::glProgram::is_supported()) { return; }
+
+        const auto* pProgram{
+            ::OpenGL::glProgramCache::instance().get(m_File, ::s_szVertexShader)
+        };
+        if (!pProgram) { return; }
+
+        if (m_Uniforms.nProgram != pProgram->name()) {
+            // New, or rebuilt, program
+            m_Uniforms.nProgram   = pProgram->name();
+            m_Uniforms.Spectrum   = pProgram->uniform_location("u_Spectrum");
+            m_Uniforms.Waveform   = pProgram->uniform_location("u_Waveform");
+            m_Uniforms.Decibel    = pProgram->uniform_location("u_Decibel");
+            m_Uniforms.Resolution = pProgram->uniform_location("u_Resolution");
+            m_Uniforms.Time       = pProgram->uniform_location("u_Time");
+            m_Uniforms.TrackTime  = pProgram->uniform_location("u_TrackTime");
+            m_Uniforms.Background = pProgram->uniform_location("u_Background");
+            m_Uniforms.Primary    = pProgram->uniform_location("u_Primary");
+            m_Uniforms.Secondary  = pProgram->uniform_location("u_Secondary");
+        }
+
+        // Spectrum: level and peak per texel
+        if (m_Uniforms.Spectrum >= 0) {
+            const auto samples = AudioDataManager.GetSpectrum(fInterp);
+            m_Texels.resize(samples.size() * 2);
+            for (size_type i = 0; i < samples.size(); ++i) {
+                m_Texels[i * 2] = m_Texels[i * 2 + 1] = static_cast<texel_type>(samples[i]);
+            }
+            if (m_bPeaks) {
+                const auto peaks = AudioDataManager.GetSpectrumPeaks(fInterp);
+                const auto nPeaks{ std::min(peaks.size(), samples.size()) };
+                for (size_type i = 0; i < nPeaks; ++i) {
+                    m_Texels[i * 2 + 1] = static_cast<texel_type>(peaks[i]);
+                }
+            }
+            Upload(m_Spectrum, m_nSpectrumW, GL_LUMINANCE16_ALPHA16, GL_LUMINANCE_ALPHA, 2);
+        }
+
+        // Waveform: [-1,1] as [0,1], as textures clamp
+        if (m_Uniforms.Waveform >= 0) {
+            const auto samples = AudioDataManager.GetWaveform(fInterp);
+            m_Texels.resize(samples.size());
+            for (size_type i = 0; i < samples.size(); ++i) {
+                m_Texels[i] = static_cast<texel_type>(samples[i] * .5f + .5f);
+            }
+            Upload(m_Waveform, m_nWaveformW, GL_LUMINANCE16, GL_LUMINANCE, 1);
+        }
+
+        const auto fDB{ static_cast<float>(AudioDataManager.GetDB(fInterp)) };
+        const auto fDBPeak{
+            m_bPeaks ? static_cast<float>(AudioDataManager.GetDBPeaks(fInterp)) : fDB
+        };
+
+        const auto canvasSize = GetDimensions();
+        const ::OpenGL::glScopedPushAttrib glAttrib{
+            GL_COLOR_BUFFER_BIT |
+                GL_ENABLE_BIT   |
+                GL_TEXTURE_BIT
+        };
+        ::glDisable(GL_BLEND);
+
+        // Samplers on units 0 (spectrum) and 1 (waveform)
+        ::glActiveTexture(GL_TEXTURE1);
+        texture_type::bind(GL_TEXTURE_1D, m_Waveform);
+        ::glActiveTexture(GL_TEXTURE0);
+        texture_type::bind(GL_TEXTURE_1D, m_Spectrum);
+
+        const ::OpenGL::glScopedUseProgram use_{ pProgram->name() };
+        ::glUniform1i(m_Uniforms.Spectrum,   0);
+        ::glUniform1i(m_Uniforms.Waveform,   1);
+        ::glUniform2f(m_Uniforms.Decibel,    fDB, fDBPeak);
+        ::glUniform2f(m_Uniforms.Resolution, static_cast<float>(canvasSize.cx),
+                                             static_cast<float>(canvasSize.cy));
+        ::glUniform1f(m_Uniforms.Time,       m_Time.GetElapsedSeconds());
+        ::glUniform1f(m_Uniforms.TrackTime,  static_cast<float>(AudioDataManager.GetTrackTime()));
+        ::glUniform3f(m_Uniforms.Background, m_Background.r(), m_Background.g(), m_Background.b());
+        ::glUniform3f(m_Uniforms.Primary,    m_Primary.r(),    m_Primary.g(),    m_Primary.b());
+        ::glUniform3f(m_Uniforms.Secondary,  m_Secondary.r(),  m_Secondary.g(),  m_Secondary.b());
+        OpenGLAssertNoError();
+        {
+            const ::OpenGL::glScopedBegin begin_{ GL_QUADS };
+            ::glTexCoord2f(0.f, 0.f); ::glVertex2i(0,             0);
+            ::glTexCoord2f(1.f, 0.f); ::glVertex2i(canvasSize.cx, 0);
+            ::glTexCoord2f(1.f, 1.f); ::glVertex2i(canvasSize.cx, canvasSize.cy);
+            ::glTexCoord2f(0.f, 1.f); ::glVertex2i(0,             canvasSize.cy);
+        }
+
+        ::glActiveTexture(GL_TEXTURE1);
+        texture_type::unbind(GL_TEXTURE_1D);
+        ::glActiveTexture(GL_TEXTURE0);
+        texture_type::unbind(GL_TEXTURE_1D);
+    }
+} // namespace Visualisation::SpectrumAnalyser::Shader
@@ -0,0 +1,147 @@
+#pragma once
+#ifndef GUID_AE7228D9_6BD3_4872_8C93_9D1755A76EAA
+#define GUID_AE7228D9_6BD3_4872_8C93_9D1755A76EAA
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Visualisation/SpectrumAnalyser.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Color.h"
+#include "GL/gltexture.h"
+#include "Windows/Windows_StopWatch.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <filesystem>
+#include <vector>
+//--------------------------------------
+
+namespace Visualisation::SpectrumAnalyser::Shader {
+    //**************************************************************************
+    // Mono
+    //**************************************************************************
+    //
+    // Runs a user supplied GLSL fragment shader over the
+    // whole canvas. The shader is read from the file named
+    // after the component with a ".frag" extension, next to
+    // the component DLL (e.g. "foo_logitech_lcd.frag"), and
+    // is rebuilt whenever that file changes (see
+    // `OpenGL::glProgramCache`).
+    //
+    // The shader (GLSL 1.10) may declare any of:
+    //
+    //  varying vec2      v_TexCoord;   // [0,1] across the canvas
+    //  uniform sampler1D u_Spectrum;   // r: level, a: peak; [0,1], low to high
+    //  uniform sampler1D u_Waveform;   // r: sample * .5 + .5
+    //  uniform vec2      u_Decibel;    // Level, peak; [-40dB,0dB] as [0,1]
+    //  uniform vec2      u_Resolution; // Canvas size in pixels
+    //  uniform float     u_Time;       // Seconds since activation
+    //  uniform float     u_TrackTime;  // Seconds into the track
+    //  uniform vec3      u_Background; // Palette
+    //  uniform vec3      u_Primary;
+    //  uniform vec3      u_Secondary;
+    //
+    // Undeclared (or unused) inputs are simply not set. The
+    // cost is one full canvas quad however busy the shader's
+    // output; without GLSL support (or a shader which has
+    // never built) nothing is drawn.
+    class Mono final : public ISpectrumAnalyser {
+    private:
+        using base_class = ISpectrumAnalyser;
+        using this_class = Mono;
+
+    public:
+        static constexpr auto Type() noexcept {
+            return visualisation_type::Shader;
+        }
+
+    public:
+        Mono(const config_type& config,
+             const dimensions_type& dim) noexcept :
+            base_class{ Type(), config, dim } {}
+
+    public:
+        virtual void Activate(request_param_type& params,
+                              const audio_data_manager_type& AudioDataManager) override;
+
+        virtual void Deactivate() override;
+
+        virtual void Draw(render_pass_type ePass,
+                          const audio_data_manager_type& AudioDataManager,
+                          float fInterp) override;
+
+        // Shaders can animate by `u_Time` and are rebuilt when
+        // their file changes, so every frame is redrawn
+        [[nodiscard]]
+        virtual dirty_rect_type GetDirtyRect(bool /*bInputChanged*/) const noexcept override {
+            const auto dim{ GetDimensions() };
+            return dirty_rect_type::all(dim.cx, dim.cy);
+        }
+
+    private:
+        using texture_type = ::OpenGL::glTexture;
+        using texel_type   = ::GLfloat;
+        using color_type   = ::Color::Color3f;
+
+        // Locations in the current program (-1 if unused)
+        struct uniforms final {
+            ::GLuint nProgram   { 0 };
+            ::GLint  Spectrum   { -1 };
+            ::GLint  Waveform   { -1 };
+            ::GLint  Decibel    { -1 };
+            ::GLint  Resolution { -1 };
+            ::GLint  Time       { -1 };
+            ::GLint  TrackTime  { -1 };
+            ::GLint  Background { -1 };
+            ::GLint  Primary    { -1 };
+            ::GLint  Secondary  { -1 };
+        };
+
+        // `m_Texels` (`nComponents` per texel) into `texture`
+        void Upload(texture_type& texture,
+                    ::GLsizei& nWidth,
+                    ::GLint internalFormat,
+                    ::GLenum dataFormat,
+                    ::GLsizei nComponents);
+
+    private:
+        std::filesystem::path   m_File      { };
+        texture_type            m_Spectrum  { };
+        texture_type            m_Waveform  { };
+        ::GLsizei               m_nSpectrumW{ 0 };
+        ::GLsizei               m_nWaveformW{ 0 };
+        std::vector<texel_type> m_Texels    { }; //< Upload scratch
+        uniforms                m_Uniforms  { };
+        color_type              m_Background{ };
+        color_type              m_Primary   { };
+        color_type              m_Secondary { };
+        ::Windows::StopWatch    m_Time      { };
+        bool                    m_bPeaks    { false };
+    }; // class Mono final
+} // namespace Visualisation::SpectrumAnalyser::Shader
+
+#endif // GUID_AE7228D9_6BD3_4872_8C93_9D1755A76EAA
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "CommonHeaders.h"
+#include "Visualisation/SpectrumAnalyser_Spectrogram.h"
+#include "Visualisation/SpectrumAnalyser_Util.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "Audio_DataManager.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "ColorBlend.h"
+#include "ColorPacker.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "GL/glcommon.h"
+#include "GL/glscopedutil.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <algorithm>
+//--------------------------------------
+
+namespace {
+    //**************************************************************************
+    // Helpers
+    //**************************************************************************
+    template <typename ValueT>
+    inline constexpr ValueT NextPowerOfTwo(ValueT val) noexcept {
+        ValueT pow2{ 1 };
+        while (pow2 < val) { pow2 <<= 1; }
+        return pow2;
+    }
+
+    //--------------------------------------------------------------------------
+    // 4x4 ordered dither (Bayer) thresholds, in [0, 255]
+    inline constexpr const int BayerThreshold[4][4]{
+        {   8, 136,  40, 168 },
+        { 200,  72, 232, 104 },
+        {  56, 184,  24, 152 },
+        { 248, 120, 216,  88 },
+    };
+} // namespace <anonymous>
+
+//==============================================================================
+
+namespace Visualisation::SpectrumAnalyser::Spectrogram::detail {
+    //**************************************************************************
+    // Spectrogram
+    //**************************************************************************
+    void Spectrogram::Activate(request_param_type& params,
+                               const audio_data_manager_type& /*AudioDataManager*/) {
+        params.Want = request_param_type::want_type::CombinedSpectrum;
+        params.Spectrum.nSampleCountHint = GetDimensions().cy; //< One bin per row
+        params.Spectrum.fnTransform = Util::Transformer{ Config() };
+        params.Spectrum.nBinsPerOctave = BinsPerOctave();
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Primary,
+                                               params.PrimaryColor);
+        ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
+                                               params.ClearColor);
+
+        // Level -> colour: background to primary, then (for the
+        // gradient) on to secondary. The dithered version only
+        // uses the two ends.
+        using ColorPacker = ::Color::PackedColor32ui::ABGR;
+        const auto background{ ColorPacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Background) };
+        const auto primary   { ColorPacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary) };
+        const auto secondary { ColorPacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
+        constexpr const auto fMaxLevel{ static_cast<float>(LevelCount - 1) };
+        for (size_type i = 0; i < LevelCount; ++i) {
+            const auto fLevel{ static_cast<float>(i) / fMaxLevel };
+            const auto color{
+                (m_bDither || fLevel <= .5f)
+                    ? ::Color::ColorBlend(background, primary, m_bDither ? fLevel : fLevel * 2.f)
+                    : ::Color::ColorBlend(primary, secondary, fLevel * 2.f - 1.f)
+            };
+            m_ColorLUT[i] = ColorPacker::Pack(color);
+        }
+
+        // Palette or size may have changed, start afresh
+        m_History.destroy();
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Spectrogram::Deactivate() {
+        m_History.destroy();
+        m_ColumnPixels.clear();
+        m_ColumnPixels.shrink_to_fit();
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Spectrogram::CreateHistory() {
+        const auto canvasSize = GetDimensions();
+        // Power of two for OpenGL 1.1; only the canvas sized
+        // corner is used
+        m_nHistoryW = ::NextPowerOfTwo(std::max(canvasSize.cx, 1));
+        m_nHistoryH = ::NextPowerOfTwo(std::max(canvasSize.cy, 1));
+        m_nColumn   = 0;
+        m_nLastFrame = 0;
+
+        const std::vector<pixel_type> clear(static_cast<size_type>(m_nHistoryW) *
+                                            static_cast<size_type>(m_nHistoryH),
+                                            m_ColorLUT.front());
+        m_History.create(/*target*/         GL_TEXTURE_2D,
+                         /*internalFormat*/ GL_RGBA,
+                         /*width*/          m_nHistoryW,
+                         /*height*/         m_nHistoryH,
+                         /*border*/         0,
+                         /*format*/         GL_RGBA,
+                         /*type*/           GL_UNSIGNED_BYTE,
+                         /*pixels*/         clear.data());
+
+        // Columns must not bleed into their neighbours
+        const ::OpenGL::glScopedBindTexture bind_{ m_History.scoped_bind(GL_TEXTURE_2D) };
+        texture_type::parameter(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        texture_type::parameter(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        m_ColumnPixels.resize(static_cast<size_type>(canvasSize.cy));
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Spectrogram::WriteColumn(const sample_type* samples,
+                                  size_type count) {
+        const auto canvasSize = GetDimensions();
+        const auto nRows{ m_ColumnPixels.size() };
+        if (!samples || count == 0 || nRows == 0) { return; }
+
+        constexpr const auto fMaxLevel{ static_cast<sample_type>(LevelCount - 1) };
+        const auto& threshold{ ::BayerThreshold[m_nColumn & 3] };
+        const auto pixelOff{ m_ColorLUT.front() };
+        const auto pixelOn { m_ColorLUT.back() };
+        for (size_type row = 0; row < nRows; ++row) {
+            const auto fSample{ samples[(row * count) / nRows] };
+            const auto nLevel{
+                static_cast<int>(std::clamp(fSample, static_cast<sample_type>(0), static_cast<sample_type>(1)) * fMaxLevel + .5f)
+            };
+            m_ColumnPixels[row] = m_bDither
+                ? ((nLevel > threshold[row & 3]) ? pixelOn : pixelOff)
+                : m_ColorLUT[static_cast<size_type>(nLevel)];
+        }
+
+        const ::OpenGL::glScopedBindTexture bind_{ m_History.scoped_bind(GL_TEXTURE_2D) };
+        texture_type::sub_image(GL_TEXTURE_2D, 0,
+                                m_nColumn, 0,
+                                1, static_cast<GLsizei>(nRows),
+                                GL_RGBA, GL_UNSIGNED_BYTE,
+                                m_ColumnPixels.data());
+        m_nColumn = (m_nColumn + 1) % std::max(canvasSize.cx, 1);
+    }
+
+    //--------------------------------------------------------------------------
+
+    void Spectrogram::Draw(render_pass_type ePass,
+                           const audio_data_manager_type& AudioDataManager,
+                           float /*fInterp*/) {
+        if (ePass != RenderPass::OpenGL) { return; }
+
+        if (!m_History) { CreateHistory(); }
+        if (!m_History) { return; }
+
+        // One column per analysis update, however often drawn.
+        // Columns are history so always use the newest data.
+        const auto nFrame{ static_cast<std::int64_t>(AudioDataManager.GetFrameTimestamp()) };
+        if (nFrame != m_nLastFrame) {
+            m_nLastFrame = nFrame;
+            const auto samples = AudioDataManager.GetSpectrum(1.f);
+            WriteColumn(samples.data(), samples.size());
+        }
+
+        // Oldest column (`m_nColumn`) at the left edge, so the
+        // ring is drawn in two parts split at the write position
+        const auto canvasSize = GetDimensions();
+        const auto fScaleS{ 1.f / static_cast<float>(m_nHistoryW) };
+        const auto fT1{ static_cast<float>(canvasSize.cy) / static_cast<float>(m_nHistoryH) };
+        const auto nSplitX{ canvasSize.cx - m_nColumn };
+        const auto fSplitS{ static_cast<float>(m_nColumn) * fScaleS };
+        const auto fEndS  { static_cast<float>(canvasSize.cx) * fScaleS };
+
+        const ::OpenGL::glScopedPushAttrib glAttrib{
+            GL_COLOR_BUFFER_BIT |
+                GL_ENABLE_BIT   |
+                GL_TEXTURE_BIT
+        };
+        ::glEnable(GL_TEXTURE_2D);
+        ::glDisable(GL_BLEND);
+        ::glColor4f(1.f, 1.f, 1.f, 1.f);
+        {
+            const ::OpenGL::glScopedBindTexture bind_{ m_History.scoped_bind(GL_TEXTURE_2D) };
+            const ::OpenGL::glScopedBegin       begin_{ GL_QUADS };
+            // Oldest: [m_nColumn, cx)
+            ::glTexCoord2f(fSplitS, 0.f); ::glVertex2i(0,       0);
+            ::glTexCoord2f(fEndS,   0.f); ::glVertex2i(nSplitX, 0);
+            ::glTexCoord2f(fEndS,   fT1); ::glVertex2i(nSplitX, canvasSize.cy);
+            ::glTexCoord2f(fSplitS, fT1); ::glVertex2i(0,       canvasSize.cy);
+            // Newest: [0, m_nColumn)
+            ::glTexCoord2f(0.f,     0.f); ::glVertex2i(nSplitX,       0);
+            ::glTexCoord2f(fSplitS, 0.f); ::glVertex2i(canvasSize.cx, 0);
+            ::glTexCoord2f(fSplitS, fT1); ::glVertex2i(canvasSize.cx, canvasSize.cy);
+            ::glTexCoord2f(0.f,     fT1); ::glVertex2i(nSplitX,       canvasSize.cy);
+        }
+    }
+} // namespace Visualisation::SpectrumAnalyser::Spectrogram::detail
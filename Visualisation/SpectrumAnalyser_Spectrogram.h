@@ -0,0 +1,145 @@
+#pragma once
+#ifndef GUID_61AAA4D9_2F01_457B_A9CF_A1C1BC5E1CD9
+#define GUID_61AAA4D9_2F01_457B_A9CF_A1C1BC5E1CD9
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "Visualisation/SpectrumAnalyser.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include "GL/gltexture.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <cstdint>
+#include <array>
+#include <vector>
+//--------------------------------------
+
+namespace Visualisation::SpectrumAnalyser::Spectrogram {
+    namespace detail {
+        //**********************************************************************
+        // Spectrogram
+        //**********************************************************************
+        //
+        // Scrolling spectrogram: time along X (newest on the
+        // right), frequency along Y and intensity as colour.
+        //
+        // History is a texture used as a ring of columns; each
+        // new spectrum writes one column (through a colour
+        // lookup table) and the ring is drawn as two quads
+        // split at the write position, so the history is never
+        // redrawn or moved.
+        class Spectrogram : public ISpectrumAnalyser {
+        private:
+            using base_class = ISpectrumAnalyser;
+            using this_class = Spectrogram;
+
+        public:
+            using pixel_type = std::uint32_t; //< Packed ABGR (GL_RGBA bytes)
+
+            inline static constexpr const size_type LevelCount{ 256 };
+
+        protected:
+            // `bDither`: two colour ordered dither (for the
+            // monochrome display) rather than a gradient.
+            Spectrogram(visualisation_type eType,
+                        const config_type& config,
+                        const dimensions_type& dim,
+                        bool bDither) noexcept :
+                base_class{ eType, config, dim },
+                m_bDither { bDither } {}
+
+        public:
+            virtual void Activate(request_param_type& params,
+                                  const audio_data_manager_type& AudioDataManager) override;
+
+            virtual void Deactivate() override;
+
+            virtual void Draw(render_pass_type ePass,
+                              const audio_data_manager_type& AudioDataManager,
+                              float fInterp) override;
+
+        private:
+            void CreateHistory();
+            void WriteColumn(const sample_type* samples,
+                             size_type count);
+
+        private:
+            using texture_type = ::OpenGL::glTexture;
+            using lut_type     = std::array<pixel_type, LevelCount>;
+
+            texture_type             m_History      { };
+            coord_type               m_nHistoryW    { 0 }; //< Texture size (power of two)
+            coord_type               m_nHistoryH    { 0 };
+            coord_type               m_nColumn      { 0 }; //< Next column to write (oldest)
+            lut_type                 m_ColorLUT     { };
+            std::vector<pixel_type>  m_ColumnPixels { };
+            std::int64_t             m_nLastFrame   { 0 }; //< `GetFrameTimestamp` of last column
+            const bool               m_bDither      { false };
+        }; // class Spectrogram
+    } // namespace detail
+
+    //**************************************************************************
+    // Mono
+    //**************************************************************************
+    class Mono final : public detail::Spectrogram {
+    private:
+        using base_class = detail::Spectrogram;
+        using this_class = Mono;
+
+    public:
+        static constexpr auto Type() noexcept {
+            return visualisation_type::Spectrogram;
+        }
+
+    public:
+        Mono(const config_type& config,
+             const dimensions_type& dim) noexcept :
+            base_class{ Type(), config, dim, true } {}
+    }; // class Mono final
+
+    //**************************************************************************
+    // MonoGradient
+    //**************************************************************************
+    class MonoGradient final : public detail::Spectrogram {
+    private:
+        using base_class = detail::Spectrogram;
+        using this_class = MonoGradient;
+
+    public:
+        static constexpr auto Type() noexcept {
+            return visualisation_type::Spectrogram;
+        }
+
+    public:
+        MonoGradient(const config_type& config,
+                     const dimensions_type& dim) noexcept :
+            base_class{ Type(), config, dim, false } {}
+    }; // class MonoGradient final
+} // namespace Visualisation::SpectrumAnalyser::Spectrogram
+
+#endif // GUID_61AAA4D9_2F01_457B_A9CF_A1C1BC5E1CD9
@@ -121,6 +121,24 @@ namespace Visualisation::SpectrumAnalyser {
             const mode_type   m_eTransform{ mode_type::NonLinear4 };
         }; // struct Transformer final
 
+        //==================================================
+        // Length in pixels of a bar `fScale` pixels long at
+        // full scale: `fSample * fScale + fBias` rounded (half
+        // up), with `fBias` 0, or .5 for the odd pixel of a
+        // split height. Only the product is rounded to
+        // `sample_type`, the bias moving the threshold, so
+        // `OpenGL::glInterpolatedVertices` repeats this
+        // exactly in its shader (`sample_type` permitting).
+        static coord_type Pixels(sample_type fSample,
+                                 sample_type fScale,
+                                 sample_type fBias) noexcept {
+            constexpr const auto fHalf{ static_cast<sample_type>(.5) };
+            const auto fPixels = fSample * fScale;
+            const auto fWhole = std::floor(fPixels);
+            const auto nWhole = static_cast<coord_type>(fWhole);
+            return (fPixels >= fWhole + (fHalf - fBias)) ? nWhole + 1 : nWhole;
+        }
+
         //==================================================
         // These functions assume the passed lambdas will be
         // inlined; if they are not, the functions should be
@@ -134,8 +152,7 @@ namespace Visualisation::SpectrumAnalyser {
             const auto fHeight = static_cast<sample_type>(canvasSize.cy);
             coord_type nX = 0;
             for (const auto fSample : samples) {
-                const auto fY = std::round(fSample * fHeight);
-                const auto nY = static_cast<coord_type>(fY);
+                const auto nY = Pixels(fSample, fHeight, 0);
                 nX = fnDraw(fSample, nX, nY);
             }
         } // static void Draw(...)
@@ -151,20 +168,23 @@ namespace Visualisation::SpectrumAnalyser {
             assert(samplesL.size() == samplesR.size());
             const auto count = std::min(samplesL.size(), samplesR.size());
             const auto fHeight = static_cast<sample_type>(canvasSize.cy);
-            const auto fHalfHeight = fHeight * .5;
+            const auto fHalfHeight = fHeight * static_cast<sample_type>(.5);
+            // Left grows from the middle row, right from the row
+            // below it for an odd height, which gets the half pixel
+            const auto nBaseL = canvasSize.cy / 2;
+            const auto nBaseR = canvasSize.cy - nBaseL;
+            const auto fBias = static_cast<sample_type>((canvasSize.cy % 2) != 0 ? .5 : 0.);
             coord_type nXL = 0, nXR = 0;
             for (size_type i = 0; i < count; ++i) {
                 {
                     const auto fSampleL = samplesL[i];
-                    const auto fYL = std::round(fSampleL * fHalfHeight + fHalfHeight);
-                    const auto nYL = static_cast<coord_type>(fYL);
+                    const auto nYL = nBaseL + Pixels(fSampleL, fHalfHeight, fBias);
                     nXL = fnDraw(fSampleL, nXL, nYL);
                 }
 
                 {
                     const auto fSampleR = samplesR[i];
-                    const auto fYR = std::round(fSampleR * fHalfHeight + fHalfHeight);
-                    const auto nYR = canvasSize.cy - static_cast<coord_type>(fYR);
+                    const auto nYR = nBaseR - Pixels(fSampleR, fHalfHeight, fBias);
                     nXR = fnDraw(fSampleR, nXR, nYR);
                 }
             }
@@ -196,8 +196,36 @@ namespace Visualisation::Text {
 
         m_TrackDetails.Draw(fInterp);
 
-        if (Config().m_ProgressBar.m_bEnabled && m_bShowProgress) {
+        m_bProgressDrawn = Config().m_ProgressBar.m_bEnabled && m_bShowProgress;
+        if (m_bProgressDrawn) {
             m_Progress.Draw(fInterp);
         }
     }
+
+    //--------------------------------------------------------------------------
+
+    // Drawing depends only on the text and progress bar, which
+    // track their own changes, so audio data is ignored.
+    TrackDetails::dirty_rect_type TrackDetails::GetDirtyRect(bool /*bInputChanged*/) const noexcept {
+        const auto dim{ GetDimensions() };
+
+        // Lines can be drawn past the text's clip (e.g. part
+        // of one at the bottom), so any change to the text
+        // redraws everything
+        const bool bProgress{ Config().m_ProgressBar.m_bEnabled && m_bShowProgress };
+        if (m_TrackDetails.IsDirty() || (bProgress != m_bProgressDrawn)) {
+            return dirty_rect_type::all(dim.cx, dim.cy);
+        }
+
+        if (bProgress && m_Progress.IsDirty()) {
+            const auto rect{ m_Progress.GetDirtyRect() };
+            return {
+                static_cast<dirty_rect_type::coord_type>(rect.left),
+                static_cast<dirty_rect_type::coord_type>(rect.top),
+                static_cast<dirty_rect_type::coord_type>(rect.right),
+                static_cast<dirty_rect_type::coord_type>(rect.bottom)
+            };
+        }
+        return {};
+    }
 } // namespace Visualisation::Text
@@ -37,6 +37,8 @@ namespace Visualisation::Text {
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) override;
 
+        virtual dirty_rect_type GetDirtyRect(bool bInputChanged) const noexcept override;
+
     private: //Methods
         void UpdateText(const audio_data_manager_type& AudioDataManager);
         void UpdateProgress(const audio_data_manager_type& AudioDataManager);
@@ -48,6 +50,7 @@ namespace Visualisation::Text {
         track_info_type m_TrackDetails;
         progress_bar_type m_Progress;
         bool m_bShowProgress;
+        bool m_bProgressDrawn{ false };
 
         int m_nMaxLines;
     }; // class TrackDetails
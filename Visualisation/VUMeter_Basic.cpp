@@ -41,6 +41,7 @@
 //
 #include "GL/glcommon.h"
 #include "GL/glscopedutil.h"
+#include "GL/glbatch.h"
 //--------------------------------------
 
 namespace Visualisation::VUMeter::HorizontalSplit {
@@ -70,6 +71,9 @@ namespace Visualisation::VUMeter::HorizontalSplit {
                       const audio_data_manager_type& AudioDataManager,
                       float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
         const auto nWidth = canvasSize.cx;
@@ -86,16 +90,16 @@ namespace Visualisation::VUMeter::HorizontalSplit {
         const auto fBarLengthR = std::max(0.0f, std::min(fWidth, fLevelR));
 
         {
-            const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
             {
                 const auto nBarL_X0 = 0;
                 const auto nBarL_Y0 = 0;
                 const auto nBarL_X1 = static_cast<coord_type>(fBarLengthL);
                 const auto nBarL_Y1 = nHalfHeight;
-                ::glVertex2i(nBarL_X0, nBarL_Y0);
-                ::glVertex2i(nBarL_X1, nBarL_Y0);
-                ::glVertex2i(nBarL_X1, nBarL_Y1);
-                ::glVertex2i(nBarL_X0, nBarL_Y1);
+                batch.vertex(nBarL_X0, nBarL_Y0);
+                batch.vertex(nBarL_X1, nBarL_Y0);
+                batch.vertex(nBarL_X1, nBarL_Y1);
+                batch.vertex(nBarL_X0, nBarL_Y1);
             }
 
             {
@@ -103,10 +107,10 @@ namespace Visualisation::VUMeter::HorizontalSplit {
                 const auto nBarR_Y0 = nHalfHeight + 1;
                 const auto nBarR_X1 = static_cast<coord_type>(fBarLengthR);
                 const auto nBarR_Y1 = nHeight;
-                ::glVertex2i(nBarR_X0, nBarR_Y0);
-                ::glVertex2i(nBarR_X1, nBarR_Y0);
-                ::glVertex2i(nBarR_X1, nBarR_Y1);
-                ::glVertex2i(nBarR_X0, nBarR_Y1);
+                batch.vertex(nBarR_X0, nBarR_Y0);
+                batch.vertex(nBarR_X1, nBarR_Y0);
+                batch.vertex(nBarR_X1, nBarR_Y1);
+                batch.vertex(nBarR_X0, nBarR_Y1);
             }
         }
 
@@ -115,14 +119,14 @@ namespace Visualisation::VUMeter::HorizontalSplit {
             const auto fPeakL = AudioDataManager.GetDBPeaks(Audio::Channel::Left,  fInterp) * fWidth;
             const auto fPeakR = AudioDataManager.GetDBPeaks(Audio::Channel::Right, fInterp) * fWidth;
 
-            const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
             {
                 const auto nPeakL_X0 = static_cast<coord_type>(fPeakL);
                 const auto nPeakL_Y0 = 0;
                 const auto nPeakL_X1 = nPeakL_X0;
                 const auto nPeakL_Y1 = nHalfHeight;
-                ::glVertex2i(nPeakL_X0, nPeakL_Y0);
-                ::glVertex2i(nPeakL_X1, nPeakL_Y1);
+                batch.vertex(nPeakL_X0, nPeakL_Y0);
+                batch.vertex(nPeakL_X1, nPeakL_Y1);
             }
 
             {
@@ -130,8 +134,8 @@ namespace Visualisation::VUMeter::HorizontalSplit {
                 const auto nPeakR_Y0 = nHalfHeight + 1;
                 const auto nPeakR_X1 = nPeakR_X0;
                 const auto nPeakR_Y1 = nHeight;
-                ::glVertex2i(nPeakR_X0, nPeakR_Y0);
-                ::glVertex2i(nPeakR_X1, nPeakR_Y1);
+                batch.vertex(nPeakR_X0, nPeakR_Y0);
+                batch.vertex(nPeakR_X1, nPeakR_Y1);
             }
         }
     }
@@ -154,6 +158,12 @@ namespace Visualisation::VUMeter::HorizontalSplit {
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        // A colour per pixel of bar length
+        m_Gradient.set(ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary),
+                       ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary),
+                       GetDimensions().cx);
     }
 
     //--------------------------------------------------------------------------
@@ -163,9 +173,11 @@ namespace Visualisation::VUMeter::HorizontalSplit {
                               float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
 
-        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
-        const auto color0{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary) };
-        const auto color1{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
+        const auto& gradient{ m_Gradient };
+        const auto& color0  { gradient.front() };
+        const auto& color1  { gradient.back() };
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
 
         const auto canvasSize = GetDimensions();
 
@@ -193,56 +205,56 @@ namespace Visualisation::VUMeter::HorizontalSplit {
             const auto nBarR_X1 = static_cast<coord_type>(fBarLengthR);
             const auto nBarR_Y1 = nHeight;
 
-            const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
             if (Config().m_Color.m_bAltGradientMode) {
                 {
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarL_X0, nBarL_Y0);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarL_X0, nBarL_Y0);
 
-                    ::glColor3f(color1.r(), color1.g(), color1.b());
-                    ::glVertex2i(nBarL_X1, nBarL_Y0);
-                    ::glVertex2i(nBarL_X1, nBarL_Y1);
+                    batch.color(color1.r(), color1.g(), color1.b());
+                    batch.vertex(nBarL_X1, nBarL_Y0);
+                    batch.vertex(nBarL_X1, nBarL_Y1);
 
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarL_X0, nBarL_Y1);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarL_X0, nBarL_Y1);
                 }
 
                 {
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarR_X0, nBarR_Y0);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarR_X0, nBarR_Y0);
 
-                    ::glColor3f(color1.r(), color1.g(), color1.b());
-                    ::glVertex2i(nBarR_X1, nBarR_Y0);
-                    ::glVertex2i(nBarR_X1, nBarR_Y1);
+                    batch.color(color1.r(), color1.g(), color1.b());
+                    batch.vertex(nBarR_X1, nBarR_Y0);
+                    batch.vertex(nBarR_X1, nBarR_Y1);
 
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarR_X0, nBarR_Y1);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarR_X0, nBarR_Y1);
                 }
             } else {
                 {
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarL_X0, nBarL_Y0);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarL_X0, nBarL_Y0);
 
-                    const auto colorBlend = ::Color::ColorBlend(color0, color1, fBarLengthL / fWidth);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nBarL_X1, nBarL_Y0);
-                    ::glVertex2i(nBarL_X1, nBarL_Y1);
+                    const auto& colorBlend = gradient[nBarL_X1];
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nBarL_X1, nBarL_Y0);
+                    batch.vertex(nBarL_X1, nBarL_Y1);
 
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarL_X0, nBarL_Y1);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarL_X0, nBarL_Y1);
                 }
 
                 {
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarR_X0, nBarR_Y0);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarR_X0, nBarR_Y0);
 
-                    const auto colorBlend = ::Color::ColorBlend(color0, color1, fBarLengthR / fWidth);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nBarR_X1, nBarR_Y0);
-                    ::glVertex2i(nBarR_X1, nBarR_Y1);
+                    const auto& colorBlend = gradient[nBarR_X1];
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nBarR_X1, nBarR_Y0);
+                    batch.vertex(nBarR_X1, nBarR_Y1);
 
-                    ::glColor3f(color0.r(), color0.g(), color0.b());
-                    ::glVertex2i(nBarR_X0, nBarR_Y1);
+                    batch.color(color0.r(), color0.g(), color0.b());
+                    batch.vertex(nBarR_X0, nBarR_Y1);
                 }
             }
         }
@@ -262,34 +274,34 @@ namespace Visualisation::VUMeter::HorizontalSplit {
             const auto nPeakR_X1 = nPeakR_X0;
             const auto nPeakR_Y1 = nHeight;
 
-            const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
             if (Config().m_Color.m_bAltGradientMode) {
-                ::glColor3f(color1.r(), color1.g(), color1.b());
+                batch.color(color1.r(), color1.g(), color1.b());
 
                 {
-                    ::glVertex2i(nPeakL_X0, nPeakL_Y0);
-                    ::glVertex2i(nPeakL_X1, nPeakL_Y1);
+                    batch.vertex(nPeakL_X0, nPeakL_Y0);
+                    batch.vertex(nPeakL_X1, nPeakL_Y1);
                 }
 
                 {
-                    ::glVertex2i(nPeakR_X0, nPeakR_Y0);
-                    ::glVertex2i(nPeakR_X1, nPeakR_Y1);
+                    batch.vertex(nPeakR_X0, nPeakR_Y0);
+                    batch.vertex(nPeakR_X1, nPeakR_Y1);
                 }
             } else {
                 {
-                    const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeakL / fWidth);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    const auto& colorBlend = gradient[nPeakL_X0];
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
 
-                    ::glVertex2i(nPeakL_X0, nPeakL_Y0);
-                    ::glVertex2i(nPeakL_X1, nPeakL_Y1);
+                    batch.vertex(nPeakL_X0, nPeakL_Y0);
+                    batch.vertex(nPeakL_X1, nPeakL_Y1);
                 }
 
                 {
-                    const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeakR / fWidth);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    const auto& colorBlend = gradient[nPeakR_X0];
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
 
-                    ::glVertex2i(nPeakR_X0, nPeakR_Y0);
-                    ::glVertex2i(nPeakR_X1, nPeakR_Y1);
+                    batch.vertex(nPeakR_X0, nPeakR_Y0);
+                    batch.vertex(nPeakR_X1, nPeakR_Y1);
                 }
             }
         }
@@ -325,6 +337,9 @@ namespace Visualisation::VUMeter::VerticalSplit {
                       const audio_data_manager_type& AudioDataManager,
                       float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
 
         const auto nWidth = canvasSize.cx;
@@ -351,19 +366,19 @@ namespace Visualisation::VUMeter::VerticalSplit {
             const auto nBarR_X1 = nWidth - static_cast<coord_type>(fBarLengthR);
             const auto nBarR_Y1 = nHeight;
 
-            const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
             {
-                ::glVertex2i(nBarL_X0, nBarL_Y0);
-                ::glVertex2i(nBarL_X0, nBarL_Y1);
-                ::glVertex2i(nBarL_X1, nBarL_Y1);
-                ::glVertex2i(nBarL_X1, nBarL_Y0);
+                batch.vertex(nBarL_X0, nBarL_Y0);
+                batch.vertex(nBarL_X0, nBarL_Y1);
+                batch.vertex(nBarL_X1, nBarL_Y1);
+                batch.vertex(nBarL_X1, nBarL_Y0);
             }
 
             {
-                ::glVertex2i(nBarR_X0, nBarR_Y0);
-                ::glVertex2i(nBarR_X0, nBarR_Y1);
-                ::glVertex2i(nBarR_X1, nBarR_Y1);
-                ::glVertex2i(nBarR_X1, nBarR_Y0);
+                batch.vertex(nBarR_X0, nBarR_Y0);
+                batch.vertex(nBarR_X0, nBarR_Y1);
+                batch.vertex(nBarR_X1, nBarR_Y1);
+                batch.vertex(nBarR_X1, nBarR_Y0);
             }
         }
 
@@ -382,15 +397,15 @@ namespace Visualisation::VUMeter::VerticalSplit {
             const auto nPeakR_X1 = nPeakR_X0;
             const auto nPeakR_Y1 = nHeight;
 
-            const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
             {
-                ::glVertex2i(nPeakL_X0, nPeakL_Y0);
-                ::glVertex2i(nPeakL_X1, nPeakL_Y1);
+                batch.vertex(nPeakL_X0, nPeakL_Y0);
+                batch.vertex(nPeakL_X1, nPeakL_Y1);
             }
 
             {
-                ::glVertex2i(nPeakR_X0, nPeakR_Y0);
-                ::glVertex2i(nPeakR_X1, nPeakR_Y1);
+                batch.vertex(nPeakR_X0, nPeakR_Y0);
+                batch.vertex(nPeakR_X1, nPeakR_Y1);
             }
         }
     }
@@ -413,6 +428,12 @@ namespace Visualisation::VUMeter::VerticalSplit {
                                                params.PrimaryColor);
         ::Color::PackedColor32ui::ABGR::Unpack(Config().m_Color.m_Palette.Background,
                                                params.ClearColor);
+
+        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
+        // A colour per pixel of bar length (each channel has half)
+        m_Gradient.set(ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary),
+                       ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary),
+                       GetDimensions().cx / 2);
     }
 
     //--------------------------------------------------------------------------
@@ -421,13 +442,15 @@ namespace Visualisation::VUMeter::VerticalSplit {
                               const audio_data_manager_type& AudioDataManager,
                               float fInterp) {
         if (ePass != RenderPass::OpenGL) { return; }
+
+        auto& batch{ ::OpenGL::glVertexBatch::instance() };
+
         const auto canvasSize = GetDimensions();
         const auto nHalfWidth = canvasSize.cx / 2;
         const auto fHalfWidth = static_cast<float>(nHalfWidth);
 
-        using ColorUnpacker = ::Color::PackedColor32ui::ABGR;
-        const auto color0{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Primary) };
-        const auto color1{ ColorUnpacker::Unpack<::Color::Color3f>(Config().m_Color.m_Palette.Secondary) };
+        const auto& gradient{ m_Gradient };
+        const auto& color0  { gradient.front() };
 
         // Transformer will have converted these values to the range [0,1]
         const auto fLevelL = static_cast<float>(AudioDataManager.GetDB(Audio::Channel::Left,  fInterp)) * fHalfWidth;
@@ -439,35 +462,35 @@ namespace Visualisation::VUMeter::VerticalSplit {
         const auto nBarLengthR = static_cast<coord_type>(fBarLengthR);
 
         {
-            const ::OpenGL::glScopedBegin _begin{ GL_QUADS };
+            const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_QUADS };
             {
                 constexpr const coord_type nX0 = 0, nY0 = 0;
                 const coord_type nX1 = nBarLengthL, nY1 = canvasSize.cy;
-                ::glColor3f(color0.r(), color0.g(), color0.b());
-                ::glVertex2i(nX0, 0);
+                batch.color(color0.r(), color0.g(), color0.b());
+                batch.vertex(nX0, 0);
 
-                const auto colorBlend = ::Color::ColorBlend(color0, color1, fBarLengthL / fHalfWidth);
-                ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                ::glVertex2i(nX1, nY0);
-                ::glVertex2i(nX1, nY1);
+                const auto& colorBlend = gradient[nBarLengthL];
+                batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                batch.vertex(nX1, nY0);
+                batch.vertex(nX1, nY1);
 
-                ::glColor3f(color0.r(), color0.g(), color0.b());
-                ::glVertex2i(nX0, nY1);
+                batch.color(color0.r(), color0.g(), color0.b());
+                batch.vertex(nX0, nY1);
             }
 
             {
                 const coord_type nX0 = canvasSize.cx, nY0 = 0;
                 const coord_type nX1 = canvasSize.cx - nBarLengthR, nY1 = canvasSize.cy;
-                ::glColor3f(color0.r(), color0.g(), color0.b());
-                ::glVertex2i(nX0, nY0);
+                batch.color(color0.r(), color0.g(), color0.b());
+                batch.vertex(nX0, nY0);
 
-                const auto colorBlend = ::Color::ColorBlend(color0, color1, fBarLengthR / fHalfWidth);
-                ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                ::glVertex2i(nX1, nY0);
-                ::glVertex2i(nX1, nY1);
+                const auto& colorBlend = gradient[nBarLengthR];
+                batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                batch.vertex(nX1, nY0);
+                batch.vertex(nX1, nY1);
 
-                ::glColor3f(color0.r(), color0.g(), color0.b());
-                ::glVertex2i(nX0, nY1);
+                batch.color(color0.r(), color0.g(), color0.b());
+                batch.vertex(nX0, nY1);
             }
         }
 
@@ -480,20 +503,20 @@ namespace Visualisation::VUMeter::VerticalSplit {
             const auto nPeakR = static_cast<coord_type>(fPeakR);
 
             {
-                const ::OpenGL::glScopedBegin _begin{ GL_LINES };
+                const ::OpenGL::glScopedBatchBegin _begin{ batch, GL_LINES };
                 {
-                    const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeakL / fHalfWidth);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nPeakL, 0);
-                    ::glVertex2i(nPeakL, canvasSize.cy);
+                    const auto& colorBlend = gradient[nPeakL];
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nPeakL, 0);
+                    batch.vertex(nPeakL, canvasSize.cy);
                 }
 
                 {
                     const auto nX = canvasSize.cx - nPeakR;
-                    const auto colorBlend = ::Color::ColorBlend(color0, color1, fPeakR / fHalfWidth);
-                    ::glColor3f(colorBlend.r(), colorBlend.g(), colorBlend.b());
-                    ::glVertex2i(nX, 0);
-                    ::glVertex2i(nX, canvasSize.cy);
+                    const auto& colorBlend = gradient[nPeakR];
+                    batch.color(colorBlend.r(), colorBlend.g(), colorBlend.b());
+                    batch.vertex(nX, 0);
+                    batch.vertex(nX, canvasSize.cy);
                 }
             }
         }
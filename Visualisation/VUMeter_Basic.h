@@ -27,6 +27,11 @@
 #include "Visualisation/VUMeter.h"
 //--------------------------------------
 
+//--------------------------------------
+//
+#include "ColorBlend.h"
+//--------------------------------------
+
 namespace Visualisation::VUMeter::HorizontalSplit {
     //**************************************************************************
     // Stereo
@@ -78,6 +83,9 @@ namespace Visualisation::VUMeter::HorizontalSplit {
         virtual void Draw(render_pass_type ePass,
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) override;
+
+    private:
+        ::Color::ColorGradient3f m_Gradient{ };
     }; // class StereoGradient final
 } // namespace Visualisation::VUMeter::HorizontalSplit
 
@@ -135,6 +143,8 @@ namespace Visualisation::VUMeter::VerticalSplit {
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) override;
 
+    private:
+        ::Color::ColorGradient3f m_Gradient{ };
     }; // class StereoGradient final
 } // namespace Visualisation::VUMeter::VerticalSplit
 
@@ -29,6 +29,7 @@
 
 //--------------------------------------
 //
+#include "Util/DirtyRect.h"
 #include "Util/FlagEnum.h"
 //--------------------------------------
 
@@ -90,6 +91,7 @@ namespace Visualisation {
         using flags_type      = ::Visualisation::VisualisationFlags;
         using mode_type       = ::VisualisationMode;
 
+        using dirty_rect_type         = ::util::dirty_rect;
         using render_pass_type        = ::RenderPass;
         using audio_data_manager_type = ::Audio::IAudioDataManager;
         using request_param_type      = ::Visualisation::RequestParams;
@@ -132,6 +134,18 @@ namespace Visualisation {
                           const audio_data_manager_type& AudioDataManager,
                           float fInterp) = 0;
 
+        // Area the next `Draw` (both passes) will change from
+        // the last, asked before each frame. By default all of
+        // it when the input (audio data or interpolation) has
+        // changed and none otherwise, so drawing must depend
+        // on nothing else unless this is overridden.
+        [[nodiscard]]
+        virtual dirty_rect_type GetDirtyRect(bool bInputChanged) const noexcept {
+            return bInputChanged
+                ? dirty_rect_type::all(m_Dimensions.cx, m_Dimensions.cy)
+                : dirty_rect_type{};
+        }
+
     public:
         constexpr auto GetMode      () const noexcept { return m_nMode; }
         constexpr auto GetIndex     () const noexcept { return m_nIndex; }
@@ -36,6 +36,7 @@
 //--------------------------------------
 //
 #include "Canvas.hpp"
+#include "GL/glbatch.h"
 //--------------------------------------
 
 //--------------------------------------
@@ -48,6 +49,31 @@
 #include "ColorCast.h"
 //--------------------------------------
 
+namespace {
+    constexpr auto ToDitherMethod(DitherMode eMode) noexcept {
+        using method = ::util::dither::method;
+        switch (eMode) {
+            case DitherMode::Bayer:          return method::bayer;
+            case DitherMode::FloydSteinberg: return method::floyd_steinberg;
+            case DitherMode::Atkinson:       return method::atkinson;
+            case DitherMode::Threshold:
+                [[fallthrough]];
+            default:                         return method::threshold;
+        }
+    }
+
+    constexpr auto ToTrailMode(TrailMode eMode) noexcept {
+        using mode = ::util::persistence::mode;
+        switch (eMode) {
+            case TrailMode::Max:      return mode::max;
+            case TrailMode::Additive: return mode::add;
+            case TrailMode::Blend:
+                [[fallthrough]];
+            default:                  return mode::blend;
+        }
+    }
+} // namespace <anonymous>
+
 //******************************************************************************
 // VisualisationManager
 //******************************************************************************
@@ -57,6 +83,10 @@ bool VisualisationManager::Initialise() {
     {
         m_pDataManager = ::Audio::IAudioDataManager::instance();
         assert(m_pDataManager); if (!m_pDataManager) { return false; }
+        if (!m_AnalysisWorker.StartThread(m_pDataManager)) {
+            LogError("Failed to start audio analysis thread. Plugin will be unavailable.");
+            return false;
+        }
     }
 
     {
@@ -69,7 +99,9 @@ bool VisualisationManager::Initialise() {
         assert(m_pCanvas); if (!m_pCanvas) { return false; }
 
         if (!m_pCanvas->IsValid()) {
-            m_pCanvas->Initialise(GetWidth(), GetHeight(), (IsMonochrome() ? 1 : 32), CanvasConfig().m_bPreferHardwareCanvas);
+            m_pCanvas->Initialise(GetWidth(), GetHeight(), (IsMonochrome() ? 1 : 32),
+                                  CanvasConfig().m_bPreferHardwareCanvas,
+                                  CanvasConfig().m_bOffscreenRendering);
             m_pCanvas->SetTransparentClears(CanvasConfig().m_bUseTrailEffect);
             if (!(m_pCanvas && m_pCanvas->IsValid())) {
                 Uninitialise();
@@ -77,6 +109,14 @@ bool VisualisationManager::Initialise() {
                 return false;
             }
         }
+        m_pCanvas->SetDitherMethod(ToDitherMethod(CanvasConfig().m_DitherMode));
+        m_pCanvas->SetTrailMode(ToTrailMode(CanvasConfig().m_TrailMode));
+    }
+
+    if (!m_Presenter.StartThread(m_pDisplay)) {
+        Uninitialise();
+        LogError("Failed to start LCD presenter thread. Plugin will be unavailable.");
+        return false;
     }
 
     m_bAutoChange = VisualisationConfig().m_AutoChange.m_bEnable;
@@ -98,6 +138,8 @@ bool VisualisationManager::Initialise() {
 
 void VisualisationManager::Uninitialise() noexcept {
     try {
+        m_Presenter.StopThread();
+        m_AnalysisWorker.StopThread();
         UninitialiseVisualisations();
         if (m_pCanvas) {
             m_pCanvas->Uninitialise();
@@ -313,6 +355,7 @@ void VisualisationManager::ActivateVisualisation(visualisation_pointer pVis) {
 
     m_pCurrent = pVis;
     assert(m_pCurrent);
+    m_pCanvas->Invalidate();
 
     using size_type = typename Visualisation::RequestParams::size_type;
     const auto nDefaultSampleCount{ static_cast<size_type>(m_pCanvas->GetWidth()) };
@@ -340,6 +383,9 @@ void VisualisationManager::ActivateVisualisation(visualisation_pointer pVis) {
     }
 
     SetFrequency(fTickHz, fUpdateHz);
+
+    m_fUpdatePeriodMS    = 1000.f / fUpdateHz;
+    m_nRequestGeneration = m_AnalysisWorker.SetRequest(m_RequestParams, fUpdateHz);
 }
 
 //------------------------------------------------------------------------------
@@ -600,8 +646,23 @@ void VisualisationManager::UpdateWallpaper(bool bForce) {
 
 //------------------------------------------------------------------------------
 
+void VisualisationManager::UpdateRenderStatistics(duration_type fPassMS) noexcept {
+    const auto& batch{ ::OpenGL::glVertexBatch::instance().get_statistics() };
+
+    constexpr const duration_type fWeight{ .1f };
+    auto stats{ m_RenderStatistics.Get() };
+    ++stats.m_nFrames;
+    stats.m_nDrawCalls  = batch.m_nDrawCalls;
+    stats.m_nVertices   = batch.m_nVertices;
+    stats.m_fPassMS     = fPassMS;
+    stats.m_fMeanPassMS = ::util::lerp(stats.m_fMeanPassMS, fPassMS, fWeight);
+    m_RenderStatistics.Set(stats);
+}
+
+//------------------------------------------------------------------------------
+
 VisualisationManager::WorkerStatus VisualisationManager::OnUpdate() {
-    GetAudioDataManager().Update(m_RequestParams);
+    GetAudioDataManager().UpdateMetadata();
 
     if (m_pCurrent && ((!DisplayConfig().m_bBackgroundMode) || m_bCurrentIsPopup)) {
         m_pCurrent->Update(GetAudioDataManager());
@@ -612,7 +673,11 @@ VisualisationManager::WorkerStatus VisualisationManager::OnUpdate() {
 //------------------------------------------------------------------------------
 
 //Called once per tick (i.e. every 1/Frequency seconds)
-VisualisationManager::WorkerStatus VisualisationManager::OnTick(float fInterp) {
+//
+// NOTE: Audio analysis happens on its own thread, so interpolation is
+//       measured from arrival of the latest analysed data rather than
+//       from this thread's update (i.e. the worker's `fInterp`).
+VisualisationManager::WorkerStatus VisualisationManager::OnTick(float /*fInterp*/) {
     if (!m_pDisplay || !m_pCanvas || !m_pDataManager) { return WorkerStatus::Quit; }
 
     if (m_bConfigChanged.Exchange(false)) {
@@ -633,26 +698,84 @@ VisualisationManager::WorkerStatus VisualisationManager::OnTick(float fInterp) {
         OnUpdate();
     }
 
+    const bool bNewData{ GetAudioDataManager().Consume() };
+    if (bNewData) {
+        m_InterpStopWatch.Start();
+    }
+
+    float fInterp{ 0.f };
+    if (m_InterpStopWatch.IsRunning() && m_fUpdatePeriodMS > 0) {
+        fInterp = std::clamp(m_InterpStopWatch.GetElapsedMilliseconds() / m_fUpdatePeriodMS,
+                             0.f, 1.f);
+    }
+
+    // Until data for the current request arrives the audio data may not
+    // match what the visualisation expects, so don't draw with it.
+    const bool bHaveData{
+        GetAudioDataManager().IsCurrent(m_nRequestGeneration) ||
+        !(m_RequestParams.Want & ~Visualisation::DataType::TrackDetails)
+    };
+
     GetAudioDataManager().StartFrame();
 
     if (CanvasConfig().m_Wallpaper.m_Mode != WallpaperMode::None) {
         UpdateWallpaper();
     }
 
-    m_pCanvas->StartFrame();
+    // Only what changed is converted and sent to the display,
+    // and a frame that changes nothing isn't drawn at all
+    const bool bDraw{ bHaveData && ((!DisplayConfig().m_bBackgroundMode) || m_bCurrentIsPopup) };
+    if (bDraw) {
+        const bool bInputChanged{ bNewData || (fInterp != m_fLastInterp) };
+        m_pCanvas->Invalidate(m_pCurrent->GetDirtyRect(bInputChanged));
+    }
+    if ((bDraw != std::exchange(m_bLastDraw, bDraw)) || m_Presenter.NeedsWholeFrame()) {
+        m_pCanvas->Invalidate();
+    }
+    m_fLastInterp = fInterp;
+
+    ::util::dirty_rect dirty{};
+    if (m_pCanvas->IsDirty()) {
+        m_pCanvas->StartFrame();
+
+        if (bDraw) {
+            for (const auto pass : RenderPass{}) {
+                if (pass == RenderPass::OpenGL) {
+                    ::OpenGL::glVertexBatch::instance().reset_statistics();
+                    m_PassStopWatch.Start();
+                }
+                m_pCanvas->StartPass(pass);
+                m_pCurrent->Draw(pass, GetAudioDataManager(), fInterp);
+                m_pCanvas->EndPass(pass);
+                if (pass == RenderPass::OpenGL) {
+                    UpdateRenderStatistics(m_PassStopWatch.GetElapsedMilliseconds());
+                }
+            }
+        }
 
-    if ((!DisplayConfig().m_bBackgroundMode) || m_bCurrentIsPopup) {
-        for (const auto pass : RenderPass{}) {
-            m_pCanvas->StartPass(pass);
-            m_pCurrent->Draw(pass, GetAudioDataManager(), fInterp);
-            m_pCanvas->EndPass(pass);
+        // Handed to the presenter thread, which sends it to the
+        // display (so any VSync wait happens there): colour frames
+        // are finished straight into its mailbox, packed ones are
+        // copied in
+        if (m_pCanvas->IsColor()) {
+            m_Presenter.Post([this](void* pMailbox, const ::util::dirty_rect& stale) {
+                return m_pCanvas->EndFrame(pMailbox, stale) ? m_pCanvas->GetDirtyRect()
+                                                            : ::util::dirty_rect{};
+            });
+        } else {
+            const void* pFrame{ m_pCanvas->EndFrame() };
+            m_Presenter.Post(pFrame, m_pCanvas->GetDirtyRect());
         }
+        dirty = m_pCanvas->GetDirtyRect();
+    } else {
+        // An unchanged frame is still sent if the display needs
+        // it (e.g. for priority)
+        m_Presenter.Refresh();
     }
 
-    void* pData = m_pCanvas->EndFrame();
-
-    //Send the update to the LCD, if using VSync this may take a long time to return
-    if (pData) { m_pDisplay->Update(pData); }
+    if (bHaveData && dirty) {
+        GetAudioDataManager().Presented(fInterp, m_Presenter.GetStatistics().m_fMeanLatencyMS);
+    }
 
     GetAudioDataManager().EndFrame();
 
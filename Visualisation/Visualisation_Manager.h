@@ -30,8 +30,10 @@
 //--------------------------------------
 //
 #include "Audio_DataManager.h"
+#include "Audio_AnalysisWorker.h"
 #include "Visualisation/Visualisation.h"
 #include "LCD/LCD.h"
+#include "LCD/LCD_Presenter.h"
 #include "Canvas.hpp"
 //--------------------------------------
 
@@ -79,6 +81,7 @@ public:
     using display_desc       = ::LCD::Device::Desc;
     using display_color_type = ::LCD::Device::Type;
     using button_state       = ::LCD::ButtonState;
+    using presenter          = ::LCD::Presenter;
 
     using canvas         = ::Windows::Canvas;
     using canvas_pointer = typename canvas::pointer_type;
@@ -86,6 +89,21 @@ public:
     using data_manger         = ::Audio::IAudioDataManager;
     using data_manger_pointer = typename data_manger::pointer_type;
 
+    using analysis_worker     = ::Audio::AnalysisWorker;
+    using generation_type     = typename analysis_worker::generation_type;
+
+    using duration_type = float;
+
+    // OpenGL pass of the most recent frame (draw calls and
+    // vertices are those submitted by `OpenGL::glVertexBatch`)
+    struct render_statistics final {
+        std::size_t   m_nFrames    { 0 };
+        std::size_t   m_nDrawCalls { 0 };
+        std::size_t   m_nVertices  { 0 };
+        duration_type m_fPassMS    { 0 }; //< CPU time, including readback
+        duration_type m_fMeanPassMS{ 0 }; //< Moving average
+    };
+
 public:
     VisualisationManager(singleton_constructor_tag /*tag*/) {};
 
@@ -123,6 +141,13 @@ public:
     decltype(auto) GetCurrentVisMode () const noexcept { return m_eCurrentVisMode; }
     decltype(auto) GetCurrentVisIndex() const noexcept { return m_CurrentVisIndex[m_eCurrentVisMode]; }
 
+    [[nodiscard]]
+    decltype(auto) GetRenderStatistics() const noexcept { return m_RenderStatistics.Get(); }
+
+    // Totals of frames posted and display updates
+    [[nodiscard]]
+    decltype(auto) GetPresentStatistics() const { return m_Presenter.GetStatistics(); }
+
 protected:
     virtual WorkerStatus OnTick  (float fInterp) override;
     virtual WorkerStatus OnUpdate()              override;
@@ -142,6 +167,8 @@ private:
     void SetVisualisation  ();
     void UpdateWallpaper   (bool bForce = false);
 
+    void UpdateRenderStatistics(duration_type fPassMS) noexcept;
+
     const auto& GetAudioDataManager() const noexcept {
         assert(m_pDataManager);
         return *m_pDataManager;
@@ -162,6 +189,15 @@ private:
     display_pointer     m_pDisplay       {};
     button_state        m_LastButtonState{ button_state::None };
 
+    analysis_worker      m_AnalysisWorker    {};
+    presenter            m_Presenter         {};
+    generation_type      m_nRequestGeneration{ 0 };
+    ::Windows::StopWatch m_InterpStopWatch   {};
+    ::Windows::StopWatch m_PassStopWatch     {};
+    float                m_fUpdatePeriodMS   { 0 };
+    float                m_fLastInterp       { -1.f };
+    bool                 m_bLastDraw         { false };
+
     visualisation_pages   m_Visualisations{};
     visualisation_pointer m_pCurrent      {};
     visualisation_pointer m_pTrackDetails {};
@@ -191,6 +227,7 @@ private:
     Config::GeneralConfig        m_Config       {};
 private:
     ::Windows::Thread::CriticalSectionProtectedVariableT<bool> m_bConfigChanged{ false };
+    ::Windows::Thread::CriticalSectionProtectedVariableT<render_statistics> m_RenderStatistics{};
 }; // class VisualisationManager final
 
 #endif // GUID_4A604C90_698C_4C0E_B360_CE67298E7C28
\ No newline at end of file
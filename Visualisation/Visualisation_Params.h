@@ -5,6 +5,8 @@
 //
 #include "Util/FlagEnum.h"
 #include "Color.h"
+#include "Audio_Resampler.h"
+#include "Audio_Trigger.h"
 //--------------------------------------
 
 //--------------------------------------
@@ -26,7 +28,10 @@ namespace Visualisation {
                                CombinedWaveform = 1 << 3,
                                Decibel          = 1 << 4,
                                CombinedDecibel  = 1 << 5,
-                               TrackDetails     = 1 << 6));
+                               TrackDetails     = 1 << 6,
+                               Beat             = 1 << 7,
+                               Correlation      = 1 << 8,
+                               Chroma           = 1 << 9));
 
     //**************************************************************************
     // SpectrumParams
@@ -40,6 +45,7 @@ namespace Visualisation {
 #endif
         using peak_type   = sample_type;
         using size_type   = std::size_t;
+        using resample_quality = ::Audio::Samples::ResampleQuality;
 
         // TODO: Using `std::function` here is far from
         //       ideal, but it's hard to find a suitable
@@ -73,19 +79,25 @@ namespace Visualisation {
             nSampleCountHint{ other.nSampleCountHint },
             fPeakMininum    { other.fPeakMininum },
             fPeakDecayRate  { other.fPeakDecayRate },
-            fnTransform     { other.fnTransform } {}
+            fnTransform     { other.fnTransform },
+            eResampleQuality{ other.eResampleQuality },
+            nBinsPerOctave  { other.nBinsPerOctave } {}
 
         SpectrumParams(SpectrumParams&& other) noexcept :
             nSampleCountHint{ exchange_zero(other.nSampleCountHint) },
             fPeakMininum    { exchange_zero(other.fPeakMininum) },
             fPeakDecayRate  { exchange_zero(other.fPeakDecayRate) },
-            fnTransform     { std::move(other.fnTransform) } {}
+            fnTransform     { std::move(other.fnTransform) },
+            eResampleQuality{ other.eResampleQuality },
+            nBinsPerOctave  { exchange_zero(other.nBinsPerOctave) } {}
 
         SpectrumParams& operator=(const SpectrumParams& other) noexcept {
             nSampleCountHint = other.nSampleCountHint;
             fPeakMininum     = other.fPeakMininum;
             fPeakDecayRate   = other.fPeakDecayRate;
             fnTransform      = other.fnTransform;
+            eResampleQuality = other.eResampleQuality;
+            nBinsPerOctave   = other.nBinsPerOctave;
             return *this;
         }
 
@@ -94,6 +106,8 @@ namespace Visualisation {
             fPeakMininum     = exchange_zero(other.fPeakMininum);
             fPeakDecayRate   = exchange_zero(other.fPeakDecayRate);
             fnTransform      = std::move(other.fnTransform);
+            eResampleQuality = other.eResampleQuality;
+            nBinsPerOctave   = exchange_zero(other.nBinsPerOctave);
             return *this;
         }
 
@@ -102,6 +116,8 @@ namespace Visualisation {
         peak_type      fPeakMininum    { 0 };
         peak_type      fPeakDecayRate  { 0 };
         transform_type fnTransform     { };
+        resample_quality eResampleQuality{ resample_quality::CubicHermite }; //< Used when enlarging
+        size_type        nBinsPerOctave  { 0 }; //< Constant-Q bins per octave, 0 for linear (FFT) bins
     }; // struct SpectrumParams final
 
     //**************************************************************************
@@ -116,6 +132,8 @@ namespace Visualisation {
 #endif
         using peak_type   = sample_type;
         using size_type   = std::size_t;
+        using resample_quality = ::Audio::Samples::ResampleQuality;
+        using trigger_mode     = ::Audio::Samples::TriggerMode;
 
         // TODO: Using `std::function` here is far from
         //       ideal, but it's hard to find a suitable
@@ -147,19 +165,28 @@ namespace Visualisation {
             nSampleCountHint{ other.nSampleCountHint },
             fPeakMininum    { other.fPeakMininum },
             fPeakDecayRate  { other.fPeakDecayRate },
-            fnTransform     { other.fnTransform } {}
+            fnTransform     { other.fnTransform },
+            bEnvelope       { other.bEnvelope },
+            eResampleQuality{ other.eResampleQuality },
+            eTrigger        { other.eTrigger } {}
 
         WaveformParams(WaveformParams&& other) noexcept :
             nSampleCountHint{ exchange_zero(other.nSampleCountHint) },
             fPeakMininum    { exchange_zero(other.fPeakMininum) },
             fPeakDecayRate  { exchange_zero(other.fPeakDecayRate) },
-            fnTransform     { std::move(other.fnTransform) } {}
+            fnTransform     { std::move(other.fnTransform) },
+            bEnvelope       { exchange_zero(other.bEnvelope) },
+            eResampleQuality{ other.eResampleQuality },
+            eTrigger        { std::exchange(other.eTrigger, trigger_mode::None) } {}
 
         WaveformParams& operator=(const WaveformParams& other) noexcept {
             nSampleCountHint = other.nSampleCountHint;
             fPeakMininum     = other.fPeakMininum;
             fPeakDecayRate   = other.fPeakDecayRate;
             fnTransform      = other.fnTransform;
+            bEnvelope        = other.bEnvelope;
+            eResampleQuality = other.eResampleQuality;
+            eTrigger         = other.eTrigger;
             return *this;
         }
 
@@ -168,6 +195,9 @@ namespace Visualisation {
             fPeakMininum     = exchange_zero(other.fPeakMininum);
             fPeakDecayRate   = exchange_zero(other.fPeakDecayRate);
             fnTransform      = std::move(other.fnTransform);
+            bEnvelope        = exchange_zero(other.bEnvelope);
+            eResampleQuality = other.eResampleQuality;
+            eTrigger         = std::exchange(other.eTrigger, trigger_mode::None);
             return *this;
         }
 
@@ -176,6 +206,9 @@ namespace Visualisation {
         peak_type      fPeakMininum    { 0 };
         peak_type      fPeakDecayRate  { 0 };
         transform_type fnTransform     {};
+        bool           bEnvelope       { false }; //< Store min/max pairs per point
+        resample_quality eResampleQuality{ resample_quality::CubicHermite }; //< Used when enlarging
+        trigger_mode     eTrigger        { trigger_mode::None }; //< Shows half the fetched audio when set
     }; // struct WaveformParams final
 
     //**************************************************************************
@@ -103,8 +103,11 @@ namespace Windows::GDI::detail {
 
         constexpr auto GetColorBitsPerPixel () const noexcept { return m_ColorBits; }
         constexpr auto GetColorBytesPerPixel() const noexcept { return GetColorBitsPerPixel() / 8; }
+        constexpr auto GetColorStride       () const noexcept { //< Bytes per row (DIB rows are padded to 32 bits)
+            return ((m_Dimensions.cx * GetColorBitsPerPixel() + 31) / 32) * 4;
+        }
         constexpr auto GetColorByteSize     () const noexcept {
-            return GetPixelCount() * GetColorBytesPerPixel();
+            return m_Dimensions.cy * GetColorStride();
         }
 
         constexpr auto HasDepthBuffer       () const noexcept { return m_DepthBits != 0; }
@@ -122,9 +125,13 @@ namespace Windows::GDI::detail {
         }
 
     protected:
-        constexpr bool Valid() const noexcept {
+        constexpr bool ValidSurface() const noexcept {
             return m_Dimensions.cx && m_Dimensions.cy &&
-                m_ColorBits && m_PixelFormat && m_hDC;
+                m_ColorBits && m_hDC;
+        }
+
+        constexpr bool Valid() const noexcept {
+            return ValidSurface() && m_PixelFormat;
         }
 
     protected:
@@ -348,8 +355,13 @@ namespace Windows::GDI {
         constexpr operator HBITMAP() const noexcept { return GetBitmap(); }
 
         constexpr bool IsMonochrome() const noexcept { return m_bMonochrome; }
+        constexpr bool IsPacked    () const noexcept { return m_bMonochrome && m_ColorBits == 1; }
+        constexpr bool IsOpenGL    () const noexcept { return m_PixelFormat != 0; }
 
-        constexpr bool Valid() const noexcept { return baseClass::Valid() && m_hBitmap; }
+        // Packed canvases are GDI only, so have no pixel format
+        constexpr bool Valid() const noexcept {
+            return (IsPacked() ? baseClass::ValidSurface() : baseClass::Valid()) && m_hBitmap;
+        }
 
     public:
         constexpr explicit operator bool() const noexcept { return Valid(); }
@@ -378,6 +390,19 @@ namespace Windows::GDI {
 
             canvas.m_hOriginalDCBitmap = (HBITMAP)::SelectObject(canvas.m_hDC,
                                                                  canvas.m_hBitmap);
+
+            const auto width     = pbmi->bmiHeader.biWidth;
+            const auto height    = pbmi->bmiHeader.biHeight;
+            const auto absHeight = (height > 0) ? height : -height;
+
+            canvas.m_Dimensions  = { width, absHeight };
+            canvas.m_ColorBits   = cColorBits;
+            canvas.m_DepthBits   = cDepthBits;
+            canvas.m_StencilBits = cStencilBits;
+
+            // No flags: GDI only, don't set a pixel format
+            if (!dwPixelFormatFlags) { return canvas; }
+
             PIXELFORMATDESCRIPTOR pfd;
             ZeroMemory(&pfd, sizeof(PIXELFORMATDESCRIPTOR));
             pfd.nVersion     = 1; pfd.nSize = sizeof(PIXELFORMATDESCRIPTOR);
@@ -395,14 +420,6 @@ namespace Windows::GDI {
             WinAPIAssert(res);
             if (!res) { return {}; }
 
-            const auto width     = pbmi->bmiHeader.biWidth;
-            const auto height    = pbmi->bmiHeader.biHeight;
-            const auto absHeight = (height > 0) ? height : -height;
-
-            canvas.m_Dimensions  = { width, absHeight };
-            canvas.m_ColorBits   = cColorBits;
-            canvas.m_DepthBits   = cDepthBits;
-            canvas.m_StencilBits = cStencilBits;
             canvas.m_PixelFormat = format;
             return canvas;
         }
@@ -459,6 +476,25 @@ namespace Windows::GDI {
             return canvas;
         }
 
+        // One bit per pixel (see `util::bit_plane`); GDI can draw
+        // to it, OpenGL can't, so it needs a separate OpenGL
+        // surface whose pixels are packed into it.
+        static auto CreatePacked(_In_opt_ HDC hDC,
+                                 _In_ LONG width,
+                                 _In_ LONG height) noexcept {
+            BitmapInfo256 bmi;
+            bmi.bmiHeader.biWidth       = width;
+            bmi.bmiHeader.biHeight      = height;
+            bmi.bmiHeader.biCompression = BI_RGB;
+            bmi.bmiHeader.biBitCount    = 1;
+            bmi.bmiHeader.biClrUsed     = 2;
+            bmi.bmiColors[1]            = RGBQUAD{ 255, 255, 255, 0 };
+
+            auto canvas = Create(hDC, bmi, 0);
+            canvas.m_bMonochrome = true; //< `Valid` depends on this
+            return canvas ? std::move(canvas) : BitmapCanvas{};
+        }
+
     private:
         bool    m_bMonochrome      { false };
         HBITMAP m_hOriginalDCBitmap{ NULL };
@@ -66,7 +66,11 @@ namespace {
 
             cfg_id_type       m_bPreferHardwareCanvas{ 0 };
             cfg_id_type       m_bUseTrailEffect      { 0 };
+            cfg_id_type       m_TrailMode            { 0 };
             cfg_wallpaper_ids m_Wallpaper            { };
+            cfg_id_type       m_DitherMode           { 0 };
+            cfg_id_type       m_bOffscreenRendering  { 0 };
+            cfg_id_type       m_bGPUInterpolation    { 0 };
         }; // struct cfg_canvas_ids final
 
         struct cfg_visualisation_ids final {
@@ -133,6 +137,8 @@ namespace {
         public:
             using native_config = decltype(native_config::m_Canvas);
             using cfg_ids       = decltype(cfg_ids::m_Canvas);
+            using cfg_dither    = foobar::Config::cfg_type_t<decltype(native_config::m_DitherMode)>;
+            using cfg_trail     = foobar::Config::cfg_type_t<decltype(native_config::m_TrailMode)>;
 
             //-------------------------
             class cfg_wallpaper final {
@@ -169,7 +175,11 @@ namespace {
         private:
             cfg_bool      m_bPreferHardwareCanvas;
             cfg_bool      m_bUseTrailEffect;
+            cfg_trail     m_TrailMode;
             cfg_wallpaper m_Wallpaper;
+            cfg_dither    m_DitherMode;
+            cfg_bool      m_bOffscreenRendering;
+            cfg_bool      m_bGPUInterpolation;
         }; // class cfg_canvas final
         //---------------------------------------
 
@@ -317,7 +327,11 @@ namespace {
                                         const native_config& defaults) :
         m_bPreferHardwareCanvas{ ids.m_bPreferHardwareCanvas, defaults.m_bPreferHardwareCanvas },
         m_bUseTrailEffect      { ids.m_bUseTrailEffect      , defaults.m_bUseTrailEffect },
-        m_Wallpaper            { ids.m_Wallpaper            , defaults.m_Wallpaper } {}
+        m_TrailMode            { ids.m_TrailMode            , defaults.m_TrailMode },
+        m_Wallpaper            { ids.m_Wallpaper            , defaults.m_Wallpaper },
+        m_DitherMode           { ids.m_DitherMode           , defaults.m_DitherMode },
+        m_bOffscreenRendering  { ids.m_bOffscreenRendering  , defaults.m_bOffscreenRendering },
+        m_bGPUInterpolation    { ids.m_bGPUInterpolation    , defaults.m_bGPUInterpolation } {}
 
     //------------------------------------------------------
 
@@ -325,7 +339,11 @@ namespace {
     void cfg_general::cfg_canvas::cfg_save(const native_config& native) {
         foobar::Config::cfg_save(m_bPreferHardwareCanvas, native.m_bPreferHardwareCanvas);
         foobar::Config::cfg_save(m_bUseTrailEffect      , native.m_bUseTrailEffect);
+        foobar::Config::cfg_save(m_TrailMode            , native.m_TrailMode);
         foobar::Config::cfg_save(m_Wallpaper            , native.m_Wallpaper);
+        foobar::Config::cfg_save(m_DitherMode           , native.m_DitherMode);
+        foobar::Config::cfg_save(m_bOffscreenRendering  , native.m_bOffscreenRendering);
+        foobar::Config::cfg_save(m_bGPUInterpolation    , native.m_bGPUInterpolation);
     }
 
     //------------------------------------------------------
@@ -333,7 +351,11 @@ namespace {
     void cfg_general::cfg_canvas::cfg_load(native_config& native) const {
         foobar::Config::cfg_load(native.m_bPreferHardwareCanvas, m_bPreferHardwareCanvas);
         foobar::Config::cfg_load(native.m_bUseTrailEffect      , m_bUseTrailEffect);
+        foobar::Config::cfg_load(native.m_TrailMode            , m_TrailMode);
         foobar::Config::cfg_load(native.m_Wallpaper            , m_Wallpaper);
+        foobar::Config::cfg_load(native.m_DitherMode           , m_DitherMode);
+        foobar::Config::cfg_load(native.m_bOffscreenRendering  , m_bOffscreenRendering);
+        foobar::Config::cfg_load(native.m_bGPUInterpolation    , m_bGPUInterpolation);
     }
 
     //------------------------------------------------------
@@ -559,12 +581,16 @@ namespace {
         cfg_ids::cfg_canvas_ids{
             cfg_id_type{ 0x84fcf324, 0x368e, 0x4bbc, { 0x87, 0x03, 0x39, 0xed, 0xfb, 0x5a, 0xe1, 0x8a } },
             cfg_id_type{ 0xa22ebdda, 0x7fb3, 0x4dd6, { 0xa1, 0xb9, 0x7e, 0x88, 0x20, 0xb2, 0x37, 0x0c } },
+            cfg_id_type{ 0x0309f2a5, 0x2cbd, 0x4ee2, { 0xa7, 0xa2, 0x01, 0xaa, 0xed, 0x32, 0xf0, 0x9e } },
             cfg_ids::cfg_canvas_ids::cfg_wallpaper_ids{
                 cfg_id_type{ 0x5eb12d20, 0xb2a1, 0x4a67, { 0x8a, 0x96, 0xb1, 0x76, 0x40, 0x9b, 0xb2, 0xc0 } },
                 cfg_id_type{ 0x43f9fe3e, 0x6ccb, 0x469f, { 0xaf, 0x50, 0xb7, 0x2b, 0x74, 0x36, 0xb6, 0xe7 } },
                 cfg_id_type{ 0x585b782e, 0x35d4, 0x40a7, { 0x85, 0x0f, 0xa2, 0x56, 0xd3, 0xd0, 0xf1, 0xa3 } },
                 cfg_id_type{ 0xb8efeef7, 0x1b82, 0x4711, { 0xb2, 0x03, 0x71, 0x5c, 0x17, 0xb4, 0xed, 0x46 } },
             },
+            cfg_id_type{ 0xbc61350b, 0x241a, 0x48f8, { 0x8e, 0x4d, 0xd6, 0x2b, 0x7f, 0xde, 0x2e, 0x4b } },
+            cfg_id_type{ 0xd3150287, 0x065e, 0x4f88, { 0xa7, 0x5d, 0xc2, 0x26, 0xcc, 0x2e, 0x03, 0x2d } },
+            cfg_id_type{ 0xdaefc560, 0x7a8c, 0x4624, { 0x99, 0xd9, 0x21, 0x96, 0xc9, 0xc5, 0x05, 0xf2 } },
         },
         cfg_ids::cfg_visualisation_ids{
             cfg_id_type{ 0x6a7021cd, 0x5322, 0x4b86, { 0x85, 0x92, 0x2b, 0xe1, 0x73, 0xa3, 0xed, 0x22 } },
@@ -114,6 +114,13 @@ namespace {
             native_config_type{ native_enum_type::StarBurstStereo }
         },
         */
+
+        //---------------------------------------
+        // native_enum_type::GoniometerStereo
+        cfg_oscilloscope{
+            cfg_id_type{ 0x720775ef, 0x0048, 0x48bf, { 0x8d, 0x7f, 0x86, 0x2c, 0x43, 0x7b, 0xed, 0xbf } },
+            native_config_type{ native_enum_type::GoniometerStereo }
+        },
     }; // static cfg_pages cfg_OscilloscopeConfig
 
     //-----------------------------------------------------
@@ -82,6 +82,27 @@ namespace {
             cfg_id_type{ 0x6610f858, 0xb1df, 0x4b49, { 0x96, 0x85, 0xe3, 0xd1, 0x97, 0x4a, 0xca, 0xfb } },
             native_config_type{ native_enum_type::StereoBlock }
         },
+
+        //---------------------------------------
+        // native_enum_type::Spectrogram
+        cfg_spectrum_analyser{
+            cfg_id_type{ 0xf0300858, 0x6ea7, 0x46e2, { 0x8e, 0x49, 0x65, 0x4e, 0x4c, 0x36, 0x87, 0xf6 } },
+            native_config_type{ native_enum_type::Spectrogram }
+        },
+
+        //---------------------------------------
+        // native_enum_type::Chromagram
+        cfg_spectrum_analyser{
+            cfg_id_type{ 0x934b5d0d, 0x7aa9, 0x41ef, { 0xac, 0x80, 0x15, 0xcf, 0xf1, 0xe0, 0x46, 0x2a } },
+            native_config_type{ native_enum_type::Chromagram }
+        },
+
+        //---------------------------------------
+        // native_enum_type::Shader
+        cfg_spectrum_analyser{
+            cfg_id_type{ 0xa806aa52, 0x2a37, 0x4933, { 0xa0, 0xd1, 0x95, 0x8b, 0xbe, 0xd1, 0x43, 0xa9 } },
+            native_config_type{ native_enum_type::Shader }
+        },
     }; // cfg_track_details_array_t cfg_SpectrumAnalyserConfig
 
     //-----------------------------------------------------
@@ -140,6 +140,16 @@
 #define IDC_SCALE_W_EDIT                1142
 #define IDC_OFFSET_W_EDIT               1143
 #define IDC_TRACK_INFO_SIZER            1144
+#define IDC_ENVELOPE_CHECK              1145
+#define IDC_TRIGGER_STATIC              1146
+#define IDC_TRIGGER_COMBO               1147
+#define IDC_SPEC_SCALE_STATIC           1148
+#define IDC_SPEC_SCALE_COMBO            1149
+#define IDC_DITHER_STATIC               1150
+#define IDC_DITHER_COMBO                1151
+#define IDC_OFFSCREEN_CHECK             1152
+#define IDC_GPU_INTERP_CHECK            1153
+#define IDC_TRAIL_MODE_COMBO            1154
 
 // Next default values for new objects
 // 
@@ -147,7 +157,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NEXT_RESOURCE_VALUE        131
 #define _APS_NEXT_COMMAND_VALUE         40001
-#define _APS_NEXT_CONTROL_VALUE         1145
+#define _APS_NEXT_CONTROL_VALUE         1155
 #define _APS_NEXT_SYMED_VALUE           101
 #endif
 #endif
@@ -50,6 +50,18 @@ namespace foobar::UI {
         ATLASSERT(m_AlbumArtCombo.IsWindow());
         ATLVERIFY(m_AlbumArtCombo.InsertAll());
 
+        ATLASSERT(IsDlgItem(IDC_DITHER_COMBO));
+        m_DitherCombo.Detach();
+        m_DitherCombo.Attach(GetDlgItem(IDC_DITHER_COMBO));
+        ATLASSERT(m_DitherCombo.IsWindow());
+        ATLVERIFY(m_DitherCombo.InsertAll());
+
+        ATLASSERT(IsDlgItem(IDC_TRAIL_MODE_COMBO));
+        m_TrailCombo.Detach();
+        m_TrailCombo.Attach(GetDlgItem(IDC_TRAIL_MODE_COMBO));
+        ATLASSERT(m_TrailCombo.IsWindow());
+        ATLVERIFY(m_TrailCombo.InsertAll());
+
         UpdateControls();
         EnableControls();
         bHandled = TRUE;
@@ -251,6 +263,20 @@ namespace foobar::UI {
                 break;
             }
 
+            case IDC_OFFSCREEN_CHECK: {
+                bConfigChanged = GetCheckBoxState(nDialogItem,
+                                                  GeneralConfig().m_Canvas.m_bOffscreenRendering);
+                bHandled = TRUE;
+                break;
+            }
+
+            case IDC_GPU_INTERP_CHECK: {
+                bConfigChanged = GetCheckBoxState(nDialogItem,
+                                                  GeneralConfig().m_Canvas.m_bGPUInterpolation);
+                bHandled = TRUE;
+                break;
+            }
+
             case IDC_BG_NONE_RADIO:
                 [[fallthrough]];
             case IDC_BG_ART_RADIO:
@@ -348,6 +374,26 @@ namespace foobar::UI {
                 break;
             }
 
+            case IDC_DITHER_COMBO: {
+                auto ditherMode = GeneralConfig().m_Canvas.m_DitherMode;
+                if (m_DitherCombo.GetCurSelVal(ditherMode)) {
+                    bConfigChanged = GeneralConfig().m_Canvas.m_DitherMode != ditherMode;
+                    GeneralConfig().m_Canvas.m_DitherMode = ditherMode;
+                }
+                bHandled = TRUE;
+                break;
+            }
+
+            case IDC_TRAIL_MODE_COMBO: {
+                auto trailMode = GeneralConfig().m_Canvas.m_TrailMode;
+                if (m_TrailCombo.GetCurSelVal(trailMode)) {
+                    bConfigChanged = GeneralConfig().m_Canvas.m_TrailMode != trailMode;
+                    GeneralConfig().m_Canvas.m_TrailMode = trailMode;
+                }
+                bHandled = TRUE;
+                break;
+            }
+
             case IDC_BG_FILE_BUTTON: {
                 CString strFile;
                 // Supported image types:
@@ -430,8 +476,12 @@ namespace foobar::UI {
 
         if (GeneralConfig().m_Canvas.m_bPreferHardwareCanvas) {
             WinAPIVerify(CheckDlgButton(IDC_TRAIL_EFFECT_CHECK, GeneralConfig().m_Canvas.m_bUseTrailEffect));
+            WinAPIVerify(CheckDlgButton(IDC_OFFSCREEN_CHECK   , GeneralConfig().m_Canvas.m_bOffscreenRendering));
+            WinAPIVerify(CheckDlgButton(IDC_GPU_INTERP_CHECK  , GeneralConfig().m_Canvas.m_bGPUInterpolation));
         } else {
             WinAPIVerify(CheckDlgButton(IDC_TRAIL_EFFECT_CHECK, FALSE));
+            WinAPIVerify(CheckDlgButton(IDC_OFFSCREEN_CHECK   , FALSE));
+            WinAPIVerify(CheckDlgButton(IDC_GPU_INTERP_CHECK  , FALSE));
         }
 
         switch (GeneralConfig().m_Canvas.m_Wallpaper.m_Mode) {
@@ -457,6 +507,12 @@ namespace foobar::UI {
         ATLASSERT(m_AlbumArtCombo.IsWindow());
         m_AlbumArtCombo.SelectValue(GeneralConfig().m_Canvas.m_Wallpaper.m_AlbumArtType);
 
+        ATLASSERT(m_DitherCombo.IsWindow());
+        m_DitherCombo.SelectValue(GeneralConfig().m_Canvas.m_DitherMode);
+
+        ATLASSERT(m_TrailCombo.IsWindow());
+        m_TrailCombo.SelectValue(GeneralConfig().m_Canvas.m_TrailMode);
+
         SetDlgItemText(IDC_BG_FILE_EDIT, GeneralConfig().m_Canvas.m_Wallpaper.m_File.c_str());
         WinAPIVerify(CheckDlgButton(IDC_BG_PIC_STRETCH_CHECK, GeneralConfig().m_Canvas.m_Wallpaper.m_bStretchToFit));
         WinAPIVerify(CheckDlgButton(IDC_BG_PIC_CLEAR_TEXT_CHECK, CoreConfig().m_TrackDetails[TrackDetailsType::Page1].m_Text.m_bClearBackground)); //!!FIXME!! - move this to track info page.
@@ -503,6 +559,27 @@ namespace foobar::UI {
             EnableDlgItem(IDC_PRIORITY_CHECK, FALSE);
         }
 
+        // Dithering needs the grey levels only the hardware canvas provides
+        ATLASSERT(IsDlgItem(IDC_DITHER_COMBO));
+        ATLASSERT(IsDlgItem(IDC_DITHER_STATIC));
+        if (!CanvasConfig().bColor && GeneralConfig().m_Canvas.m_bPreferHardwareCanvas) {
+            EnableDlgItem(IDC_DITHER_COMBO , TRUE);
+            EnableDlgItem(IDC_DITHER_STATIC, TRUE);
+        } else {
+            EnableDlgItem(IDC_DITHER_COMBO , FALSE);
+            EnableDlgItem(IDC_DITHER_STATIC, FALSE);
+        }
+
+        // Offscreen rendering needs the hardware canvas's render context
+        ATLASSERT(IsDlgItem(IDC_OFFSCREEN_CHECK));
+        EnableDlgItem(IDC_OFFSCREEN_CHECK,
+                      GeneralConfig().m_Canvas.m_bPreferHardwareCanvas ? TRUE : FALSE);
+
+        // As does interpolating on the GPU
+        ATLASSERT(IsDlgItem(IDC_GPU_INTERP_CHECK));
+        EnableDlgItem(IDC_GPU_INTERP_CHECK,
+                      GeneralConfig().m_Canvas.m_bPreferHardwareCanvas ? TRUE : FALSE);
+
         if (CanvasConfig().bColor) {
             ATLASSERT(IsDlgItem(IDC_COLOUR_LCD_STATIC));
             ATLASSERT(IsDlgItem(IDC_SLIT_SCREEN_CHECK));
@@ -511,6 +588,11 @@ namespace foobar::UI {
             EnableDlgItem(IDC_SLIT_SCREEN_CHECK,  TRUE);
             EnableDlgItem(IDC_TRAIL_EFFECT_CHECK, TRUE);
 
+            // Persisting trails works on the hardware canvas's read back
+            ATLASSERT(IsDlgItem(IDC_TRAIL_MODE_COMBO));
+            EnableDlgItem(IDC_TRAIL_MODE_COMBO,
+                          GeneralConfig().m_Canvas.m_bPreferHardwareCanvas ? TRUE : FALSE);
+
             ATLASSERT(IsDlgItem(IDC_BACKGROUND_IMG_STATIC));
             ATLASSERT(IsDlgItem(IDC_BG_NONE_RADIO));
             ATLASSERT(IsDlgItem(IDC_BG_ART_RADIO));
@@ -564,6 +646,9 @@ namespace foobar::UI {
             EnableDlgItem(IDC_SLIT_SCREEN_CHECK,  FALSE);
             EnableDlgItem(IDC_TRAIL_EFFECT_CHECK, FALSE);
 
+            ATLASSERT(IsDlgItem(IDC_TRAIL_MODE_COMBO));
+            EnableDlgItem(IDC_TRAIL_MODE_COMBO, FALSE);
+
             ATLASSERT(IsDlgItem(IDC_BACKGROUND_IMG_STATIC));
             ATLASSERT(IsDlgItem(IDC_BG_NONE_RADIO));
             ATLASSERT(IsDlgItem(IDC_BG_ART_RADIO));
@@ -56,6 +56,14 @@ namespace foobar::UI {
             foobar::UI::CSequentialEnumHelperT<AlbumArtType>;
         using CAlbumArtCombo =
             Windows::UI::CEnumComboBoxT<AlbumArtType, CAlbumArtComboHelper>;
+        using CDitherComboHelper =
+            foobar::UI::CSequentialEnumHelperT<DitherMode>;
+        using CDitherCombo =
+            Windows::UI::CEnumComboBoxT<DitherMode, CDitherComboHelper>;
+        using CTrailComboHelper =
+            foobar::UI::CSequentialEnumHelperT<TrailMode>;
+        using CTrailCombo =
+            Windows::UI::CEnumComboBoxT<TrailMode, CTrailComboHelper>;
 
     private:
         thisClass(thisClass&)            = delete; // No Copy
@@ -124,6 +132,8 @@ namespace foobar::UI {
     private:
         SVisPrefConfig m_Config       {};
         CAlbumArtCombo m_AlbumArtCombo{};
+        CDitherCombo   m_DitherCombo  {};
+        CTrailCombo    m_TrailCombo   {};
     }; // class CGeneralDlg
 } // namespace foobar::UI
 
@@ -55,6 +55,13 @@ namespace foobar::UI {
         ATLASSERT(IsDlgItem(IDC_BG_COLOUR_STATIC));
         ATLVERIFY(m_Color[BackgroundSwatch].Initialise(GetDlgItem(IDC_BG_COLOUR_STATIC),
                                                        VisConfig().m_Color.m_Palette.Background));
+
+        ATLASSERT(IsDlgItem(IDC_TRIGGER_COMBO));
+        m_TriggerCombo.Detach();
+        m_TriggerCombo.Attach(GetDlgItem(IDC_TRIGGER_COMBO));
+        ATLASSERT(m_TriggerCombo.IsWindow());
+        ATLVERIFY(m_TriggerCombo.InsertAll());
+
         UpdateControls();
         EnableControls();
         bHandled = TRUE;
@@ -166,6 +173,23 @@ namespace foobar::UI {
                 break;
             }
 
+            case IDC_ENVELOPE_CHECK: {
+                bConfigChanged = GetCheckBoxState(nDialogItem,
+                                                  VisConfig().m_bEnvelope);
+                bHandled = TRUE;
+                break;
+            }
+
+            case IDC_TRIGGER_COMBO: {
+                auto trigger = VisConfig().m_eTrigger;
+                if (m_TriggerCombo.GetCurSelVal(trigger)) {
+                    bConfigChanged = VisConfig().m_eTrigger != trigger;
+                    VisConfig().m_eTrigger = trigger;
+                }
+                bHandled = TRUE;
+                break;
+            }
+
             case IDC_COLOUR_1_BUTTON: {
                 const auto oldColor = m_Color[PrimarySwatch].GetColor();
                 if (m_Color[PrimarySwatch].SelectColor() &&
@@ -232,6 +256,17 @@ namespace foobar::UI {
 
         ATLASSERT(IsDlgItem(IDC_SCALE_EDIT));
         WinAPIVerify(SetDlgItemFloat(IDC_SCALE_EDIT, VisConfig().m_fScale));
+
+        ATLASSERT(IsDlgItem(IDC_ENVELOPE_CHECK));
+        WinAPIVerify(CheckDlgButton(IDC_ENVELOPE_CHECK,
+                                    VisConfig().m_bEnvelope
+                                    ? BST_CHECKED
+                                    : BST_UNCHECKED));
+
+        ATLASSERT(m_TriggerCombo.IsWindow());
+        [[maybe_unused]]
+        const auto nIndex = m_TriggerCombo.SelectValue(VisConfig().m_eTrigger);
+        ATLASSERT(nIndex != CB_ERR);
     }
 
     //-----------------------------------------------------------------------------
@@ -251,6 +286,14 @@ namespace foobar::UI {
         EnableDlgItem(IDC_SCALE_STATIC, bEnable);
         EnableDlgItem(IDC_SCALE_EDIT  , bEnable);
 
+        ATLASSERT(IsDlgItem(IDC_ENVELOPE_CHECK));
+        EnableDlgItem(IDC_ENVELOPE_CHECK, bEnable);
+
+        ATLASSERT(IsDlgItem(IDC_TRIGGER_STATIC));
+        ATLASSERT(IsDlgItem(IDC_TRIGGER_COMBO));
+        EnableDlgItem(IDC_TRIGGER_STATIC, bEnable);
+        EnableDlgItem(IDC_TRIGGER_COMBO , bEnable);
+
         ATLASSERT(IsDlgItem(IDC_COLOUR_1_STATIC_TEXT));
         ATLASSERT(IsDlgItem(IDC_COLOUR_1_STATIC));
         ATLASSERT(IsDlgItem(IDC_COLOUR_1_BUTTON));
@@ -30,6 +30,7 @@
 //--------------------------------------
 //
 #include "foobar/UI/foobar_pref_vis_dlg.h"
+#include "Windows/UI/ATL_EnumComboBox.h"
 #include "Config/Config_Oscilloscope.h"
 //--------------------------------------
 
@@ -51,6 +52,10 @@ namespace foobar::UI {
         using dialogImpl = Windows::UI::CDialogImpl<thisClass, baseClass>;
 
         using CColorSwatchStatic = Windows::UI::CColorSwatchStatic;
+        using CTriggerComboHelper =
+            foobar::UI::CSequentialEnumHelperT<OscilloscopeTrigger>;
+        using CTriggerCombo =
+            Windows::UI::CEnumComboBoxT<OscilloscopeTrigger, CTriggerComboHelper>;
 
     public: // Construction
         COscilloscopeDlg() = default;
@@ -122,6 +127,7 @@ namespace foobar::UI {
     private: // Data
         enum { PrimarySwatch = 0, SecondarySwatch = 1, BackgroundSwatch = 2, SwatchCount };
         CColorSwatchStatic m_Color[SwatchCount]{};
+        CTriggerCombo      m_TriggerCombo{};
     }; // class COscilloscopeDlg
 } // namespace foobar::UI
 
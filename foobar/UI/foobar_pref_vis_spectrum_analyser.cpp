@@ -62,6 +62,12 @@ namespace foobar::UI::detail {
         ATLASSERT(m_ModeCombo.IsWindow());
         ATLVERIFY(m_ModeCombo.InsertAll());
 
+        ATLASSERT(IsDlgItem(IDC_SPEC_SCALE_COMBO));
+        m_ScaleCombo.Detach();
+        m_ScaleCombo.Attach(GetDlgItem(IDC_SPEC_SCALE_COMBO));
+        ATLASSERT(m_ScaleCombo.IsWindow());
+        ATLVERIFY(m_ScaleCombo.InsertAll());
+
         UpdateControls();
         EnableControls();
         bHandled = TRUE;
@@ -204,6 +210,16 @@ namespace foobar::UI::detail {
                 break;
             }
 
+            case IDC_SPEC_SCALE_COMBO: {
+                auto spectrumScale = VisConfig().m_Scale;
+                if (m_ScaleCombo.GetCurSelVal(spectrumScale)) {
+                    bConfigChanged = VisConfig().m_Scale != spectrumScale;
+                    VisConfig().m_Scale = spectrumScale;
+                }
+                bHandled = TRUE;
+                break;
+            }
+
             case IDC_PEAK_CHECK: {
                 bConfigChanged = GetCheckBoxState(nDialogItem,
                                                   VisConfig().m_Peak.m_bEnable);
@@ -330,6 +346,11 @@ namespace foobar::UI::detail {
         const auto nIndex = m_ModeCombo.SelectValue(VisConfig().m_SpectrumMode);
         ATLASSERT(nIndex != CB_ERR);
 
+        ATLASSERT(m_ScaleCombo.IsWindow());
+        [[maybe_unused]]
+        const auto nScaleIndex = m_ScaleCombo.SelectValue(VisConfig().m_Scale);
+        ATLASSERT(nScaleIndex != CB_ERR);
+
         WinAPIVerify(CheckDlgButton(IDC_PEAK_CHECK,
                                     VisConfig().m_Peak.m_bEnable
                                     ? BST_CHECKED
@@ -386,10 +407,14 @@ namespace foobar::UI::detail {
         EnableDlgItem(IDC_START_WITH_CHECK, bEnableStartWith);
 
         ATLASSERT(IsDlgItem(IDC_SPEC_MODE_COMBO));
+        ATLASSERT(IsDlgItem(IDC_SPEC_SCALE_STATIC));
+        ATLASSERT(IsDlgItem(IDC_SPEC_SCALE_COMBO));
         ATLASSERT(IsDlgItem(IDC_PEAK_CHECK));
         ATLASSERT(IsDlgItem(IDC_PRE_SCALE_STATIC));
         ATLASSERT(IsDlgItem(IDC_PRE_SCALE_EDIT));
         EnableDlgItem(IDC_SPEC_MODE_COMBO , bEnable);
+        EnableDlgItem(IDC_SPEC_SCALE_STATIC, bEnable);
+        EnableDlgItem(IDC_SPEC_SCALE_COMBO , bEnable);
         EnableDlgItem(IDC_PEAK_CHECK      , bEnable);
         EnableDlgItem(IDC_PRE_SCALE_STATIC, bEnable);
         EnableDlgItem(IDC_PRE_SCALE_EDIT  , bEnable);
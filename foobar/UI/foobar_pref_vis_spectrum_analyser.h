@@ -56,6 +56,10 @@ namespace foobar::UI::detail {
             foobar::UI::CSequentialEnumHelperT<SpectrumAnalyserMode>;
         using CModeCombo =
             Windows::UI::CEnumComboBoxT<SpectrumAnalyserMode, CModeComboHelper>;
+        using CScaleComboHelper =
+            foobar::UI::CSequentialEnumHelperT<SpectrumAnalyserScale>;
+        using CScaleCombo =
+            Windows::UI::CEnumComboBoxT<SpectrumAnalyserScale, CScaleComboHelper>;
 
     protected: // Construction
         CSpectrumAnalyserDialogCommon() = default;
@@ -105,6 +109,7 @@ namespace foobar::UI::detail {
         };
         CColorSwatchStatic m_Color[SwatchCount]{};
         CModeCombo         m_ModeCombo{};
+        CScaleCombo        m_ScaleCombo{};
     }; //class CSpectrumAnalyserDialogCommon
 } // namespace foobar::UI::detail
 
@@ -42,7 +42,13 @@ namespace foobar::UI {
                 switch (s) {
                     case SpectrumAnalyserType::Mono:
                         [[fallthrough]];
-                    case SpectrumAnalyserType::Stereo: {
+                    case SpectrumAnalyserType::Stereo:
+                        [[fallthrough]];
+                    case SpectrumAnalyserType::Spectrogram:
+                        [[fallthrough]];
+                    case SpectrumAnalyserType::Chromagram:
+                        [[fallthrough]];
+                    case SpectrumAnalyserType::Shader: {
                         auto pDlg = CSpectrumAnalyserDlg::MakeDialog(s.to_string(),
                                                                      VisualisationMode::SpectrumAnalyser,
                                                                      s, Config());
@@ -114,6 +114,7 @@ namespace foobar {
         now_playing_album_art_notify_manager::get()->remove(this);
         play_callback_manager::get()->unregister_callback(this);
         m_pVisStream.reset();
+        m_WaveformBuffer.reset();
         m_pCurrentTrack.release();
     }
 
@@ -143,10 +144,7 @@ namespace foobar {
     //------------------------------------------------------
     //------------------------------------------------------
 
-    void foobar_audio_data_manager::OnUpdate(const update_params& params,
-                                             const update_hint_params& hints) {
-        namespace fb_vis = foobar::visualisation;
-
+    void foobar_audio_data_manager::OnUpdateMetadata() {
         fb_cached_metadata cached_metadata{};
         {
             const auto lock{ m_CriticalSection.ScopedLock() };
@@ -156,6 +154,14 @@ namespace foobar {
 
         SetTrackChanged(cached_metadata.has_track_changed());
 
+        // Any discontinuity in playback invalidates the buffered waveform,
+        // the analysis thread will act on this at its next update.
+        if (cached_metadata.has_track_changed() ||
+            cached_metadata.has_seeked() ||
+            cached_metadata.has_play_state_changed()) {
+            m_bResyncAudio.Set(true);
+        }
+
         if (cached_metadata.has_play_state_changed()) {
             SetPlayState(cached_metadata.get_stopped(),
                          cached_metadata.get_paused());
@@ -167,6 +173,7 @@ namespace foobar {
 
         if (cached_metadata.has_track_length_changed()) {
             SetTrackDuration(static_cast<duration_type>(cached_metadata.get_track_length()));
+            m_fAnalysisTrackLength.Set(cached_metadata.get_track_length());
         }
 
         if (cached_metadata.has_text_data_changed()) {
@@ -187,6 +194,17 @@ namespace foobar {
             }
             SetAlbumArt(std::move(image));
         }
+    }
+
+    //------------------------------------------------------
+
+    void foobar_audio_data_manager::OnUpdate(const update_params& params,
+                                             const update_hint_params& hints) {
+        namespace fb_vis = foobar::visualisation;
+
+        if (m_bResyncAudio.Exchange(false)) {
+            m_WaveformBuffer.reset();
+        }
 
         if (params.m_WantWaveform || params.m_WantSpectrum) {
             fb_duration_type absTime{ 0 };
@@ -194,7 +212,7 @@ namespace foobar {
                 absTime = 0;
             }
             auto offset{ absTime + static_cast<double>(params.m_Offset) };
-            const auto length{ GetTrackLength() };
+            const auto length{ m_fAnalysisTrackLength.Get() };
             if (offset > length) { offset = length; }
 
             if (params.m_WantWaveform) {
@@ -206,10 +224,19 @@ namespace foobar {
                 } else if (duratation < minimum_duratation) {
                     duratation = minimum_duratation;
                 }
-                const auto data{ fb_vis::get_audio_data(m_pVisStream, offset, duratation) };
-                SetWaveformData(data.get_data(),
-                                data.get_data_size(),
-                                data.get_channel_count());
+                // Only the audio since the last update is requested from
+                // the stream, the remainder of the window is retained from
+                // previous updates (and read in place).
+                if (m_WaveformBuffer.update(m_pVisStream, offset, duratation)) {
+                    const auto channels{ m_WaveformBuffer.get_channel_count() };
+                    SetWaveformData(m_WaveformBuffer.window(),
+                                    m_WaveformBuffer.get_frame_count() * channels,
+                                    channels,
+                                    m_WaveformBuffer.get_added_count() * channels,
+                                    m_WaveformBuffer.get_sample_rate());
+                } else {
+                    SetWaveformData(nullptr, 0, 0, 0, 0);
+                }
             }
 
             if (params.m_WantSpectrum) {
@@ -219,7 +246,8 @@ namespace foobar {
                 const auto data{ fb_vis::get_spectrum_data(m_pVisStream, offset, fftSize) };
                 SetSpectrumData(data.get_data(),
                                 data.get_data_size(),
-                                data.get_channel_count());
+                                data.get_channel_count(),
+                                data.get_sample_rate());
             }
         }
     }
@@ -277,7 +305,7 @@ namespace foobar {
 
     void foobar_audio_data_manager::on_playback_seek(double p_time) noexcept {
         const auto lock{ m_CriticalSection.ScopedLock() };
-        m_CachedMetadata.on_playback_time(p_time);
+        m_CachedMetadata.on_playback_seek(p_time);
     }
 
     //------------------------------------------------------
@@ -32,6 +32,7 @@
 #include "foobar/foobar_core_util.h"
 #include "foobar/foobar_formatter_util.h"
 #include "foobar/foobar_visualisation_util.h"
+#include "foobar/foobar_visualisation_ring_buffer.h"
 #include "foobar/foobar_album_art_util.h"
 #include "foobar/foobar_cached_metadata.h"
 //--------------------------------------
@@ -68,10 +69,14 @@ namespace foobar {
         using fb_metadata_ptr             = ::metadb_handle_ptr;
         using fb_visualisation_stream_ptr = ::foobar::visualisation::stream_ptr_t;
         using fb_album_art_id_list        = ::foobar::metadata::album_art::id_list_t;
+        using fb_audio_ring_buffer        = ::foobar::visualisation::audio_ring_buffer;
 
     private:
         using critical_section            = ::Windows::Thread::CriticalSection;
 
+        template <typename TypeT>
+        using critical_section_protected  = ::Windows::Thread::CriticalSectionProtectedVariableT<TypeT>;
+
     public:
         static void initialise() {
             IAudioDataManager::initialise<foobar_audio_data_manager>();
@@ -111,6 +116,8 @@ namespace foobar {
 
         virtual void OnUpdateConfig() override;
 
+        virtual void OnUpdateMetadata() override;
+
         virtual void OnUpdate(const update_params& params,
                               const update_hint_params& hints)  override;
 
@@ -124,9 +131,14 @@ namespace foobar {
         fb_title_formatter          m_TitleFormatter    {};
         fb_cached_metadata          m_CachedMetadata    {};
         fb_album_art_id_list        m_AlbumArtTypeIDList{};
+        fb_audio_ring_buffer        m_WaveformBuffer    {};
 
     private:
         mutable critical_section m_CriticalSection{};
+
+    private: // Render -> Analysis thread
+        critical_section_protected<bool>             m_bResyncAudio        { false };
+        critical_section_protected<fb_duration_type> m_fAnalysisTrackLength{ 0 };
     }; // class foobar_audio_data_manager final
 } // namespace foobar
 
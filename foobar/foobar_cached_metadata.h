@@ -48,6 +48,7 @@ namespace foobar::metadata {
             changed_track_length  = 1 << 3,
             changed_text_data     = 1 << 4,
             changed_album_art     = 1 << 5,
+            changed_seek          = 1 << 6,
         };
 
     public:
@@ -93,6 +94,11 @@ namespace foobar::metadata {
             m_flags |= changed_playback_time;
         }
 
+        void on_playback_seek(duration_type p_time) noexcept {
+            m_playback_time = p_time;
+            m_flags |= changed_playback_time | changed_seek;
+        }
+
         void on_playback_new_track(text_data_type p_metadata,
                                    duration_type p_length,
                                    album_art_data_type p_album_art = {}) {
@@ -140,6 +146,10 @@ namespace foobar::metadata {
             return has_changed(changed_track);
         }
 
+        constexpr bool has_seeked() const noexcept {
+            return has_changed(changed_seek);
+        }
+
         constexpr bool has_play_state_changed() const noexcept {
             return has_changed(changed_play_state);
         }
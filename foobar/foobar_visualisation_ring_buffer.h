@@ -0,0 +1,231 @@
+#pragma once
+#ifndef GUID_587D4995_29C1_43C5_94AB_32C9C743E2A5
+#define GUID_587D4995_29C1_43C5_94AB_32C9C743E2A5
+/*******************************************************************************
+ *******************************************************************************
+ * Copyright (c) 2009-2023 ectotropic (ectotropic@gmail.com,                   *
+ *                                     https://github.com/ectotropic)          *
+ *                                                                             *
+ * This program is free software: you can redistribute it and/or modify it     *
+ * under the terms of the GNU Lesser General Public License as published by    *
+ * the Free Software Foundation, either version 2.1 of the License, or (at     *
+ * your option) any later version.                                             *
+ *                                                                             *
+ * This program is distributed in the hope that it will be useful, but WITHOUT *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License *
+ * for more details.                                                           *
+ *                                                                             *
+ * You should have received a copy of the GNU Lesser General Public License    *
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.       *
+ *                                                                             *
+ *******************************************************************************
+ ******************************************************************************/
+
+//--------------------------------------
+//
+#include "foobar/foobar_visualisation_util.h"
+//--------------------------------------
+
+//--------------------------------------
+//
+#include <vector>
+#include <cmath>
+#include <cstring> // memcpy
+#include <cassert>
+//--------------------------------------
+
+namespace foobar::visualisation {
+    //**************************************************************************
+    // audio_ring_buffer
+    //**************************************************************************
+    // Keeps a fixed length window of (interleaved) audio frames and tops it up
+    // from the visualisation stream with only those frames which have become
+    // available since the last update, rather than re-requesting the whole
+    // window each time.
+    //
+    // The window is resynchronised (i.e. discarded and fetched in full) when:
+    //  - `reset` is called (track change, seek, stop, etc.)
+    //  - The requested time moves backwards
+    //  - The requested time moves forwards by more than the window length
+    //  - The requested window length changes
+    //  - The stream sample rate or channel count changes
+    //
+    // Every frame is stored twice, `capacity` frames apart, so the window is
+    // always one contiguous run within the ring; consumers read it in place
+    // (see `window`) rather than from a copy, and those only interested in
+    // the frames added by the last update can read just those (see `added`).
+    //
+    // NOTE: The stream is sampled in whole frames, with the end of the window
+    //       tracked in frames rather than seconds, so repeated small updates
+    //       will not accumulate rounding drift.
+    class audio_ring_buffer final {
+    public:
+        using sample_type   = ::audio_sample;
+        using size_type     = std::size_t;
+        using duration_type = double;
+        using buffer_type   = std::vector<sample_type>;
+
+    public:
+        audio_ring_buffer() noexcept = default;
+
+        void reset() noexcept {
+            m_valid       = false;
+            m_write       = 0;
+            m_filled      = 0;
+            m_added       = 0;
+            m_end_frame   = 0;
+        }
+
+        bool update(foobar::visualisation::stream_ptr_t p_stream,
+                    duration_type p_offset,
+                    duration_type p_length) {
+            assert(p_stream.is_valid()); if (!p_stream.is_valid()) { return false; }
+            assert(p_length > 0);        if (p_length <= 0) { return false; }
+
+            m_added = 0;
+            if (m_valid) {
+                const auto window_frames{ to_frames(p_length) };
+                const auto target_frame{ to_frames(p_offset + p_length) };
+                if (window_frames != m_capacity ||
+                    target_frame < m_end_frame ||
+                    (target_frame - m_end_frame) > m_capacity) {
+                    m_valid = false;
+                } else if (target_frame > m_end_frame) {
+                    const auto delta{ target_frame - m_end_frame };
+                    ::audio_chunk_impl chunk{};
+                    if (!p_stream->get_chunk_absolute(chunk,
+                                                      from_frames(m_end_frame),
+                                                      from_frames(delta))) {
+                        return m_filled > 0;
+                    }
+                    if (chunk.get_sample_rate() != m_sample_rate ||
+                        chunk.get_channel_count() != m_channel_count) {
+                        m_valid = false;
+                    } else {
+                        const auto frames{ std::min<size_type>(chunk.get_sample_count(), delta) };
+                        push(chunk.get_data(), frames);
+                        m_end_frame += frames;
+                        ++m_fetch_count;
+                        m_fetched_frames += frames;
+                        return true;
+                    }
+                } else {
+                    return m_filled > 0;
+                }
+            }
+            return resync(p_stream, p_offset, p_length);
+        }
+
+        // Whole window (interleaved), oldest first; `get_frame_count`
+        // frames long. Valid until the next `update` or `reset`.
+        [[nodiscard]]
+        const sample_type* window() const noexcept {
+            if (m_filled == 0) { return nullptr; }
+            const auto start{ (m_write + m_capacity - m_filled) % m_capacity };
+            return m_ring.data() + start * m_channel_count;
+        }
+
+        // Frames added by the last `update` (the end of `window`);
+        // `get_added_count` frames long. After a resync, this is the
+        // whole window.
+        [[nodiscard]]
+        const sample_type* added() const noexcept {
+            if (m_added == 0) { return nullptr; }
+            return window() + (m_filled - m_added) * m_channel_count;
+        }
+
+        constexpr auto get_channel_count() const noexcept { return m_channel_count; }
+        constexpr auto get_sample_rate  () const noexcept { return m_sample_rate; }
+        constexpr auto get_frame_count  () const noexcept { return m_filled; }
+        constexpr auto get_added_count  () const noexcept { return m_added; }
+
+        // Statistics (cumulative)
+        constexpr auto get_fetch_count  () const noexcept { return m_fetch_count; }
+        constexpr auto get_fetched_frames() const noexcept { return m_fetched_frames; }
+        constexpr auto get_resync_count () const noexcept { return m_resync_count; }
+
+    private:
+        [[nodiscard]]
+        size_type to_frames(duration_type p_time) const noexcept {
+            if (p_time <= 0) { return 0; }
+            gsl_suppress(26467) // C26467: Converting from floating point to unsigned integral types results in non-portable code if the double/float has a negative value.
+            return static_cast<size_type>(std::llround(p_time * static_cast<duration_type>(m_sample_rate)));
+        }
+
+        [[nodiscard]]
+        duration_type from_frames(size_type p_frames) const noexcept {
+            return static_cast<duration_type>(p_frames) / static_cast<duration_type>(m_sample_rate);
+        }
+
+        bool resync(foobar::visualisation::stream_ptr_t p_stream,
+                    duration_type p_offset,
+                    duration_type p_length) {
+            reset();
+            ++m_resync_count;
+
+            ::audio_chunk_impl chunk{};
+            if (!p_stream->get_chunk_absolute(chunk, p_offset, p_length)) {
+                return false;
+            }
+            const auto sample_rate{ chunk.get_sample_rate() };
+            const auto channels{ chunk.get_channel_count() };
+            if (sample_rate == 0 || channels == 0) { return false; }
+
+            m_sample_rate   = sample_rate;
+            m_channel_count = channels;
+            m_capacity      = std::max<size_type>(to_frames(p_length), 1);
+            m_ring.resize(m_capacity * m_channel_count * 2);
+
+            const auto frames{ std::min<size_type>(chunk.get_sample_count(), m_capacity) };
+            push(chunk.get_data(), frames);
+            m_end_frame = to_frames(p_offset) + frames;
+            m_valid     = true;
+
+            ++m_fetch_count;
+            m_fetched_frames += frames;
+            return true;
+        }
+
+        void push(const sample_type* p_data, size_type p_frames) noexcept {
+            if (!p_data || p_frames == 0) { return; }
+            const auto channels{ m_channel_count };
+            if (p_frames >= m_capacity) {
+                p_data   += (p_frames - m_capacity) * channels;
+                p_frames  = m_capacity;
+            }
+            // Write to both copies; a run which would pass the end
+            // of the second copy wraps round to the start of the first
+            const auto mirror{ m_capacity * channels };
+            const auto first{ std::min(p_frames, m_capacity - m_write) };
+            const auto first_size{ first * channels * sizeof(sample_type) };
+            std::memcpy(m_ring.data() + m_write * channels,          p_data, first_size);
+            std::memcpy(m_ring.data() + m_write * channels + mirror, p_data, first_size);
+            if (first < p_frames) {
+                const auto rest_size{ (p_frames - first) * channels * sizeof(sample_type) };
+                std::memcpy(m_ring.data(),          p_data + first * channels, rest_size);
+                std::memcpy(m_ring.data() + mirror, p_data + first * channels, rest_size);
+            }
+            m_write  = (m_write + p_frames) % m_capacity;
+            m_filled = std::min(m_filled + p_frames, m_capacity);
+            m_added  = std::min(m_added  + p_frames, m_capacity);
+        }
+
+    private:
+        buffer_type m_ring         {}; //< Two copies of `m_capacity` frames
+        size_type   m_capacity     { 0 }; //< In frames
+        size_type   m_write        { 0 }; //< In frames
+        size_type   m_filled       { 0 }; //< In frames
+        size_type   m_added        { 0 }; //< In frames, by the last update
+        size_type   m_end_frame    { 0 }; //< Absolute (stream) frame one past end of window
+        unsigned    m_sample_rate  { 0 };
+        unsigned    m_channel_count{ 0 };
+        bool        m_valid        { false };
+
+        size_type   m_fetch_count   { 0 };
+        size_type   m_fetched_frames{ 0 };
+        size_type   m_resync_count  { 0 };
+    }; // class audio_ring_buffer final
+} // namespace foobar::visualisation
+
+#endif // GUID_587D4995_29C1_43C5_94AB_32C9C743E2A5
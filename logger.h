@@ -117,15 +117,15 @@ namespace logger {
 //
 #ifndef LOGGER_DETAIL_LogIf
 #   define LOGGER_DETAIL_LogIf(logger, expr, ...) \
-        do { if (expr) { logger ## (__VA_ARGS__); } } while(0)
+        do { if (expr) { logger(__VA_ARGS__); } } while(0)
 #endif
 #ifndef LOGGER_DETAIL_LogUnless
 #   define LOGGER_DETAIL_LogUnless(logger, expr, ...) \
-        do { if (!(expr)) { logger ## (__VA_ARGS__); } } while(0)
+        do { if (!(expr)) { logger(__VA_ARGS__); } } while(0)
 #endif
 #ifndef LOGGER_DETAIL_SafeLog
 #   define LOGGER_DETAIL_SafeLog(logger, ...) \
-        do { try{ logger ## (__VA_ARGS__); } catch(...) { assert(false); } } while(0)
+        do { try{ logger(__VA_ARGS__); } catch(...) { assert(false); } } while(0)
 #endif
 //--------------------------------------
 